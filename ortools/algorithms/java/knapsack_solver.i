@@ -46,6 +46,7 @@
 %unignore operations_research::KnapsackSolver::SolverType;
 %unignore operations_research::KnapsackSolver::KNAPSACK_BRUTE_FORCE_SOLVER;
 %unignore operations_research::KnapsackSolver::KNAPSACK_64ITEMS_SOLVER;
+%unignore operations_research::KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER;
 %unignore operations_research::KnapsackSolver::KNAPSACK_DIVIDE_AND_CONQUER_SOLVER;
 %unignore operations_research::KnapsackSolver::KNAPSACK_DYNAMIC_PROGRAMMING_SOLVER;
 %unignore operations_research::KnapsackSolver::KNAPSACK_MULTIDIMENSION_CBC_MIP_SOLVER;  // untested
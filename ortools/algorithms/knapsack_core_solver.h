@@ -0,0 +1,553 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This library solves the 0-1 one-dimensional knapsack problem exactly with a
+// core-based dynamic programming algorithm in the spirit of Pisinger's
+// "minknap" [David Pisinger, "A Minimal Algorithm for the 0-1 Knapsack
+// Problem", Operations Research 45(5):758-767, 1997].
+//
+// The items are sorted by decreasing efficiency (profit per unit of weight),
+// and the greedy solution takes them in this order until the first one that
+// does not fit, the break item. Most items of an optimal solution are the same
+// as in the greedy solution, and only the items whose efficiency is close to
+// the one of the break item, the core, need to be decided. The core is
+// expanded alternately with the next item after it, which may be added to the
+// greedy solution, and with the next item before it, which may be removed from
+// it.
+//
+// Unlike the classic dynamic programming algorithm, which uses a table indexed
+// by capacity, the states are the undominated (weight, profit) pairs of the
+// solutions on the current core, stored in increasing order of weight. Their
+// number does not depend on the capacity, so the algorithm handles very large
+// capacities. States that cannot improve on the best solution found, according
+// to the Dembo-Hammer upper bound computed with the efficiency of the next
+// items to add and to remove, are discarded, which keeps the lists short on
+// most instances. Strongly correlated instances with large coefficients, where
+// all the items have almost the same efficiency, remain hard and may need many
+// states: the time limit should be set accordingly. The states share the
+// history of the changes made to the greedy solution (history_parents_ and
+// history_candidates_), where one record is added for each state created.
+// The records of discarded states are dropped when the history grows beyond a
+// small multiple of the number of states, so that memory stays proportional
+// to the records the current states and the best solution still refer to.
+//
+// The states are stored as separate arrays of weights and profits, so that the
+// loops computing the shifted states when an item is added to the core and
+// their upper bounds are straight loops over contiguous arrays, which the
+// compiler vectorizes.
+//
+// The profits and weights are either int64_t, in which case the result is
+// exact as long as the sum of all the profits and the sum of all the weights
+// fit in an int64_t, or double. Items with a non-positive weight and a
+// non-negative profit are always packed, items with a non-negative weight and
+// a non-positive profit never are, and items with a negative weight and a
+// negative profit are handled by packing them first and deciding whether to
+// remove them.
+//
+// Example Usage:
+// KnapsackCoreSolver<int64_t> solver;
+// solver.Init(profits, weights, capacity);
+// bool is_solution_optimal = false;
+// TimeLimit time_limit(time_limit_seconds);
+// const int64_t profit = solver.Solve(&time_limit, &is_solution_optimal);
+// for (int item_id = 0; item_id < profits.size(); ++item_id) {
+//   solver.best_solution(item_id);  // Access the solution.
+// }
+
+#ifndef OR_TOOLS_ALGORITHMS_KNAPSACK_CORE_SOLVER_H_
+#define OR_TOOLS_ALGORITHMS_KNAPSACK_CORE_SOLVER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/numeric/int128.h"
+#include "absl/types/span.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+
+template <typename Value>
+class KnapsackCoreSolver {
+ public:
+  static_assert(std::is_same_v<Value, int64_t> || std::is_same_v<Value, double>,
+                "KnapsackCoreSolver only supports int64_t and double.");
+
+  KnapsackCoreSolver() = default;
+
+  KnapsackCoreSolver(const KnapsackCoreSolver&) = delete;
+  KnapsackCoreSolver& operator=(const KnapsackCoreSolver&) = delete;
+
+  // Initializes the solver and enters the problem to be solved.
+  void Init(absl::Span<const Value> profits, absl::Span<const Value> weights,
+            Value capacity);
+
+  // Solves the problem and returns the profit of the best solution found. If
+  // the problem is infeasible, i.e. the capacity is too small even with all
+  // the items of negative weight, returns 0 with an empty solution.
+  // is_solution_optimal is set to false if the search was interrupted by the
+  // time limit or by one of the thresholds below.
+  Value Solve(TimeLimit* time_limit, bool* is_solution_optimal);
+
+  // Returns true if the item 'item_id' is packed in the best solution.
+  bool best_solution(int item_id) const {
+    DCHECK_LT(item_id, best_solution_.size());
+    return best_solution_[item_id];
+  }
+
+  // Returns an upper bound on the optimal profit, computed by the last call to
+  // Solve(). It is equal to the profit of the best solution when it is
+  // optimal.
+  Value upper_bound() const { return upper_bound_; }
+
+  // The solver stops if a solution with profit better than
+  // 'solution_lower_bound_threshold' is found.
+  void set_solution_lower_bound_threshold(Value threshold) {
+    solution_lower_bound_threshold_ = threshold;
+  }
+
+  // The solver stops if the upper bound on profit drops below
+  // 'solution_upper_bound_threshold'.
+  void set_solution_upper_bound_threshold(Value threshold) {
+    solution_upper_bound_threshold_ = threshold;
+  }
+
+  // Returns the maximum number of states stored at the same time during the
+  // last call to Solve().
+  int64_t max_num_states() const { return max_num_states_; }
+
+  // Returns the maximum number of records in the history of the states during
+  // the last call to Solve().
+  int64_t max_history_size() const { return max_history_size_; }
+
+ private:
+  // An item that is neither always nor never packed. When is_flipped is true,
+  // the original item has a negative weight and profit, and it is packed
+  // first: packing the candidate means removing it from the knapsack.
+  struct Candidate {
+    int item_id;
+    bool is_flipped;
+    Value weight;
+    Value profit;
+  };
+
+  static constexpr int64_t kNoRecord = -1;
+  static constexpr int64_t kGreedyRecord = -2;
+  // The history is compacted when it has more records than
+  // kHistoryCompactionFactor times the number of states, twice its size after
+  // the last compaction, and kMinHistorySizeToCompact.
+  static constexpr int64_t kHistoryCompactionFactor = 4;
+  static constexpr int64_t kMinHistorySizeToCompact = 1024;
+  static constexpr Value kLowest = std::numeric_limits<Value>::lowest();
+  static constexpr Value kMax = std::numeric_limits<Value>::max();
+
+  // Returns true if candidate a has a strictly greater efficiency than b.
+  bool IsMoreEfficient(const Candidate& a, const Candidate& b) const;
+
+  // Returns an upper bound on the profit of the solutions that can be reached
+  // from the state (weight, profit) by adding the candidates from next_add on,
+  // and removing the candidates up to next_remove, or kLowest if none of them
+  // fits in the knapsack.
+  Value StateUpperBound(Value weight, Value profit, int next_add,
+                        int next_remove) const;
+
+  // Adds the candidate to the core: each state is duplicated with the
+  // candidate packed (if add is true) or removed (if add is false), and only
+  // the undominated states are kept. Updates the best solution.
+  void ExpandCore(int candidate, bool add);
+
+  // Removes the states that cannot improve on the best solution, and updates
+  // states_upper_bound_.
+  void ReduceStates(int next_add, int next_remove);
+
+  // Drops the records of the history which are not on the chains of the
+  // states or of the best solution, if the history is large enough, and
+  // renumbers the other ones.
+  void MaybeCompactHistory();
+
+  // Sets best_solution_ from the best state or from the greedy solution.
+  void BuildBestSolution(int break_candidate);
+
+  std::vector<Value> profits_;
+  std::vector<Value> weights_;
+  Value capacity_ = 0;
+
+  // The candidates, by decreasing efficiency, and the capacity left for them
+  // once the items that are always packed are in the knapsack.
+  std::vector<Candidate> candidates_;
+  Value candidate_capacity_ = 0;
+
+  // The undominated states, by increasing weight and profit, with the index of
+  // their last change in the history.
+  std::vector<Value> state_weights_;
+  std::vector<Value> state_profits_;
+  std::vector<int64_t> state_records_;
+
+  // Buffers used by ExpandCore().
+  std::vector<Value> shifted_weights_;
+  std::vector<Value> shifted_profits_;
+  std::vector<Value> new_weights_;
+  std::vector<Value> new_profits_;
+  std::vector<int64_t> new_records_;
+
+  // The changes made to the greedy solution: a state is obtained by toggling
+  // history_candidates_[r] for each record r on the chain that starts at its
+  // record and follows history_parents_. Parents always have a lower index
+  // than their children, which MaybeCompactHistory() preserves.
+  std::vector<int64_t> history_parents_;
+  std::vector<int> history_candidates_;
+  int64_t compacted_history_size_ = 0;
+
+  // The best solution found, in terms of the candidates: its profit and
+  // either its record, or kGreedyRecord if it is the greedy solution, whose
+  // candidates are in greedy_solution_.
+  Value lower_bound_ = 0;
+  int64_t best_record_ = kNoRecord;
+  std::vector<bool> greedy_solution_;
+
+  // The maximum upper bound of the states, computed by ReduceStates().
+  Value states_upper_bound_ = 0;
+
+  std::vector<bool> best_solution_;
+  Value upper_bound_ = 0;
+  Value solution_lower_bound_threshold_ = kMax;
+  Value solution_upper_bound_threshold_ = kLowest;
+  int64_t max_num_states_ = 0;
+  int64_t max_history_size_ = 0;
+};
+
+template <typename Value>
+void KnapsackCoreSolver<Value>::Init(absl::Span<const Value> profits,
+                                     absl::Span<const Value> weights,
+                                     Value capacity) {
+  CHECK_EQ(profits.size(), weights.size());
+  profits_.assign(profits.begin(), profits.end());
+  weights_.assign(weights.begin(), weights.end());
+  capacity_ = capacity;
+  best_solution_.assign(profits_.size(), false);
+  upper_bound_ = 0;
+}
+
+template <typename Value>
+bool KnapsackCoreSolver<Value>::IsMoreEfficient(const Candidate& a,
+                                                const Candidate& b) const {
+  if constexpr (std::is_integral_v<Value>) {
+    return absl::int128(a.profit) * b.weight >
+           absl::int128(b.profit) * a.weight;
+  } else {
+    return a.profit * b.weight > b.profit * a.weight;
+  }
+}
+
+template <typename Value>
+Value KnapsackCoreSolver<Value>::StateUpperBound(Value weight, Value profit,
+                                                 int next_add,
+                                                 int next_remove) const {
+  const int num_candidates = candidates_.size();
+  if (weight <= candidate_capacity_) {
+    // Removing an item cannot help, as the items that can be added are less
+    // efficient.
+    if (next_add >= num_candidates) return profit;
+    const Candidate& candidate = candidates_[next_add];
+    if constexpr (std::is_integral_v<Value>) {
+      const absl::int128 bound =
+          absl::int128(profit) +
+          absl::int128(candidate_capacity_ - weight) * candidate.profit /
+              candidate.weight;
+      return bound > kMax ? kMax : static_cast<Value>(bound);
+    } else {
+      return profit +
+             (candidate_capacity_ - weight) * candidate.profit /
+                 candidate.weight;
+    }
+  }
+  // The state must remove at least weight - candidate_capacity_, with items
+  // that are at least as efficient as the next one to remove.
+  if (next_remove < 0) return kLowest;
+  const Candidate& candidate = candidates_[next_remove];
+  if constexpr (std::is_integral_v<Value>) {
+    const absl::int128 excess =
+        absl::int128(weight - candidate_capacity_) * candidate.profit;
+    // Rounds the loss up, i.e. the bound down, as the profits are integers.
+    const absl::int128 bound =
+        absl::int128(profit) -
+        (excess + candidate.weight - 1) / candidate.weight;
+    return bound < kLowest ? kLowest : static_cast<Value>(bound);
+  } else {
+    return profit -
+           (weight - candidate_capacity_) * candidate.profit / candidate.weight;
+  }
+}
+
+template <typename Value>
+void KnapsackCoreSolver<Value>::ExpandCore(int candidate, bool add) {
+  const Value delta_weight =
+      add ? candidates_[candidate].weight : -candidates_[candidate].weight;
+  const Value delta_profit =
+      add ? candidates_[candidate].profit : -candidates_[candidate].profit;
+  const size_t num_states = state_weights_.size();
+
+  // The states with the candidate toggled. The order by weight is preserved.
+  shifted_weights_.resize(num_states);
+  shifted_profits_.resize(num_states);
+  for (size_t i = 0; i < num_states; ++i) {
+    shifted_weights_[i] = state_weights_[i] + delta_weight;
+    shifted_profits_[i] = state_profits_[i] + delta_profit;
+  }
+
+  // Merges the two lists by increasing weight, keeping a state only if its
+  // profit is greater than the one of all the lighter states.
+  new_weights_.clear();
+  new_profits_.clear();
+  new_records_.clear();
+  size_t i = 0;
+  size_t j = 0;
+  while (i < num_states || j < num_states) {
+    bool take_shifted;
+    if (i == num_states) {
+      take_shifted = true;
+    } else if (j == num_states) {
+      take_shifted = false;
+    } else if (shifted_weights_[j] != state_weights_[i]) {
+      take_shifted = shifted_weights_[j] < state_weights_[i];
+    } else {
+      take_shifted = shifted_profits_[j] > state_profits_[i];
+    }
+    const Value weight = take_shifted ? shifted_weights_[j] : state_weights_[i];
+    const Value profit = take_shifted ? shifted_profits_[j] : state_profits_[i];
+    const int64_t parent_record = take_shifted ? state_records_[j] : 0;
+    const int64_t record = take_shifted ? 0 : state_records_[i];
+    if (take_shifted) {
+      ++j;
+    } else {
+      ++i;
+    }
+    if (!new_profits_.empty() && profit <= new_profits_.back()) continue;
+    new_weights_.push_back(weight);
+    new_profits_.push_back(profit);
+    if (take_shifted) {
+      new_records_.push_back(history_parents_.size());
+      history_parents_.push_back(parent_record);
+      history_candidates_.push_back(candidate);
+      if (weight <= candidate_capacity_ && profit > lower_bound_) {
+        lower_bound_ = profit;
+        best_record_ = new_records_.back();
+      }
+    } else {
+      new_records_.push_back(record);
+    }
+  }
+  state_weights_.swap(new_weights_);
+  state_profits_.swap(new_profits_);
+  state_records_.swap(new_records_);
+  max_num_states_ =
+      std::max<int64_t>(max_num_states_, state_weights_.size());
+}
+
+template <typename Value>
+void KnapsackCoreSolver<Value>::ReduceStates(int next_add, int next_remove) {
+  states_upper_bound_ = lower_bound_;
+  size_t num_kept = 0;
+  for (size_t i = 0; i < state_weights_.size(); ++i) {
+    const Value bound = StateUpperBound(state_weights_[i], state_profits_[i],
+                                        next_add, next_remove);
+    if (bound <= lower_bound_) continue;
+    states_upper_bound_ = std::max(states_upper_bound_, bound);
+    state_weights_[num_kept] = state_weights_[i];
+    state_profits_[num_kept] = state_profits_[i];
+    state_records_[num_kept] = state_records_[i];
+    ++num_kept;
+  }
+  state_weights_.resize(num_kept);
+  state_profits_.resize(num_kept);
+  state_records_.resize(num_kept);
+}
+
+template <typename Value>
+void KnapsackCoreSolver<Value>::MaybeCompactHistory() {
+  const int64_t history_size = history_parents_.size();
+  max_history_size_ = std::max(max_history_size_, history_size);
+  if (history_size <= std::max({kMinHistorySizeToCompact,
+                                kHistoryCompactionFactor *
+                                    static_cast<int64_t>(state_records_.size()),
+                                2 * compacted_history_size_})) {
+    return;
+  }
+  // Marks the records on the chains with 0, in a single backward pass since
+  // parents come before their children.
+  std::vector<int64_t> new_records(history_size, kNoRecord);
+  for (const int64_t record : state_records_) {
+    if (record >= 0) new_records[record] = 0;
+  }
+  if (best_record_ >= 0) new_records[best_record_] = 0;
+  for (int64_t record = history_size - 1; record >= 0; --record) {
+    const int64_t parent = history_parents_[record];
+    if (new_records[record] == 0 && parent >= 0) new_records[parent] = 0;
+  }
+  // Keeps the marked records in the same order.
+  int64_t num_kept = 0;
+  for (int64_t record = 0; record < history_size; ++record) {
+    if (new_records[record] == kNoRecord) continue;
+    const int64_t parent = history_parents_[record];
+    history_parents_[num_kept] = parent >= 0 ? new_records[parent] : parent;
+    history_candidates_[num_kept] = history_candidates_[record];
+    new_records[record] = num_kept++;
+  }
+  history_parents_.resize(num_kept);
+  history_candidates_.resize(num_kept);
+  for (int64_t& record : state_records_) {
+    if (record >= 0) record = new_records[record];
+  }
+  if (best_record_ >= 0) best_record_ = new_records[best_record_];
+  compacted_history_size_ = num_kept;
+}
+
+template <typename Value>
+void KnapsackCoreSolver<Value>::BuildBestSolution(int break_candidate) {
+  const int num_candidates = candidates_.size();
+  std::vector<bool> is_packed;
+  if (best_record_ == kGreedyRecord) {
+    is_packed = greedy_solution_;
+  } else {
+    is_packed.assign(num_candidates, false);
+    std::fill(is_packed.begin(), is_packed.begin() + break_candidate, true);
+    for (int64_t record = best_record_; record != kNoRecord;
+         record = history_parents_[record]) {
+      const int candidate = history_candidates_[record];
+      is_packed[candidate] = !is_packed[candidate];
+    }
+  }
+  for (int candidate = 0; candidate < num_candidates; ++candidate) {
+    const Candidate& c = candidates_[candidate];
+    best_solution_[c.item_id] = is_packed[candidate] != c.is_flipped;
+  }
+}
+
+template <typename Value>
+Value KnapsackCoreSolver<Value>::Solve(TimeLimit* time_limit,
+                                       bool* is_solution_optimal) {
+  DCHECK(time_limit != nullptr);
+  DCHECK(is_solution_optimal != nullptr);
+  *is_solution_optimal = true;
+  max_num_states_ = 0;
+  max_history_size_ = 0;
+  const int num_items = profits_.size();
+  best_solution_.assign(num_items, false);
+
+  // Fixes the items whose decision is trivial, and flips the ones with a
+  // negative weight and profit.
+  candidates_.clear();
+  Value fixed_profit = 0;
+  candidate_capacity_ = capacity_;
+  for (int item_id = 0; item_id < num_items; ++item_id) {
+    const Value profit = profits_[item_id];
+    const Value weight = weights_[item_id];
+    if (weight <= 0 && profit >= 0) {
+      best_solution_[item_id] = true;
+      fixed_profit += profit;
+      candidate_capacity_ -= weight;
+    } else if (weight >= 0 && profit <= 0) {
+      continue;
+    } else if (weight > 0) {
+      candidates_.push_back({item_id, false, weight, profit});
+    } else {
+      best_solution_[item_id] = true;
+      fixed_profit += profit;
+      candidate_capacity_ -= weight;
+      candidates_.push_back({item_id, true, -weight, -profit});
+    }
+  }
+  if (candidate_capacity_ < 0) {
+    // Even the lightest solution does not fit.
+    best_solution_.assign(num_items, false);
+    upper_bound_ = 0;
+    return 0;
+  }
+  std::stable_sort(candidates_.begin(), candidates_.end(),
+                   [this](const Candidate& a, const Candidate& b) {
+                     return IsMoreEfficient(a, b);
+                   });
+  const int num_candidates = candidates_.size();
+
+  // The break solution packs all the candidates before the break candidate.
+  int break_candidate = 0;
+  Value break_weight = 0;
+  Value break_profit = 0;
+  while (break_candidate < num_candidates &&
+         candidates_[break_candidate].weight <=
+             candidate_capacity_ - break_weight) {
+    break_weight += candidates_[break_candidate].weight;
+    break_profit += candidates_[break_candidate].profit;
+    ++break_candidate;
+  }
+
+  // The greedy solution also packs the next candidates that still fit.
+  greedy_solution_.assign(num_candidates, false);
+  std::fill(greedy_solution_.begin(),
+            greedy_solution_.begin() + break_candidate, true);
+  Value greedy_weight = break_weight;
+  lower_bound_ = break_profit;
+  for (int candidate = break_candidate; candidate < num_candidates;
+       ++candidate) {
+    if (candidates_[candidate].weight <= candidate_capacity_ - greedy_weight) {
+      greedy_weight += candidates_[candidate].weight;
+      lower_bound_ += candidates_[candidate].profit;
+      greedy_solution_[candidate] = true;
+    }
+  }
+  best_record_ = kGreedyRecord;
+
+  history_parents_.clear();
+  history_candidates_.clear();
+  compacted_history_size_ = 0;
+  state_weights_.assign(1, break_weight);
+  state_profits_.assign(1, break_profit);
+  state_records_.assign(1, kNoRecord);
+  int next_add = break_candidate;
+  int next_remove = break_candidate - 1;
+  ReduceStates(next_add, next_remove);
+  while (!state_weights_.empty() &&
+         (next_add < num_candidates || next_remove >= 0)) {
+    if (time_limit->LimitReached() ||
+        fixed_profit + lower_bound_ > solution_lower_bound_threshold_ ||
+        fixed_profit + states_upper_bound_ < solution_upper_bound_threshold_) {
+      *is_solution_optimal = false;
+      break;
+    }
+    if (next_add < num_candidates) {
+      ExpandCore(next_add, /*add=*/true);
+      ++next_add;
+      ReduceStates(next_add, next_remove);
+      MaybeCompactHistory();
+    }
+    if (next_remove >= 0 && !state_weights_.empty()) {
+      ExpandCore(next_remove, /*add=*/false);
+      --next_remove;
+      ReduceStates(next_add, next_remove);
+      MaybeCompactHistory();
+    }
+  }
+
+  BuildBestSolution(break_candidate);
+  upper_bound_ = fixed_profit + (*is_solution_optimal ? lower_bound_
+                                                      : states_upper_bound_);
+  return fixed_profit + lower_bound_;
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_ALGORITHMS_KNAPSACK_CORE_SOLVER_H_
@@ -0,0 +1,287 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/algorithms/knapsack_core_solver.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+namespace {
+
+// The instance of KnapsackSolverTest.SolveBigOneDimension.
+const std::vector<int64_t>& BigProfits() {
+  static const auto* const kProfits = new std::vector<int64_t>{
+      360, 83, 59,  130, 431, 67, 230, 52,  93,  125, 670, 892, 600,
+      38,  48, 147, 78,  256, 63, 17,  120, 164, 432, 35,  92,  110,
+      22,  42, 50,  323, 514, 28, 87,  73,  78,  15,  26,  78,  210,
+      36,  85, 189, 274, 43,  33, 10,  19,  389, 276, 312};
+  return *kProfits;
+}
+
+const std::vector<int64_t>& BigWeights() {
+  static const auto* const kWeights = new std::vector<int64_t>{
+      7,  0,  30, 22, 80, 94, 11, 81, 70, 64, 59, 18, 0,  36, 3,  8,  15,
+      42, 9,  0,  42, 47, 52, 32, 26, 48, 55, 6,  29, 84, 2,  4,  18, 56,
+      7,  29, 93, 44, 71, 3,  86, 66, 31, 65, 0,  79, 20, 65, 52, 13};
+  return *kWeights;
+}
+
+constexpr int64_t kBigCapacity = 850;
+constexpr int64_t kBigOptimalProfit = 7534;
+
+// Returns the profit of the best solution by enumerating all the solutions, or
+// nullopt if no solution fits.
+template <typename Value>
+std::optional<Value> BruteForceProfit(const std::vector<Value>& profits,
+                                      const std::vector<Value>& weights,
+                                      Value capacity) {
+  const int num_items = profits.size();
+  std::optional<Value> best_profit;
+  for (int solution = 0; solution < (1 << num_items); ++solution) {
+    Value weight = 0;
+    Value profit = 0;
+    for (int item_id = 0; item_id < num_items; ++item_id) {
+      if (solution & (1 << item_id)) {
+        weight += weights[item_id];
+        profit += profits[item_id];
+      }
+    }
+    if (weight <= capacity && (!best_profit || profit > *best_profit)) {
+      best_profit = profit;
+    }
+  }
+  return best_profit;
+}
+
+// Checks that the best solution of the solver fits and has the given profit.
+template <typename Value>
+void ExpectSolution(const KnapsackCoreSolver<Value>& solver,
+                    const std::vector<Value>& profits,
+                    const std::vector<Value>& weights, Value capacity,
+                    Value expected_profit) {
+  Value weight = 0;
+  Value profit = 0;
+  for (int item_id = 0; item_id < profits.size(); ++item_id) {
+    if (solver.best_solution(item_id)) {
+      weight += weights[item_id];
+      profit += profits[item_id];
+    }
+  }
+  EXPECT_LE(weight, capacity);
+  EXPECT_EQ(profit, expected_profit);
+}
+
+template <typename Value>
+class KnapsackCoreSolverTest : public ::testing::Test {};
+
+using ValueTypes = ::testing::Types<int64_t, double>;
+TYPED_TEST_SUITE(KnapsackCoreSolverTest, ValueTypes);
+
+TYPED_TEST(KnapsackCoreSolverTest, MatchesBruteForce) {
+  // Values in [-kRange, kRange], in quarters for doubles, so that the sums are
+  // exact. Negative capacities and items with a negative weight and profit,
+  // which are flipped, are frequent.
+  constexpr int kRange = 20;
+  const TypeParam kUnit = std::is_integral_v<TypeParam> ? 1 : 0.25;
+  std::mt19937 random(12345);
+  const auto uniform = [&random, kUnit](int low, int high) {
+    return kUnit * std::uniform_int_distribution<int>(low, high)(random);
+  };
+  KnapsackCoreSolver<TypeParam> solver;
+  for (int instance = 0; instance < 500; ++instance) {
+    SCOPED_TRACE(instance);
+    const int num_items = std::uniform_int_distribution<int>(0, 12)(random);
+    std::vector<TypeParam> profits(num_items);
+    std::vector<TypeParam> weights(num_items);
+    for (int item_id = 0; item_id < num_items; ++item_id) {
+      profits[item_id] = uniform(-kRange, kRange);
+      weights[item_id] = uniform(-kRange, kRange);
+    }
+    const TypeParam capacity = uniform(-kRange, 3 * kRange);
+    solver.Init(profits, weights, capacity);
+    TimeLimit time_limit;
+    bool is_solution_optimal = false;
+    const TypeParam profit = solver.Solve(&time_limit, &is_solution_optimal);
+    EXPECT_TRUE(is_solution_optimal);
+    EXPECT_EQ(solver.upper_bound(), profit);
+    const std::optional<TypeParam> expected_profit =
+        BruteForceProfit(profits, weights, capacity);
+    if (!expected_profit.has_value()) {
+      EXPECT_EQ(profit, 0);
+      for (int item_id = 0; item_id < num_items; ++item_id) {
+        EXPECT_FALSE(solver.best_solution(item_id));
+      }
+    } else {
+      EXPECT_EQ(profit, *expected_profit);
+      ExpectSolution(solver, profits, weights, capacity, profit);
+    }
+  }
+}
+
+TYPED_TEST(KnapsackCoreSolverTest, NegativeWeightsAndProfits) {
+  // The first item, of negative weight and profit, is packed to make room for
+  // the second one, whose profit makes up for its loss.
+  const std::vector<TypeParam> profits = {-3, 10, -1, 4};
+  const std::vector<TypeParam> weights = {-5, 8, -1, 4};
+  KnapsackCoreSolver<TypeParam> solver;
+  solver.Init(profits, weights, 3);
+  TimeLimit time_limit;
+  bool is_solution_optimal = false;
+  EXPECT_EQ(solver.Solve(&time_limit, &is_solution_optimal), 7);
+  EXPECT_TRUE(is_solution_optimal);
+  EXPECT_TRUE(solver.best_solution(0));
+  EXPECT_TRUE(solver.best_solution(1));
+  EXPECT_FALSE(solver.best_solution(2));
+  EXPECT_FALSE(solver.best_solution(3));
+  ExpectSolution<TypeParam>(solver, profits, weights, 3, 7);
+}
+
+TYPED_TEST(KnapsackCoreSolverTest, InfeasibleCapacity) {
+  KnapsackCoreSolver<TypeParam> solver;
+  // Even with the item of negative weight, the lightest solution weighs -2.
+  solver.Init({5, -1, 3}, {4, -2, 1}, -3);
+  TimeLimit time_limit;
+  bool is_solution_optimal = false;
+  EXPECT_EQ(solver.Solve(&time_limit, &is_solution_optimal), 0);
+  EXPECT_TRUE(is_solution_optimal);
+  EXPECT_EQ(solver.upper_bound(), 0);
+  for (int item_id = 0; item_id < 3; ++item_id) {
+    EXPECT_FALSE(solver.best_solution(item_id));
+  }
+  // A capacity that fits the lightest solution.
+  solver.Init({5, -1, 3}, {4, -2, 1}, -2);
+  EXPECT_EQ(solver.Solve(&time_limit, &is_solution_optimal), -1);
+  EXPECT_TRUE(is_solution_optimal);
+  EXPECT_TRUE(solver.best_solution(1));
+}
+
+// Strongly correlated instances, where all the items have almost the same
+// efficiency, need many states and create many more, whose records must be
+// dropped from the history to bound memory.
+TEST(KnapsackCoreSolverHistoryTest, StronglyCorrelatedInstances) {
+  std::mt19937 random(12345);
+  for (int instance = 0; instance < 10; ++instance) {
+    SCOPED_TRACE(instance);
+    constexpr int kNumItems = 300;
+    std::vector<int64_t> profits(kNumItems);
+    std::vector<int64_t> weights(kNumItems);
+    int64_t total_weight = 0;
+    for (int item_id = 0; item_id < kNumItems; ++item_id) {
+      weights[item_id] =
+          std::uniform_int_distribution<int64_t>(1, 1000)(random);
+      profits[item_id] = weights[item_id] + 100;
+      total_weight += weights[item_id];
+    }
+    const int64_t capacity = total_weight / 2;
+    // Dynamic programming on the capacity.
+    std::vector<int64_t> best_profits(capacity + 1, 0);
+    for (int item_id = 0; item_id < kNumItems; ++item_id) {
+      for (int64_t c = capacity; c >= weights[item_id]; --c) {
+        best_profits[c] =
+            std::max(best_profits[c],
+                     best_profits[c - weights[item_id]] + profits[item_id]);
+      }
+    }
+    KnapsackCoreSolver<int64_t> solver;
+    solver.Init(profits, weights, capacity);
+    TimeLimit time_limit;
+    bool is_solution_optimal = false;
+    const int64_t profit = solver.Solve(&time_limit, &is_solution_optimal);
+    EXPECT_TRUE(is_solution_optimal);
+    EXPECT_EQ(profit, best_profits[capacity]);
+    ExpectSolution(solver, profits, weights, capacity, profit);
+    // The history is compacted when it grows beyond a few times the number of
+    // states; without compaction, it is 10 to 25 times larger.
+    EXPECT_LE(solver.max_history_size(),
+              4 * std::max<int64_t>(solver.max_num_states(), 1024));
+  }
+}
+
+class KnapsackCoreSolverBigTest : public ::testing::Test {
+ protected:
+  KnapsackCoreSolverBigTest() {
+    solver_.Init(BigProfits(), BigWeights(), kBigCapacity);
+  }
+
+  // Solves the instance and checks the best solution.
+  int64_t Solve(TimeLimit* time_limit, bool* is_solution_optimal) {
+    const int64_t profit = solver_.Solve(time_limit, is_solution_optimal);
+    ExpectSolution(solver_, BigProfits(), BigWeights(), kBigCapacity, profit);
+    EXPECT_LE(profit, kBigOptimalProfit);
+    EXPECT_LE(profit, solver_.upper_bound());
+    EXPECT_GE(solver_.upper_bound(), kBigOptimalProfit);
+    return profit;
+  }
+
+  KnapsackCoreSolver<int64_t> solver_;
+};
+
+TEST_F(KnapsackCoreSolverBigTest, Optimal) {
+  TimeLimit time_limit;
+  bool is_solution_optimal = false;
+  EXPECT_EQ(Solve(&time_limit, &is_solution_optimal), kBigOptimalProfit);
+  EXPECT_TRUE(is_solution_optimal);
+  EXPECT_EQ(solver_.upper_bound(), kBigOptimalProfit);
+  EXPECT_GT(solver_.max_num_states(), 0);
+}
+
+TEST_F(KnapsackCoreSolverBigTest, UpperBoundAfterInterruption) {
+  std::unique_ptr<TimeLimit> time_limit = TimeLimit::FromDeterministicTime(0.0);
+  bool is_solution_optimal = true;
+  const int64_t profit = Solve(time_limit.get(), &is_solution_optimal);
+  EXPECT_FALSE(is_solution_optimal);
+  EXPECT_LT(profit, solver_.upper_bound());
+}
+
+TEST_F(KnapsackCoreSolverBigTest, SolutionLowerBoundThreshold) {
+  constexpr int64_t kThreshold = 7000;
+  solver_.set_solution_lower_bound_threshold(kThreshold);
+  TimeLimit time_limit;
+  bool is_solution_optimal = true;
+  const int64_t profit = Solve(&time_limit, &is_solution_optimal);
+  EXPECT_FALSE(is_solution_optimal);
+  EXPECT_GT(profit, kThreshold);
+}
+
+TEST_F(KnapsackCoreSolverBigTest, SolutionUpperBoundThreshold) {
+  // Above the bound of the break solution, so that the search stops at once.
+  constexpr int64_t kThreshold = 2 * kBigOptimalProfit;
+  solver_.set_solution_upper_bound_threshold(kThreshold);
+  TimeLimit time_limit;
+  bool is_solution_optimal = true;
+  Solve(&time_limit, &is_solution_optimal);
+  EXPECT_FALSE(is_solution_optimal);
+  EXPECT_LT(solver_.upper_bound(), kThreshold);
+}
+
+TEST_F(KnapsackCoreSolverBigTest, UnreachedThresholds) {
+  solver_.set_solution_lower_bound_threshold(kBigOptimalProfit);
+  solver_.set_solution_upper_bound_threshold(kBigOptimalProfit);
+  TimeLimit time_limit;
+  bool is_solution_optimal = false;
+  EXPECT_EQ(Solve(&time_limit, &is_solution_optimal), kBigOptimalProfit);
+  EXPECT_TRUE(is_solution_optimal);
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -24,6 +24,7 @@
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "ortools/algorithms/knapsack_core_solver.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "ortools/sat/cp_model.h"
@@ -1042,6 +1043,42 @@ int64_t KnapsackDynamicProgrammingSolver::Solve(TimeLimit* /*time_limit*/,
 
   return computed_profits_[capacity_];
 }
+
+// ----- KnapsackCoreDynamicProgrammingSolver -----
+// KnapsackCoreDynamicProgrammingSolver solves the 0-1 knapsack problem with
+// the core-based dynamic programming algorithm of KnapsackCoreSolver, see
+// ortools/algorithms/knapsack_core_solver.h.
+class KnapsackCoreDynamicProgrammingSolver : public BaseKnapsackSolver {
+ public:
+  explicit KnapsackCoreDynamicProgrammingSolver(absl::string_view solver_name)
+      : BaseKnapsackSolver(solver_name) {}
+
+  // Initializes the solver and enters the problem to be solved.
+  void Init(const std::vector<int64_t>& profits,
+            const std::vector<std::vector<int64_t>>& weights,
+            const std::vector<int64_t>& capacities) override {
+    CHECK_EQ(weights.size(), 1)
+        << "Current implementation of the core dynamic programming solver "
+        << "only deals with one dimension.";
+    CHECK_EQ(capacities.size(), weights.size());
+    solver_.Init(profits, weights[0], capacities[0]);
+  }
+
+  // Solves the problem and returns the profit of the optimal solution.
+  int64_t Solve(TimeLimit* time_limit, double /*time_limit_in_second*/,
+                bool* is_solution_optimal) override {
+    return solver_.Solve(time_limit, is_solution_optimal);
+  }
+
+  // Returns true if the item 'item_id' is packed in the optimal knapsack.
+  bool best_solution(int item_id) const override {
+    return solver_.best_solution(item_id);
+  }
+
+ private:
+  KnapsackCoreSolver<int64_t> solver_;
+};
+
 // ----- KnapsackDivideAndConquerSolver -----
 // KnapsackDivideAndConquerSolver solves the 0-1 knapsack problem (KP)
 // using divide and conquer and dynamic programming.
@@ -1410,6 +1447,10 @@ KnapsackSolver::KnapsackSolver(SolverType solver_type,
     case KNAPSACK_DIVIDE_AND_CONQUER_SOLVER:
       solver_ = std::make_unique<KnapsackDivideAndConquerSolver>(solver_name);
       break;
+    case KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER:
+      solver_ = std::make_unique<KnapsackCoreDynamicProgrammingSolver>(
+          solver_name);
+      break;
 #if defined(USE_CBC)
     case KNAPSACK_MULTIDIMENSION_CBC_MIP_SOLVER:
       solver_ = std::make_unique<KnapsackMIPSolver>(
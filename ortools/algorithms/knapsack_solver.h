@@ -197,6 +197,16 @@ class KnapsackSolver {
      * dimensions. This solver is based on the CP-SAT solver
      */
     KNAPSACK_MULTIDIMENSION_CP_SAT_SOLVER = 10,
+    /** Core-based Dynamic Programming approach for single dimension problems
+     *
+     * Limited to one dimension, this solver is based on a dynamic programming
+     * algorithm restricted to the items whose efficiency is close to the one
+     * of the greedy break item, with upper bounds to discard the states that
+     * cannot improve on the greedy solution. Its memory does not depend on
+     * the capacity, which makes it suitable for problems with very large
+     * capacities.
+     */
+    KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER = 11,
   };
 
   explicit KnapsackSolver(const std::string& solver_name);
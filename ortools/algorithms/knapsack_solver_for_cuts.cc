@@ -297,6 +297,9 @@ void KnapsackSolverForCuts::Init(absl::Span<const double> profits,
   CHECK_EQ(number_of_items, weights.size());
 
   propagator_.Init(profits, weights, capacity);
+  if (use_core_dynamic_programming_) {
+    core_solver_.Init(profits, weights, capacity);
+  }
 }
 
 void KnapsackSolverForCuts::GetLowerAndUpperBoundWhenItem(int item_id,
@@ -326,6 +329,17 @@ double KnapsackSolverForCuts::Solve(TimeLimit* time_limit,
                                     bool* is_solution_optimal) {
   DCHECK(time_limit != nullptr);
   DCHECK(is_solution_optimal != nullptr);
+  if (use_core_dynamic_programming_) {
+    core_solver_.set_solution_lower_bound_threshold(
+        solution_lower_bound_threshold_);
+    core_solver_.set_solution_upper_bound_threshold(
+        solution_upper_bound_threshold_);
+    best_solution_profit_ = core_solver_.Solve(time_limit, is_solution_optimal);
+    for (int item_id = 0; item_id < best_solution_.size(); ++item_id) {
+      best_solution_[item_id] = core_solver_.best_solution(item_id);
+    }
+    return best_solution_profit_;
+  }
   best_solution_profit_ = 0;
   *is_solution_optimal = true;
 
@@ -52,6 +52,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/types/span.h"
+#include "ortools/algorithms/knapsack_core_solver.h"
 #include "ortools/base/int_type.h"
 #include "ortools/base/logging.h"
 #include "ortools/util/time_limit.h"
@@ -337,6 +338,15 @@ class KnapsackSolverForCuts {
   // Stops the knapsack solver after processing 'node_limit' nodes.
   void set_node_limit(const int64_t node_limit) { node_limit_ = node_limit; }
 
+  // If true, Solve() uses the core-based dynamic programming algorithm of
+  // KnapsackCoreSolver instead of branch and bound. It is usually much faster
+  // on instances with many items. The node limit is then ignored, but the
+  // thresholds and the time limit still apply. Must be called before Init(),
+  // which only copies the problem into the core solver when it is used.
+  void set_use_core_dynamic_programming(bool use_core_dynamic_programming) {
+    use_core_dynamic_programming_ = use_core_dynamic_programming;
+  }
+
   // Solves the problem and returns the profit of the best solution found.
   double Solve(TimeLimit* time_limit, bool* is_solution_optimal);
   // Returns true if the item 'item_id' is packed in the optimal knapsack.
@@ -380,6 +390,8 @@ class KnapsackSolverForCuts {
   double solution_upper_bound_threshold_ =
       -std::numeric_limits<double>::infinity();
   int64_t node_limit_ = std::numeric_limits<int64_t>::max();
+  bool use_core_dynamic_programming_ = false;
+  KnapsackCoreSolver<double> core_solver_;
 };
 // TODO(user) : Add reduction algorithm.
 
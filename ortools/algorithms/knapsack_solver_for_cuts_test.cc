@@ -337,5 +337,38 @@ TEST(KnapsackSolverForCutsTest, SolveOneDimensionFractional) {
   EXPECT_EQ(kOptimalProfit, profit);
 }
 
+TEST(KnapsackSolverForCutsTest, SolveWithCoreDynamicProgramming) {
+  const std::vector<double> profits = {
+      360, 83, 59,  130, 431, 67, 230, 52,  93,  125, 670, 892, 600,
+      38,  48, 147, 78,  256, 63, 17,  120, 164, 432, 35,  92,  110,
+      22,  42, 50,  323, 514, 28, 87,  73,  78,  15,  26,  78,  210,
+      36,  85, 189, 274, 43,  33, 10,  19,  389, 276, 312};
+  const std::vector<double> weights = {
+      7,  0,  30, 22, 80, 94, 11, 81, 70, 64, 59, 18, 0,  36, 3,  8,  15,
+      42, 9,  0,  42, 47, 52, 32, 26, 48, 55, 6,  29, 84, 2,  4,  18, 56,
+      7,  29, 93, 44, 71, 3,  86, 66, 31, 65, 0,  79, 20, 65, 52, 13};
+  ASSERT_EQ(profits.size(), weights.size());
+  const double kCapacity = 850;
+  const double kOptimalProfit = 7534;
+  KnapsackSolverForCuts solver("solver");
+  solver.set_use_core_dynamic_programming(true);
+  solver.Init(profits, weights, kCapacity);
+  const double profit = SolveKnapsackProblem(&solver);
+  EXPECT_EQ(kOptimalProfit, profit);
+  const int number_of_items(profits.size());
+  std::vector<bool> best_solution(number_of_items, false);
+  for (int item_id(0); item_id < number_of_items; ++item_id) {
+    best_solution.at(item_id) = solver.best_solution(item_id);
+  }
+  EXPECT_TRUE(
+      IsSolutionValid(profits, weights, kCapacity, best_solution, profit));
+
+  // Fractional profits and weights.
+  const std::vector<double> fractional_profits = {0, 0.5, 0.4, 1, 1, 1.1};
+  const std::vector<double> fractional_weights = {9, 6, 2, 1.5, 1.5, 1.5};
+  solver.Init(fractional_profits, fractional_weights, 4);
+  EXPECT_EQ(2.1, SolveKnapsackProblem(&solver));
+}
+
 }  // namespace
 }  // namespace operations_research
@@ -172,6 +172,15 @@ int64_t SolveKnapsackProblem(
     }
   }
 
+  const int64_t core_dynamic_programming_profit =
+      SolveKnapsackProblemUsingSpecificSolver(
+          profit_array, number_of_items, weight_array, capacity_array,
+          number_of_dimensions,
+          KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER);
+  if (core_dynamic_programming_profit != generic_profit) {
+    return kInvalidSolution;
+  }
+
   if (number_of_items <= kMaxNumberOfItemsForDivideAndConquerSolver) {
     const int64_t divide_and_conquer_profit =
         SolveKnapsackProblemUsingSpecificSolver(
@@ -623,5 +632,30 @@ TEST(KnapsackSolverTest, AllItemsReduced) {
   EXPECT_EQ(kOptimalProfit, profit);
 }
 
+TEST(KnapsackSolverTest, SolveOneDimensionWithLargeCapacity) {
+  // The instance of SolveBigOneDimension with weights and capacity scaled up,
+  // which is out of reach of KNAPSACK_DYNAMIC_PROGRAMMING_SOLVER.
+  const int64_t kProfitArray[] = {
+      360, 83, 59,  130, 431, 67, 230, 52,  93,  125, 670, 892, 600,
+      38,  48, 147, 78,  256, 63, 17,  120, 164, 432, 35,  92,  110,
+      22,  42, 50,  323, 514, 28, 87,  73,  78,  15,  26,  78,  210,
+      36,  85, 189, 274, 43,  33, 10,  19,  389, 276, 312};
+  const int64_t kScale = 1000000000000LL;
+  std::vector<int64_t> weights = {
+      7,  0,  30, 22, 80, 94, 11, 81, 70, 64, 59, 18, 0,  36, 3,  8,  15,
+      42, 9,  0,  42, 47, 52, 32, 26, 48, 55, 6,  29, 84, 2,  4,  18, 56,
+      7,  29, 93, 44, 71, 3,  86, 66, 31, 65, 0,  79, 20, 65, 52, 13};
+  for (int64_t& weight : weights) weight *= kScale;
+  const int64_t kCapacityArray[] = {850 * kScale};
+  const int kArraySize = ABSL_ARRAYSIZE(kProfitArray);
+  const int kNumberOfDimensions = ABSL_ARRAYSIZE(kCapacityArray);
+  const int kOptimalProfit = 7534;
+  const int64_t profit = SolveKnapsackProblemUsingSpecificSolver(
+      kProfitArray, kArraySize, weights.data(), kCapacityArray,
+      kNumberOfDimensions,
+      KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER);
+  EXPECT_EQ(kOptimalProfit, profit);
+}
+
 }  // namespace
 }  // namespace operations_research
@@ -184,6 +184,17 @@ Limited to 30 items and one dimension, this solver uses a brute force
 algorithm, ie. explores all possible states. Experiments show
 competitive performance for instances with less than 15 items.)doc";
 
+static const char*
+    __doc_operations_research_KnapsackSolver_SolverType_KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER =  // NOLINT
+    R"doc(Core-based Dynamic Programming approach for single dimension problems
+
+Limited to one dimension, this solver is based on a dynamic
+programming algorithm restricted to the items whose efficiency is
+close to the one of the greedy break item, with upper bounds to
+discard the states that cannot improve on the greedy solution. Its
+memory does not depend on the capacity, which makes it suitable for
+problems with very large capacities.)doc";
+
 static const char*
     __doc_operations_research_KnapsackSolver_SolverType_KNAPSACK_DIVIDE_AND_CONQUER_SOLVER =  // NOLINT
     R"doc(Divide and Conquer approach for single dimension problems
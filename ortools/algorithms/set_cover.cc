@@ -15,19 +15,25 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <numeric>
+#include <random>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
+#include "absl/random/bit_gen_ref.h"
 #include "absl/random/random.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/set_cover_invariant.h"
 #include "ortools/algorithms/set_cover_model.h"
 #include "ortools/algorithms/set_cover_utils.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -191,13 +197,6 @@ void GuidedTabuSearch::Initialize() {
   utilities_ = subset_costs;
 }
 
-namespace {
-bool FlipCoin() {
-  // TODO(user): use STL for repeatable testing.
-  return absl::Bernoulli(absl::BitGen(), 0.5);
-}
-}  // namespace
-
 void GuidedTabuSearch::UpdatePenalties(absl::Span<const SubsetIndex> focus) {
   const SubsetCostVector& subset_costs = inv_->model()->subset_costs();
   Cost max_utility = -1.0;
@@ -210,7 +209,8 @@ void GuidedTabuSearch::UpdatePenalties(absl::Span<const SubsetIndex> focus) {
   for (const SubsetIndex subset : focus) {
     if (inv_->is_selected()[subset]) {
       const double utility = utilities_[subset];
-      if ((max_utility - utility <= epsilon_utility) && FlipCoin()) {
+      if ((max_utility - utility <= epsilon_utility) &&
+          absl::Bernoulli(random_, 0.5)) {
         ++times_penalized_[subset];
         const int times_penalized = times_penalized_[subset];
         const Cost cost =
@@ -303,10 +303,11 @@ bool GuidedTabuSearch::NextSolution(const std::vector<SubsetIndex>& focus,
 }
 
 namespace {
-void SampleSubsets(std::vector<SubsetIndex>* list, std::size_t num_subsets) {
+void SampleSubsets(std::vector<SubsetIndex>* list, std::size_t num_subsets,
+                   absl::BitGenRef random) {
   num_subsets = std::min(num_subsets, list->size());
   CHECK_GE(num_subsets, 0);
-  std::shuffle(list->begin(), list->end(), absl::BitGen());
+  std::shuffle(list->begin(), list->end(), random);
   list->resize(num_subsets);
 }
 }  // namespace
@@ -319,6 +320,14 @@ std::vector<SubsetIndex> ClearRandomSubsets(std::size_t num_subsets,
 std::vector<SubsetIndex> ClearRandomSubsets(absl::Span<const SubsetIndex> focus,
                                             std::size_t num_subsets,
                                             SetCoverInvariant* inv) {
+  absl::BitGen random;
+  return ClearRandomSubsets(focus, num_subsets, random, inv);
+}
+
+std::vector<SubsetIndex> ClearRandomSubsets(absl::Span<const SubsetIndex> focus,
+                                            std::size_t num_subsets,
+                                            absl::BitGenRef random,
+                                            SetCoverInvariant* inv) {
   num_subsets = std::min(num_subsets, focus.size());
   CHECK_GE(num_subsets, 0);
   std::vector<SubsetIndex> chosen_indices;
@@ -327,7 +336,7 @@ std::vector<SubsetIndex> ClearRandomSubsets(absl::Span<const SubsetIndex> focus,
       chosen_indices.push_back(subset);
     }
   }
-  SampleSubsets(&chosen_indices, num_subsets);
+  SampleSubsets(&chosen_indices, num_subsets, random);
   for (const SubsetIndex subset : chosen_indices) {
     // Use UnsafeToggle because we allow non-solutions.
     inv->UnsafeToggle(subset, false);
@@ -394,4 +403,111 @@ std::vector<SubsetIndex> ClearMostCoveredElements(
   return chosen_indices;
 }
 
+// SetCoverPortfolio.
+
+namespace {
+// The best solution found by the workers of a SetCoverPortfolio.
+class SharedSolution {
+ public:
+  // Stores choices if their cost is lower than the one of the best solution.
+  void MaybeUpdate(Cost cost, const SubsetBoolVector& choices) {
+    absl::MutexLock lock(&mutex_);
+    if (has_solution_ && cost >= cost_) return;
+    has_solution_ = true;
+    cost_ = cost;
+    choices_ = choices;
+  }
+
+  // Copies the best solution to choices. Returns false if there is none.
+  bool Get(SubsetBoolVector* choices) const {
+    absl::MutexLock lock(&mutex_);
+    if (!has_solution_) return false;
+    *choices = choices_;
+    return true;
+  }
+
+ private:
+  mutable absl::Mutex mutex_;
+  bool has_solution_ ABSL_GUARDED_BY(mutex_) = false;
+  Cost cost_ ABSL_GUARDED_BY(mutex_) = 0.0;
+  SubsetBoolVector choices_ ABSL_GUARDED_BY(mutex_);
+};
+
+struct PortfolioWorkerParameters {
+  int num_rounds;
+  int num_iterations;
+  double clear_ratio;
+  uint64_t seed;
+  bool run_tabu_search;
+};
+
+void RunPortfolioWorker(const PortfolioWorkerParameters& params,
+                        SetCoverModel* model, SharedSolution* best) {
+  SetCoverInvariant inv(model);
+  std::mt19937_64 random(params.seed);
+  SubsetBoolVector choices;
+  const std::vector<SubsetIndex> all_subsets = model->all_subsets();
+  for (int round = 0; round < params.num_rounds; ++round) {
+    CHECK(best->Get(&choices));
+    inv.LoadSolution(choices);
+    const std::size_t num_selected =
+        std::count(choices.begin(), choices.end(), true);
+    const std::size_t num_subsets_to_clear = std::max<std::size_t>(
+        1, static_cast<std::size_t>(params.clear_ratio * num_selected));
+    ClearRandomSubsets(all_subsets, num_subsets_to_clear, random, &inv);
+    GreedySolutionGenerator greedy(&inv);
+    CHECK(greedy.NextSolution());
+    SteepestSearch steepest(&inv);
+    CHECK(steepest.NextSolution(params.num_iterations));
+    if (params.run_tabu_search) {
+      GuidedTabuSearch gts(&inv);
+      gts.SetSeed(random());
+      CHECK(gts.NextSolution(params.num_iterations));
+    }
+    DCHECK(inv.CheckSolution());
+    best->MaybeUpdate(inv.cost(), inv.is_selected());
+  }
+}
+}  // namespace
+
+bool SetCoverPortfolio::NextSolution() {
+  CHECK_GE(num_workers_, 1);
+  SetCoverModel* const model = inv_->model();
+  // The workers only read the model, so its row views must be built first.
+  model->CreateSparseRowView();
+  // All the workers start from the same solution, computed only once.
+  if (inv_->num_elements_covered() != model->num_elements()) {
+    GreedySolutionGenerator greedy(inv_);
+    if (!greedy.NextSolution()) return false;
+  }
+  SteepestSearch steepest(inv_);
+  if (!steepest.NextSolution(num_iterations_)) return false;
+  SharedSolution best;
+  best.MaybeUpdate(inv_->cost(), inv_->is_selected());
+  const auto worker_parameters = [this](int worker) {
+    return PortfolioWorkerParameters{.num_rounds = num_rounds_,
+                                     .num_iterations = num_iterations_,
+                                     .clear_ratio = clear_ratio_,
+                                     .seed = seed_ + worker,
+                                     .run_tabu_search = worker % 2 == 1};
+  };
+  if (num_workers_ == 1) {
+    RunPortfolioWorker(worker_parameters(0), model, &best);
+  } else {
+    // The destructor of the pool waits for all the workers to finish.
+    ThreadPool pool("SetCoverPortfolio", num_workers_);
+    pool.StartWorkers();
+    for (int worker = 0; worker < num_workers_; ++worker) {
+      pool.Schedule([params = worker_parameters(worker), model, &best]() {
+        RunPortfolioWorker(params, model, &best);
+      });
+    }
+  }
+  SubsetBoolVector choices;
+  CHECK(best.Get(&choices));
+  inv_->LoadSolution(choices);
+  DCHECK(inv_->CheckSolution());
+  return true;
+}
+
 }  // namespace operations_research
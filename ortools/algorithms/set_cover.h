@@ -15,8 +15,11 @@
 #define OR_TOOLS_ALGORITHMS_SET_COVER_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <random>
 #include <vector>
 
+#include "absl/random/bit_gen_ref.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/set_cover_invariant.h"
 #include "ortools/algorithms/set_cover_model.h"
@@ -41,8 +44,8 @@ namespace operations_research {
 // indices. Focus make it possible to run the algorithms on the corresponding
 // subproblems.
 //
-// TODO(user): make the different algorithms concurrent, solving independent
-// subproblems in different threads.
+// SetCoverPortfolio runs several of these algorithms concurrently, in
+// different threads.
 //
 // An obvious idea is to take all the T_j's (or equivalently to set all the
 // x_j's to 1). It's a bit silly but fast, and we can improve on it later using
@@ -198,7 +201,8 @@ class GuidedTabuSearch {
         epsilon_(kDefaultEpsilon),
         augmented_costs_(),
         times_penalized_(),
-        tabu_list_(SubsetIndex(kDefaultTabuListSize)) {
+        tabu_list_(SubsetIndex(kDefaultTabuListSize)),
+        random_() {
     Initialize();
   }
 
@@ -229,6 +233,10 @@ class GuidedTabuSearch {
   void SetTabuListSize(int size) { tabu_list_.Init(size); }
   int GetTabuListSize() const { return tabu_list_.size(); }
 
+  // Sets the seed of the random generator used to choose the subsets to
+  // penalize.
+  void SetSeed(uint64_t seed) { random_.seed(seed); }
+
  private:
   // Updates the penalties on the subsets in focus.
   void UpdatePenalties(absl::Span<const SubsetIndex> focus);
@@ -267,6 +275,9 @@ class GuidedTabuSearch {
   // Tabu search-related data.
   static constexpr int kDefaultTabuListSize = 17;  // Nice prime number.
   TabuList<SubsetIndex> tabu_list_;
+
+  // The random generator used by UpdatePenalties.
+  std::mt19937_64 random_;
 };
 
 // Randomly clears a proportion num_subsets variables in the solution.
@@ -279,6 +290,13 @@ std::vector<SubsetIndex> ClearRandomSubsets(absl::Span<const SubsetIndex> focus,
                                             std::size_t num_subsets,
                                             SetCoverInvariant* inv);
 
+// Same as above, but draws the subsets using the random generator random,
+// which makes the result reproducible for a given seed.
+std::vector<SubsetIndex> ClearRandomSubsets(absl::Span<const SubsetIndex> focus,
+                                            std::size_t num_subsets,
+                                            absl::BitGenRef random,
+                                            SetCoverInvariant* inv);
+
 // Clears the variables that cover the most covered elements. This is capped
 // by num_subsets.
 // Return the list of chosen subset indices to be potentially reused as a focus.
@@ -290,6 +308,73 @@ std::vector<SubsetIndex> ClearMostCoveredElements(
     absl::Span<const SubsetIndex> focus, std::size_t num_subsets,
     SetCoverInvariant* inv);
 
+// Runs a portfolio of randomized local searches on several threads, sharing
+// the best solution found so far.
+//
+// The search starts from the solution in the invariant, or from a greedy
+// solution if there is none, improved by SteepestSearch. Each worker has its
+// own SetCoverInvariant on the (shared, read-only) model and its own random
+// generator, seeded from the seed of the portfolio and the index of the
+// worker. For each round, it loads the best solution shared by all the
+// workers, clears a random proportion of its subsets, completes it again with
+// GreedySolutionGenerator and improves it with SteepestSearch. One worker out
+// of two also runs GuidedTabuSearch afterwards. The workers thus explore
+// different neighborhoods of the best solution, which they update whenever
+// they improve on it.
+//
+// With one worker, the search is deterministic for a given seed.
+class SetCoverPortfolio {
+ public:
+  explicit SetCoverPortfolio(SetCoverInvariant* inv)
+      : inv_(inv),
+        num_workers_(1),
+        num_rounds_(kDefaultNumRounds),
+        num_iterations_(kDefaultNumIterations),
+        clear_ratio_(kDefaultClearRatio),
+        seed_(0) {}
+
+  // Returns true if a solution was found. The best solution is loaded in the
+  // invariant. If the invariant already contains a solution, the search
+  // starts from it and the result is at least as good.
+  bool NextSolution();
+
+  // Setters and getters for the parameters of the portfolio.
+  void SetNumWorkers(int num_workers) { num_workers_ = num_workers; }
+  int GetNumWorkers() const { return num_workers_; }
+
+  // The number of perturbation rounds of each worker.
+  void SetNumRounds(int num_rounds) { num_rounds_ = num_rounds; }
+  int GetNumRounds() const { return num_rounds_; }
+
+  // The maximum number of iterations of SteepestSearch and GuidedTabuSearch in
+  // each round.
+  void SetNumIterations(int num_iterations) {
+    num_iterations_ = num_iterations;
+  }
+  int GetNumIterations() const { return num_iterations_; }
+
+  // The proportion of the subsets of the best solution cleared in each round.
+  void SetClearRatio(double ratio) { clear_ratio_ = ratio; }
+  double GetClearRatio() const { return clear_ratio_; }
+
+  void SetSeed(uint64_t seed) { seed_ = seed; }
+  uint64_t GetSeed() const { return seed_; }
+
+ private:
+  // The data structure that holds the model and receives the best solution.
+  SetCoverInvariant* inv_;
+
+  static constexpr int kDefaultNumRounds = 100;
+  static constexpr int kDefaultNumIterations = 10000;
+  static constexpr double kDefaultClearRatio = 0.1;
+
+  int num_workers_;
+  int num_rounds_;
+  int num_iterations_;
+  double clear_ratio_;
+  uint64_t seed_;
+};
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_ALGORITHMS_SET_COVER_H_
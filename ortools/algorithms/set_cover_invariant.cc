@@ -33,6 +33,7 @@ void SetCoverInvariant::Initialize() {
   const SubsetIndex num_subsets(model_->num_subsets());
   is_selected_.assign(num_subsets, false);
   is_removable_.assign(num_subsets, false);
+  subset_seen_.assign(num_subsets, false);
   marginal_impacts_.assign(num_subsets, ElementIndex(0));
 
   const SparseColumnView& columns = model_->columns();
@@ -162,7 +163,7 @@ ElementIndex SetCoverInvariant::ComputeNumElementsCovered(
 ElementToSubsetVector SetCoverInvariant::ComputeCoverage(
     const SubsetBoolVector& choices) const {
   const ElementIndex num_elements(model_->num_elements());
-  const SparseRowView& rows = model_->rows();
+  const CompressedRowView& rows = model_->compressed_rows();
   // Use "crypterse" naming to avoid confusing with coverage_.
   ElementToSubsetVector cvrg(num_elements, SubsetIndex(0));
   for (ElementIndex element(0); element < num_elements; ++element) {
@@ -171,7 +172,7 @@ ElementToSubsetVector SetCoverInvariant::ComputeCoverage(
         ++cvrg[element];
       }
     }
-    DCHECK_LE(cvrg[element], rows[element].size().value());
+    DCHECK_LE(cvrg[element], rows[element].size());
     DCHECK_GE(cvrg[element], 0);
   }
   return cvrg;
@@ -231,22 +232,21 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeToggle(SubsetIndex subset,
   UpdateCoverage(subset, value);
   const std::vector<SubsetIndex> impacted_subsets =
       ComputeImpactedSubsets(subset);
-  UpdateIsRemovable(impacted_subsets);
-  UpdateMarginalImpacts(impacted_subsets);
+  UpdateMarginalImpactsAndIsRemovable(impacted_subsets);
   DCHECK((is_selected_[subset] <= (marginal_impacts_[subset] == 0)));
   return impacted_subsets;
 }
 
 void SetCoverInvariant::UpdateCoverage(SubsetIndex subset, bool value) {
-  const SparseColumnView& columns = model_->columns();
-  const SparseRowView& rows = model_->rows();
+  const CompressedColumnView& columns = model_->compressed_columns();
+  const CompressedRowView& rows = model_->compressed_rows();
   const int delta = value ? 1 : -1;
   for (const ElementIndex element : columns[subset]) {
     DVLOG(2) << "Coverage of element " << element << " changed from "
              << coverage_[element] << " to " << coverage_[element] + delta;
     coverage_[element] += delta;
     DCHECK_GE(coverage_[element], 0);
-    DCHECK_LE(coverage_[element], rows[element].size().value());
+    DCHECK_LE(coverage_[element], rows[element].size());
     if (coverage_[element] == 1) {
       ++num_elements_covered_;
     } else if (coverage_[element] == 0) {
@@ -260,19 +260,20 @@ void SetCoverInvariant::UpdateCoverage(SubsetIndex subset, bool value) {
 // containing element. Be careful to add the elements only once.
 std::vector<SubsetIndex> SetCoverInvariant::ComputeImpactedSubsets(
     SubsetIndex subset) const {
-  const SparseColumnView& columns = model_->columns();
-  const SparseRowView& rows = model_->rows();
-  SubsetBoolVector subset_seen(columns.size(), false);
+  const CompressedColumnView& columns = model_->compressed_columns();
+  const CompressedRowView& rows = model_->compressed_rows();
   std::vector<SubsetIndex> impacted_subsets;
-  impacted_subsets.reserve(columns.size().value());
   for (const ElementIndex element : columns[subset]) {
     for (const SubsetIndex subset : rows[element]) {
-      if (!subset_seen[subset]) {
-        subset_seen[subset] = true;
+      if (!subset_seen_[subset]) {
+        subset_seen_[subset] = true;
         impacted_subsets.push_back(subset);
       }
     }
   }
+  for (const SubsetIndex subset : impacted_subsets) {
+    subset_seen_[subset] = false;
+  }
   DCHECK_LE(impacted_subsets.size(), model_->num_subsets());
   // Testing has shown there is no gain in sorting impacted_subsets.
   return impacted_subsets;
@@ -289,13 +290,6 @@ bool SetCoverInvariant::ComputeIsRemovable(SubsetIndex subset) const {
   return true;
 }
 
-void SetCoverInvariant::UpdateIsRemovable(
-    absl::Span<const SubsetIndex> impacted_subsets) {
-  for (const SubsetIndex subset : impacted_subsets) {
-    is_removable_[subset] = ComputeIsRemovable(subset);
-  }
-}
-
 SubsetBoolVector SetCoverInvariant::ComputeIsRemovable(
     const ElementToSubsetVector& cvrg) const {
   DCHECK(CheckCoverageAgainstSolution(is_selected_));
@@ -324,21 +318,25 @@ bool SetCoverInvariant::CheckIsRemovable() const {
   return true;
 }
 
-void SetCoverInvariant::UpdateMarginalImpacts(
+void SetCoverInvariant::UpdateMarginalImpactsAndIsRemovable(
     absl::Span<const SubsetIndex> impacted_subsets) {
-  const SparseColumnView& columns = model_->columns();
+  const CompressedColumnView& columns = model_->compressed_columns();
   for (const SubsetIndex subset : impacted_subsets) {
-    ElementIndex impact(0);
+    // The counts are computed without branches on the contiguous elements of
+    // the column, so that the compiler can vectorize the loop.
+    int num_uncovered = 0;
+    int num_covered_at_most_once = 0;
     for (const ElementIndex element : columns[subset]) {
-      if (coverage_[element] == 0) {
-        ++impact;
-      }
+      const SubsetIndex cvrg = coverage_[element];
+      num_uncovered += cvrg == 0;
+      num_covered_at_most_once += cvrg <= 1;
     }
     DVLOG(2) << "Changing impact of subset " << subset << " from "
-             << marginal_impacts_[subset] << " to " << impact;
-    marginal_impacts_[subset] = impact;
-    DCHECK_LE(marginal_impacts_[subset], columns[subset].size().value());
-    DCHECK_GE(marginal_impacts_[subset], 0);
+             << marginal_impacts_[subset] << " to " << num_uncovered;
+    marginal_impacts_[subset] = ElementIndex(num_uncovered);
+    is_removable_[subset] = num_covered_at_most_once == 0;
+    DCHECK_LE(marginal_impacts_[subset], columns[subset].size());
+    DCHECK_EQ(is_removable_[subset], ComputeIsRemovable(subset));
   }
   DCHECK(CheckCoverageAndMarginalImpacts(is_selected_));
 }
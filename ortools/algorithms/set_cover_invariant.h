@@ -150,8 +150,10 @@ class SetCoverInvariant {
   SubsetToElementVector ComputeMarginalImpacts(
       const ElementToSubsetVector& cvrg) const;
 
-  // Updates marginal_impacts_ for each subset in impacted_subsets.
-  void UpdateMarginalImpacts(absl::Span<const SubsetIndex> impacted_subsets);
+  // Updates marginal_impacts_ and is_removable_ for each subset in
+  // impacted_subsets, in a single pass over their elements.
+  void UpdateMarginalImpactsAndIsRemovable(
+      absl::Span<const SubsetIndex> impacted_subsets);
 
   // Computes the number of elements covered based on coverage vector 'cvrg'.
   ElementIndex ComputeNumElementsCovered(
@@ -162,9 +164,6 @@ class SetCoverInvariant {
   // This function is used to check that is_removable[subset] is consistent.
   bool ComputeIsRemovable(SubsetIndex subset) const;
 
-  // Updates is_removable_ for each subset in impacted_subsets.
-  void UpdateIsRemovable(absl::Span<const SubsetIndex> impacted_subsets);
-
   // Returns the number of elements currently covered by subset.
   ElementToSubsetVector ComputeSingleSubsetCoverage(SubsetIndex subset) const;
 
@@ -203,6 +202,12 @@ class SetCoverInvariant {
   // True if the subset can be removed from the solution without making it
   // infeasible.
   SubsetBoolVector is_removable_;
+
+  // Scratch vector used by ComputeImpactedSubsets() to avoid adding a subset
+  // twice, which is all false between calls. Keeping it avoids allocating a
+  // vector of the size of the model for each toggle. A SetCoverInvariant is
+  // not meant to be shared between threads, even through const methods.
+  mutable SubsetBoolVector subset_seen_;
 };
 
 }  // namespace operations_research
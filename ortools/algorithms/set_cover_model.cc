@@ -115,6 +115,8 @@ void SetCoverModel::CreateSparseRowView() {
       rows_[element].push_back(subset);
     }
   }
+  compressed_columns_.Build(columns_);
+  compressed_rows_.Build(rows_);
   row_view_is_valid_ = true;
 }
 
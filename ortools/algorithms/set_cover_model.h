@@ -14,9 +14,11 @@
 #ifndef OR_TOOLS_ALGORITHMS_SET_COVER_MODEL_H_
 #define OR_TOOLS_ALGORITHMS_SET_COVER_MODEL_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
 #include "ortools/algorithms/set_cover.pb.h"
 #include "ortools/lp_data/lp_types.h"  // For StrictITIVector.
 #include "ortools/util/strong_integers.h"
@@ -69,6 +71,50 @@ using SparseRowView = glop::StrictITIVector<ElementIndex, SparseRow>;
 using ElementToSubsetVector = glop::StrictITIVector<ElementIndex, SubsetIndex>;
 using SubsetToElementVector = glop::StrictITIVector<SubsetIndex, ElementIndex>;
 
+// A compressed sparse representation of a SparseColumnView or of a
+// SparseRowView, in which the entries of all the columns (resp. rows) are
+// stored in a single contiguous array. The entries of the column (resp. row)
+// of index i are at positions [starts[i], starts[i + 1]) of entries.
+// Scanning it does not go through a separate allocation for each column or
+// row, which matters when scanning many short columns, as the local search
+// algorithms do.
+template <typename MajorIndex, typename MinorIndex>
+class CompressedSparseView {
+ public:
+  CompressedSparseView() : starts_(1, 0), entries_() {}
+
+  // Builds the compressed representation of view.
+  void Build(const glop::StrictITIVector<
+             MajorIndex, glop::StrictITIVector<EntryIndex, MinorIndex>>& view) {
+    starts_.assign(1, 0);
+    starts_.reserve(view.size().value() + 1);
+    entries_.clear();
+    for (const auto& vector : view) {
+      entries_.insert(entries_.end(), vector.begin(), vector.end());
+      starts_.push_back(entries_.size());
+    }
+  }
+
+  // Returns the number of columns (resp. rows).
+  MajorIndex size() const { return MajorIndex(starts_.size() - 1); }
+
+  // Returns the entries of the column (resp. row) of index i.
+  absl::Span<const MinorIndex> operator[](MajorIndex i) const {
+    return absl::MakeConstSpan(entries_.data() + starts_[i.value()],
+                               entries_.data() + starts_[i.value() + 1]);
+  }
+
+  absl::Span<const int64_t> starts() const { return starts_; }
+  absl::Span<const MinorIndex> entries() const { return entries_; }
+
+ private:
+  std::vector<int64_t> starts_;
+  std::vector<MinorIndex> entries_;
+};
+
+using CompressedColumnView = CompressedSparseView<SubsetIndex, ElementIndex>;
+using CompressedRowView = CompressedSparseView<ElementIndex, SubsetIndex>;
+
 // Main class for describing a weighted set-covering problem.
 class SetCoverModel {
  public:
@@ -79,6 +125,8 @@ class SetCoverModel {
         subset_costs_(),
         columns_(),
         rows_(),
+        compressed_columns_(),
+        compressed_rows_(),
         all_subsets_() {}
 
   // Current number of elements to be covered in the model, i.e. the number of
@@ -101,6 +149,17 @@ class SetCoverModel {
     return rows_;
   }
 
+  // Compressed views of the columns and of the rows, valid as long as the row
+  // view is.
+  const CompressedColumnView& compressed_columns() const {
+    DCHECK(row_view_is_valid_);
+    return compressed_columns_;
+  }
+  const CompressedRowView& compressed_rows() const {
+    DCHECK(row_view_is_valid_);
+    return compressed_rows_;
+  }
+
   // Returns true if rows_ and columns_ represent the same problem.
   bool row_view_is_valid() const { return row_view_is_valid_; }
 
@@ -123,7 +182,9 @@ class SetCoverModel {
   // Adds 'element' to and already existing 'subset'.
   void AddElementToSubset(int element, int subset);
 
-  // Creates the sparse ("dual") representation of the problem.
+  // Creates the sparse ("dual") representation of the problem, and the
+  // compressed views of the columns and of the rows. Does nothing if they are
+  // up-to-date, so that the model can then be shared by several threads.
   void CreateSparseRowView();
 
   // Returns true if the problem is feasible, i.e. if the subsets cover all
@@ -166,6 +227,10 @@ class SetCoverModel {
   // subsets containing the element.
   SparseRowView rows_;
 
+  // Same as columns_ and rows_, in compressed form.
+  CompressedColumnView compressed_columns_;
+  CompressedRowView compressed_rows_;
+
   // Vector of indices from 0 to columns.size() - 1. (Like std::iota, but built
   // incrementally.) Used to (un)focus optimization algorithms on the complete
   // problem.
@@ -98,6 +98,23 @@ TEST(SolutionProtoTest, SaveReloadTwice) {
   SetCoverSolutionResponse reloaded_proto = inv.ExportSolutionAsProto();
 }
 
+TEST(SetCoverModelTest, CompressedViews) {
+  SetCoverModel model = CreateKnightsCoverModel(10, 10);
+  model.CreateSparseRowView();
+  const CompressedColumnView& compressed_columns = model.compressed_columns();
+  ASSERT_EQ(compressed_columns.size(), model.num_subsets());
+  for (SubsetIndex subset(0); subset < model.num_subsets(); ++subset) {
+    EXPECT_THAT(compressed_columns[subset],
+                testing::ElementsAreArray(model.columns()[subset]));
+  }
+  const CompressedRowView& compressed_rows = model.compressed_rows();
+  ASSERT_EQ(compressed_rows.size(), model.num_elements());
+  for (ElementIndex element(0); element < model.num_elements(); ++element) {
+    EXPECT_THAT(compressed_rows[element],
+                testing::ElementsAreArray(model.rows()[element]));
+  }
+}
+
 TEST(SetCoverTest, InitialValues) {
   SetCoverModel model;
   model.AddEmptySubset(1);
@@ -321,6 +338,48 @@ TEST(SetCoverTest, KnightsCoverRandomClearMip) {
   }
 }
 
+TEST(SetCoverTest, KnightsCoverPortfolio) {
+#ifdef NDEBUG
+  constexpr int BoardSize = 50;
+#else
+  constexpr int BoardSize = 15;
+#endif
+  SetCoverModel model = CreateKnightsCoverModel(BoardSize, BoardSize);
+  SetCoverInvariant inv(&model);
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  SteepestSearch steepest(&inv);
+  CHECK(steepest.NextSolution(10000));
+  const Cost steepest_cost = inv.cost();
+  LOG(INFO) << "SteepestSearch cost: " << steepest_cost;
+
+  SetCoverPortfolio portfolio(&inv);
+  portfolio.SetNumWorkers(4);
+  portfolio.SetNumRounds(20);
+  portfolio.SetNumIterations(1000);
+  CHECK(portfolio.NextSolution());
+  LOG(INFO) << "SetCoverPortfolio cost: " << inv.cost();
+  EXPECT_TRUE(inv.CheckSolution());
+  EXPECT_LE(inv.cost(), steepest_cost);
+  DisplayKnightsCoverSolution(inv.is_selected(), BoardSize, BoardSize);
+}
+
+TEST(SetCoverTest, PortfolioIsDeterministicWithOneWorker) {
+  SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
+  Cost costs[2];
+  for (Cost& cost : costs) {
+    SetCoverInvariant inv(&model);
+    SetCoverPortfolio portfolio(&inv);
+    portfolio.SetNumRounds(10);
+    portfolio.SetNumIterations(1000);
+    portfolio.SetSeed(42);
+    CHECK(portfolio.NextSolution());
+    EXPECT_TRUE(inv.CheckSolution());
+    cost = inv.cost();
+  }
+  EXPECT_EQ(costs[0], costs[1]);
+}
+
 TEST(SetCoverTest, KnightsCoverMip) {
 #ifdef NDEBUG
   constexpr int BoardSize = 50;
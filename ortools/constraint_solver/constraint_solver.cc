@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <csetjmp>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <iosfwd>
@@ -39,9 +40,8 @@
 #include "ortools/base/sysinfo.h"
 #include "ortools/base/timer.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
+#include "ortools/constraint_solver/trail_packer.h"
 #include "ortools/util/tuple_set.h"
-#include "zconf.h"
-#include "zlib.h"
 
 // These flags are used to set the fields in the DefaultSolverParameters proto.
 ABSL_FLAG(bool, cp_trace_propagation, false,
@@ -480,6 +480,9 @@ struct StateMarker {
   int rev_object_array_memory_index_;
   int rev_memory_index_;
   int rev_memory_array_index_;
+  int rev_arena_object_index_;
+  int arena_block_index_;
+  size_t arena_offset_;
   StateInfo info_;
 };
 
@@ -497,114 +500,16 @@ StateMarker::StateMarker(Solver::MarkerType t, const StateInfo& info)
       rev_double_memory_index_(0),
       rev_object_memory_index_(0),
       rev_object_array_memory_index_(0),
+      rev_arena_object_index_(0),
+      arena_block_index_(-1),
+      arena_offset_(0),
       info_(info) {}
 
 // ---------- Trail and Reversibility ----------
 
 namespace {
-// ----- addrval struct -----
-
-// This template class is used internally to implement reversibility.
-// It stores an address and the value that was at the address.
-template <class T>
-struct addrval {
- public:
-  addrval() : address_(nullptr) {}
-  explicit addrval(T* adr) : address_(adr), old_value_(*adr) {}
-  void restore() const { (*address_) = old_value_; }
-
- private:
-  T* address_;
-  T old_value_;
-};
-
 // ----- Compressed trail -----
 
-// ---------- Trail Packer ---------
-// Abstract class to pack trail blocks.
-
-template <class T>
-class TrailPacker {
- public:
-  explicit TrailPacker(int block_size) : block_size_(block_size) {}
-
-  // This type is neither copyable nor movable.
-  TrailPacker(const TrailPacker&) = delete;
-  TrailPacker& operator=(const TrailPacker&) = delete;
-  virtual ~TrailPacker() {}
-  int input_size() const { return block_size_ * sizeof(addrval<T>); }
-  virtual void Pack(const addrval<T>* block, std::string* packed_block) = 0;
-  virtual void Unpack(const std::string& packed_block, addrval<T>* block) = 0;
-
- private:
-  const int block_size_;
-};
-
-template <class T>
-class NoCompressionTrailPacker : public TrailPacker<T> {
- public:
-  explicit NoCompressionTrailPacker(int block_size)
-      : TrailPacker<T>(block_size) {}
-
-  // This type is neither copyable nor movable.
-  NoCompressionTrailPacker(const NoCompressionTrailPacker&) = delete;
-  NoCompressionTrailPacker& operator=(const NoCompressionTrailPacker&) = delete;
-  ~NoCompressionTrailPacker() override {}
-  void Pack(const addrval<T>* block, std::string* packed_block) override {
-    DCHECK(block != nullptr);
-    DCHECK(packed_block != nullptr);
-    absl::string_view block_str(reinterpret_cast<const char*>(block),
-                                this->input_size());
-    packed_block->assign(block_str.data(), block_str.size());
-  }
-  void Unpack(const std::string& packed_block, addrval<T>* block) override {
-    DCHECK(block != nullptr);
-    memcpy(block, packed_block.c_str(), packed_block.size());
-  }
-};
-
-template <class T>
-class ZlibTrailPacker : public TrailPacker<T> {
- public:
-  explicit ZlibTrailPacker(int block_size)
-      : TrailPacker<T>(block_size),
-        tmp_size_(compressBound(this->input_size())),
-        tmp_block_(new char[tmp_size_]) {}
-
-  // This type is neither copyable nor movable.
-  ZlibTrailPacker(const ZlibTrailPacker&) = delete;
-  ZlibTrailPacker& operator=(const ZlibTrailPacker&) = delete;
-
-  ~ZlibTrailPacker() override {}
-
-  void Pack(const addrval<T>* block, std::string* packed_block) override {
-    DCHECK(block != nullptr);
-    DCHECK(packed_block != nullptr);
-    uLongf size = tmp_size_;
-    const int result =
-        compress(reinterpret_cast<Bytef*>(tmp_block_.get()), &size,
-                 reinterpret_cast<const Bytef*>(block), this->input_size());
-    CHECK_EQ(Z_OK, result);
-    absl::string_view block_str;
-    block_str = absl::string_view(tmp_block_.get(), size);
-    packed_block->assign(block_str.data(), block_str.size());
-  }
-
-  void Unpack(const std::string& packed_block, addrval<T>* block) override {
-    DCHECK(block != nullptr);
-    uLongf size = this->input_size();
-    const int result =
-        uncompress(reinterpret_cast<Bytef*>(block), &size,
-                   reinterpret_cast<const Bytef*>(packed_block.c_str()),
-                   packed_block.size());
-    CHECK_EQ(Z_OK, result);
-  }
-
- private:
-  const uint64_t tmp_size_;
-  std::unique_ptr<char[]> tmp_block_;
-};
-
 template <class T>
 class CompressedTrail {
  public:
@@ -628,6 +533,10 @@ class CompressedTrail {
         packer_.reset(new ZlibTrailPacker<T>(block_size));
         break;
       }
+      case ConstraintSolverParameters::COMPRESS_WITH_VARINT: {
+        packer_.reset(new VarintTrailPacker<T>(block_size));
+        break;
+      }
       default: {
         LOG(ERROR) << "Should not be here";
       }
@@ -754,6 +663,20 @@ struct Trail {
   std::vector<BaseObject**> rev_object_array_memory_;
   std::vector<void*> rev_memory_;
   std::vector<void**> rev_memory_array_;
+  // Objects constructed in the arena, with their destructors.
+  std::vector<std::pair<void*, void (*)(void*)>> rev_arena_objects_;
+  // Arena memory blocks: blocks up to arena_block_index_ are in use, the
+  // current one up to arena_offset_; the following blocks are free and reused
+  // by later allocations.
+  std::vector<std::unique_ptr<char[]>> arena_blocks_;
+  int arena_block_index_ = -1;
+  size_t arena_offset_ = 0;
+
+  // Size of the blocks of the arena. Objects larger than
+  // kMaxArenaAllocationSize are allocated on the heap to limit the memory
+  // wasted at the end of blocks.
+  static constexpr size_t kArenaBlockSize = 64 << 10;
+  static constexpr size_t kMaxArenaAllocationSize = kArenaBlockSize / 16;
 
   Trail(int block_size,
         ConstraintSolverParameters::TrailCompression compression_level)
@@ -843,6 +766,14 @@ struct Trail {
     }
     rev_object_memory_.resize(target);
 
+    target = m->rev_arena_object_index_;
+    for (int curr = rev_arena_objects_.size() - 1; curr >= target; --curr) {
+      rev_arena_objects_[curr].second(rev_arena_objects_[curr].first);
+    }
+    rev_arena_objects_.resize(target);
+    arena_block_index_ = m->arena_block_index_;
+    arena_offset_ = m->arena_offset_;
+
     target = m->rev_object_array_memory_index_;
     for (int curr = rev_object_array_memory_.size() - 1; curr >= target;
          --curr) {
@@ -869,6 +800,22 @@ struct Trail {
     }
     rev_memory_array_.resize(target);
   }
+
+  // Returns memory from the arena, allocating a new block if the current one
+  // is full, or nullptr if the allocation is too large for the arena.
+  void* ArenaAllocate(size_t size, size_t alignment) {
+    if (size > kMaxArenaAllocationSize) return nullptr;
+    size_t offset = (arena_offset_ + alignment - 1) & ~(alignment - 1);
+    if (arena_block_index_ < 0 || offset + size > kArenaBlockSize) {
+      ++arena_block_index_;
+      if (arena_block_index_ == static_cast<int>(arena_blocks_.size())) {
+        arena_blocks_.emplace_back(new char[kArenaBlockSize]);
+      }
+      offset = 0;
+    }
+    arena_offset_ = offset + size;
+    return arena_blocks_[arena_block_index_].get() + offset;
+  }
 };
 
 void Solver::InternalSaveValue(int* valptr) {
@@ -962,6 +909,21 @@ void** Solver::UnsafeRevAllocArrayAux(void** ptr) {
   return ptr;
 }
 
+void* Solver::ArenaAllocate(size_t size, size_t alignment) {
+  check_alloc_state();
+  DCHECK_LE(alignment, alignof(std::max_align_t));
+  DCHECK_EQ(alignment & (alignment - 1), 0);
+  void* const memory = trail_->ArenaAllocate(size, alignment);
+  if (memory != nullptr) return memory;
+  // Large allocations are released with the other unsafe allocations, after
+  // arena objects have been destroyed.
+  return UnsafeRevAllocAux(::operator new(size));
+}
+
+void Solver::RegisterArenaObject(void* object, void (*destructor)(void*)) {
+  trail_->rev_arena_objects_.push_back({object, destructor});
+}
+
 void InternalSaveBooleanVarValue(Solver* const solver, IntVar* const var) {
   solver->trail_->rev_boolvar_list_.push_back(var);
 }
@@ -1614,6 +1576,9 @@ void Solver::PushState(Solver::MarkerType t, const StateInfo& info) {
     m->rev_object_array_memory_index_ = trail_->rev_object_array_memory_.size();
     m->rev_memory_index_ = trail_->rev_memory_.size();
     m->rev_memory_array_index_ = trail_->rev_memory_array_.size();
+    m->rev_arena_object_index_ = trail_->rev_arena_objects_.size();
+    m->arena_block_index_ = trail_->arena_block_index_;
+    m->arena_offset_ = trail_->arena_offset_;
   }
   searches_.back()->marker_stack_.push_back(m);
   queue_->increase_stamp();
@@ -74,9 +74,11 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <new>
 #include <ostream>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -854,6 +856,25 @@ class Solver {
     return reinterpret_cast<T*>(SafeRevAllocArray(object));
   }
 
+#ifndef SWIG
+  /// Like RevAlloc(new T(args...)), but the object is constructed in memory
+  /// owned by the solver. Objects are allocated contiguously in large blocks,
+  /// and backtracking out of the current state destroys them and releases
+  /// their memory at once; blocks are then reused by later allocations. This
+  /// is much cheaper than individual heap allocations when building large
+  /// models. The returned object must not be deleted.
+  template <typename T, typename... Args>
+  T* RevAllocInArena(Args&&... args) {
+    void* const memory = ArenaAllocate(sizeof(T), alignof(T));
+    T* const object = new (memory) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible_v<T>) {
+      RegisterArenaObject(object,
+                          [](void* ptr) { static_cast<T*>(ptr)->~T(); });
+    }
+    return object;
+  }
+#endif  // SWIG
+
   /// Adds the constraint 'c' to the model.
   ///
   /// After calling this method, and until there is a backtrack that undoes the
@@ -3199,6 +3220,12 @@ class Solver {
     return reinterpret_cast<T**>(
         UnsafeRevAllocArrayAux(reinterpret_cast<void**>(ptr)));
   }
+  /// Returns 'size' bytes of memory aligned on 'alignment', which are released
+  /// when backtracking out of the current state; see RevAllocInArena().
+  void* ArenaAllocate(size_t size, size_t alignment);
+  /// Registers the destructor of an object constructed in memory returned by
+  /// ArenaAllocate(); it is called when backtracking out of the current state.
+  void RegisterArenaObject(void* object, void (*destructor)(void*));
 
   void InitCachedIntConstants();
   void InitCachedConstraint();
@@ -0,0 +1,235 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/constraint_solver.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace operations_research {
+namespace {
+
+// Counts the live instances of the class and records the order in which they
+// are destroyed. Instances own heap memory, which leaks if they are not
+// destroyed.
+class Tracked {
+ public:
+  Tracked(int id, int* num_live, std::vector<int>* destroyed)
+      : id_(id),
+        num_live_(num_live),
+        destroyed_(destroyed),
+        payload_(std::make_unique<std::string>(100, 'x')) {
+    ++*num_live_;
+  }
+  ~Tracked() {
+    --*num_live_;
+    destroyed_->push_back(id_);
+  }
+
+ private:
+  const int id_;
+  int* const num_live_;
+  std::vector<int>* const destroyed_;
+  std::unique_ptr<std::string> payload_;
+};
+
+// Larger than the largest allocation served by the arena, which is allocated
+// on the heap instead.
+class LargeTracked : public Tracked {
+ public:
+  using Tracked::Tracked;
+
+ private:
+  char data_[1 << 14] = {};
+};
+
+// Calls 'next' and makes no decision.
+class CallbackDecisionBuilder : public DecisionBuilder {
+ public:
+  explicit CallbackDecisionBuilder(std::function<void(Solver*)> next)
+      : next_(std::move(next)) {}
+  Decision* Next(Solver* solver) override {
+    next_(solver);
+    return nullptr;
+  }
+
+ private:
+  std::function<void(Solver*)> next_;
+};
+
+TEST(RevAllocInArenaTest, ObjectsAreDestroyedInReverseOrderOnBacktrack) {
+  // Declared before the solver, which may destroy objects referring to them.
+  int num_live = 0;
+  std::vector<int> destroyed;
+  Solver solver("arena");
+  // Enough objects to fill several arena blocks.
+  constexpr int kNumObjects = 5000;
+  solver.RevAllocInArena<Tracked>(-1, &num_live, &destroyed);
+  solver.PushState();
+  std::vector<Tracked*> objects;
+  for (int i = 0; i < kNumObjects; ++i) {
+    objects.push_back(
+        solver.RevAllocInArena<Tracked>(i, &num_live, &destroyed));
+  }
+  EXPECT_EQ(num_live, kNumObjects + 1);
+  solver.PopState();
+  EXPECT_EQ(num_live, 1);
+  ASSERT_EQ(destroyed.size(), kNumObjects);
+  for (int i = 0; i < kNumObjects; ++i) {
+    EXPECT_EQ(destroyed[i], kNumObjects - 1 - i);
+  }
+
+  // The memory released on backtrack is reused, at the same addresses.
+  solver.PushState();
+  for (int i = 0; i < kNumObjects; ++i) {
+    EXPECT_EQ(solver.RevAllocInArena<Tracked>(i, &num_live, &destroyed),
+              objects[i]);
+  }
+  solver.PopState();
+  EXPECT_EQ(num_live, 1);
+}
+
+TEST(RevAllocInArenaTest, TriviallyDestructibleObjects) {
+  Solver solver("arena");
+  solver.PushState();
+  int64_t* const first = solver.RevAllocInArena<int64_t>(1);
+  int64_t* const second = solver.RevAllocInArena<int64_t>(2);
+  EXPECT_EQ(*first, 1);
+  EXPECT_EQ(*second, 2);
+  EXPECT_NE(first, second);
+  solver.PopState();
+  solver.PushState();
+  EXPECT_EQ(solver.RevAllocInArena<int64_t>(3), first);
+  solver.PopState();
+}
+
+TEST(RevAllocInArenaTest, LargeObjects) {
+  int num_live = 0;
+  std::vector<int> destroyed;
+  Solver solver("arena");
+  solver.PushState();
+  solver.RevAllocInArena<Tracked>(0, &num_live, &destroyed);
+  solver.RevAllocInArena<LargeTracked>(1, &num_live, &destroyed);
+  solver.RevAllocInArena<Tracked>(2, &num_live, &destroyed);
+  EXPECT_EQ(num_live, 3);
+  solver.PopState();
+  EXPECT_EQ(num_live, 0);
+  EXPECT_EQ(destroyed, std::vector<int>({2, 1, 0}));
+}
+
+// Objects allocated at each node of the search are destroyed when the search
+// backtracks from the node, and the next nodes reuse their memory.
+TEST(RevAllocInArenaTest, ObjectsAllocatedDuringSearch) {
+  int num_live = 0;
+  std::vector<int> destroyed;
+  Solver solver("arena");
+  std::vector<IntVar*> vars;
+  solver.MakeBoolVarArray(4, "x", &vars);
+  std::vector<int> num_live_at_solutions;
+  std::vector<const void*> addresses_at_solutions;
+  DecisionBuilder* const allocate = solver.RevAlloc(
+      new CallbackDecisionBuilder([&](Solver* solver) {
+        for (int i = 0; i < 100; ++i) {
+          const Tracked* const object =
+              solver->RevAllocInArena<Tracked>(i, &num_live, &destroyed);
+          if (i == 0) addresses_at_solutions.push_back(object);
+        }
+        solver->RevAllocInArena<LargeTracked>(100, &num_live, &destroyed);
+        num_live_at_solutions.push_back(num_live);
+      }));
+  DecisionBuilder* const db = solver.Compose(
+      solver.MakePhase(vars, Solver::CHOOSE_FIRST_UNBOUND,
+                       Solver::ASSIGN_MIN_VALUE),
+      allocate);
+  solver.NewSearch(db);
+  int num_solutions = 0;
+  while (solver.NextSolution()) ++num_solutions;
+  solver.EndSearch();
+  EXPECT_EQ(num_solutions, 16);
+  EXPECT_EQ(num_live, 0);
+  EXPECT_EQ(destroyed.size(), 16 * 101);
+  EXPECT_EQ(num_live_at_solutions, std::vector<int>(16, 101));
+  ASSERT_EQ(addresses_at_solutions.size(), 16);
+  for (const void* address : addresses_at_solutions) {
+    EXPECT_EQ(address, addresses_at_solutions[0]);
+  }
+}
+
+// Nested searches allocate objects in the same arena as the enclosing search.
+// Objects of a nested Solve() are destroyed when it returns, while objects of a
+// nested SolveAndCommit() live until the enclosing search backtracks.
+TEST(RevAllocInArenaTest, NestedSearches) {
+  int num_live = 0;
+  std::vector<int> destroyed;
+  Solver solver("arena");
+  int id = 0;
+  DecisionBuilder* const inner = solver.RevAlloc(
+      new CallbackDecisionBuilder([&](Solver* solver) {
+        for (int i = 0; i < 10; ++i) {
+          solver->RevAllocInArena<Tracked>(id++, &num_live, &destroyed);
+        }
+      }));
+  std::vector<int> num_live_after_nested_searches;
+  DecisionBuilder* const outer = solver.RevAlloc(
+      new CallbackDecisionBuilder([&](Solver* solver) {
+        solver->RevAllocInArena<Tracked>(id++, &num_live, &destroyed);
+        EXPECT_TRUE(solver->Solve(inner));
+        num_live_after_nested_searches.push_back(num_live);
+        EXPECT_TRUE(solver->SolveAndCommit(inner));
+        num_live_after_nested_searches.push_back(num_live);
+        EXPECT_TRUE(solver->Solve(inner));
+        num_live_after_nested_searches.push_back(num_live);
+      }));
+  EXPECT_TRUE(solver.Solve(outer));
+  EXPECT_EQ(num_live_after_nested_searches, std::vector<int>({1, 11, 11}));
+  EXPECT_EQ(num_live, 0);
+  EXPECT_EQ(id, 31);
+  EXPECT_EQ(destroyed.size(), 31);
+}
+
+// Destroying the solver destroys the objects which are still alive, allocated
+// outside search or in a search which was not ended. Leaks are reported by
+// LeakSanitizer.
+TEST(RevAllocInArenaTest, SolverDestructionWithLiveObjects) {
+  int num_live = 0;
+  std::vector<int> destroyed;
+  {
+    Solver solver("arena");
+    solver.RevAllocInArena<Tracked>(0, &num_live, &destroyed);
+    solver.RevAllocInArena<LargeTracked>(1, &num_live, &destroyed);
+    DecisionBuilder* const allocate = solver.RevAlloc(
+        new CallbackDecisionBuilder([&](Solver* solver) {
+          for (int i = 2; i < 3001; ++i) {
+            solver->RevAllocInArena<Tracked>(i, &num_live, &destroyed);
+          }
+          solver->RevAllocInArena<LargeTracked>(3001, &num_live, &destroyed);
+        }));
+    solver.NewSearch(allocate);
+    EXPECT_TRUE(solver.NextSolution());
+    EXPECT_EQ(num_live, 3002);
+  }
+  EXPECT_EQ(num_live, 0);
+  ASSERT_EQ(destroyed.size(), 3002);
+  for (int i = 0; i < 3002; ++i) {
+    EXPECT_EQ(destroyed[i], 3001 - i);
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
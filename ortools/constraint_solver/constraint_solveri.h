@@ -172,7 +172,7 @@ class SimpleRevFIFO {
 
   void Push(Solver* const s, T val) {
     if (pos_.Value() == 0) {
-      Chunk* const chunk = s->UnsafeRevAlloc(new Chunk(chunks_));
+      Chunk* const chunk = s->RevAllocInArena<Chunk>(chunks_);
       s->SaveAndSetValue(reinterpret_cast<void**>(&chunks_),
                          reinterpret_cast<void*>(chunk));
       pos_.SetValue(s, CHUNK_SIZE - 1);
@@ -322,7 +322,7 @@ class RevImmutableMultiMap {
   void Insert(const K& key, const V& value) {
     const int position = Hash1(key) % size_.Value();
     Cell* const cell =
-        solver_->UnsafeRevAlloc(new Cell(key, value, array_[position]));
+        solver_->RevAllocInArena<Cell>(key, value, array_[position]);
     solver_->SaveAndSetValue(reinterpret_cast<void**>(&array_[position]),
                              reinterpret_cast<void*>(cell));
     num_items_.Incr(solver_);
@@ -522,7 +522,7 @@ class CallMethod0 : public Demon {
 template <class T>
 Demon* MakeConstraintDemon0(Solver* const s, T* const ct, void (T::*method)(),
                             const std::string& name) {
-  return s->RevAlloc(new CallMethod0<T>(ct, method, name));
+  return s->RevAllocInArena<CallMethod0<T>>(ct, method, name);
 }
 
 template <class P>
@@ -563,7 +563,7 @@ class CallMethod1 : public Demon {
 template <class T, class P>
 Demon* MakeConstraintDemon1(Solver* const s, T* const ct, void (T::*method)(P),
                             const std::string& name, P param1) {
-  return s->RevAlloc(new CallMethod1<T, P>(ct, method, name, param1));
+  return s->RevAllocInArena<CallMethod1<T, P>>(ct, method, name, param1);
 }
 
 /// Demon proxy to a method on the constraint with two arguments.
@@ -603,8 +603,8 @@ template <class T, class P, class Q>
 Demon* MakeConstraintDemon2(Solver* const s, T* const ct,
                             void (T::*method)(P, Q), const std::string& name,
                             P param1, Q param2) {
-  return s->RevAlloc(
-      new CallMethod2<T, P, Q>(ct, method, name, param1, param2));
+  return s->RevAllocInArena<CallMethod2<T, P, Q>>(ct, method, name, param1,
+                                                  param2);
 }
 /// Demon proxy to a method on the constraint with three arguments.
 template <class T, class P, class Q, class R>
@@ -646,8 +646,8 @@ template <class T, class P, class Q, class R>
 Demon* MakeConstraintDemon3(Solver* const s, T* const ct,
                             void (T::*method)(P, Q, R), const std::string& name,
                             P param1, Q param2, R param3) {
-  return s->RevAlloc(
-      new CallMethod3<T, P, Q, R>(ct, method, name, param1, param2, param3));
+  return s->RevAllocInArena<CallMethod3<T, P, Q, R>>(ct, method, name, param1,
+                                                     param2, param3);
 }
 /// @}
 
@@ -686,7 +686,7 @@ template <class T>
 Demon* MakeDelayedConstraintDemon0(Solver* const s, T* const ct,
                                    void (T::*method)(),
                                    const std::string& name) {
-  return s->RevAlloc(new DelayedCallMethod0<T>(ct, method, name));
+  return s->RevAllocInArena<DelayedCallMethod0<T>>(ct, method, name);
 }
 
 /// Low-priority demon proxy to a method on the constraint with one argument.
@@ -722,7 +722,8 @@ template <class T, class P>
 Demon* MakeDelayedConstraintDemon1(Solver* const s, T* const ct,
                                    void (T::*method)(P),
                                    const std::string& name, P param1) {
-  return s->RevAlloc(new DelayedCallMethod1<T, P>(ct, method, name, param1));
+  return s->RevAllocInArena<DelayedCallMethod1<T, P>>(ct, method, name,
+                                                       param1);
 }
 
 /// Low-priority demon proxy to a method on the constraint with two arguments.
@@ -767,8 +768,8 @@ Demon* MakeDelayedConstraintDemon2(Solver* const s, T* const ct,
                                    void (T::*method)(P, Q),
                                    const std::string& name, P param1,
                                    Q param2) {
-  return s->RevAlloc(
-      new DelayedCallMethod2<T, P, Q>(ct, method, name, param1, param2));
+  return s->RevAllocInArena<DelayedCallMethod2<T, P, Q>>(ct, method, name,
+                                                         param1, param2);
 }
 /// @}
 
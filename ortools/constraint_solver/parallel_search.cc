@@ -0,0 +1,236 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/parallel_search.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/util/saturated_arithmetic.h"
+
+namespace operations_research {
+namespace {
+
+// State shared by the workers of a portfolio. Objective values are stored as
+// values to minimize, i.e. negated for maximization problems.
+class PortfolioState {
+ public:
+  // Returns the objective value of the best solution found so far, or
+  // kint64max if none was found.
+  int64_t BestValue() const { return best_value_.load(); }
+
+  // Records a solution found by 'worker', if it improves on the best solution.
+  // 'values' is only called in that case, and returns the values of the
+  // solution variables.
+  void AddSolution(int worker, int64_t value, int64_t objective_value,
+                   const std::function<std::vector<int64_t>()>& values) {
+    absl::MutexLock lock(&mutex_);
+    if (result_.solution_found && value >= best_value_.load()) return;
+    result_.solution_found = true;
+    result_.solution_values = values();
+    result_.objective_value = objective_value;
+    result_.solution_worker = worker;
+    best_value_ = value;
+  }
+
+  // Records that 'worker' completed its search, and stops all workers.
+  void SetProven(int worker) {
+    absl::MutexLock lock(&mutex_);
+    if (!result_.proven) {
+      result_.proven = true;
+      result_.proof_worker = worker;
+    }
+    stop_ = true;
+  }
+
+  void Stop() { stop_ = true; }
+  bool ShouldStop() const { return stop_.load(); }
+
+  PortfolioSearchResult Result() {
+    absl::MutexLock lock(&mutex_);
+    return result_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::atomic<int64_t> best_value_ = std::numeric_limits<int64_t>::max();
+  std::atomic<bool> stop_ = false;
+  PortfolioSearchResult result_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Bridges the objective of a worker with the state shared by the portfolio:
+// publishes the solutions found by the worker, rejects solutions which do not
+// improve on the best solution of the portfolio, and tightens the objective
+// when another worker finds a better solution. It complements the OptimizeVar
+// of the worker, which only knows about its own solutions.
+class SharedObjectiveMonitor : public SearchMonitor {
+ public:
+  SharedObjectiveMonitor(Solver* solver, int worker,
+                         const PortfolioModel& model, PortfolioState* state)
+      : SearchMonitor(solver),
+        worker_(worker),
+        solution_vars_(model.solution_vars),
+        objective_(model.objective),
+        maximize_(model.maximize),
+        step_(model.step),
+        state_(state) {}
+  ~SharedObjectiveMonitor() override {}
+
+  void BeginNextDecision(DecisionBuilder*) override { ApplySharedBound(); }
+  void RefuteDecision(Decision*) override { ApplySharedBound(); }
+  bool AcceptSolution() override {
+    return objective_ == nullptr || Value() < state_->BestValue();
+  }
+  bool AtSolution() override {
+    const int64_t objective_value =
+        objective_ == nullptr ? 0 : objective_->Value();
+    state_->AddSolution(worker_, Value(), objective_value, [this]() {
+      std::vector<int64_t> values;
+      values.reserve(solution_vars_.size());
+      for (const IntVar* const var : solution_vars_) {
+        values.push_back(var->Value());
+      }
+      return values;
+    });
+    if (objective_ == nullptr) state_->Stop();
+    return objective_ != nullptr;
+  }
+  std::string DebugString() const override { return "SharedObjectiveMonitor"; }
+
+ private:
+  // Returns the value of the objective, as a value to minimize.
+  int64_t Value() const {
+    if (objective_ == nullptr) return 0;
+    return maximize_ ? CapOpp(objective_->Max()) : objective_->Min();
+  }
+  void ApplySharedBound() {
+    if (objective_ == nullptr) return;
+    const int64_t best_value = state_->BestValue();
+    if (best_value == std::numeric_limits<int64_t>::max()) return;
+    const int64_t bound = CapSub(best_value, step_);
+    if (maximize_) {
+      objective_->SetMin(CapOpp(bound));
+    } else {
+      objective_->SetMax(bound);
+    }
+  }
+
+  const int worker_;
+  const std::vector<IntVar*> solution_vars_;
+  IntVar* const objective_;
+  const bool maximize_;
+  const int64_t step_;
+  PortfolioState* const state_;
+};
+
+void RunPortfolioWorker(int worker, const PortfolioModelBuilder& builder,
+                        const PortfolioSearchParameters& parameters,
+                        absl::Time deadline, PortfolioState* state) {
+  Solver solver(absl::StrCat("PortfolioWorker", worker),
+                parameters.solver_parameters);
+  const int32_t seed = parameters.random_seed + worker;
+  solver.ReSeed(seed);
+  const PortfolioModel model = builder(&solver);
+  CHECK(model.decision_builder != nullptr);
+
+  // Search strategy of the worker.
+  DecisionBuilder* db = model.decision_builder;
+  std::vector<SearchMonitor*> monitors = model.monitors;
+  if (!model.decision_vars.empty()) {
+    switch (worker % 3) {
+      case 0:
+        break;
+      case 1: {
+        DefaultPhaseParameters default_parameters;
+        default_parameters.random_seed = seed;
+        db = solver.MakeDefaultPhase(model.decision_vars, default_parameters);
+        break;
+      }
+      case 2:
+        db = solver.MakePhase(model.decision_vars, Solver::CHOOSE_RANDOM,
+                              Solver::ASSIGN_RANDOM_VALUE);
+        monitors.push_back(
+            solver.MakeLubyRestart(parameters.restart_scale_factor));
+        break;
+    }
+  }
+
+  if (model.objective != nullptr) {
+    monitors.push_back(
+        solver.MakeOptimize(model.maximize, model.objective, model.step));
+  }
+  monitors.push_back(solver.RevAlloc(
+      new SharedObjectiveMonitor(&solver, worker, model, state)));
+  const std::atomic<bool>* const interrupt = parameters.interrupt;
+  SearchLimit* const stop_limit =
+      solver.MakeCustomLimit([state, interrupt]() {
+        return state->ShouldStop() ||
+               (interrupt != nullptr && interrupt->load());
+      });
+  monitors.push_back(stop_limit);
+  SearchLimit* time_limit = nullptr;
+  if (deadline != absl::InfiniteFuture()) {
+    time_limit = solver.MakeTimeLimit(deadline - absl::Now());
+    monitors.push_back(time_limit);
+  }
+
+  solver.NewSearch(db, monitors);
+  bool solution_found = false;
+  while (solver.NextSolution()) {
+    solution_found = true;
+    if (model.objective == nullptr) break;
+  }
+  solver.EndSearch();
+  const bool complete = !stop_limit->crossed() &&
+                        (time_limit == nullptr || !time_limit->crossed());
+  if (complete || (model.objective == nullptr && solution_found)) {
+    state->SetProven(worker);
+  }
+}
+
+}  // namespace
+
+PortfolioSearchResult SolveWithPortfolio(
+    const PortfolioModelBuilder& builder,
+    const PortfolioSearchParameters& parameters) {
+  CHECK_GE(parameters.num_workers, 1);
+  const absl::Time deadline =
+      parameters.time_limit == absl::InfiniteDuration()
+          ? absl::InfiniteFuture()
+          : absl::Now() + parameters.time_limit;
+  PortfolioState state;
+  {
+    ThreadPool pool("PortfolioSearch", parameters.num_workers);
+    pool.StartWorkers();
+    for (int worker = 0; worker < parameters.num_workers; ++worker) {
+      pool.Schedule([worker, &builder, &parameters, deadline, &state]() {
+        RunPortfolioWorker(worker, builder, parameters, deadline, &state);
+      });
+    }
+  }
+  return state.Result();
+}
+
+}  // namespace operations_research
@@ -0,0 +1,122 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parallel portfolio search for models of the CP solver.
+//
+// A Solver is single-threaded; the portfolio builds the same model in several
+// independent solvers, each run in its own thread with a different search
+// strategy and random seed:
+// - the search of the model itself,
+// - the impact-based default search (see Solver::MakeDefaultPhase()),
+// - a randomized search with Luby restarts.
+// Workers share the value of the best solution found: each worker only accepts
+// solutions improving on it, and tightens its objective with it as soon as it
+// is improved by another worker. When a worker completes its search, the best
+// solution found is optimal (or the problem has no solution) and all workers
+// are stopped; for satisfaction problems, all workers are stopped as soon as a
+// solution is found.
+//
+// Example:
+//   const PortfolioModelBuilder builder = [](Solver* solver) {
+//     PortfolioModel model;
+//     ... create variables and constraints on 'solver' ...
+//     model.decision_vars = vars;
+//     model.solution_vars = vars;
+//     model.objective = cost;
+//     model.decision_builder = solver->MakePhase(
+//         vars, Solver::CHOOSE_FIRST_UNBOUND, Solver::ASSIGN_MIN_VALUE);
+//     return model;
+//   };
+//   PortfolioSearchParameters parameters;
+//   parameters.num_workers = 8;
+//   const PortfolioSearchResult result =
+//       SolveWithPortfolio(builder, parameters);
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_SEARCH_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_SEARCH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+
+namespace operations_research {
+
+// Model built by a worker of the portfolio. All objects belong to the solver
+// on which the model was built.
+struct PortfolioModel {
+  // Search of the model; it must be complete for the portfolio to prove
+  // optimality.
+  DecisionBuilder* decision_builder = nullptr;
+  // Variables on which the default and randomized searches branch. If empty,
+  // all workers use 'decision_builder', with different random seeds.
+  std::vector<IntVar*> decision_vars;
+  // Variables whose values are reported in the result.
+  std::vector<IntVar*> solution_vars;
+  // Objective to optimize, nullptr for satisfaction problems.
+  IntVar* objective = nullptr;
+  bool maximize = false;
+  int64_t step = 1;
+  // Additional monitors of the search. They must not stop the search, which
+  // would otherwise be considered as complete.
+  std::vector<SearchMonitor*> monitors;
+};
+
+// Builds the model on 'solver'. The builder is called concurrently, once per
+// worker, and must only create objects on the given solver.
+using PortfolioModelBuilder = std::function<PortfolioModel(Solver* solver)>;
+
+struct PortfolioSearchParameters {
+  // Number of workers, each running in its own thread.
+  int num_workers = 4;
+  // Worker i uses the random seed random_seed + i.
+  int32_t random_seed = 0;
+  // Time limit of the whole search.
+  absl::Duration time_limit = absl::InfiniteDuration();
+  // If not null, all workers are stopped as soon as it becomes true, e.g. when
+  // set by another thread to cancel the search. It must outlive the search.
+  const std::atomic<bool>* interrupt = nullptr;
+  // Scale factor of the Luby restarts of randomized workers.
+  int restart_scale_factor = 100;
+  // Parameters of the solvers of the workers.
+  ConstraintSolverParameters solver_parameters =
+      Solver::DefaultSolverParameters();
+};
+
+struct PortfolioSearchResult {
+  // Whether a solution was found.
+  bool solution_found = false;
+  // Whether the search was complete: the solution found is optimal, or the
+  // problem has no solution if none was found.
+  bool proven = false;
+  // Values of PortfolioModel::solution_vars and of the objective in the best
+  // solution found.
+  std::vector<int64_t> solution_values;
+  int64_t objective_value = 0;
+  // Worker which found the best solution, and worker which completed its
+  // search if the search was proven (-1 otherwise).
+  int solution_worker = -1;
+  int proof_worker = -1;
+};
+
+// Solves the model built by 'builder' with a portfolio of workers.
+PortfolioSearchResult SolveWithPortfolio(
+    const PortfolioModelBuilder& builder,
+    const PortfolioSearchParameters& parameters);
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_SEARCH_H_
@@ -0,0 +1,195 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/parallel_search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+
+namespace operations_research {
+namespace {
+
+const std::vector<int64_t> kWeights = {23, 31, 29, 44, 53, 38, 63, 85,
+                                       89, 82, 12, 17, 41, 27, 33};
+const std::vector<int64_t> kProfits = {92, 57, 49, 68, 60, 43, 67, 84,
+                                       87, 72, 21, 30, 55, 40, 41};
+constexpr int64_t kCapacity = 265;
+
+// 0-1 knapsack maximizing the total profit of the items.
+PortfolioModel BuildKnapsack(Solver* solver) {
+  PortfolioModel model;
+  std::vector<IntVar*> taken;
+  solver->MakeBoolVarArray(kWeights.size(), "taken", &taken);
+  solver->AddConstraint(solver->MakeScalProdLessOrEqual(taken, kWeights,
+                                                        kCapacity));
+  model.objective = solver->MakeScalProd(taken, kProfits)->Var();
+  model.maximize = true;
+  model.decision_vars = taken;
+  model.solution_vars = taken;
+  model.decision_builder = solver->MakePhase(
+      taken, Solver::CHOOSE_FIRST_UNBOUND, Solver::ASSIGN_MAX_VALUE);
+  return model;
+}
+
+int64_t BruteForceKnapsackOptimum() {
+  const int num_items = kWeights.size();
+  int64_t best_profit = 0;
+  for (int subset = 0; subset < (1 << num_items); ++subset) {
+    int64_t weight = 0;
+    int64_t profit = 0;
+    for (int i = 0; i < num_items; ++i) {
+      if (subset & (1 << i)) {
+        weight += kWeights[i];
+        profit += kProfits[i];
+      }
+    }
+    if (weight <= kCapacity) best_profit = std::max(best_profit, profit);
+  }
+  return best_profit;
+}
+
+// Pigeonhole problem with one more pigeon than holes and pairwise
+// disequalities: it has no solution, and no worker can prove it in a
+// reasonable time.
+PortfolioModel BuildPigeonHole(Solver* solver) {
+  constexpr int kNumHoles = 14;
+  PortfolioModel model;
+  std::vector<IntVar*> holes;
+  solver->MakeIntVarArray(kNumHoles + 1, 0, kNumHoles - 1, "hole", &holes);
+  for (int i = 0; i < holes.size(); ++i) {
+    for (int j = i + 1; j < holes.size(); ++j) {
+      solver->AddConstraint(solver->MakeNonEquality(holes[i], holes[j]));
+    }
+  }
+  model.decision_vars = holes;
+  model.solution_vars = holes;
+  model.decision_builder = solver->MakePhase(
+      holes, Solver::CHOOSE_FIRST_UNBOUND, Solver::ASSIGN_MIN_VALUE);
+  return model;
+}
+
+TEST(PortfolioSearchTest, SeveralWorkersAreAtLeastAsGoodAsOne) {
+  const int64_t optimum = BruteForceKnapsackOptimum();
+  PortfolioSearchParameters parameters;
+  parameters.num_workers = 1;
+  const PortfolioSearchResult single = SolveWithPortfolio(BuildKnapsack,
+                                                          parameters);
+  ASSERT_TRUE(single.solution_found);
+  EXPECT_TRUE(single.proven);
+  EXPECT_EQ(single.objective_value, optimum);
+  for (const int num_workers : {2, 3, 6}) {
+    parameters.num_workers = num_workers;
+    const PortfolioSearchResult result =
+        SolveWithPortfolio(BuildKnapsack, parameters);
+    ASSERT_TRUE(result.solution_found);
+    EXPECT_TRUE(result.proven);
+    EXPECT_GE(result.objective_value, single.objective_value);
+    EXPECT_EQ(result.objective_value, optimum);
+  }
+}
+
+TEST(PortfolioSearchTest, PublishesBestSolution) {
+  PortfolioSearchParameters parameters;
+  parameters.num_workers = 4;
+  parameters.random_seed = 7;
+  const PortfolioSearchResult result =
+      SolveWithPortfolio(BuildKnapsack, parameters);
+  ASSERT_TRUE(result.solution_found);
+  ASSERT_TRUE(result.proven);
+  EXPECT_GE(result.solution_worker, 0);
+  EXPECT_LT(result.solution_worker, parameters.num_workers);
+  EXPECT_GE(result.proof_worker, 0);
+  EXPECT_LT(result.proof_worker, parameters.num_workers);
+  // The published values are those of the published objective value.
+  ASSERT_EQ(result.solution_values.size(), kWeights.size());
+  int64_t weight = 0;
+  int64_t profit = 0;
+  for (int i = 0; i < kWeights.size(); ++i) {
+    ASSERT_TRUE(result.solution_values[i] == 0 ||
+                result.solution_values[i] == 1);
+    weight += kWeights[i] * result.solution_values[i];
+    profit += kProfits[i] * result.solution_values[i];
+  }
+  EXPECT_LE(weight, kCapacity);
+  EXPECT_EQ(profit, result.objective_value);
+  EXPECT_EQ(profit, BruteForceKnapsackOptimum());
+}
+
+TEST(PortfolioSearchTest, SatisfactionProblem) {
+  PortfolioSearchParameters parameters;
+  parameters.num_workers = 3;
+  const PortfolioSearchResult result = SolveWithPortfolio(
+      [](Solver* solver) {
+        PortfolioModel model;
+        std::vector<IntVar*> vars;
+        solver->MakeIntVarArray(8, 0, 7, "x", &vars);
+        solver->AddConstraint(solver->MakeAllDifferent(vars));
+        model.decision_vars = vars;
+        model.solution_vars = vars;
+        model.decision_builder = solver->MakePhase(
+            vars, Solver::CHOOSE_FIRST_UNBOUND, Solver::ASSIGN_MIN_VALUE);
+        return model;
+      },
+      parameters);
+  ASSERT_TRUE(result.solution_found);
+  EXPECT_TRUE(result.proven);
+  std::vector<bool> used(8, false);
+  for (const int64_t value : result.solution_values) {
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, 8);
+    EXPECT_FALSE(used[value]);
+    used[value] = true;
+  }
+}
+
+TEST(PortfolioSearchTest, RespectsTimeLimit) {
+  PortfolioSearchParameters parameters;
+  parameters.num_workers = 3;
+  parameters.time_limit = absl::Milliseconds(300);
+  const absl::Time start = absl::Now();
+  const PortfolioSearchResult result =
+      SolveWithPortfolio(BuildPigeonHole, parameters);
+  EXPECT_LT(absl::Now() - start, absl::Seconds(10));
+  EXPECT_FALSE(result.solution_found);
+  EXPECT_FALSE(result.proven);
+  EXPECT_EQ(result.proof_worker, -1);
+}
+
+TEST(PortfolioSearchTest, StopsWhenInterrupted) {
+  std::atomic<bool> interrupt = false;
+  PortfolioSearchParameters parameters;
+  parameters.num_workers = 3;
+  parameters.interrupt = &interrupt;
+  std::thread canceller([&interrupt]() {
+    absl::SleepFor(absl::Milliseconds(300));
+    interrupt = true;
+  });
+  const absl::Time start = absl::Now();
+  const PortfolioSearchResult result =
+      SolveWithPortfolio(BuildPigeonHole, parameters);
+  canceller.join();
+  EXPECT_LT(absl::Now() - start, absl::Seconds(10));
+  EXPECT_FALSE(result.solution_found);
+  EXPECT_FALSE(result.proven);
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -1151,6 +1151,7 @@ namespace operations_research {
 %unignore ConstraintSolverParameters::TrailCompression;
 %unignore ConstraintSolverParameters::NO_COMPRESSION;
 %unignore ConstraintSolverParameters::COMPRESS_WITH_ZLIB;
+%unignore ConstraintSolverParameters::COMPRESS_WITH_VARINT;
 
 // ConstraintSolverParameters: methods.
 %unignore ConstraintSolverParameters::compress_trail;
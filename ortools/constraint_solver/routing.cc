@@ -850,6 +850,34 @@ RoutingModel::StateDependentTransit RoutingModel::MakeStateDependentTransit(
           MakeCachedRangeMinMaxIndexFunction(g, domain_start, domain_end)};
 }
 
+bool RoutingModel::AddTimeDependentDimension(
+    int pure_transit, const TimeDependentTransits* transits, int64_t slack_max,
+    int64_t capacity, bool fix_start_cumul_to_zero, const std::string& name) {
+  CHECK(transits != nullptr);
+  CHECK_EQ(transits->num_indices(), Size() + vehicles());
+  // Functions are shared by all the arcs with the same profile; they are
+  // deleted with the state dependent transit cache.
+  auto profile_transits =
+      std::make_shared<absl::flat_hash_map<int, StateDependentTransit>>();
+  const int dependent_transit = RegisterStateDependentTransitCallback(
+      [transits, profile_transits](int64_t i, int64_t j) {
+        const int profile = transits->ArcProfile(i, j);
+        auto [it, inserted] = profile_transits->insert({profile, {}});
+        if (inserted) {
+          it->second = {transits->MakeTransitFunction(profile),
+                        transits->MakeArrivalFunction(profile)};
+        }
+        return it->second;
+      });
+  if (!AddDimensionDependentDimensionWithVehicleCapacity(
+          pure_transit, dependent_transit, /*base_dimension=*/nullptr,
+          slack_max, capacity, fix_start_cumul_to_zero, name)) {
+    return false;
+  }
+  GetMutableDimension(name)->time_dependent_transits_ = transits;
+  return true;
+}
+
 std::vector<std::string> RoutingModel::GetAllDimensionNames() const {
   std::vector<std::string> dimension_names;
   for (const auto& dimension_name_index : dimension_name_to_index_) {
@@ -3690,6 +3718,15 @@ int64_t RoutingModel::GetArcCostForClassInternal(
       cache->cost_class_index == cost_class_index) {
     return cache->cost;
   }
+  const int64_t cost =
+      ComputeArcCostForClass(from_index, to_index, cost_class_index);
+  *cache = {static_cast<int>(to_index), cost_class_index, cost};
+  return cost;
+}
+
+int64_t RoutingModel::ComputeArcCostForClass(
+    int64_t from_index, int64_t to_index,
+    CostClassIndex cost_class_index) const {
   int64_t cost = 0;
   const CostClass& cost_class = cost_classes_[cost_class_index];
   const auto& evaluator = transit_evaluators_[cost_class.evaluator_index];
@@ -3714,7 +3751,6 @@ int64_t RoutingModel::GetArcCostForClassInternal(
       cost = 0;
     }
   }
-  *cache = {static_cast<int>(to_index), cost_class_index, cost};
   return cost;
 }
 
@@ -4924,6 +4960,8 @@ void RoutingModel::StoreDimensionCumulOptimizers(
   for (DimensionIndex dim = DimensionIndex(0); dim < num_dimensions; dim++) {
     RoutingDimension* dimension = dimensions_[dim];
     DCHECK_EQ(dimension->model(), this);
+    // The scheduling models of dimension optimizers assume fixed transits.
+    if (dimension->time_dependent_transits() != nullptr) continue;
     const int num_resource_groups =
         GetDimensionResourceGroupIndices(dimension).size();
     bool needs_optimizer = false;
@@ -5280,6 +5318,20 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
           .cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization();  // NOLINT
   gci_parameters.add_unperformed_entries =
       search_parameters.cheapest_insertion_add_unperformed_entries();
+  gci_parameters.num_initialization_workers =
+      search_parameters.cheapest_insertion_first_solution_num_workers();
+  gci_parameters.max_entries_per_node =
+      search_parameters
+          .cheapest_insertion_first_solution_max_entries_per_node();
+  // The arc cost cache is not thread-safe, it is bypassed when insertion
+  // entries are computed concurrently, and only then.
+  if (gci_parameters.num_initialization_workers > 1) {
+    gci_parameters.initialization_evaluator = [this](int64_t i, int64_t j,
+                                                     int64_t vehicle) {
+      if (i == j || vehicle < 0) return int64_t{0};
+      return ComputeArcCostForClass(i, j, GetCostClassIndexOfVehicle(vehicle));
+    };
+  }
   for (bool is_sequential : {false, true}) {
     FirstSolutionStrategy::Value first_solution_strategy =
         is_sequential ? FirstSolutionStrategy::SEQUENTIAL_CHEAPEST_INSERTION
@@ -786,6 +786,22 @@ class RoutingModel {
   static RoutingModel::StateDependentTransit MakeStateDependentTransit(
       const std::function<int64_t(int64_t)>& f, int64_t domain_start,
       int64_t domain_end);
+#if !defined(SWIG)
+  /// Creates a self-based dimension where the transit from node i to node j
+  /// when leaving i at time t = cumul(i) is
+  /// 'pure_transit'(i, j) + 'transits'->Transit(i, j, t), typically a time
+  /// dimension with traffic-dependent travel times. Travel times being
+  /// FIFO-consistent, the earliest schedule of a route can be computed
+  /// forward, which is what the path cumul filters do for these dimensions.
+  /// 'transits' must be defined on the Size() + vehicles() indices of the
+  /// model, and must outlive it. Returns false if a dimension with the same
+  /// name has already been created.
+  bool AddTimeDependentDimension(int pure_transit,
+                                 const TimeDependentTransits* transits,
+                                 int64_t slack_max, int64_t capacity,
+                                 bool fix_start_cumul_to_zero,
+                                 const std::string& name);
+#endif  // !defined(SWIG)
 
   /// Outputs the names of all dimensions added to the routing engine.
   // TODO(user): rename.
@@ -2072,6 +2088,10 @@ class RoutingModel {
   void TopologicallySortVisitTypes();
   int64_t GetArcCostForClassInternal(int64_t from_index, int64_t to_index,
                                      CostClassIndex cost_class_index) const;
+  // Same as GetArcCostForClassInternal() but bypasses the cost cache, and can
+  // therefore be called concurrently if transit callbacks are thread-safe.
+  int64_t ComputeArcCostForClass(int64_t from_index, int64_t to_index,
+                                 CostClassIndex cost_class_index) const;
   void AppendHomogeneousArcCosts(const RoutingSearchParameters& parameters,
                                  int node_index,
                                  std::vector<IntVar*>* cost_elements);
@@ -3323,6 +3343,13 @@ class RoutingDimension {
 
   /// Returns the parent in the dependency tree if any or nullptr otherwise.
   const RoutingDimension* base_dimension() const { return base_dimension_; }
+#if !defined(SWIG)
+  /// Returns the time-dependent travel times of a dimension created with
+  /// RoutingModel::AddTimeDependentDimension(), nullptr otherwise.
+  const TimeDependentTransits* time_dependent_transits() const {
+    return time_dependent_transits_;
+  }
+#endif  // !defined(SWIG)
   /// It makes sense to use the function only for self-dependent dimension.
   /// For such dimensions the value of the slack of a node determines the
   /// transition cost of the next transit. Provided that
@@ -3556,6 +3583,9 @@ class RoutingDimension {
   // class.
   std::vector<int> state_dependent_class_evaluators_;
   std::vector<int64_t> state_dependent_vehicle_to_class_;
+  // Time-dependent part of the transits of self-based dimensions created with
+  // RoutingModel::AddTimeDependentDimension(); not owned.
+  const TimeDependentTransits* time_dependent_transits_ = nullptr;
 
   // For each pickup/delivery pair_index for which limits have been set,
   // pickup_to_delivery_limits_per_pair_index_[pair_index] contains the
@@ -0,0 +1,384 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_decomposition.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_search.h"
+#include "ortools/util/saturated_arithmetic.h"
+
+namespace operations_research {
+
+namespace {
+
+using NodeIndex = RoutingIndexManager::NodeIndex;
+using DecompositionParameters =
+    RoutingSearchParameters::DecompositionParameters;
+
+// Splits 'nodes' in 'num_clusters' consecutive chunks of balanced sizes.
+std::vector<std::vector<NodeIndex>> SplitInChunks(
+    const std::vector<NodeIndex>& nodes, int num_clusters) {
+  std::vector<std::vector<NodeIndex>> clusters(num_clusters);
+  for (int i = 0; i < nodes.size(); ++i) {
+    clusters[static_cast<int64_t>(i) * num_clusters / nodes.size()].push_back(
+        nodes[i]);
+  }
+  return clusters;
+}
+
+// Clusters nodes by angle around the depot, using the coordinates of the sweep
+// arranger of the model.
+std::vector<std::vector<NodeIndex>> SweepClusters(
+    const RoutingIndexManager& manager, const RoutingModel& model,
+    const std::vector<bool>& is_customer, int num_clusters) {
+  std::vector<int64_t> arranged_indices;
+  model.sweep_arranger()->ArrangeIndices(&arranged_indices);
+  std::vector<NodeIndex> customers;
+  for (const int64_t index : arranged_indices) {
+    if (index < 0 || index >= manager.num_indices()) continue;
+    const NodeIndex node = manager.IndexToNode(index);
+    if (is_customer[node.value()]) customers.push_back(node);
+  }
+  return SplitInChunks(customers, num_clusters);
+}
+
+// Clusters nodes around centers spread with a farthest-first traversal using
+// the arc costs of the first vehicle. Clusters are filled from the nodes
+// closest to their centers, and contain at most 'max_cluster_size' nodes.
+std::vector<std::vector<NodeIndex>> DistanceClusters(
+    const RoutingIndexManager& manager, const RoutingModel& model,
+    const std::vector<bool>& is_customer, int num_clusters,
+    int max_cluster_size) {
+  std::vector<int64_t> customers;
+  for (NodeIndex node(0); node < manager.num_nodes(); ++node) {
+    if (is_customer[node.value()]) {
+      customers.push_back(manager.NodeToIndex(node));
+    }
+  }
+  const int num_customers = customers.size();
+  const auto cost = [&model](int64_t from, int64_t to) {
+    return model.GetArcCostForVehicle(from, to, /*vehicle=*/0);
+  };
+  // costs[c * num_customers + i] is the cost from center c to customer i.
+  std::vector<int64_t> costs;
+  costs.reserve(static_cast<int64_t>(num_clusters) * num_customers);
+  std::vector<int64_t> cost_to_closest_center(
+      num_customers, std::numeric_limits<int64_t>::max());
+  int center = 0;
+  for (int c = 0; c < num_clusters; ++c) {
+    int farthest = 0;
+    for (int i = 0; i < num_customers; ++i) {
+      const int64_t center_cost = cost(customers[center], customers[i]);
+      costs.push_back(center_cost);
+      cost_to_closest_center[i] =
+          std::min(cost_to_closest_center[i], center_cost);
+      if (cost_to_closest_center[i] > cost_to_closest_center[farthest]) {
+        farthest = i;
+      }
+    }
+    center = farthest;
+  }
+  std::vector<int> sorted_customers(num_customers);
+  std::iota(sorted_customers.begin(), sorted_customers.end(), 0);
+  std::stable_sort(sorted_customers.begin(), sorted_customers.end(),
+                   [&cost_to_closest_center](int a, int b) {
+                     return cost_to_closest_center[a] <
+                            cost_to_closest_center[b];
+                   });
+  std::vector<std::vector<NodeIndex>> clusters(num_clusters);
+  for (const int i : sorted_customers) {
+    int best_cluster = -1;
+    for (int c = 0; c < num_clusters; ++c) {
+      if (clusters[c].size() >= max_cluster_size) continue;
+      if (best_cluster == -1 ||
+          costs[c * num_customers + i] <
+              costs[best_cluster * num_customers + i]) {
+        best_cluster = c;
+      }
+    }
+    DCHECK_NE(best_cluster, -1);
+    clusters[best_cluster].push_back(manager.IndexToNode(customers[i]));
+  }
+  return clusters;
+}
+
+// Distributes vehicles to clusters, proportionally to the size of clusters;
+// each cluster gets at least one vehicle. Vehicles go to the clusters closest
+// to their start and end, so that clusters get vehicles from nearby depots
+// when depots are heterogeneous: the (vehicle, cluster) pairs are considered
+// by increasing cost of the cheapest route of the vehicle visiting a single
+// node of the cluster, and a pair is kept if neither the vehicle nor all the
+// vehicles of the cluster are allocated yet.
+std::vector<std::vector<int>> AllocateVehicles(
+    const RoutingIndexManager& manager, const RoutingModel& model,
+    const std::vector<std::vector<NodeIndex>>& clusters) {
+  const int num_clusters = clusters.size();
+  const int num_vehicles = model.vehicles();
+  DCHECK_LE(num_clusters, num_vehicles);
+  std::vector<int> num_cluster_vehicles(num_clusters, 1);
+  for (int v = num_clusters; v < num_vehicles; ++v) {
+    int best_cluster = 0;
+    for (int c = 1; c < num_clusters; ++c) {
+      // Compares clusters[c].size() / num_cluster_vehicles[c] ratios.
+      if (static_cast<int64_t>(clusters[c].size()) *
+              num_cluster_vehicles[best_cluster] >
+          static_cast<int64_t>(clusters[best_cluster].size()) *
+              num_cluster_vehicles[c]) {
+        best_cluster = c;
+      }
+    }
+    ++num_cluster_vehicles[best_cluster];
+  }
+
+  // Distances are only computed on a sample of the nodes of large clusters,
+  // to keep the number of arc cost evaluations linear in the number of
+  // vehicles.
+  constexpr int kMaxSampledNodes = 64;
+  std::vector<std::tuple<int64_t, int, int>> pairs;
+  pairs.reserve(static_cast<int64_t>(num_vehicles) * num_clusters);
+  for (int vehicle = 0; vehicle < num_vehicles; ++vehicle) {
+    const int64_t start = model.Start(vehicle);
+    const int64_t end = model.End(vehicle);
+    const int64_t cost_class =
+        model.GetCostClassIndexOfVehicle(vehicle).value();
+    for (int c = 0; c < num_clusters; ++c) {
+      const int num_nodes = clusters[c].size();
+      const int num_sampled_nodes = std::min(num_nodes, kMaxSampledNodes);
+      int64_t cost = std::numeric_limits<int64_t>::max();
+      for (int i = 0; i < num_sampled_nodes; ++i) {
+        const int64_t index = manager.NodeToIndex(
+            clusters[c][static_cast<int64_t>(i) * num_nodes /
+                        num_sampled_nodes]);
+        cost = std::min(
+            cost, CapAdd(model.GetArcCostForClass(start, index, cost_class),
+                         model.GetArcCostForClass(index, end, cost_class)));
+      }
+      pairs.push_back({cost, vehicle, c});
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::vector<std::vector<int>> vehicles(num_clusters);
+  std::vector<bool> is_allocated(num_vehicles, false);
+  for (const auto& [cost, vehicle, c] : pairs) {
+    if (is_allocated[vehicle] ||
+        vehicles[c].size() == num_cluster_vehicles[c]) {
+      continue;
+    }
+    is_allocated[vehicle] = true;
+    vehicles[c].push_back(vehicle);
+  }
+  for (std::vector<int>& cluster_vehicles : vehicles) {
+    std::sort(cluster_vehicles.begin(), cluster_vehicles.end());
+  }
+  return vehicles;
+}
+
+RoutingSubProblem MakeSubProblem(const RoutingIndexManager& manager,
+                                 const RoutingModel& model,
+                                 const std::vector<NodeIndex>& customers,
+                                 std::vector<int> vehicles) {
+  RoutingSubProblem subproblem;
+  subproblem.vehicles = std::move(vehicles);
+  absl::flat_hash_map<int, int> subproblem_node;
+  const auto add_node = [&subproblem, &subproblem_node](NodeIndex node) {
+    const auto [it, inserted] =
+        subproblem_node.insert({node.value(), subproblem.nodes.size()});
+    if (inserted) subproblem.nodes.push_back(node);
+    return NodeIndex(it->second);
+  };
+  std::vector<NodeIndex> starts;
+  std::vector<NodeIndex> ends;
+  for (const int vehicle : subproblem.vehicles) {
+    starts.push_back(add_node(manager.IndexToNode(model.Start(vehicle))));
+    ends.push_back(add_node(manager.IndexToNode(model.End(vehicle))));
+  }
+  for (const NodeIndex node : customers) add_node(node);
+  subproblem.manager = std::make_unique<RoutingIndexManager>(
+      subproblem.nodes.size(), subproblem.vehicles.size(), starts, ends);
+  return subproblem;
+}
+
+absl::Duration GetTimeLimit(const RoutingSearchParameters& parameters) {
+  if (!parameters.has_time_limit()) return absl::InfiniteDuration();
+  return util_time::DecodeGoogleApiProto(parameters.time_limit()).value();
+}
+
+void SetTimeLimit(absl::Duration time_limit,
+                  RoutingSearchParameters* parameters) {
+  if (time_limit == absl::InfiniteDuration()) {
+    parameters->clear_time_limit();
+    return;
+  }
+  CHECK_OK(util_time::EncodeGoogleApiProto(
+      std::max(time_limit, absl::ZeroDuration()),
+      parameters->mutable_time_limit()));
+}
+
+}  // namespace
+
+std::vector<RoutingSubProblem> DecomposeRoutingProblem(
+    const RoutingIndexManager& manager, const RoutingModel& model,
+    const DecompositionParameters& parameters) {
+  std::vector<bool> is_customer(manager.num_nodes(), true);
+  for (int vehicle = 0; vehicle < model.vehicles(); ++vehicle) {
+    is_customer[manager.IndexToNode(model.Start(vehicle)).value()] = false;
+    is_customer[manager.IndexToNode(model.End(vehicle)).value()] = false;
+  }
+  const int num_customers =
+      std::count(is_customer.begin(), is_customer.end(), true);
+  const int max_nodes = parameters.max_nodes_per_subproblem();
+  const int num_clusters =
+      std::min((num_customers + max_nodes - 1) / max_nodes, model.vehicles());
+  if (num_clusters == 0) return {};
+
+  bool use_sweep =
+      parameters.clustering_method() == DecompositionParameters::SWEEP;
+  if (parameters.clustering_method() == DecompositionParameters::UNSET) {
+    use_sweep = model.sweep_arranger() != nullptr;
+  }
+  if (use_sweep && model.sweep_arranger() == nullptr) {
+    LOG(WARNING) << "No sweep arranger in the model, clustering nodes by "
+                    "distance instead.";
+    use_sweep = false;
+  }
+  // When there are fewer vehicles than needed, clusters get larger than the
+  // maximum size.
+  const int max_cluster_size =
+      std::max(max_nodes, (num_customers + num_clusters - 1) / num_clusters);
+  const std::vector<std::vector<NodeIndex>> clusters =
+      use_sweep ? SweepClusters(manager, model, is_customer, num_clusters)
+                : DistanceClusters(manager, model, is_customer, num_clusters,
+                                   max_cluster_size);
+  std::vector<std::vector<int>> vehicles =
+      AllocateVehicles(manager, model, clusters);
+  std::vector<RoutingSubProblem> subproblems;
+  subproblems.reserve(num_clusters);
+  for (int c = 0; c < num_clusters; ++c) {
+    subproblems.push_back(
+        MakeSubProblem(manager, model, clusters[c], std::move(vehicles[c])));
+  }
+  return subproblems;
+}
+
+const Assignment* SolveWithDecomposition(
+    const RoutingIndexManager& manager, const RoutingSubModelBuilder& builder,
+    const RoutingSearchParameters& parameters, RoutingModel* model) {
+  const absl::Time start_time = absl::Now();
+  model->CloseModelWithParameters(parameters);
+  if (!parameters.use_decomposition()) {
+    return model->SolveWithParameters(parameters);
+  }
+  const DecompositionParameters& decomposition =
+      parameters.decomposition_parameters();
+  std::vector<RoutingSubProblem> subproblems =
+      DecomposeRoutingProblem(manager, *model, decomposition);
+  if (subproblems.size() <= 1) {
+    return model->SolveWithParameters(parameters);
+  }
+
+  // Subproblems are solved in waves of num_workers subproblems, which share
+  // the time allotted to subproblems.
+  const int num_subproblems = subproblems.size();
+  const int num_workers =
+      std::min(decomposition.num_workers(), num_subproblems);
+  const int num_waves = (num_subproblems + num_workers - 1) / num_workers;
+  const absl::Duration time_limit = GetTimeLimit(parameters);
+  RoutingSearchParameters subproblem_parameters = parameters;
+  subproblem_parameters.set_use_decomposition(false);
+  SetTimeLimit(
+      time_limit * decomposition.subproblem_time_limit_ratio() / num_waves,
+      &subproblem_parameters);
+  if (parameters.log_search()) {
+    LOG(INFO) << "Decomposing the problem in " << num_subproblems
+              << " subproblems.";
+  }
+
+  // routes[vehicle] is the route of the vehicle in the stitched solution;
+  // subproblems have disjoint vehicles, so they can fill it concurrently.
+  std::vector<std::vector<int64_t>> routes(model->vehicles());
+  {
+    ThreadPool pool("RoutingDecomposition", num_workers);
+    pool.StartWorkers();
+    for (int s = 0; s < num_subproblems; ++s) {
+      pool.Schedule([s, &subproblems, &subproblem_parameters, &builder,
+                     &manager, &routes]() {
+        const RoutingSubProblem& subproblem = subproblems[s];
+        std::unique_ptr<RoutingModel> sub_model = builder(subproblem);
+        RoutingSearchParameters sub_parameters = subproblem_parameters;
+        if (sub_parameters.log_search()) {
+          sub_parameters.set_log_tag(
+              absl::StrCat(sub_parameters.log_tag(), "[subproblem ", s, "]"));
+        }
+        const Assignment* solution =
+            sub_model->SolveWithParameters(sub_parameters);
+        if (solution == nullptr) {
+          LOG(WARNING) << "No solution found for subproblem " << s;
+          return;
+        }
+        std::vector<std::vector<int64_t>> sub_routes;
+        sub_model->AssignmentToRoutes(*solution, &sub_routes);
+        for (int v = 0; v < sub_routes.size(); ++v) {
+          std::vector<int64_t>& route = routes[subproblem.vehicles[v]];
+          for (const int64_t sub_index : sub_routes[v]) {
+            const NodeIndex node =
+                subproblem
+                    .nodes[subproblem.manager->IndexToNode(sub_index).value()];
+            route.push_back(manager.NodeToIndex(node));
+          }
+        }
+      });
+    }
+  }
+
+  // Boundary repair: local search on the whole problem, starting from the
+  // stitched solution.
+  RoutingSearchParameters repair_parameters = parameters;
+  repair_parameters.set_use_decomposition(false);
+  SetTimeLimit(time_limit - (absl::Now() - start_time), &repair_parameters);
+  Assignment stitched_solution(model->solver());
+  if (model->RoutesToAssignment(routes, /*ignore_inactive_indices=*/true,
+                                /*close_routes=*/true, &stitched_solution)) {
+    const Assignment* solution =
+        model->SolveFromAssignmentWithParameters(&stitched_solution,
+                                                 repair_parameters);
+    if (solution != nullptr) return solution;
+  }
+  // The stitched solution is not feasible for the whole problem (some nodes
+  // may not have been routed); falling back to a regular solve.
+  LOG(WARNING) << "Stitched solution is infeasible, solving the problem as a "
+                  "whole.";
+  SetTimeLimit(time_limit - (absl::Now() - start_time), &repair_parameters);
+  return model->SolveWithParameters(repair_parameters);
+}
+
+}  // namespace operations_research
@@ -0,0 +1,80 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Decomposition of large vehicle routing problems.
+//
+// The nodes of the problem are clustered (by sweep angle around the depot or
+// by distance) and each cluster is assigned a subset of the vehicles, chosen
+// among the ones whose starts and ends are closest to its nodes. Each
+// subproblem is built as a RoutingModel of its own by a user-provided builder,
+// which keeps all the dimensions and constraints of the original problem, and
+// subproblems are solved concurrently. Their routes are then stitched into a
+// solution of the original model, which is improved by local search to repair
+// the boundaries between subproblems.
+//
+// The decomposition is controlled by the use_decomposition and
+// decomposition_parameters fields of RoutingSearchParameters.
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_DECOMPOSITION_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_DECOMPOSITION_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+
+namespace operations_research {
+
+// Subset of the nodes and vehicles of a routing problem.
+struct RoutingSubProblem {
+  // Nodes of the original problem in the subproblem: node i of the subproblem
+  // corresponds to node nodes[i] of the original problem. Starts and ends of
+  // the vehicles of the subproblem come first.
+  std::vector<RoutingIndexManager::NodeIndex> nodes;
+  // Vehicles of the original problem in the subproblem: vehicle v of the
+  // subproblem corresponds to vehicle vehicles[v] of the original problem.
+  std::vector<int> vehicles;
+  // Index manager of the subproblem, on which its model must be built.
+  std::unique_ptr<RoutingIndexManager> manager;
+};
+
+// Builds the model of the original problem restricted to the nodes and
+// vehicles of a subproblem, on subproblem.manager. Builders are called
+// concurrently when subproblems are solved by several workers.
+using RoutingSubModelBuilder = std::function<std::unique_ptr<RoutingModel>(
+    const RoutingSubProblem& subproblem)>;
+
+// Splits the nodes and vehicles of 'model', built on 'manager', in
+// subproblems following 'parameters'. Each node which is not the start or end
+// of a vehicle belongs to exactly one subproblem, and each vehicle to at most
+// one. 'model' must be closed.
+std::vector<RoutingSubProblem> DecomposeRoutingProblem(
+    const RoutingIndexManager& manager, const RoutingModel& model,
+    const RoutingSearchParameters::DecompositionParameters& parameters);
+
+// Solves 'model', built on 'manager', by decomposition if
+// parameters.use_decomposition() is true, and as a whole otherwise. Sub-models
+// are built with 'builder' and solved with 'parameters', within the share of
+// the time limit given by the decomposition parameters. Returns the best
+// solution found, or nullptr if none was found.
+const Assignment* SolveWithDecomposition(
+    const RoutingIndexManager& manager, const RoutingSubModelBuilder& builder,
+    const RoutingSearchParameters& parameters, RoutingModel* model);
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_DECOMPOSITION_H_
@@ -0,0 +1,276 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_decomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/time/time.h"
+#include "gtest/gtest.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_enums.pb.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_search.h"
+
+namespace operations_research {
+namespace {
+
+using NodeIndex = RoutingIndexManager::NodeIndex;
+using DecompositionParameters =
+    RoutingSearchParameters::DecompositionParameters;
+
+constexpr int kNumCustomers = 40;
+constexpr int64_t kVehicleCapacity = 12;
+
+// Multi-depot problem: node 0 is the end of all vehicles, nodes 1 and 2 are
+// the starts of two vehicles each, so that start indices are duplicated and
+// node 0 has no index of its own among the first indices. Customers (nodes 3
+// and above) are spread on a circle around the depots, in an order unrelated to
+// their node numbers, and all have a demand of 1.
+struct MultiDepotProblem {
+  MultiDepotProblem()
+      : manager(kNumCustomers + 3, 4,
+                std::vector<NodeIndex>{NodeIndex(1), NodeIndex(1),
+                                       NodeIndex(2), NodeIndex(2)},
+                std::vector<NodeIndex>(4, NodeIndex(0))) {
+    points = {{0, 0}, {1, 0}, {0, 1}};
+    for (NodeIndex node(3); node < kNumCustomers + 3; ++node) {
+      const double angle = 2 * M_PI * Position(node) / kNumCustomers;
+      points.push_back({static_cast<int64_t>(std::round(100 * cos(angle))),
+                        static_cast<int64_t>(std::round(100 * sin(angle)))});
+    }
+  }
+
+  bool IsCustomer(NodeIndex node) const { return node.value() >= 3; }
+  // Position of a customer on the circle, in [0, kNumCustomers): customers
+  // with even and odd numbers go around the circle in opposite directions.
+  static int Position(NodeIndex node) {
+    const int customer = node.value() - 3;
+    return customer % 2 == 0 ? customer / 2 : kNumCustomers - 1 - customer / 2;
+  }
+
+  RoutingIndexManager manager;
+  std::vector<std::pair<int64_t, int64_t>> points;
+};
+
+// Two depots far apart: node 0 is the depot of the even vehicles, on the west,
+// and node 1 the depot of the odd vehicles, on the east. Half of the customers
+// are around each depot, so that allocating vehicles to clusters in index
+// order would mix depots.
+struct TwoDepotProblem {
+  static constexpr int kNumVehicles = 4;
+  static constexpr int kNumCustomersPerDepot = 10;
+
+  TwoDepotProblem()
+      : manager(2 * kNumCustomersPerDepot + 2, kNumVehicles,
+                VehicleDepots(), VehicleDepots()) {
+    points = {{-1000, 0}, {1000, 0}};
+    for (int i = 0; i < kNumCustomersPerDepot; ++i) {
+      points.push_back({-1000 + 10 * i, 20});
+      points.push_back({1000 - 10 * i, -20});
+    }
+  }
+
+  static std::vector<NodeIndex> VehicleDepots() {
+    std::vector<NodeIndex> depots;
+    for (int vehicle = 0; vehicle < kNumVehicles; ++vehicle) {
+      depots.push_back(NodeIndex(vehicle % 2));
+    }
+    return depots;
+  }
+  bool IsCustomer(NodeIndex node) const { return node.value() >= 2; }
+  // 0 for customers around the west depot, 1 for the east one.
+  static int Side(NodeIndex node) { return node.value() % 2; }
+
+  RoutingIndexManager manager;
+  std::vector<std::pair<int64_t, int64_t>> points;
+};
+
+// Builds the model of 'problem' restricted to 'nodes' and 'vehicles' on
+// 'manager'.
+template <typename Problem>
+std::unique_ptr<RoutingModel> BuildModel(const Problem& problem,
+                                         const RoutingIndexManager& manager,
+                                         std::vector<NodeIndex> nodes,
+                                         const std::vector<int>& vehicles) {
+  auto model = std::make_unique<RoutingModel>(manager);
+  const auto to_point = [&problem, &manager, nodes](int64_t index) {
+    return problem.points[nodes[manager.IndexToNode(index).value()].value()];
+  };
+  const int distance = model->RegisterTransitCallback(
+      [to_point](int64_t from, int64_t to) {
+        const auto [from_x, from_y] = to_point(from);
+        const auto [to_x, to_y] = to_point(to);
+        return static_cast<int64_t>(
+            std::round(std::hypot(from_x - to_x, from_y - to_y)));
+      });
+  model->SetArcCostEvaluatorOfAllVehicles(distance);
+  const int demand = model->RegisterUnaryTransitCallback(
+      [&problem, &manager, nodes](int64_t index) -> int64_t {
+        return problem.IsCustomer(nodes[manager.IndexToNode(index).value()]);
+      });
+  model->AddDimensionWithVehicleCapacity(
+      demand, 0, std::vector<int64_t>(vehicles.size(), kVehicleCapacity),
+      /*fix_start_cumul_to_zero=*/true, "Load");
+  std::vector<std::pair<int64_t, int64_t>> index_points;
+  for (int64_t index = 0; index < manager.num_indices(); ++index) {
+    index_points.push_back(to_point(index));
+  }
+  model->SetSweepArranger(new SweepArranger(index_points));
+  return model;
+}
+
+template <typename Problem>
+std::unique_ptr<RoutingModel> BuildFullModel(const Problem& problem) {
+  std::vector<NodeIndex> nodes(problem.manager.num_nodes());
+  std::iota(nodes.begin(), nodes.end(), NodeIndex(0));
+  std::vector<int> vehicles(problem.manager.num_vehicles());
+  std::iota(vehicles.begin(), vehicles.end(), 0);
+  return BuildModel(problem, problem.manager, std::move(nodes), vehicles);
+}
+
+TEST(RoutingDecompositionTest, SweepClustersWithSeveralDepots) {
+  const MultiDepotProblem problem;
+  std::unique_ptr<RoutingModel> model = BuildFullModel(problem);
+  model->CloseModel();
+  DecompositionParameters parameters;
+  parameters.set_clustering_method(DecompositionParameters::SWEEP);
+  parameters.set_max_nodes_per_subproblem(10);
+  const std::vector<RoutingSubProblem> subproblems =
+      DecomposeRoutingProblem(problem.manager, *model, parameters);
+  ASSERT_EQ(subproblems.size(), 4);
+
+  std::vector<int> num_occurrences(problem.manager.num_nodes(), 0);
+  std::vector<int> vehicle_occurrences(model->vehicles(), 0);
+  for (const RoutingSubProblem& subproblem : subproblems) {
+    std::vector<int> positions;
+    for (const NodeIndex node : subproblem.nodes) {
+      if (!problem.IsCustomer(node)) continue;
+      ++num_occurrences[node.value()];
+      positions.push_back(MultiDepotProblem::Position(node));
+    }
+    EXPECT_EQ(positions.size(), kNumCustomers / 4);
+    // Customers of a cluster form an angular sector: their positions are
+    // consecutive on the circle, so exactly one (cyclic) gap is larger than 1.
+    std::sort(positions.begin(), positions.end());
+    int num_gaps = 0;
+    for (int i = 0; i < positions.size(); ++i) {
+      const int next = positions[(i + 1) % positions.size()];
+      if ((next - positions[i] + kNumCustomers) % kNumCustomers != 1) {
+        ++num_gaps;
+      }
+    }
+    EXPECT_EQ(num_gaps, 1);
+    ASSERT_EQ(subproblem.vehicles.size(), 1);
+    ++vehicle_occurrences[subproblem.vehicles[0]];
+    // The start and end of the vehicle come first.
+    const int vehicle = subproblem.vehicles[0];
+    EXPECT_EQ(subproblem.nodes[0],
+              problem.manager.IndexToNode(model->Start(vehicle)));
+    EXPECT_EQ(subproblem.nodes[1],
+              problem.manager.IndexToNode(model->End(vehicle)));
+  }
+  for (NodeIndex node(0); node < problem.manager.num_nodes(); ++node) {
+    EXPECT_EQ(num_occurrences[node.value()], problem.IsCustomer(node) ? 1 : 0)
+        << "node " << node;
+  }
+  EXPECT_EQ(vehicle_occurrences, std::vector<int>(model->vehicles(), 1));
+}
+
+TEST(RoutingDecompositionTest, VehiclesGoToTheClosestClusters) {
+  const TwoDepotProblem problem;
+  std::unique_ptr<RoutingModel> model = BuildFullModel(problem);
+  model->CloseModel();
+  for (const auto method :
+       {DecompositionParameters::SWEEP, DecompositionParameters::DISTANCE}) {
+    DecompositionParameters parameters;
+    parameters.set_clustering_method(method);
+    parameters.set_max_nodes_per_subproblem(
+        TwoDepotProblem::kNumCustomersPerDepot);
+    const std::vector<RoutingSubProblem> subproblems =
+        DecomposeRoutingProblem(problem.manager, *model, parameters);
+    ASSERT_EQ(subproblems.size(), 2);
+    for (const RoutingSubProblem& subproblem : subproblems) {
+      ASSERT_EQ(subproblem.vehicles.size(), 2);
+      // All the customers of the cluster are on one side, and all its
+      // vehicles start and end at the depot of this side.
+      int side = -1;
+      for (const NodeIndex node : subproblem.nodes) {
+        if (!problem.IsCustomer(node)) continue;
+        if (side == -1) side = TwoDepotProblem::Side(node);
+        EXPECT_EQ(TwoDepotProblem::Side(node), side) << "node " << node;
+      }
+      for (const int vehicle : subproblem.vehicles) {
+        EXPECT_EQ(vehicle % 2, side) << "vehicle " << vehicle;
+      }
+    }
+  }
+}
+
+TEST(RoutingDecompositionTest, DecomposedSolveIsFeasible) {
+  const MultiDepotProblem problem;
+  RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+  parameters.set_first_solution_strategy(
+      FirstSolutionStrategy::PATH_CHEAPEST_ARC);
+  parameters.set_local_search_metaheuristic(
+      LocalSearchMetaheuristic::GREEDY_DESCENT);
+  CHECK_OK(util_time::EncodeGoogleApiProto(absl::Seconds(30),
+                                           parameters.mutable_time_limit()));
+  parameters.set_use_decomposition(true);
+  DecompositionParameters* const decomposition =
+      parameters.mutable_decomposition_parameters();
+  decomposition->set_max_nodes_per_subproblem(10);
+  decomposition->set_num_workers(2);
+
+  for (const auto method :
+       {DecompositionParameters::SWEEP, DecompositionParameters::DISTANCE}) {
+    decomposition->set_clustering_method(method);
+    std::unique_ptr<RoutingModel> model = BuildFullModel(problem);
+    const Assignment* const solution = SolveWithDecomposition(
+        problem.manager,
+        [&problem](const RoutingSubProblem& subproblem) {
+          return BuildModel(problem, *subproblem.manager, subproblem.nodes,
+                            subproblem.vehicles);
+        },
+        parameters, model.get());
+    ASSERT_NE(solution, nullptr);
+    EXPECT_TRUE(model->CheckIfAssignmentIsFeasible(
+        *solution, /*call_at_solution_monitors=*/false));
+    std::vector<std::vector<int64_t>> routes;
+    model->AssignmentToRoutes(*solution, &routes);
+    std::vector<int> num_visits(problem.manager.num_nodes(), 0);
+    for (const std::vector<int64_t>& route : routes) {
+      EXPECT_LE(route.size(), kVehicleCapacity);
+      for (const int64_t index : route) {
+        ++num_visits[problem.manager.IndexToNode(index).value()];
+      }
+    }
+    for (NodeIndex node(3); node < problem.manager.num_nodes(); ++node) {
+      EXPECT_EQ(num_visits[node.value()], 1) << "node " << node;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
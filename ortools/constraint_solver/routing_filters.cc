@@ -47,6 +47,7 @@
 #include "ortools/constraint_solver/routing_lp_scheduling.h"
 #include "ortools/constraint_solver/routing_parameters.pb.h"
 #include "ortools/constraint_solver/routing_types.h"
+#include "ortools/constraint_solver/routing_utils.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/piecewise_linear_function.h"
 #include "ortools/util/saturated_arithmetic.h"
@@ -1016,6 +1017,32 @@ class PathCumulFilter : public BasePathFilter {
     std::vector<std::vector<int64_t>> transits_;
   };
 
+  // Transit between two nodes when leaving the first one at a given time. For
+  // time-dependent dimensions, min and max are the bounds of the transit over
+  // all departure times, to be used in bounds which do not depend on the
+  // schedule of the route; for other dimensions, all values are equal.
+  struct Transit {
+    int64_t value;
+    int64_t min;
+    int64_t max;
+  };
+  Transit GetTransit(int vehicle, int64_t node, int64_t next,
+                     int64_t departure) const {
+    const int64_t transit = (*evaluators_[vehicle])(node, next);
+    if (time_dependent_transits_ == nullptr) {
+      return {transit, transit, transit};
+    }
+    // Travel times being FIFO-consistent, leaving at the earliest departure
+    // time gives the earliest arrival time.
+    const int profile = time_dependent_transits_->ArcProfile(node, next);
+    return {CapAdd(transit, time_dependent_transits_->ProfileTransit(
+                                profile, departure)),
+            CapAdd(transit,
+                   time_dependent_transits_->ProfileMinTransit(profile)),
+            CapAdd(transit,
+                   time_dependent_transits_->ProfileMaxTransit(profile))};
+  }
+
   bool InitializeAcceptPath() override {
     cumul_cost_delta_ = total_current_cumul_cost_value_;
     node_with_precedence_to_delta_min_max_cumuls_.clear();
@@ -1053,7 +1080,8 @@ class PathCumulFilter : public BasePathFilter {
   }
 
   bool FilterWithDimensionCumulOptimizerForVehicle(int vehicle) const {
-    if (!can_use_lp_ || FilterCumulPiecewiseLinearCosts()) {
+    if (!can_use_lp_ || FilterCumulPiecewiseLinearCosts() ||
+        time_dependent_transits_ != nullptr) {
       return false;
     }
 
@@ -1156,6 +1184,7 @@ class PathCumulFilter : public BasePathFilter {
   const std::vector<IntVar*> slacks_;
   std::vector<int64_t> start_to_vehicle_;
   std::vector<const RoutingModel::TransitCallback2*> evaluators_;
+  const TimeDependentTransits* const time_dependent_transits_;
   std::vector<int64_t> vehicle_span_upper_bounds_;
   const bool has_vehicle_span_upper_bounds_;
   int64_t total_current_cumul_cost_value_;
@@ -1229,6 +1258,7 @@ PathCumulFilter::PathCumulFilter(const RoutingModel& routing_model,
       cumuls_(dimension.cumuls()),
       slacks_(dimension.slacks()),
       evaluators_(routing_model.vehicles(), nullptr),
+      time_dependent_transits_(dimension.time_dependent_transits()),
       vehicle_span_upper_bounds_(dimension.vehicle_span_upper_bounds()),
       has_vehicle_span_upper_bounds_(absl::c_any_of(
           vehicle_span_upper_bounds_,
@@ -1430,14 +1460,16 @@ void PathCumulFilter::OnBeforeSynchronizePaths() {
       current_cumul_cost_value = CapAdd(
           current_cumul_cost_value, GetCumulPiecewiseLinearCost(node, cumul));
 
+      // Upper bound of the sum of transits on the path.
       int64_t total_transit = 0;
       while (node < Size()) {
         const int64_t next = Value(node);
-        const int64_t transit = (*evaluators_[vehicle])(node, next);
-        total_transit = CapAdd(total_transit, transit);
-        const int64_t transit_slack = CapAdd(transit, slacks_[node]->Min());
-        current_path_transits_.PushTransit(r, node, next, transit_slack);
-        cumul = CapAdd(cumul, transit_slack);
+        const Transit transit = GetTransit(vehicle, node, next, cumul);
+        total_transit = CapAdd(total_transit, transit.max);
+        const int64_t slack_min = slacks_[node]->Min();
+        current_path_transits_.PushTransit(r, node, next,
+                                           CapAdd(transit.min, slack_min));
+        cumul = CapAdd(cumul, CapAdd(transit.value, slack_min));
         cumul =
             dimension_.GetFirstPossibleGreaterOrEqualValueForNode(next, cumul);
         cumul = std::max(cumuls_[next]->Min(), cumul);
@@ -1466,10 +1498,14 @@ void PathCumulFilter::OnBeforeSynchronizePaths() {
             current_path_transits_, r, Start(r), cumul);
         const int64_t span_lower_bound = CapSub(cumul, start);
         if (FilterSlackCost()) {
+          int64_t min_total_slack = CapSub(span_lower_bound, total_transit);
+          if (time_dependent_transits_ != nullptr) {
+            min_total_slack = std::max<int64_t>(0, min_total_slack);
+          }
           current_cumul_cost_value =
               CapAdd(current_cumul_cost_value,
                      CapProd(vehicle_total_slack_cost_coefficients_[vehicle],
-                             CapSub(span_lower_bound, total_transit)));
+                             min_total_slack));
         }
         if (FilterSoftSpanCost()) {
           const BoundCost bound_cost =
@@ -1572,7 +1608,9 @@ bool PathCumulFilter::AcceptPath(int64_t path_start, int64_t /*chain_start*/,
   int64_t node = path_start;
   int64_t cumul = cumuls_[node]->Min();
   int64_t cumul_cost_delta = 0;
+  // Lower and upper bounds of the sum of transits on the path.
   int64_t total_transit = 0;
+  int64_t total_max_transit = 0;
   const int path = delta_path_transits_.AddPaths(1);
   const int vehicle = start_to_vehicle_[path_start];
   const int64_t capacity = vehicle_capacities_[vehicle];
@@ -1599,11 +1637,13 @@ bool PathCumulFilter::AcceptPath(int64_t path_start, int64_t /*chain_start*/,
   node = path_start;
   while (node < Size()) {
     const int64_t next = GetNext(node);
-    const int64_t transit = (*evaluators_[vehicle])(node, next);
-    total_transit = CapAdd(total_transit, transit);
-    const int64_t transit_slack = CapAdd(transit, slacks_[node]->Min());
-    delta_path_transits_.PushTransit(path, node, next, transit_slack);
-    cumul = CapAdd(cumul, transit_slack);
+    const Transit transit = GetTransit(vehicle, node, next, cumul);
+    total_transit = CapAdd(total_transit, transit.min);
+    total_max_transit = CapAdd(total_max_transit, transit.max);
+    const int64_t slack_min = slacks_[node]->Min();
+    delta_path_transits_.PushTransit(path, node, next,
+                                     CapAdd(transit.min, slack_min));
+    cumul = CapAdd(cumul, CapAdd(transit.value, slack_min));
     cumul = dimension_.GetFirstPossibleGreaterOrEqualValueForNode(next, cumul);
     if (cumul > std::min(capacity, cumuls_[next]->Max())) {
       return false;
@@ -1635,7 +1675,10 @@ bool PathCumulFilter::AcceptPath(int64_t path_start, int64_t /*chain_start*/,
     const int64_t max_start_from_min_end = ComputePathMaxStartFromEndCumul(
         delta_path_transits_, path, path_start, min_end);
     const int64_t span_lb = CapSub(min_end, max_start_from_min_end);
-    int64_t min_total_slack = CapSub(span_lb, total_transit);
+    int64_t min_total_slack = CapSub(span_lb, total_max_transit);
+    if (time_dependent_transits_ != nullptr) {
+      min_total_slack = std::max<int64_t>(0, min_total_slack);
+    }
     if (min_total_slack > slack_max) return false;
 
     if (dimension_.HasBreakConstraints()) {
@@ -2138,6 +2181,26 @@ void AppendLightWeightDimensionFilters(
       } else {
         const auto& binary_evaluator =
             dimension->GetBinaryTransitEvaluator(vehicle);
+        const TimeDependentTransits* const time_dependent_transits =
+            dimension->time_dependent_transits();
+        if (time_dependent_transits != nullptr) {
+          transits[vehicle_class] = [&binary_evaluator, time_dependent_transits,
+                                     dimension, num_slacks](
+                                        int64_t node,
+                                        int64_t next) -> Interval {
+            if (node >= num_slacks) return {0, 0};
+            const int64_t transit = binary_evaluator(node, next);
+            const int profile = time_dependent_transits->ArcProfile(node, next);
+            const int64_t min_transit = CapAdd(
+                transit, time_dependent_transits->ProfileMinTransit(profile));
+            const int64_t max_transit = CapAdd(
+                CapAdd(transit,
+                       time_dependent_transits->ProfileMaxTransit(profile)),
+                dimension->SlackVar(node)->Max());
+            return {min_transit, max_transit};
+          };
+          continue;
+        }
 
         transits[vehicle_class] = [&binary_evaluator, dimension, num_slacks](
                                       int64_t node, int64_t next) -> Interval {
@@ -2190,8 +2253,13 @@ void AppendDimensionCumulFilters(
   for (int d = 0; d < num_dimensions; d++) {
     const RoutingDimension& dimension = *dimensions[d];
     const bool has_cumul_cost = DimensionHasCumulCost(dimension);
-    use_path_cumul_filter[d] =
-        has_cumul_cost || DimensionHasPathCumulConstraint(dimension);
+    // Time-dependent transits are only handled by path cumul filters and
+    // cumul bounds propagators, dimension optimizers assume fixed transits.
+    const bool has_time_dependent_transits =
+        dimension.time_dependent_transits() != nullptr;
+    use_path_cumul_filter[d] = has_cumul_cost ||
+                               DimensionHasPathCumulConstraint(dimension) ||
+                               has_time_dependent_transits;
 
     const int num_dimension_resource_groups =
         dimension.model()->GetDimensionResourceGroupIndices(&dimension).size();
@@ -2201,7 +2269,7 @@ void AppendDimensionCumulFilters(
         (!filter_objective_cost || !has_cumul_cost);
     const bool has_precedences = !dimension.GetNodePrecedences().empty();
     use_global_lp_filter[d] =
-        has_dimension_optimizers &&
+        has_dimension_optimizers && !has_time_dependent_transits &&
         ((has_precedences && !can_use_cumul_bounds_propagator_filter) ||
          (filter_objective_cost &&
           dimension.global_span_cost_coefficient() > 0) ||
@@ -2210,8 +2278,9 @@ void AppendDimensionCumulFilters(
     use_cumul_bounds_propagator_filter[d] =
         has_precedences && !use_global_lp_filter[d];
 
-    use_resource_assignment_filter[d] =
-        has_dimension_optimizers && num_dimension_resource_groups > 0;
+    use_resource_assignment_filter[d] = has_dimension_optimizers &&
+                                        !has_time_dependent_transits &&
+                                        num_dimension_resource_groups > 0;
   }
 
   for (int d = 0; d < num_dimensions; d++) {
@@ -43,6 +43,7 @@
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
 #include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_utils.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/graph/ebert_graph.h"
 #include "ortools/graph/min_cost_flow.h"
@@ -347,6 +348,8 @@ bool CumulBoundsPropagator::InitializeArcsAndBounds(
 
   RoutingModel* const model = dimension_.model();
   std::vector<int64_t>& lower_bounds = propagated_bounds_;
+  const TimeDependentTransits* const time_dependent_transits =
+      dimension_.time_dependent_transits();
 
   for (int vehicle = 0; vehicle < model->vehicles(); vehicle++) {
     const std::function<int64_t(int64_t, int64_t)>& transit_accessor =
@@ -381,13 +384,28 @@ bool CumulBoundsPropagator::InitializeArcsAndBounds(
                   transition_info.post_travel_transit_value;
         ++index_on_route;
       }
+      int64_t max_transit = transit;
+      if (time_dependent_transits != nullptr) {
+        // Time-dependent travel times are bounded over the departure times
+        // allowed by the cumul bounds of node, which keeps arc offsets
+        // constant (and positive cycle detection valid).
+        const int profile = time_dependent_transits->ArcProfile(node, next);
+        const int64_t earliest_departure = CapAdd(cumul_lb, cumul_offset);
+        const int64_t latest_departure = CapAdd(cumul_ub, cumul_offset);
+        max_transit =
+            CapAdd(transit, time_dependent_transits->ProfileRangeMaxTransit(
+                                profile, earliest_departure, latest_departure));
+        transit = CapAdd(transit,
+                         time_dependent_transits->ProfileRangeMinTransit(
+                             profile, earliest_departure, latest_departure));
+      }
       const IntVar& slack_var = *dimension_.SlackVar(node);
       // node + transit + slack_var == next
       // Add arcs for node + transit + slack_min <= next
       AddArcs(node, next, CapAdd(transit, slack_var.Min()));
       if (slack_var.Max() < std::numeric_limits<int64_t>::max()) {
         // Add arcs for node + transit + slack_max >= next.
-        AddArcs(next, node, CapSub(-slack_var.Max(), transit));
+        AddArcs(next, node, CapSub(-slack_var.Max(), max_transit));
       }
 
       node = next;
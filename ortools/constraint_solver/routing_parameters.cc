@@ -80,6 +80,8 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization(  // NOLINT
       false);
   p.set_cheapest_insertion_add_unperformed_entries(false);
+  p.set_cheapest_insertion_first_solution_num_workers(1);
+  p.set_cheapest_insertion_first_solution_max_entries_per_node(0);
   p.set_local_cheapest_insertion_pickup_delivery_strategy(
       RoutingSearchParameters::BEST_PICKUP_THEN_BEST_DELIVERY);
   p.set_local_cheapest_cost_insertion_pickup_delivery_strategy(
@@ -157,6 +159,14 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_use_iterated_local_search(false);
   *p.mutable_iterated_local_search_parameters() =
       CreateDefaultIteratedLocalSearchParameters();
+  p.set_use_decomposition(false);
+  RoutingSearchParameters::DecompositionParameters* decomposition =
+      p.mutable_decomposition_parameters();
+  decomposition->set_clustering_method(
+      RoutingSearchParameters::DecompositionParameters::UNSET);
+  decomposition->set_max_nodes_per_subproblem(1000);
+  decomposition->set_num_workers(1);
+  decomposition->set_subproblem_time_limit_ratio(0.5);
 
   const std::string error = FindErrorInRoutingSearchParameters(p);
   LOG_IF(DFATAL, !error.empty())
@@ -311,6 +321,21 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
         StrCat("Invalid cheapest_insertion_first_solution_min_neighbors: ",
                min_neighbors, ". Must be greater or equal to 1."));
   }
+  if (const int32_t num_workers =
+          search_parameters.cheapest_insertion_first_solution_num_workers();
+      num_workers < 0) {
+    errors.emplace_back(
+        StrCat("Invalid cheapest_insertion_first_solution_num_workers: ",
+               num_workers, ". Must be non-negative."));
+  }
+  if (const int32_t max_entries =
+          search_parameters
+              .cheapest_insertion_first_solution_max_entries_per_node();
+      max_entries < 0) {
+    errors.emplace_back(StrCat(
+        "Invalid cheapest_insertion_first_solution_max_entries_per_node: ",
+        max_entries, ". Must be non-negative."));
+  }
   if (const double ratio =
           search_parameters.cheapest_insertion_ls_operator_neighbors_ratio();
       std::isnan(ratio) || ratio <= 0 || ratio > 1) {
@@ -475,6 +500,29 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
                exploration_coefficient));
   }
 
+  if (search_parameters.use_decomposition()) {
+    const RoutingSearchParameters::DecompositionParameters& decomposition =
+        search_parameters.decomposition_parameters();
+    if (decomposition.max_nodes_per_subproblem() <= 0) {
+      errors.emplace_back(
+          StrCat("Invalid value for "
+                 "decomposition_parameters.max_nodes_per_subproblem: ",
+                 decomposition.max_nodes_per_subproblem()));
+    }
+    if (decomposition.num_workers() <= 0) {
+      errors.emplace_back(
+          StrCat("Invalid value for decomposition_parameters.num_workers: ",
+                 decomposition.num_workers()));
+    }
+    if (const double ratio = decomposition.subproblem_time_limit_ratio();
+        std::isnan(ratio) || ratio <= 0 || ratio > 1) {
+      errors.emplace_back(
+          StrCat("Invalid value for "
+                 "decomposition_parameters.subproblem_time_limit_ratio: ",
+                 ratio));
+    }
+  }
+
   if (const sat::SatParameters& sat_parameters =
           search_parameters.sat_parameters();
       sat_parameters.enumerate_all_solutions() &&
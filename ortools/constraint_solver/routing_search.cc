@@ -47,6 +47,7 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/map_util.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -681,11 +682,12 @@ void CheapestInsertionFilteredHeuristic::AppendInsertionPositionsAfter(
 
 int64_t CheapestInsertionFilteredHeuristic::GetInsertionCostForNodeAtPosition(
     int64_t node_to_insert, int64_t insert_after, int64_t insert_before,
-    int vehicle) const {
-  DCHECK(evaluator_ != nullptr);
-  return CapSub(CapAdd(evaluator_(insert_after, node_to_insert, vehicle),
-                       evaluator_(node_to_insert, insert_before, vehicle)),
-                evaluator_(insert_after, insert_before, vehicle));
+    int vehicle,
+    const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator) const {
+  DCHECK(evaluator != nullptr);
+  return CapSub(CapAdd(evaluator(insert_after, node_to_insert, vehicle),
+                       evaluator(node_to_insert, insert_before, vehicle)),
+                evaluator(insert_after, insert_before, vehicle));
 }
 
 int64_t CheapestInsertionFilteredHeuristic::GetUnperformedValue(
@@ -1980,29 +1982,89 @@ bool GlobalCheapestInsertionFilteredHeuristic::InitializePositions(
       vehicles.empty() ? model()->vehicles() : vehicles.size();
   const bool all_vehicles = (num_vehicles == model()->vehicles());
 
+  std::vector<int> nodes_to_initialize;
   for (int node = 0; node < nodes.size(); node++) {
-    if (!nodes[node] || Contains(node)) {
-      continue;
-    }
-    if (StopSearch()) return false;
+    if (nodes[node] && !Contains(node)) nodes_to_initialize.push_back(node);
+  }
+  const auto add_entries = [this, all_vehicles, queue](
+                               int node,
+                               const std::vector<NodeInsertion>& entries) {
     // Add insertion entry making node unperformed.
     if (gci_params_.add_unperformed_entries &&
         GetUnperformedValue(node) != std::numeric_limits<int64_t>::max()) {
       AddNodeEntry(node, node, -1, all_vehicles, queue);
     }
     // Add all insertion entries making node performed.
-    InitializeInsertionEntriesPerformingNode(node, vehicles, queue);
+    const int64_t bucket = GetBucketOfNode(node);
+    for (const NodeInsertion& entry : entries) {
+      queue->PushInsertion(node, entry.insert_after, entry.vehicle, bucket,
+                           entry.value);
+    }
+  };
+
+  const int num_workers = std::min<int>(gci_params_.num_initialization_workers,
+                                        nodes_to_initialize.size());
+  if (num_workers <= 1) {
+    std::vector<NodeInsertion> entries;
+    for (const int node : nodes_to_initialize) {
+      if (StopSearch()) return false;
+      entries.clear();
+      AppendInsertionEntriesPerformingNode(node, vehicles, evaluator_,
+                                           &entries);
+      add_entries(node, entries);
+    }
+    return true;
+  }
+
+  // Entries of each node are computed by the workers, each on a slice of the
+  // nodes, and are then added to the queue sequentially, in node order, which
+  // leads to the same queue as the sequential initialization. Search limits
+  // are not thread-safe and are only checked once the workers are done.
+  const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator =
+      gci_params_.initialization_evaluator != nullptr
+          ? gci_params_.initialization_evaluator
+          : evaluator_;
+  std::vector<std::vector<NodeInsertion>> entries_per_node(
+      nodes_to_initialize.size());
+  {
+    ThreadPool pool("GlobalCheapestInsertion", num_workers);
+    pool.StartWorkers();
+    for (int worker = 0; worker < num_workers; ++worker) {
+      pool.Schedule([this, worker, num_workers, &nodes_to_initialize,
+                     &vehicles, &evaluator, &entries_per_node]() {
+        for (int i = worker; i < nodes_to_initialize.size();
+             i += num_workers) {
+          AppendInsertionEntriesPerformingNode(nodes_to_initialize[i],
+                                               vehicles, evaluator,
+                                               &entries_per_node[i]);
+        }
+      });
+    }
+  }
+  if (StopSearch()) return false;
+  for (int i = 0; i < nodes_to_initialize.size(); ++i) {
+    add_entries(nodes_to_initialize[i], entries_per_node[i]);
+    // Release memory as soon as entries are in the queue.
+    std::vector<NodeInsertion>().swap(entries_per_node[i]);
   }
   return true;
 }
 
 void GlobalCheapestInsertionFilteredHeuristic::
-    InitializeInsertionEntriesPerformingNode(
+    AppendInsertionEntriesPerformingNode(
         int64_t node, const absl::flat_hash_set<int>& vehicles,
-        NodeEntryQueue* queue) {
+        const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator,
+        std::vector<NodeInsertion>* entries) {
   const int num_vehicles =
       vehicles.empty() ? model()->vehicles() : vehicles.size();
   const bool all_vehicles = (num_vehicles == model()->vehicles());
+  const int num_initial_entries = entries->size();
+  const auto append_entry = [this, node, all_vehicles, &evaluator, entries](
+                                int64_t insert_after, int vehicle) {
+    const std::optional<int64_t> value = GetNodeEntryValue(
+        node, insert_after, vehicle, all_vehicles, evaluator);
+    if (value.has_value()) entries->push_back({insert_after, vehicle, *value});
+  };
 
   if (!gci_params_.use_neighbors_ratio_for_initialization) {
     auto vehicles_it = vehicles.begin();
@@ -2022,37 +2084,44 @@ void GlobalCheapestInsertionFilteredHeuristic::
                                     /*ignore_cost=*/true, &insertions);
       for (const NodeInsertion& insertion : insertions) {
         DCHECK_EQ(insertion.vehicle, vehicle);
-        AddNodeEntry(node, insertion.insert_after, vehicle, all_vehicles,
-                     queue);
+        append_entry(insertion.insert_after, vehicle);
       }
     }
-    return;
-  }
-
-  // We're only considering the closest neighbors as insertion positions for
-  // the node.
-  const auto insert_on_vehicle_for_cost_class = [this, &vehicles, all_vehicles](
-                                                    int v, int cost_class) {
-    return (model()->GetCostClassIndexOfVehicle(v).value() == cost_class) &&
-           (all_vehicles || vehicles.contains(v));
-  };
-  for (int cost_class = 0; cost_class < model()->GetCostClassesCount();
-       cost_class++) {
-    for (const int64_t insert_after :
-         node_index_to_neighbors_by_cost_class_->GetNeighborsOfNodeForCostClass(
-             cost_class, node)) {
-      if (!Contains(insert_after)) {
-        continue;
-      }
-      const int vehicle = node_index_to_vehicle_[insert_after];
-      if (vehicle == -1 ||
-          !insert_on_vehicle_for_cost_class(vehicle, cost_class)) {
-        continue;
+  } else {
+    // We're only considering the closest neighbors as insertion positions for
+    // the node.
+    const auto insert_on_vehicle_for_cost_class =
+        [this, &vehicles, all_vehicles](int v, int cost_class) {
+          return (model()->GetCostClassIndexOfVehicle(v).value() ==
+                  cost_class) &&
+                 (all_vehicles || vehicles.contains(v));
+        };
+    for (int cost_class = 0; cost_class < model()->GetCostClassesCount();
+         cost_class++) {
+      for (const int64_t insert_after :
+           node_index_to_neighbors_by_cost_class_
+               ->GetNeighborsOfNodeForCostClass(cost_class, node)) {
+        if (!Contains(insert_after)) {
+          continue;
+        }
+        const int vehicle = node_index_to_vehicle_[insert_after];
+        if (vehicle == -1 ||
+            !insert_on_vehicle_for_cost_class(vehicle, cost_class)) {
+          continue;
+        }
+        if (all_vehicles && !IsCheapestClassRepresentative(vehicle)) continue;
+        append_entry(insert_after, vehicle);
       }
-      if (all_vehicles && !IsCheapestClassRepresentative(vehicle)) continue;
-      AddNodeEntry(node, insert_after, vehicle, all_vehicles, queue);
     }
   }
+
+  // Only keep the cheapest entries of the node.
+  const int max_entries = gci_params_.max_entries_per_node;
+  if (max_entries > 0 && entries->size() > num_initial_entries + max_entries) {
+    const auto first = entries->begin() + num_initial_entries;
+    std::nth_element(first, first + max_entries, entries->end());
+    entries->resize(num_initial_entries + max_entries);
+  }
 }
 
 bool GlobalCheapestInsertionFilteredHeuristic::UpdateAfterNodeInsertion(
@@ -2106,6 +2175,17 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
 void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
     int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
     NodeEntryQueue* queue) const {
+  const std::optional<int64_t> value =
+      GetNodeEntryValue(node, insert_after, vehicle, all_vehicles, evaluator_);
+  if (!value.has_value()) return;
+  queue->PushInsertion(node, insert_after, vehicle, GetBucketOfNode(node),
+                       *value);
+}
+
+std::optional<int64_t>
+GlobalCheapestInsertionFilteredHeuristic::GetNodeEntryValue(
+    int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
+    const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator) const {
   const int64_t node_penalty = GetUnperformedValue(node);
   const int64_t penalty_shift =
       absl::GetFlag(FLAGS_routing_shift_insertion_cost_by_penalty)
@@ -2113,7 +2193,7 @@ void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
           : 0;
   const IntVar* const vehicle_var = model()->VehicleVar(node);
   if (!vehicle_var->Contains(vehicle)) {
-    if (vehicle == -1 || !VehicleIsEmpty(vehicle)) return;
+    if (vehicle == -1 || !VehicleIsEmpty(vehicle)) return std::nullopt;
     // We need to check there is not an equivalent empty vehicle the node
     // could fit on.
     const auto vehicle_is_compatible = [vehicle_var](int vehicle) {
@@ -2122,34 +2202,29 @@ void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
     if (!empty_vehicle_type_curator_->HasCompatibleVehicleOfType(
             empty_vehicle_type_curator_->Type(vehicle),
             vehicle_is_compatible)) {
-      return;
+      return std::nullopt;
     }
   }
-  const int num_allowed_vehicles = vehicle_var->Size();
   if (vehicle == -1) {
     DCHECK_EQ(node, insert_after);
     if (!all_vehicles) {
       // NOTE: In the case where we're not considering all routes
       // simultaneously, we don't add insertion entries making nodes
       // unperformed.
-      return;
+      return std::nullopt;
     }
-    queue->PushInsertion(node, node, -1, num_allowed_vehicles,
-                         CapSub(node_penalty, penalty_shift));
-    return;
+    return CapSub(node_penalty, penalty_shift);
   }
 
   const int64_t insertion_cost = GetInsertionCostForNodeAtPosition(
-      node, insert_after, Value(insert_after), vehicle);
+      node, insert_after, Value(insert_after), vehicle, evaluator);
   if (!all_vehicles && insertion_cost > node_penalty) {
     // NOTE: When all vehicles aren't considered for insertion, we don't
     // add entries making nodes unperformed, so we don't add insertions
     // which cost more than the node penalty either.
-    return;
+    return std::nullopt;
   }
-
-  queue->PushInsertion(node, insert_after, vehicle, num_allowed_vehicles,
-                       CapSub(insertion_cost, penalty_shift));
+  return CapSub(insertion_cost, penalty_shift);
 }
 
 void InsertionSequenceGenerator::AppendPickupDeliveryMultitourInsertions(
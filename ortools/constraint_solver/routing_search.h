@@ -421,7 +421,15 @@ class CheapestInsertionFilteredHeuristic : public RoutingFilteredHeuristic {
   int64_t GetInsertionCostForNodeAtPosition(int64_t node_to_insert,
                                             int64_t insert_after,
                                             int64_t insert_before,
-                                            int vehicle) const;
+                                            int vehicle) const {
+    return GetInsertionCostForNodeAtPosition(
+        node_to_insert, insert_after, insert_before, vehicle, evaluator_);
+  }
+  /// Same as above, with the costs of the arcs given by 'evaluator'.
+  int64_t GetInsertionCostForNodeAtPosition(
+      int64_t node_to_insert, int64_t insert_after, int64_t insert_before,
+      int vehicle,
+      const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator) const;
   /// Returns the cost of unperforming node 'node_to_insert'. Returns kint64max
   /// if penalty callback is null or if the node cannot be unperformed.
   int64_t GetUnperformedValue(int64_t node_to_insert) const;
@@ -462,6 +470,17 @@ class GlobalCheapestInsertionFilteredHeuristic
     /// the node/pair will be made unperformed. If false, only entries making
     /// a node/pair performed are considered.
     bool add_unperformed_entries;
+    /// Number of threads used to compute the initial insertion entries of the
+    /// nodes. When greater than 1, the penalty evaluator and
+    /// 'initialization_evaluator' must be thread-safe.
+    int num_initialization_workers = 1;
+    /// Evaluator used instead of the evaluator of the heuristic by the threads
+    /// computing the initial insertion entries; it must return the same values.
+    /// If null, the evaluator of the heuristic is used.
+    std::function<int64_t(int64_t, int64_t, int64_t)> initialization_evaluator;
+    /// If positive, only the 'max_entries_per_node' cheapest initial entries
+    /// performing each node are added to the priority queue.
+    int max_entries_per_node = 0;
   };
 
   /// Takes ownership of evaluators.
@@ -774,14 +793,19 @@ class GlobalCheapestInsertionFilteredHeuristic
   bool InitializePositions(const std::vector<bool>& nodes,
                            const absl::flat_hash_set<int>& vehicles,
                            NodeEntryQueue* queue);
-  /// Adds insertion entries performing 'node', and updates 'queue' and
-  /// position_to_node_entries accordingly.
+  /// Appends to 'entries' the insertion entries performing 'node', with the
+  /// values they have in the priority queue.
   /// Based on gci_params_.use_neighbors_ratio_for_initialization, either all
   /// contained nodes are considered as insertion positions, or only the
-  /// closest neighbors of 'node'.
-  void InitializeInsertionEntriesPerformingNode(
+  /// closest neighbors of 'node'. If gci_params_.max_entries_per_node is
+  /// positive, only the cheapest entries are kept.
+  /// Insertion costs are computed with 'evaluator'.
+  /// Only reads the current solution, and can therefore be called concurrently
+  /// for different nodes if 'evaluator' is thread-safe.
+  void AppendInsertionEntriesPerformingNode(
       int64_t node, const absl::flat_hash_set<int>& vehicles,
-      NodeEntryQueue* queue);
+      const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator,
+      std::vector<NodeInsertion>* entries);
   /// Performs all the necessary updates after 'node' was successfully inserted
   /// on the 'vehicle' after 'insert_after'.
   bool UpdateAfterNodeInsertion(const std::vector<bool>& nodes, int vehicle,
@@ -806,6 +830,14 @@ class GlobalCheapestInsertionFilteredHeuristic
   /// 'node_entries'.
   void AddNodeEntry(int64_t node, int64_t insert_after, int vehicle,
                     bool all_vehicles, NodeEntryQueue* queue) const;
+  /// Returns the value of the NodeEntry corresponding to the insertion of
+  /// 'node' after 'insert_after' on 'vehicle', or nullopt if no such entry
+  /// must be added to the priority queue. The insertion cost is computed with
+  /// 'evaluator'.
+  std::optional<int64_t> GetNodeEntryValue(
+      int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
+      const std::function<int64_t(int64_t, int64_t, int64_t)>& evaluator)
+      const;
 
   void ResetVehicleIndices() override {
     node_index_to_vehicle_.assign(node_index_to_vehicle_.size(), -1);
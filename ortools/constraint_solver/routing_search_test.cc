@@ -0,0 +1,206 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_search.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_enums.pb.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+
+namespace operations_research {
+namespace {
+
+using NodeIndex = RoutingIndexManager::NodeIndex;
+
+// Capacitated problem with random customers and three depots, each the start
+// and end of two vehicles of different capacities, so that vehicles belong to
+// several classes and nodes have several initial insertion entries.
+class GlobalCheapestInsertionTest : public ::testing::Test {
+ protected:
+  static constexpr int kNumDepots = 3;
+  static constexpr int kNumVehicles = 2 * kNumDepots;
+  static constexpr int kNumCustomers = 60;
+
+  GlobalCheapestInsertionTest()
+      : manager_(kNumDepots + kNumCustomers, kNumVehicles, VehicleDepots(),
+                 VehicleDepots()) {
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int64_t> coordinate(0, 1000);
+    for (int node = 0; node < kNumDepots + kNumCustomers; ++node) {
+      points_.push_back({coordinate(random), coordinate(random)});
+    }
+  }
+
+  static std::vector<NodeIndex> VehicleDepots() {
+    std::vector<NodeIndex> depots;
+    for (int vehicle = 0; vehicle < kNumVehicles; ++vehicle) {
+      depots.push_back(NodeIndex(vehicle / 2));
+    }
+    return depots;
+  }
+
+  std::unique_ptr<RoutingModel> BuildModel() const {
+    auto model = std::make_unique<RoutingModel>(manager_);
+    const int distance = model->RegisterTransitCallback(
+        [this](int64_t from, int64_t to) {
+          const auto [from_x, from_y] =
+              points_[manager_.IndexToNode(from).value()];
+          const auto [to_x, to_y] = points_[manager_.IndexToNode(to).value()];
+          return static_cast<int64_t>(
+              std::round(std::hypot(from_x - to_x, from_y - to_y)));
+        });
+    model->SetArcCostEvaluatorOfAllVehicles(distance);
+    const int demand =
+        model->RegisterUnaryTransitCallback([this](int64_t index) -> int64_t {
+          return manager_.IndexToNode(index).value() >= kNumDepots;
+        });
+    std::vector<int64_t> capacities;
+    for (int vehicle = 0; vehicle < kNumVehicles; ++vehicle) {
+      capacities.push_back(vehicle % 2 == 0 ? 8 : 14);
+    }
+    model->AddDimensionWithVehicleCapacity(
+        demand, 0, capacities, /*fix_start_cumul_to_zero=*/true, "Load");
+    return model;
+  }
+
+  // Returns the first solution found by parallel cheapest insertion with
+  // 'num_workers' threads computing the initial entries, as the routes of the
+  // vehicles, and checks that all customers are performed.
+  std::vector<std::vector<int64_t>> FirstSolutionRoutes(
+      int num_workers, int max_entries_per_node,
+      bool use_neighbors_ratio_for_initialization) const {
+    std::unique_ptr<RoutingModel> model = BuildModel();
+    RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+    parameters.set_first_solution_strategy(
+        FirstSolutionStrategy::PARALLEL_CHEAPEST_INSERTION);
+    parameters.set_solution_limit(1);
+    parameters.set_cheapest_insertion_first_solution_num_workers(num_workers);
+    parameters.set_cheapest_insertion_first_solution_max_entries_per_node(
+        max_entries_per_node);
+    if (use_neighbors_ratio_for_initialization) {
+      parameters.set_cheapest_insertion_first_solution_neighbors_ratio(0.2);
+      parameters
+          .set_cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization(  // NOLINT
+              true);
+    }
+    const Assignment* const solution = model->SolveWithParameters(parameters);
+    EXPECT_NE(solution, nullptr);
+    if (solution == nullptr) return {};
+    std::vector<std::vector<int64_t>> routes(kNumVehicles);
+    int num_visited_customers = 0;
+    for (int vehicle = 0; vehicle < kNumVehicles; ++vehicle) {
+      for (int64_t index = model->Start(vehicle); !model->IsEnd(index);
+           index = solution->Value(model->NextVar(index))) {
+        routes[vehicle].push_back(index);
+        if (!model->IsStart(index)) ++num_visited_customers;
+      }
+    }
+    EXPECT_EQ(num_visited_customers, kNumCustomers);
+    return routes;
+  }
+
+  RoutingIndexManager manager_;
+  std::vector<std::pair<int64_t, int64_t>> points_;
+};
+
+TEST_F(GlobalCheapestInsertionTest, ParallelInitializationIsDeterministic) {
+  for (const bool use_neighbors : {false, true}) {
+    SCOPED_TRACE(use_neighbors);
+    const std::vector<std::vector<int64_t>> routes =
+        FirstSolutionRoutes(/*num_workers=*/1, /*max_entries_per_node=*/0,
+                            use_neighbors);
+    for (const int num_workers : {2, 4, 7}) {
+      SCOPED_TRACE(num_workers);
+      EXPECT_EQ(FirstSolutionRoutes(num_workers, /*max_entries_per_node=*/0,
+                                    use_neighbors),
+                routes);
+    }
+  }
+}
+
+TEST_F(GlobalCheapestInsertionTest, MaxEntriesPerNode) {
+  for (const int max_entries_per_node : {1, 2, 5}) {
+    SCOPED_TRACE(max_entries_per_node);
+    const std::vector<std::vector<int64_t>> routes = FirstSolutionRoutes(
+        /*num_workers=*/1, max_entries_per_node,
+        /*use_neighbors_ratio_for_initialization=*/false);
+    EXPECT_EQ(FirstSolutionRoutes(/*num_workers=*/4, max_entries_per_node,
+                                  /*use_neighbors_ratio_for_initialization=*/
+                                  false),
+              routes);
+  }
+}
+
+// Two customers next to the depot of a vehicle which can only serve one of
+// them, and far from the depot of a vehicle which can serve both. The cheapest
+// initial entries of both customers are on the small vehicle; when they are the
+// only ones kept, the second customer has no insertion on the other vehicle
+// once the small one is full, and is left unperformed.
+TEST(GlobalCheapestInsertionMaxEntriesTest, OnlyCheapestEntriesAreQueued) {
+  const std::vector<NodeIndex> depots = {NodeIndex(0), NodeIndex(1)};
+  const std::vector<int64_t> positions = {0, 1000, 10, 20};
+  constexpr int64_t kPenalty = 1'000'000;
+  for (const int max_entries_per_node : {0, 1}) {
+    SCOPED_TRACE(max_entries_per_node);
+    RoutingIndexManager manager(4, 2, depots, depots);
+    RoutingModel model(manager);
+    const int distance = model.RegisterTransitCallback(
+        [&manager, &positions](int64_t from, int64_t to) {
+          return std::abs(positions[manager.IndexToNode(from).value()] -
+                          positions[manager.IndexToNode(to).value()]);
+        });
+    model.SetArcCostEvaluatorOfAllVehicles(distance);
+    const int demand = model.RegisterUnaryTransitCallback(
+        [&manager](int64_t index) -> int64_t {
+          return manager.IndexToNode(index).value() >= 2;
+        });
+    model.AddDimensionWithVehicleCapacity(demand, 0, {1, 2},
+                                          /*fix_start_cumul_to_zero=*/true,
+                                          "Load");
+    for (const NodeIndex node : {NodeIndex(2), NodeIndex(3)}) {
+      model.AddDisjunction({manager.NodeToIndex(node)}, kPenalty);
+    }
+    RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+    parameters.set_first_solution_strategy(
+        FirstSolutionStrategy::PARALLEL_CHEAPEST_INSERTION);
+    parameters.set_solution_limit(1);
+    parameters.set_cheapest_insertion_first_solution_max_entries_per_node(
+        max_entries_per_node);
+    const Assignment* const solution = model.SolveWithParameters(parameters);
+    ASSERT_NE(solution, nullptr);
+    int num_unperformed = 0;
+    for (const NodeIndex node : {NodeIndex(2), NodeIndex(3)}) {
+      const int64_t vehicle =
+          solution->Value(model.VehicleVar(manager.NodeToIndex(node)));
+      if (vehicle == -1) ++num_unperformed;
+    }
+    EXPECT_EQ(num_unperformed, max_entries_per_node == 0 ? 0 : 1);
+    EXPECT_EQ(solution->ObjectiveValue(),
+              max_entries_per_node == 0 ? 20 + 2 * 980 : 20 + kPenalty);
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
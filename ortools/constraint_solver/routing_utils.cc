@@ -14,13 +14,18 @@
 #include "ortools/constraint_solver/routing_utils.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <queue>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "ortools/base/mathutil.h"
+#include "ortools/util/range_query_function.h"
 #include "ortools/util/saturated_arithmetic.h"
 
 namespace operations_research {
@@ -117,6 +122,289 @@ void BinCapacities::ClearItems() {
   }
 }
 
+namespace {
+
+// Returns the first x in [lo, hi] for which 'pred' is true, or hi + 1 if
+// there is none; 'pred' must be false then true on [lo, hi].
+template <typename Predicate>
+int64_t FirstTrue(int64_t lo, int64_t hi, const Predicate& pred) {
+  while (lo <= hi) {
+    const int64_t mid =
+        lo + static_cast<int64_t>((static_cast<uint64_t>(hi) -
+                                   static_cast<uint64_t>(lo)) /
+                                  2);
+    if (pred(mid)) {
+      hi = mid - 1;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+// Returns the value at 'time' of the piecewise-linear function taking values
+// 'values' at 'times', rounded down; 'time' must be between the breakpoints
+// of 'segment' and 'segment + 1'.
+int64_t InterpolateOnSegment(absl::Span<const int64_t> times,
+                             absl::Span<const int64_t> values, int segment,
+                             int64_t time) {
+  DCHECK_LE(times[segment], time);
+  DCHECK_LE(time, times[segment + 1]);
+  return CapAdd(values[segment],
+                MathUtil::FloorOfRatio(
+                    CapProd(CapSub(values[segment + 1], values[segment]),
+                            CapSub(time, times[segment])),
+                    CapSub(times[segment + 1], times[segment])));
+}
+
+// Same as above, the function being constant before the first breakpoint and
+// after the last one.
+int64_t Interpolate(absl::Span<const int64_t> times,
+                    absl::Span<const int64_t> values, int64_t time) {
+  if (time <= times.front()) return values.front();
+  if (time >= times.back()) return values.back();
+  const int segment =
+      std::upper_bound(times.begin(), times.end(), time) - times.begin() - 1;
+  return InterpolateOnSegment(times, values, segment, time);
+}
+
+// Returns the last time of the piece of the piecewise-linear function defined
+// by 'times' containing 'time', capped to 'max_time'. The function is monotone
+// on pieces.
+int64_t PieceEnd(absl::Span<const int64_t> times, int64_t time,
+                 int64_t max_time) {
+  const auto next = std::upper_bound(times.begin(), times.end(), time);
+  return next == times.end() ? max_time : std::min(max_time, *next);
+}
+
+// Same as above, with the first time of the piece, capped to 'min_time'.
+int64_t PieceStart(absl::Span<const int64_t> times, int64_t time,
+                   int64_t min_time) {
+  const auto next = std::lower_bound(times.begin(), times.end(), time);
+  return next == times.begin() ? min_time : std::max(min_time, *(next - 1));
+}
+
+}  // namespace
+
+TimeDependentTransits::TimeDependentTransits(int num_indices)
+    : num_indices_(num_indices), arc_profiles_(num_indices) {}
+
+int TimeDependentTransits::AddBreakpointTable(
+    std::vector<int64_t> breakpoint_times) {
+  CHECK(!breakpoint_times.empty());
+  for (int i = 1; i < breakpoint_times.size(); ++i) {
+    CHECK_LT(breakpoint_times[i - 1], breakpoint_times[i]);
+  }
+  times_.insert(times_.end(), breakpoint_times.begin(), breakpoint_times.end());
+  table_starts_.push_back(times_.size());
+  return table_starts_.size() - 2;
+}
+
+int TimeDependentTransits::AddProfile(int table,
+                                      absl::Span<const int64_t> travel_times) {
+  CHECK_GE(table, 0);
+  CHECK_LT(table, table_starts_.size() - 1);
+  const int first_travel_time = travel_times_.size();
+  const int num_breakpoints = table_starts_[table + 1] - table_starts_[table];
+  CHECK_EQ(travel_times.size(), num_breakpoints);
+  travel_times_.insert(travel_times_.end(), travel_times.begin(),
+                       travel_times.end());
+  const int64_t* const times = times_.data() + table_starts_[table];
+  int64_t* const values = travel_times_.data() + first_travel_time;
+  // Making arrival times at breakpoints non-decreasing, which makes them
+  // non-decreasing between breakpoints too.
+  for (int i = num_breakpoints - 1; i >= 0; --i) {
+    CHECK_GE(values[i], 0);
+    if (i + 1 < num_breakpoints) {
+      values[i] = std::min(
+          values[i], CapSub(CapAdd(times[i + 1], values[i + 1]), times[i]));
+    }
+  }
+  const auto [min_value, max_value] =
+      std::minmax_element(values, values + num_breakpoints);
+  profiles_.push_back({table, first_travel_time, *min_value, *max_value});
+  return profiles_.size() - 1;
+}
+
+void TimeDependentTransits::SetArcProfile(int64_t from, int64_t to,
+                                          int profile) {
+  CHECK_GE(from, 0);
+  CHECK_LT(from, num_indices_);
+  CHECK_GE(to, 0);
+  CHECK_LT(to, num_indices_);
+  CHECK_GE(profile, kNoProfile);
+  CHECK_LT(profile, NumProfiles());
+  std::vector<OutgoingArc>& arcs = arc_profiles_[from];
+  const auto it = arcs.begin() + (FindOutgoingArc(arcs, to) - arcs.begin());
+  const bool has_profile = it != arcs.end() && it->to == to;
+  if (profile == kNoProfile) {
+    if (has_profile) arcs.erase(it);
+  } else if (has_profile) {
+    it->profile = profile;
+  } else {
+    arcs.insert(it, {static_cast<int>(to), profile});
+  }
+}
+
+std::pair<absl::Span<const int64_t>, absl::Span<const int64_t>>
+TimeDependentTransits::Breakpoints(int profile) const {
+  static constexpr int64_t kZero[] = {0};
+  if (profile == kNoProfile) return {kZero, kZero};
+  const Profile& p = profiles_[profile];
+  const int start = table_starts_[p.table];
+  const int size = table_starts_[p.table + 1] - start;
+  return {
+      absl::MakeConstSpan(times_).subspan(start, size),
+      absl::MakeConstSpan(travel_times_).subspan(p.first_travel_time, size)};
+}
+
+int64_t TimeDependentTransits::ProfileTransit(int profile,
+                                              int64_t departure_time) const {
+  if (profile == kNoProfile) return 0;
+  const auto [times, values] = Breakpoints(profile);
+  return Interpolate(times, values, departure_time);
+}
+
+int64_t TimeDependentTransits::ProfileRangeMinTransit(
+    int profile, int64_t earliest_departure, int64_t latest_departure) const {
+  if (earliest_departure > latest_departure) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  if (profile == kNoProfile) return 0;
+  const auto [times, values] = Breakpoints(profile);
+  // The minimum is reached at a breakpoint or at a bound of the range.
+  int64_t min_value = std::min(Interpolate(times, values, earliest_departure),
+                               Interpolate(times, values, latest_departure));
+  for (int i = std::upper_bound(times.begin(), times.end(),
+                                earliest_departure) -
+               times.begin();
+       i < times.size() && times[i] < latest_departure; ++i) {
+    min_value = std::min(min_value, values[i]);
+  }
+  return min_value;
+}
+
+int64_t TimeDependentTransits::ProfileRangeMaxTransit(
+    int profile, int64_t earliest_departure, int64_t latest_departure) const {
+  if (earliest_departure > latest_departure) {
+    return std::numeric_limits<int64_t>::min();
+  }
+  if (profile == kNoProfile) return 0;
+  const auto [times, values] = Breakpoints(profile);
+  int64_t max_value = std::max(Interpolate(times, values, earliest_departure),
+                               Interpolate(times, values, latest_departure));
+  for (int i = std::upper_bound(times.begin(), times.end(),
+                                earliest_departure) -
+               times.begin();
+       i < times.size() && times[i] < latest_departure; ++i) {
+    max_value = std::max(max_value, values[i]);
+  }
+  return max_value;
+}
+
+// Travel time function of a profile. Travel times are monotone on the pieces
+// between breakpoints, which makes it possible to search them by dichotomy.
+class TimeDependentTransits::ProfileTransitFunction
+    : public RangeIntToIntFunction {
+ public:
+  ProfileTransitFunction(const TimeDependentTransits* transits, int profile)
+      : transits_(transits), profile_(profile) {}
+  int64_t Query(int64_t argument) const override {
+    return transits_->ProfileTransit(profile_, argument);
+  }
+  int64_t RangeMin(int64_t from, int64_t to) const override {
+    return transits_->ProfileRangeMinTransit(profile_, from, to - 1);
+  }
+  int64_t RangeMax(int64_t from, int64_t to) const override {
+    return transits_->ProfileRangeMaxTransit(profile_, from, to - 1);
+  }
+  int64_t RangeFirstInsideInterval(int64_t range_begin, int64_t range_end,
+                                   int64_t interval_begin,
+                                   int64_t interval_end) const override {
+    const auto [times, values] = transits_->Breakpoints(profile_);
+    const auto value = [&times = times, &values = values](int64_t t) {
+      return Interpolate(times, values, t);
+    };
+    for (int64_t start = range_begin; start < range_end;) {
+      const int64_t end = PieceEnd(times, start, range_end - 1);
+      const int64_t first =
+          value(start) <= value(end)
+              ? FirstTrue(start, end,
+                          [&value, interval_begin](int64_t t) {
+                            return value(t) >= interval_begin;
+                          })
+              : FirstTrue(start, end, [&value, interval_end](int64_t t) {
+                  return value(t) < interval_end;
+                });
+      if (first <= end && interval_begin <= value(first) &&
+          value(first) < interval_end) {
+        return first;
+      }
+      start = end + 1;
+    }
+    return range_end;
+  }
+  int64_t RangeLastInsideInterval(int64_t range_begin, int64_t range_end,
+                                  int64_t interval_begin,
+                                  int64_t interval_end) const override {
+    const auto [times, values] = transits_->Breakpoints(profile_);
+    const auto value = [&times = times, &values = values](int64_t t) {
+      return Interpolate(times, values, t);
+    };
+    for (int64_t end = range_end - 1; end >= range_begin;) {
+      const int64_t start = PieceStart(times, end, range_begin);
+      const int64_t last =
+          value(start) <= value(end)
+              ? FirstTrue(start, end,
+                          [&value, interval_end](int64_t t) {
+                            return value(t) >= interval_end;
+                          }) -
+                    1
+              : FirstTrue(start, end,
+                          [&value, interval_begin](int64_t t) {
+                            return value(t) < interval_begin;
+                          }) -
+                    1;
+      if (last >= start && interval_begin <= value(last) &&
+          value(last) < interval_end) {
+        return last;
+      }
+      end = start - 1;
+    }
+    return range_begin - 1;
+  }
+
+ private:
+  const TimeDependentTransits* const transits_;
+  const int profile_;
+};
+
+// Arrival time function t + f(t) of a profile, which is non-decreasing.
+class TimeDependentTransits::ProfileArrivalFunction
+    : public RangeMinMaxIndexFunction {
+ public:
+  int64_t RangeMaxArgument(int64_t /*from*/, int64_t to) const override {
+    return to - 1;
+  }
+  int64_t RangeMinArgument(int64_t from, int64_t /*to*/) const override {
+    return from;
+  }
+};
+
+RangeIntToIntFunction* TimeDependentTransits::MakeTransitFunction(
+    int profile) const {
+  CHECK_GE(profile, kNoProfile);
+  CHECK_LT(profile, NumProfiles());
+  return new ProfileTransitFunction(this, profile);
+}
+
+RangeMinMaxIndexFunction* TimeDependentTransits::MakeArrivalFunction(
+    int profile) const {
+  CHECK_GE(profile, kNoProfile);
+  CHECK_LT(profile, NumProfiles());
+  return new ProfileArrivalFunction();
+}
+
 bool FindMostExpensiveArcsOnRoute(
     int num_arcs, int64_t start,
     const std::function<int64_t(int64_t)>& next_accessor,
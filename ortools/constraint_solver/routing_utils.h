@@ -14,11 +14,16 @@
 #ifndef OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_UTILS_H_
 #define OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_UTILS_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <utility>
 #include <vector>
 
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "ortools/util/range_query_function.h"
+
 namespace operations_research {
 
 // Tracks whether bins constrained by several nonnegative dimensions can contain
@@ -75,6 +80,132 @@ class BinCapacities {
   int64_t total_cost_;
 };
 
+// Stores time-dependent travel times of the arcs of a routing problem.
+//
+// The travel time of an arc is a piecewise-linear function of the time at
+// which the arc is left, defined by its values at the times of a breakpoint
+// table; it is constant before the first breakpoint and after the last one.
+// Breakpoint tables (typically the times at which traffic conditions change)
+// are shared by all the profiles using them, and travel time profiles (the
+// values of a function at the breakpoints of its table) are shared by all the
+// arcs using them. Arcs without a profile have a travel time of 0.
+//
+// Profiles are made FIFO-consistent when added: leaving an arc later never
+// makes one arrive earlier, i.e. t + travel_time(t) is non-decreasing. When the
+// travel times given do not have this property, the travel time at a
+// breakpoint is replaced by the duration of waiting for a later departure and
+// traveling, when this is faster.
+//
+// Arc profiles are stored per origin index, in arrays sorted by destination:
+// memory is linear in the number of indices and of arcs with a profile, and
+// looking up the profile of an arc is a binary search among the arcs with a
+// profile leaving the same index.
+class TimeDependentTransits {
+ public:
+  static constexpr int kNoProfile = -1;
+
+  // Arcs are between indices in [0, num_indices), typically the indices of a
+  // RoutingModel.
+  explicit TimeDependentTransits(int num_indices);
+
+  // Adds a table of strictly increasing breakpoint times, returns its index.
+  int AddBreakpointTable(std::vector<int64_t> breakpoint_times);
+  // Adds a profile with the given non-negative travel times at the breakpoints
+  // of 'table', returns its index.
+  int AddProfile(int table, absl::Span<const int64_t> travel_times);
+  // Sets the travel time profile of the arc from 'from' to 'to'.
+  void SetArcProfile(int64_t from, int64_t to, int profile);
+  // Returns the profile of the arc from 'from' to 'to', or kNoProfile.
+  int ArcProfile(int64_t from, int64_t to) const {
+    DCHECK_GE(from, 0);
+    DCHECK_LT(from, num_indices_);
+    DCHECK_GE(to, 0);
+    DCHECK_LT(to, num_indices_);
+    const std::vector<OutgoingArc>& arcs = arc_profiles_[from];
+    const auto it = FindOutgoingArc(arcs, to);
+    return it != arcs.end() && it->to == to ? it->profile : kNoProfile;
+  }
+  int NumProfiles() const { return profiles_.size(); }
+  int64_t num_indices() const { return num_indices_; }
+
+  // Returns the travel time on the arc from 'from' to 'to' when leaving at
+  // 'departure_time'.
+  int64_t Transit(int64_t from, int64_t to, int64_t departure_time) const {
+    return ProfileTransit(ArcProfile(from, to), departure_time);
+  }
+  // Returns the min and max travel times on an arc, over all departure times.
+  int64_t MinTransit(int64_t from, int64_t to) const {
+    return ProfileMinTransit(ArcProfile(from, to));
+  }
+  int64_t MaxTransit(int64_t from, int64_t to) const {
+    return ProfileMaxTransit(ArcProfile(from, to));
+  }
+
+  // Same as above, on profiles. All accept kNoProfile.
+  int64_t ProfileTransit(int profile, int64_t departure_time) const;
+  int64_t ProfileMinTransit(int profile) const {
+    return profile == kNoProfile ? 0 : profiles_[profile].min_travel_time;
+  }
+  int64_t ProfileMaxTransit(int profile) const {
+    return profile == kNoProfile ? 0 : profiles_[profile].max_travel_time;
+  }
+  // Returns the min and max travel times of a profile for departure times in
+  // [earliest_departure, latest_departure].
+  int64_t ProfileRangeMinTransit(int profile, int64_t earliest_departure,
+                                 int64_t latest_departure) const;
+  int64_t ProfileRangeMaxTransit(int profile, int64_t earliest_departure,
+                                 int64_t latest_departure) const;
+
+  // Returns the travel time of a profile and the arrival time t + f(t) as
+  // range query functions, which can be used to build state dependent
+  // transits (see RoutingModel::StateDependentTransit). The functions keep a
+  // pointer to this object, which must outlive them. Ownership is transferred
+  // to the caller.
+  RangeIntToIntFunction* MakeTransitFunction(int profile) const;
+  RangeMinMaxIndexFunction* MakeArrivalFunction(int profile) const;
+
+ private:
+  class ProfileTransitFunction;
+  class ProfileArrivalFunction;
+
+  struct OutgoingArc {
+    int to;
+    int profile;
+  };
+
+  // Returns the first arc of 'arcs' whose destination is not before 'to'.
+  static std::vector<OutgoingArc>::const_iterator FindOutgoingArc(
+      const std::vector<OutgoingArc>& arcs, int64_t to) {
+    return std::lower_bound(
+        arcs.begin(), arcs.end(), to,
+        [](const OutgoingArc& arc, int64_t to) { return arc.to < to; });
+  }
+
+  struct Profile {
+    int table;
+    // Travel times are stored in travel_times_[first_travel_time, ...).
+    int first_travel_time;
+    int64_t min_travel_time;
+    int64_t max_travel_time;
+  };
+
+  // Returns the breakpoint times and the travel times at these breakpoints of
+  // 'profile'. kNoProfile is represented by a single breakpoint at time 0.
+  std::pair<absl::Span<const int64_t>, absl::Span<const int64_t>> Breakpoints(
+      int profile) const;
+
+  // Breakpoint times of all tables; the times of table t are in
+  // times_[table_starts_[t], table_starts_[t + 1]).
+  std::vector<int64_t> times_;
+  std::vector<int> table_starts_ = {0};
+  std::vector<int64_t> travel_times_;
+  std::vector<Profile> profiles_;
+  const int64_t num_indices_;
+  // arc_profiles_[from] holds the arcs leaving 'from' which have a profile,
+  // sorted by destination.
+  std::vector<std::vector<OutgoingArc>> arc_profiles_;
+};
+
 // Returns false if the route starting with 'start' is empty. Otherwise sets
 // most_expensive_arc_starts_and_ranks and first_expensive_arc_indices according
 // to the most expensive chains on the route, and returns true.
@@ -0,0 +1,232 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_filters.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+
+namespace operations_research {
+namespace {
+
+using NodeIndex = RoutingIndexManager::NodeIndex;
+
+TEST(TimeDependentTransitsTest, ProfilesAreMadeFifoConsistent) {
+  TimeDependentTransits transits(2);
+  const int table = transits.AddBreakpointTable({0, 10, 20});
+  // Leaving at 0 arrives at 30, later than leaving at 10 (arrival at 15): the
+  // travel time at 0 must become 15 (waiting until 10).
+  const int profile = transits.AddProfile(table, {30, 5, 5});
+  transits.SetArcProfile(0, 1, profile);
+  EXPECT_EQ(transits.Transit(0, 1, 0), 15);
+  EXPECT_EQ(transits.Transit(0, 1, 10), 5);
+  EXPECT_EQ(transits.Transit(0, 1, 100), 5);
+  EXPECT_EQ(transits.MinTransit(0, 1), 5);
+  EXPECT_EQ(transits.MaxTransit(0, 1), 15);
+  int64_t previous_arrival = std::numeric_limits<int64_t>::min();
+  for (int64_t departure = -5; departure <= 30; ++departure) {
+    const int64_t arrival = departure + transits.Transit(0, 1, departure);
+    EXPECT_GE(arrival, previous_arrival) << "departure " << departure;
+    previous_arrival = arrival;
+  }
+}
+
+TEST(TimeDependentTransitsTest, ArcProfiles) {
+  TimeDependentTransits transits(3);
+  const int table = transits.AddBreakpointTable({0, 100});
+  const int profile = transits.AddProfile(table, {10, 20});
+  EXPECT_EQ(transits.NumProfiles(), 1);
+  EXPECT_EQ(transits.ArcProfile(1, 2), TimeDependentTransits::kNoProfile);
+  EXPECT_EQ(transits.Transit(1, 2, 50), 0);
+  transits.SetArcProfile(1, 2, profile);
+  EXPECT_EQ(transits.ArcProfile(1, 2), profile);
+  EXPECT_EQ(transits.ArcProfile(2, 1), TimeDependentTransits::kNoProfile);
+  EXPECT_EQ(transits.Transit(1, 2, 50), 15);
+  EXPECT_EQ(transits.ProfileRangeMinTransit(profile, 20, 60), 12);
+  EXPECT_EQ(transits.ProfileRangeMaxTransit(profile, 20, 60), 16);
+  EXPECT_EQ(transits.ProfileRangeMinTransit(profile, 60, 20),
+            std::numeric_limits<int64_t>::max());
+  transits.SetArcProfile(1, 2, TimeDependentTransits::kNoProfile);
+  EXPECT_EQ(transits.ArcProfile(1, 2), TimeDependentTransits::kNoProfile);
+}
+
+// Sets, overwrites and clears random arcs of a large graph, and checks lookups
+// against a map of the arcs set.
+TEST(TimeDependentTransitsTest, SparseArcProfiles) {
+  constexpr int kNumIndices = 10000;
+  TimeDependentTransits transits(kNumIndices);
+  const int table = transits.AddBreakpointTable({0, 100});
+  std::vector<int> profiles;
+  for (int p = 0; p < 3; ++p) {
+    profiles.push_back(transits.AddProfile(table, {10 + p, 20 + p}));
+  }
+  std::map<std::pair<int, int>, int> expected_profiles;
+  std::mt19937 random(12345);
+  // Arcs are drawn among a few origins, so that origins have many arcs.
+  std::uniform_int_distribution<int> from_distribution(0, 9);
+  std::uniform_int_distribution<int> to_distribution(0, kNumIndices - 1);
+  std::uniform_int_distribution<int> profile_distribution(-1, 2);
+  for (int step = 0; step < 5000; ++step) {
+    const int from = from_distribution(random) * 997;
+    const int to = to_distribution(random) % 200;
+    const int p = profile_distribution(random);
+    const int profile = p < 0 ? TimeDependentTransits::kNoProfile : profiles[p];
+    transits.SetArcProfile(from, to, profile);
+    if (profile == TimeDependentTransits::kNoProfile) {
+      expected_profiles.erase({from, to});
+    } else {
+      expected_profiles[{from, to}] = profile;
+    }
+  }
+  for (int from = 0; from < kNumIndices; from += 997) {
+    for (int to = 0; to < 201; ++to) {
+      const auto it = expected_profiles.find({from, to});
+      const int expected_profile = it == expected_profiles.end()
+                                       ? TimeDependentTransits::kNoProfile
+                                       : it->second;
+      EXPECT_EQ(transits.ArcProfile(from, to), expected_profile)
+          << from << " -> " << to;
+    }
+  }
+  EXPECT_EQ(transits.ArcProfile(kNumIndices - 1, kNumIndices - 1),
+            TimeDependentTransits::kNoProfile);
+}
+
+constexpr int kNumNodes = 5;
+constexpr int64_t kServiceTime = 3;
+
+// Sets the travel time profiles of a problem on kNumNodes nodes where the
+// vehicle starts and ends at node 0; arcs alternate between two profiles.
+void SetProfiles(TimeDependentTransits* transits) {
+  const int table = transits->AddBreakpointTable({0, 50, 100});
+  const int fast_then_slow = transits->AddProfile(table, {10, 30, 10});
+  const int slow_then_fast = transits->AddProfile(table, {20, 5, 20});
+  for (int64_t from = 0; from < transits->num_indices(); ++from) {
+    for (int64_t to = 0; to < transits->num_indices(); ++to) {
+      transits->SetArcProfile(
+          from, to, (from + to) % 2 == 0 ? fast_then_slow : slow_then_fast);
+    }
+  }
+}
+
+TEST(TimeDependentDimensionTest, CumulsFollowTravelTimes) {
+  RoutingIndexManager manager(kNumNodes, 1, NodeIndex(0));
+  RoutingModel model(manager);
+  TimeDependentTransits transits(manager.num_indices());
+  SetProfiles(&transits);
+  const int service_time = model.RegisterTransitCallback(
+      [](int64_t, int64_t) { return kServiceTime; });
+  model.SetArcCostEvaluatorOfAllVehicles(service_time);
+  ASSERT_TRUE(model.AddTimeDependentDimension(
+      service_time, &transits, /*slack_max=*/0, /*capacity=*/1000,
+      /*fix_start_cumul_to_zero=*/true, "Time"));
+  const RoutingDimension& time = model.GetDimensionOrDie("Time");
+
+  const Assignment* const solution =
+      model.SolveWithParameters(DefaultRoutingSearchParameters());
+  ASSERT_NE(solution, nullptr);
+  // Without slack, arrival times are entirely defined by departure times.
+  int64_t index = model.Start(0);
+  EXPECT_EQ(solution->Min(time.CumulVar(index)), 0);
+  int num_visits = 0;
+  while (!model.IsEnd(index)) {
+    const int64_t next = solution->Value(model.NextVar(index));
+    const int64_t departure = solution->Min(time.CumulVar(index));
+    EXPECT_EQ(solution->Min(time.CumulVar(next)),
+              departure + kServiceTime +
+                  transits.Transit(index, next, departure));
+    index = next;
+    ++num_visits;
+  }
+  EXPECT_EQ(num_visits, kNumNodes);
+}
+
+TEST(TimeDependentDimensionTest, FilterAgreesWithPropagation) {
+  RoutingIndexManager manager(kNumNodes, 1, NodeIndex(0));
+  RoutingModel model(manager);
+  TimeDependentTransits transits(manager.num_indices());
+  SetProfiles(&transits);
+  const int service_time = model.RegisterTransitCallback(
+      [](int64_t, int64_t) { return kServiceTime; });
+  model.SetArcCostEvaluatorOfAllVehicles(service_time);
+  ASSERT_TRUE(model.AddTimeDependentDimension(
+      service_time, &transits, /*slack_max=*/1000, /*capacity=*/1000,
+      /*fix_start_cumul_to_zero=*/true, "Time"));
+  const RoutingDimension& time = model.GetDimensionOrDie("Time");
+  const std::vector<std::pair<int64_t, int64_t>> time_windows = {
+      {0, 0}, {0, 30}, {20, 60}, {50, 90}, {0, 200}};
+  for (int node = 1; node < kNumNodes; ++node) {
+    time.CumulVar(manager.NodeToIndex(NodeIndex(node)))
+        ->SetRange(time_windows[node].first, time_windows[node].second);
+  }
+  model.CloseModelWithParameters(DefaultRoutingSearchParameters());
+
+  Solver* const solver = model.solver();
+  IntVarLocalSearchFilter* const filter = MakePathCumulFilter(
+      time, /*propagate_own_objective_value=*/false,
+      /*filter_objective_cost=*/false, /*can_use_lp=*/false);
+  // Synchronizes the filter on the solution where no node is visited.
+  Assignment empty_solution(solver);
+  for (int64_t index = 0; index < model.Size(); ++index) {
+    empty_solution.Add(model.NextVar(index))
+        ->SetValue(model.IsStart(index) ? model.End(0) : index);
+  }
+  filter->Synchronize(&empty_solution, nullptr);
+
+  std::vector<int64_t> route;
+  for (int node = 1; node < kNumNodes; ++node) {
+    route.push_back(manager.NodeToIndex(NodeIndex(node)));
+  }
+  std::sort(route.begin(), route.end());
+  int num_feasible = 0;
+  int num_infeasible = 0;
+  do {
+    Assignment delta(solver);
+    int64_t previous = model.Start(0);
+    for (const int64_t index : route) {
+      delta.Add(model.NextVar(previous))->SetValue(index);
+      previous = index;
+    }
+    delta.Add(model.NextVar(previous))->SetValue(model.End(0));
+    Assignment deltadelta(solver);
+    const bool filter_accepts =
+        filter->Accept(&delta, &deltadelta, std::numeric_limits<int64_t>::min(),
+                       std::numeric_limits<int64_t>::max());
+
+    Assignment solution(solver);
+    ASSERT_TRUE(model.RoutesToAssignment({route},
+                                         /*ignore_inactive_indices=*/false,
+                                         /*close_routes=*/true, &solution));
+    const bool feasible = model.CheckIfAssignmentIsFeasible(
+        solution, /*call_at_solution_monitors=*/false);
+    EXPECT_EQ(filter_accepts, feasible);
+    ++(feasible ? num_feasible : num_infeasible);
+  } while (std::next_permutation(route.begin(), route.end()));
+  EXPECT_GT(num_feasible, 0);
+  EXPECT_GT(num_infeasible, 0);
+}
+
+}  // namespace
+}  // namespace operations_research
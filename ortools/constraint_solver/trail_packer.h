@@ -0,0 +1,244 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Packers of the blocks of the trail of the solver, which stores the values
+// to restore when backtracking. This is internal to the solver, and exposed
+// for testing purposes only.
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_TRAIL_PACKER_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_TRAIL_PACKER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "absl/log/check.h"
+#include "absl/strings/string_view.h"
+#include "zconf.h"
+#include "zlib.h"
+
+namespace operations_research {
+
+// ----- addrval struct -----
+
+// This template class is used internally to implement reversibility.
+// It stores an address and the value that was at the address.
+template <class T>
+struct addrval {
+ public:
+  addrval() : address_(nullptr) {}
+  explicit addrval(T* adr) : address_(adr), old_value_(*adr) {}
+  addrval(T* adr, T old_value) : address_(adr), old_value_(old_value) {}
+  void restore() const { (*address_) = old_value_; }
+  T* address() const { return address_; }
+  const T& old_value() const { return old_value_; }
+
+ private:
+  T* address_;
+  T old_value_;
+};
+
+// ---------- Trail Packer ---------
+// Abstract class to pack trail blocks.
+
+template <class T>
+class TrailPacker {
+ public:
+  explicit TrailPacker(int block_size) : block_size_(block_size) {}
+
+  // This type is neither copyable nor movable.
+  TrailPacker(const TrailPacker&) = delete;
+  TrailPacker& operator=(const TrailPacker&) = delete;
+  virtual ~TrailPacker() {}
+  int block_size() const { return block_size_; }
+  int input_size() const { return block_size_ * sizeof(addrval<T>); }
+  virtual void Pack(const addrval<T>* block, std::string* packed_block) = 0;
+  virtual void Unpack(const std::string& packed_block, addrval<T>* block) = 0;
+
+ private:
+  const int block_size_;
+};
+
+template <class T>
+class NoCompressionTrailPacker : public TrailPacker<T> {
+ public:
+  explicit NoCompressionTrailPacker(int block_size)
+      : TrailPacker<T>(block_size) {}
+
+  // This type is neither copyable nor movable.
+  NoCompressionTrailPacker(const NoCompressionTrailPacker&) = delete;
+  NoCompressionTrailPacker& operator=(const NoCompressionTrailPacker&) = delete;
+  ~NoCompressionTrailPacker() override {}
+  void Pack(const addrval<T>* block, std::string* packed_block) override {
+    DCHECK(block != nullptr);
+    DCHECK(packed_block != nullptr);
+    absl::string_view block_str(reinterpret_cast<const char*>(block),
+                                this->input_size());
+    packed_block->assign(block_str.data(), block_str.size());
+  }
+  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+    DCHECK(block != nullptr);
+    memcpy(block, packed_block.c_str(), packed_block.size());
+  }
+};
+
+template <class T>
+class ZlibTrailPacker : public TrailPacker<T> {
+ public:
+  explicit ZlibTrailPacker(int block_size)
+      : TrailPacker<T>(block_size),
+        tmp_size_(compressBound(this->input_size())),
+        tmp_block_(new char[tmp_size_]) {}
+
+  // This type is neither copyable nor movable.
+  ZlibTrailPacker(const ZlibTrailPacker&) = delete;
+  ZlibTrailPacker& operator=(const ZlibTrailPacker&) = delete;
+
+  ~ZlibTrailPacker() override {}
+
+  void Pack(const addrval<T>* block, std::string* packed_block) override {
+    DCHECK(block != nullptr);
+    DCHECK(packed_block != nullptr);
+    uLongf size = tmp_size_;
+    const int result =
+        compress(reinterpret_cast<Bytef*>(tmp_block_.get()), &size,
+                 reinterpret_cast<const Bytef*>(block), this->input_size());
+    CHECK_EQ(Z_OK, result);
+    absl::string_view block_str;
+    block_str = absl::string_view(tmp_block_.get(), size);
+    packed_block->assign(block_str.data(), block_str.size());
+  }
+
+  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+    DCHECK(block != nullptr);
+    uLongf size = this->input_size();
+    const int result =
+        uncompress(reinterpret_cast<Bytef*>(block), &size,
+                   reinterpret_cast<const Bytef*>(packed_block.c_str()),
+                   packed_block.size());
+    CHECK_EQ(Z_OK, result);
+  }
+
+ private:
+  const uint64_t tmp_size_;
+  std::unique_ptr<char[]> tmp_block_;
+};
+
+// Packs trail blocks by encoding the address of each entry as the difference
+// with the address of the previous entry, and its value as the difference with
+// the previous value, both as zigzag varints. Consecutive entries of a block
+// usually save nearby addresses and close values, which then take a few bytes
+// each; packing is much faster than general-purpose compression.
+template <class T>
+class VarintTrailPacker : public TrailPacker<T> {
+ public:
+  explicit VarintTrailPacker(int block_size)
+      : TrailPacker<T>(block_size),
+        tmp_block_(new char[block_size * 2 * kMaxVarintSize]) {}
+
+  // This type is neither copyable nor movable.
+  VarintTrailPacker(const VarintTrailPacker&) = delete;
+  VarintTrailPacker& operator=(const VarintTrailPacker&) = delete;
+
+  ~VarintTrailPacker() override {}
+
+  void Pack(const addrval<T>* block, std::string* packed_block) override {
+    DCHECK(block != nullptr);
+    DCHECK(packed_block != nullptr);
+    char* out = tmp_block_.get();
+    uint64_t previous_address = 0;
+    uint64_t previous_value = 0;
+    for (int i = 0; i < this->block_size(); ++i) {
+      const uint64_t address = reinterpret_cast<uintptr_t>(block[i].address());
+      const uint64_t value = ValueToBits(block[i].old_value());
+      out = EncodeVarint(ZigZagEncode(address - previous_address), out);
+      out = EncodeVarint(ZigZagEncode(value - previous_value), out);
+      previous_address = address;
+      previous_value = value;
+    }
+    packed_block->assign(tmp_block_.get(), out - tmp_block_.get());
+  }
+
+  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+    DCHECK(block != nullptr);
+    const char* in = packed_block.data();
+    uint64_t address = 0;
+    uint64_t value = 0;
+    for (int i = 0; i < this->block_size(); ++i) {
+      uint64_t delta = 0;
+      in = DecodeVarint(in, &delta);
+      address += ZigZagDecode(delta);
+      in = DecodeVarint(in, &delta);
+      value += ZigZagDecode(delta);
+      block[i] = addrval<T>(reinterpret_cast<T*>(address), BitsToValue(value));
+    }
+    DCHECK_EQ(in, packed_block.data() + packed_block.size());
+  }
+
+ private:
+  static constexpr int kMaxVarintSize = 10;
+
+  // Integral values are sign-extended, so that small negative values also
+  // lead to small differences.
+  static uint64_t ValueToBits(const T& value) {
+    if constexpr (std::is_integral_v<T>) {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+      static_assert(sizeof(T) <= sizeof(uint64_t));
+      uint64_t bits = 0;
+      memcpy(&bits, &value, sizeof(T));
+      return bits;
+    }
+  }
+  static T BitsToValue(uint64_t bits) {
+    if constexpr (std::is_integral_v<T>) {
+      return static_cast<T>(static_cast<int64_t>(bits));
+    } else {
+      T value;
+      memcpy(&value, &bits, sizeof(T));
+      return value;
+    }
+  }
+  static uint64_t ZigZagEncode(uint64_t delta) {
+    return static_cast<int64_t>(delta) < 0 ? ~(delta << 1) : delta << 1;
+  }
+  static uint64_t ZigZagDecode(uint64_t encoded) {
+    return (encoded & 1) ? ~(encoded >> 1) : encoded >> 1;
+  }
+  static char* EncodeVarint(uint64_t value, char* out) {
+    while (value >= 0x80) {
+      *out++ = static_cast<char>(value | 0x80);
+      value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+  }
+  static const char* DecodeVarint(const char* in, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0;; shift += 7) {
+      const uint8_t byte = static_cast<uint8_t>(*in++);
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (byte < 0x80) break;
+    }
+    *value = result;
+    return in;
+  }
+
+  std::unique_ptr<char[]> tmp_block_;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_TRAIL_PACKER_H_
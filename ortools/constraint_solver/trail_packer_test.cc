@@ -0,0 +1,217 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/trail_packer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/solver_parameters.pb.h"
+
+namespace operations_research {
+namespace {
+
+constexpr int kBlockSize = 64;
+
+template <typename T>
+T* Address(uint64_t address) {
+  return reinterpret_cast<T*>(static_cast<uintptr_t>(address));
+}
+
+template <typename T>
+uint64_t Bits(const T& value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+template <typename T>
+T FromBits(uint64_t bits) {
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+// Packs and unpacks a full block with 'packer', and checks that addresses and
+// values are restored bit for bit. Returns the size of the packed block.
+template <typename T>
+int RoundTrip(TrailPacker<T>* packer, const std::vector<addrval<T>>& block) {
+  EXPECT_EQ(block.size(), packer->block_size());
+  std::string packed;
+  packer->Pack(block.data(), &packed);
+  std::vector<addrval<T>> unpacked(block.size());
+  packer->Unpack(packed, unpacked.data());
+  for (int i = 0; i < block.size(); ++i) {
+    EXPECT_EQ(unpacked[i].address(), block[i].address()) << i;
+    EXPECT_EQ(Bits(unpacked[i].old_value()), Bits(block[i].old_value())) << i;
+  }
+  return packed.size();
+}
+
+// Returns a full block made of 'values', in order and repeated as needed, at
+// addresses which increase, decrease, jump to the extremes of the address
+// space, and repeat.
+template <typename T>
+std::vector<addrval<T>> MakeBlock(const std::vector<T>& values) {
+  const std::vector<uint64_t> addresses = {
+      0x7fff0000,
+      0x7fff0008,
+      0x7fff0010,
+      0x7ffe0000,  // Decreasing.
+      0x7fff0010,  // Repeated.
+      0x1000,
+      std::numeric_limits<uintptr_t>::max() & ~uint64_t{7},
+      8,
+      0,
+      std::numeric_limits<uintptr_t>::max() / 2 + 1,
+      std::numeric_limits<uintptr_t>::max() / 2 - 7,
+  };
+  std::vector<addrval<T>> block;
+  for (int i = 0; i < kBlockSize; ++i) {
+    const uint64_t address =
+        i < addresses.size() ? addresses[i] : 0x10000 - 8 * i;
+    block.push_back(
+        addrval<T>(Address<T>(address), values[i % values.size()]));
+  }
+  return block;
+}
+
+TEST(VarintTrailPackerTest, Int) {
+  VarintTrailPacker<int> packer(kBlockSize);
+  RoundTrip<int>(&packer,
+                 MakeBlock<int>({0, 1, -1, std::numeric_limits<int>::min(),
+                                 std::numeric_limits<int>::max(), 42, -42,
+                                 1 << 20}));
+}
+
+TEST(VarintTrailPackerTest, Int64) {
+  constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+  VarintTrailPacker<int64_t> packer(kBlockSize);
+  RoundTrip<int64_t>(&packer, MakeBlock<int64_t>({kMin, kMax, kMin, 0, kMax,
+                                                  -1, 1, kMin + 1, kMax - 1}));
+}
+
+TEST(VarintTrailPackerTest, Uint64) {
+  constexpr uint64_t kMax = std::numeric_limits<uint64_t>::max();
+  VarintTrailPacker<uint64_t> packer(kBlockSize);
+  RoundTrip<uint64_t>(&packer, MakeBlock<uint64_t>({0, kMax, 1, kMax - 1,
+                                                    kMax / 2, kMax / 2 + 1,
+                                                    0x8000000000000000}));
+}
+
+TEST(VarintTrailPackerTest, Double) {
+  VarintTrailPacker<double> packer(kBlockSize);
+  RoundTrip<double>(
+      &packer,
+      MakeBlock<double>(
+          {0.0, -0.0, 1.5, -1.5, std::numeric_limits<double>::infinity(),
+           -std::numeric_limits<double>::infinity(),
+           std::numeric_limits<double>::max(),
+           std::numeric_limits<double>::denorm_min(),
+           std::numeric_limits<double>::quiet_NaN(),
+           std::numeric_limits<double>::signaling_NaN(),
+           // NaNs with a payload, and a negative one.
+           FromBits<double>(0x7ff0000000000001),
+           FromBits<double>(0x7ff8dead00beef00),
+           FromBits<double>(0xfff0000000000001),
+           FromBits<double>(0xffffffffffffffff)}));
+}
+
+TEST(VarintTrailPackerTest, Pointer) {
+  VarintTrailPacker<void*> packer(kBlockSize);
+  RoundTrip<void*>(
+      &packer,
+      MakeBlock<void*>(
+          {nullptr, Address<void>(0x7fff0000), Address<void>(0x10),
+           Address<void>(0x7ffe0000),
+           Address<void>(std::numeric_limits<uintptr_t>::max())}));
+}
+
+TEST(VarintTrailPackerTest, RandomBlocks) {
+  std::mt19937_64 random(1234);
+  VarintTrailPacker<int64_t> packer(kBlockSize);
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::vector<addrval<int64_t>> block;
+    for (int i = 0; i < kBlockSize; ++i) {
+      block.push_back(addrval<int64_t>(Address<int64_t>(random() & ~7),
+                                       static_cast<int64_t>(random())));
+    }
+    RoundTrip<int64_t>(&packer, block);
+  }
+}
+
+TEST(VarintTrailPackerTest, NearbyEntriesArePackedCompactly) {
+  std::vector<addrval<int64_t>> block;
+  for (int i = 0; i < kBlockSize; ++i) {
+    block.push_back(
+        addrval<int64_t>(Address<int64_t>(0x7fff0000 + 8 * (i % 4)), i - 10));
+  }
+  VarintTrailPacker<int64_t> varint_packer(kBlockSize);
+  NoCompressionTrailPacker<int64_t> no_compression_packer(kBlockSize);
+  EXPECT_EQ(RoundTrip<int64_t>(&no_compression_packer, block),
+            kBlockSize * sizeof(addrval<int64_t>));
+  // All differences but the first address take a single byte.
+  EXPECT_LE(RoundTrip<int64_t>(&varint_packer, block), 2 * kBlockSize + 8);
+}
+
+// Solutions of the n-queens problem, in the order they are found.
+std::vector<std::vector<int64_t>> QueensSolutions(
+    ConstraintSolverParameters::TrailCompression compression) {
+  ConstraintSolverParameters parameters = Solver::DefaultSolverParameters();
+  parameters.set_compress_trail(compression);
+  // Small blocks, so that many of them are packed and unpacked.
+  parameters.set_trail_block_size(4);
+  Solver solver("queens", parameters);
+  constexpr int kSize = 8;
+  std::vector<IntVar*> queens;
+  solver.MakeIntVarArray(kSize, 0, kSize - 1, "queen", &queens);
+  std::vector<IntVar*> diagonals;
+  std::vector<IntVar*> anti_diagonals;
+  for (int i = 0; i < kSize; ++i) {
+    diagonals.push_back(solver.MakeSum(queens[i], i)->Var());
+    anti_diagonals.push_back(solver.MakeSum(queens[i], -i)->Var());
+  }
+  solver.AddConstraint(solver.MakeAllDifferent(queens));
+  solver.AddConstraint(solver.MakeAllDifferent(diagonals));
+  solver.AddConstraint(solver.MakeAllDifferent(anti_diagonals));
+  solver.NewSearch(solver.MakePhase(queens, Solver::CHOOSE_MIN_SIZE_LOWEST_MIN,
+                                    Solver::ASSIGN_CENTER_VALUE));
+  std::vector<std::vector<int64_t>> solutions;
+  while (solver.NextSolution()) {
+    std::vector<int64_t> solution;
+    for (const IntVar* const queen : queens) solution.push_back(queen->Value());
+    solutions.push_back(solution);
+  }
+  solver.EndSearch();
+  return solutions;
+}
+
+TEST(VarintTrailPackerTest, SearchMatchesNoCompression) {
+  const std::vector<std::vector<int64_t>> solutions =
+      QueensSolutions(ConstraintSolverParameters::NO_COMPRESSION);
+  EXPECT_EQ(solutions.size(), 92);
+  EXPECT_EQ(QueensSolutions(ConstraintSolverParameters::COMPRESS_WITH_VARINT),
+            solutions);
+  EXPECT_EQ(QueensSolutions(ConstraintSolverParameters::COMPRESS_WITH_ZLIB),
+            solutions);
+}
+
+}  // namespace
+}  // namespace operations_research
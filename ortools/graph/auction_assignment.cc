@@ -0,0 +1,236 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/auction_assignment.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/blocking_counter.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/graph/ebert_graph.h"
+#include "ortools/util/saturated_arithmetic.h"
+
+namespace operations_research {
+namespace {
+
+// Calls f(i) for all i in [0, size), distributing the indices among
+// num_threads threads of the pool by chunks, and returns once all the calls
+// are done.
+void ParallelFor(ThreadPool* pool, int num_threads, int size,
+                 const std::function<void(int)>& f) {
+  // Each call scans a full cost row, so chunks can be small.
+  constexpr int kChunkSize = 8;
+  const int num_tasks =
+      std::min(num_threads, (size + kChunkSize - 1) / kChunkSize);
+  if (num_tasks <= 1) {
+    for (int i = 0; i < size; ++i) f(i);
+    return;
+  }
+  std::atomic<int> next_chunk_start = 0;
+  absl::BlockingCounter counter(num_tasks);
+  for (int task = 0; task < num_tasks; ++task) {
+    pool->Schedule([size, &f, &next_chunk_start, &counter]() {
+      while (true) {
+        const int start = next_chunk_start.fetch_add(kChunkSize);
+        if (start >= size) break;
+        const int end = std::min(size, start + kChunkSize);
+        for (int i = start; i < end; ++i) f(i);
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+}
+
+}  // namespace
+
+AuctionAssignment::AuctionAssignment(NodeIndex num_left_nodes)
+    : num_left_nodes_(num_left_nodes),
+      cost_scaling_factor_(1 + static_cast<CostValue>(num_left_nodes)),
+      scaled_cost_(static_cast<int64_t>(num_left_nodes) * num_left_nodes, 0) {
+  DCHECK_GE(num_left_nodes, 0);
+}
+
+void AuctionAssignment::SetArcCost(NodeIndex left_node, NodeIndex right_node,
+                                   CostValue cost) {
+  largest_cost_magnitude_ = std::max(largest_cost_magnitude_, CapAbs(cost));
+  scaled_cost_[Index(left_node, right_node)] =
+      CapProd(cost, cost_scaling_factor_);
+}
+
+AuctionAssignment::Bid AuctionAssignment::ComputeBid(NodeIndex person) const {
+  const CostValue* const row = &scaled_cost_[Index(person, 0)];
+  const CostValue* const price = price_.data();
+  const NodeIndex n = num_left_nodes_;
+  // The scans below are plain min reductions over contiguous arrays, without
+  // any index tracking, so that compilers can vectorize them. The best object
+  // is found by a second scan which usually stops early.
+  CostValue best_value = std::numeric_limits<CostValue>::max();
+  for (NodeIndex object = 0; object < n; ++object) {
+    best_value = std::min(best_value, row[object] + price[object]);
+  }
+  NodeIndex best_object = 0;
+  while (row[best_object] + price[best_object] != best_value) ++best_object;
+  CostValue second_best_value = std::numeric_limits<CostValue>::max();
+  for (NodeIndex object = 0; object < best_object; ++object) {
+    second_best_value =
+        std::min(second_best_value, row[object] + price[object]);
+  }
+  for (NodeIndex object = best_object + 1; object < n; ++object) {
+    second_best_value =
+        std::min(second_best_value, row[object] + price[object]);
+  }
+  // With a single object, there is no competition for it.
+  if (n == 1) second_best_value = best_value;
+  return {best_object, second_best_value - row[best_object] + epsilon_};
+}
+
+void AuctionAssignment::GaussSeidelAuction() {
+  std::vector<NodeIndex> unassigned(num_left_nodes_);
+  std::iota(unassigned.rbegin(), unassigned.rend(), 0);
+  while (!unassigned.empty()) {
+    const NodeIndex person = unassigned.back();
+    unassigned.pop_back();
+    const Bid bid = ComputeBid(person);
+    ++num_bids_;
+    price_[bid.object] = bid.price;
+    const NodeIndex previous_owner = owner_[bid.object];
+    if (previous_owner != -1) {
+      mate_[previous_owner] = -1;
+      unassigned.push_back(previous_owner);
+    }
+    owner_[bid.object] = person;
+    mate_[person] = bid.object;
+  }
+}
+
+void AuctionAssignment::JacobiAuction(ThreadPool* pool) {
+  std::vector<NodeIndex> unassigned(num_left_nodes_);
+  std::iota(unassigned.begin(), unassigned.end(), 0);
+  std::vector<NodeIndex> next_unassigned;
+  std::vector<Bid> bids;
+  // The highest bid received by each object in the current round, if any.
+  std::vector<NodeIndex> best_bidder(num_left_nodes_, -1);
+  std::vector<CostValue> best_bid_price(num_left_nodes_);
+  std::vector<NodeIndex> objects_with_bids;
+  while (!unassigned.empty()) {
+    const int num_bidders = unassigned.size();
+    bids.resize(num_bidders);
+    ParallelFor(pool, num_threads_, num_bidders, [this, &unassigned,
+                                                  &bids](int i) {
+      bids[i] = ComputeBid(unassigned[i]);
+    });
+    num_bids_ += num_bidders;
+
+    objects_with_bids.clear();
+    for (int i = 0; i < num_bidders; ++i) {
+      const NodeIndex object = bids[i].object;
+      if (best_bidder[object] == -1) {
+        objects_with_bids.push_back(object);
+      } else if (bids[i].price <= best_bid_price[object]) {
+        continue;
+      }
+      best_bidder[object] = unassigned[i];
+      best_bid_price[object] = bids[i].price;
+    }
+    next_unassigned.clear();
+    for (int i = 0; i < num_bidders; ++i) {
+      if (best_bidder[bids[i].object] != unassigned[i]) {
+        next_unassigned.push_back(unassigned[i]);
+      }
+    }
+    for (const NodeIndex object : objects_with_bids) {
+      const NodeIndex person = best_bidder[object];
+      best_bidder[object] = -1;
+      price_[object] = best_bid_price[object];
+      const NodeIndex previous_owner = owner_[object];
+      if (previous_owner != -1) {
+        mate_[previous_owner] = -1;
+        next_unassigned.push_back(previous_owner);
+      }
+      owner_[object] = person;
+      mate_[person] = object;
+    }
+    unassigned.swap(next_unassigned);
+  }
+}
+
+bool AuctionAssignment::ComputeAssignment() {
+  success_ = false;
+  num_bids_ = 0;
+  const NodeIndex n = num_left_nodes_;
+  price_.assign(n, 0);
+  mate_.assign(n, -1);
+  owner_.assign(n, -1);
+  if (n == 0) {
+    success_ = true;
+    return true;
+  }
+
+  // Within a scaling phase, the price of an object only rises above the
+  // largest price at the start of the phase by at most the cost range plus
+  // epsilon, and prices are shifted to a minimum of zero after each phase.
+  // Prices thus stay below 4 times the cost range, and the values compared
+  // in ComputeBid() below 9 times the largest scaled cost magnitude.
+  constexpr CostValue kMaxMagnitude =
+      std::numeric_limits<CostValue>::max() / 16;
+  if (largest_cost_magnitude_ > kMaxMagnitude / cost_scaling_factor_) {
+    LOG(WARNING) << "Costs of magnitude up to " << largest_cost_magnitude_
+                 << " may overflow with " << n << " left nodes.";
+    return false;
+  }
+  const auto [min_cost, max_cost] =
+      std::minmax_element(scaled_cost_.begin(), scaled_cost_.end());
+  const CostValue cost_range = *max_cost - *min_cost;
+
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads_ > 1) {
+    pool = std::make_unique<ThreadPool>("AuctionAssignment", num_threads_);
+    pool->StartWorkers();
+  }
+  epsilon_ = std::max<CostValue>(cost_range, 1);
+  do {
+    epsilon_ = std::max<CostValue>(epsilon_ / alpha_, 1);
+    std::fill(mate_.begin(), mate_.end(), -1);
+    std::fill(owner_.begin(), owner_.end(), -1);
+    if (pool == nullptr) {
+      GaussSeidelAuction();
+    } else {
+      JacobiAuction(pool.get());
+    }
+    const CostValue min_price = *std::min_element(price_.begin(), price_.end());
+    for (CostValue& price : price_) price -= min_price;
+  } while (epsilon_ > 1);
+  success_ = true;
+  return true;
+}
+
+CostValue AuctionAssignment::GetCost() const {
+  DCHECK(success_);
+  CostValue cost = 0;
+  for (NodeIndex left_node = 0; left_node < num_left_nodes_; ++left_node) {
+    cost += GetAssignmentCost(left_node);
+  }
+  return cost;
+}
+
+}  // namespace operations_research
@@ -0,0 +1,198 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// An implementation of the auction algorithm of Bertsekas with epsilon
+// scaling for dense assignment problems, i.e. problems in which every left
+// node can be assigned to every right node.
+//
+// LinearSumAssignment (see linear_assignment.h) is the method of choice for
+// sparse problems. For large dense problems, the auction algorithm is
+// attractive because the work is dominated by scans of contiguous cost rows,
+// and because the bids of all unassigned left nodes can be computed in
+// parallel.
+//
+// Example usage:
+//
+//   #include "ortools/graph/auction_assignment.h"
+//
+//   operations_research::AuctionAssignment assignment(num_left_nodes);
+//   for (int left = 0; left < num_left_nodes; ++left) {
+//     for (int right = 0; right < num_left_nodes; ++right) {
+//       assignment.SetArcCost(left, right, Cost(left, right));
+//     }
+//   }
+//   assignment.SetNumThreads(8);
+//   if (assignment.ComputeAssignment()) {
+//     const operations_research::CostValue cost = assignment.GetCost();
+//     for (int left = 0; left < num_left_nodes; ++left) {
+//       const int right = assignment.GetMate(left);
+//       ...
+//     }
+//   }
+//
+// The left nodes ("persons") bid for the right nodes ("objects"), which
+// have prices. Each person wants an object j minimizing c(i, j) + p(j). An
+// unassigned person i whose best object is j1, with value v1, and whose
+// second best value is v2, raises the price of j1 by v2 - v1 + epsilon and
+// takes j1 from its current owner. When all persons are assigned, the
+// assignment is epsilon-optimal: every person is within epsilon of its best
+// object. Costs are multiplied by (n + 1) internally, so that a 1-optimal
+// assignment of the scaled problem is optimal.
+//
+// Epsilon scaling solves a sequence of problems with decreasing epsilon,
+// reusing the prices of the previous one, which bounds the number of bids.
+//
+// Two variants are implemented:
+// - Gauss-Seidel (one thread): persons bid one at a time, each bid using
+//   the prices updated by the previous ones.
+// - Jacobi (several threads): all unassigned persons bid in parallel on the
+//   same prices, then each object goes to its highest bidder.
+//
+// References:
+// [ Bertsekas ] D. P. Bertsekas, "The Auction Algorithm: A Distributed
+// Relaxation Method for the Assignment Problem," Annals of Operations
+// Research, Vol. 14, pages 105-123, 1988.
+//
+// [ Bertsekas and Castanon ] D. P. Bertsekas and D. A. Castanon, "Parallel
+// Synchronous and Asynchronous Implementations of the Auction Algorithm,"
+// Parallel Computing, Vol. 17, pages 707-732, 1991.
+
+#ifndef OR_TOOLS_GRAPH_AUCTION_ASSIGNMENT_H_
+#define OR_TOOLS_GRAPH_AUCTION_ASSIGNMENT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "ortools/base/logging.h"
+#include "ortools/graph/ebert_graph.h"
+
+namespace operations_research {
+
+class ThreadPool;
+
+class AuctionAssignment {
+ public:
+  // Creates a problem with num_left_nodes left nodes and as many right
+  // nodes, in which all the arc costs are zero. Left and right nodes are both
+  // indexed in [0, num_left_nodes).
+  explicit AuctionAssignment(NodeIndex num_left_nodes);
+
+  // This type is neither copyable nor movable.
+  AuctionAssignment(const AuctionAssignment&) = delete;
+  AuctionAssignment& operator=(const AuctionAssignment&) = delete;
+
+  // Sets the cost of assigning left_node to right_node.
+  void SetArcCost(NodeIndex left_node, NodeIndex right_node, CostValue cost);
+
+  // Returns the cost of assigning left_node to right_node.
+  CostValue ArcCost(NodeIndex left_node, NodeIndex right_node) const {
+    return scaled_cost_[Index(left_node, right_node)] / cost_scaling_factor_;
+  }
+
+  // Sets the amount by which epsilon is divided between two scaling phases.
+  void SetCostScalingDivisor(CostValue divisor) {
+    DCHECK_GT(divisor, 1);
+    alpha_ = divisor;
+  }
+
+  // Sets the number of threads used to compute the bids. With one thread
+  // (the default), the Gauss-Seidel variant is used, otherwise the Jacobi
+  // one.
+  void SetNumThreads(int num_threads) {
+    DCHECK_GE(num_threads, 1);
+    num_threads_ = num_threads;
+  }
+
+  // Computes the optimum assignment. Returns true on success. Since every
+  // left node can be assigned to every right node, the problem is always
+  // feasible, and false means that the magnitude of some cost is too large
+  // for the computation to be guaranteed not to overflow.
+  bool ComputeAssignment();
+
+  // Returns the cost of the minimum-cost perfect matching.
+  // Precondition: ComputeAssignment() returned true.
+  CostValue GetCost() const;
+
+  // Returns the number of left nodes, which is also the number of right
+  // nodes.
+  NodeIndex NumLeftNodes() const { return num_left_nodes_; }
+
+  // Returns the right node to which the given left node is matched.
+  // Precondition: ComputeAssignment() returned true.
+  NodeIndex GetMate(NodeIndex left_node) const {
+    DCHECK(success_);
+    return mate_[left_node];
+  }
+
+  // Returns the cost of the arc by which the given left node is matched.
+  // Precondition: ComputeAssignment() returned true.
+  CostValue GetAssignmentCost(NodeIndex left_node) const {
+    return ArcCost(left_node, GetMate(left_node));
+  }
+
+  // Returns the number of bids of the last call to ComputeAssignment().
+  int64_t num_bids() const { return num_bids_; }
+
+ private:
+  struct Bid {
+    NodeIndex object;
+    CostValue price;
+  };
+
+  int64_t Index(NodeIndex left_node, NodeIndex right_node) const {
+    DCHECK_GE(left_node, 0);
+    DCHECK_LT(left_node, num_left_nodes_);
+    DCHECK_GE(right_node, 0);
+    DCHECK_LT(right_node, num_left_nodes_);
+    return static_cast<int64_t>(left_node) * num_left_nodes_ + right_node;
+  }
+
+  // Returns the bid of the given person with the current prices: its best
+  // object, and the price at which this object is as attractive to the
+  // person as its second best object, plus epsilon.
+  Bid ComputeBid(NodeIndex person) const;
+
+  // Runs the auction with the current epsilon, starting from the current
+  // prices and an empty assignment, until all persons are assigned.
+  void GaussSeidelAuction();
+  void JacobiAuction(ThreadPool* pool);
+
+  const NodeIndex num_left_nodes_;
+  const CostValue cost_scaling_factor_;
+
+  // The costs multiplied by cost_scaling_factor_, row by row.
+  std::vector<CostValue> scaled_cost_;
+
+  // The largest magnitude of a cost, before scaling.
+  CostValue largest_cost_magnitude_ = 0;
+
+  CostValue alpha_ = 7;
+  int num_threads_ = 1;
+  CostValue epsilon_ = 0;
+
+  // The price of each object.
+  std::vector<CostValue> price_;
+
+  // The object assigned to each person, and the person owning each object,
+  // or -1.
+  std::vector<NodeIndex> mate_;
+  std::vector<NodeIndex> owner_;
+
+  int64_t num_bids_ = 0;
+  bool success_ = false;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_AUCTION_ASSIGNMENT_H_
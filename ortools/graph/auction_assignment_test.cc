@@ -0,0 +1,175 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/auction_assignment.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "benchmark/benchmark.h"
+#include "gtest/gtest.h"
+#include "ortools/base/logging.h"
+#include "ortools/graph/assignment.h"
+#include "ortools/graph/ebert_graph.h"
+
+namespace operations_research {
+namespace {
+
+// Checks that the assignment is a permutation, and that GetCost() is the sum
+// of the assignment costs.
+void CheckAssignment(const AuctionAssignment& assignment) {
+  const int n = assignment.NumLeftNodes();
+  std::vector<bool> matched(n, false);
+  CostValue cost = 0;
+  for (int left = 0; left < n; ++left) {
+    const int right = assignment.GetMate(left);
+    ASSERT_GE(right, 0);
+    ASSERT_LT(right, n);
+    ASSERT_FALSE(matched[right]);
+    matched[right] = true;
+    EXPECT_EQ(assignment.GetAssignmentCost(left),
+              assignment.ArcCost(left, right));
+    cost += assignment.GetAssignmentCost(left);
+  }
+  EXPECT_EQ(cost, assignment.GetCost());
+}
+
+TEST(AuctionAssignmentTest, Empty) {
+  AuctionAssignment assignment(0);
+  EXPECT_TRUE(assignment.ComputeAssignment());
+  EXPECT_EQ(assignment.GetCost(), 0);
+}
+
+TEST(AuctionAssignmentTest, OneNode) {
+  AuctionAssignment assignment(1);
+  assignment.SetArcCost(0, 0, -42);
+  EXPECT_TRUE(assignment.ComputeAssignment());
+  EXPECT_EQ(assignment.GetMate(0), 0);
+  EXPECT_EQ(assignment.GetCost(), -42);
+}
+
+TEST(AuctionAssignmentTest, SmallProblem) {
+  const std::vector<std::vector<CostValue>> costs = {
+      {90, 76, 75, 80},
+      {35, 85, 55, 65},
+      {125, 95, 90, 105},
+      {45, 110, 95, 115}};
+  for (const int num_threads : {1, 4}) {
+    AuctionAssignment assignment(4);
+    for (int left = 0; left < 4; ++left) {
+      for (int right = 0; right < 4; ++right) {
+        assignment.SetArcCost(left, right, costs[left][right]);
+      }
+    }
+    assignment.SetNumThreads(num_threads);
+    EXPECT_TRUE(assignment.ComputeAssignment());
+    CheckAssignment(assignment);
+    EXPECT_EQ(assignment.GetCost(), 275);
+    EXPECT_EQ(assignment.GetMate(0), 3);
+    EXPECT_EQ(assignment.GetMate(1), 2);
+    EXPECT_EQ(assignment.GetMate(2), 1);
+    EXPECT_EQ(assignment.GetMate(3), 0);
+  }
+}
+
+TEST(AuctionAssignmentTest, CostsTooLarge) {
+  AuctionAssignment assignment(2);
+  assignment.SetArcCost(0, 0, std::numeric_limits<CostValue>::max() / 4);
+  EXPECT_FALSE(assignment.ComputeAssignment());
+}
+
+// Compares the optimal costs with the ones found by
+// SimpleLinearSumAssignment on random dense problems.
+TEST(AuctionAssignmentTest, RandomProblems) {
+  std::mt19937 random(12345);
+  for (int iteration = 0; iteration < 40; ++iteration) {
+    const int n = absl::Uniform(random, 1, 80);
+    // Small cost ranges lead to many ties.
+    const CostValue max_cost = iteration % 2 == 0 ? 5 : 1000000;
+    std::vector<std::vector<CostValue>> costs(n, std::vector<CostValue>(n));
+    SimpleLinearSumAssignment reference;
+    for (int left = 0; left < n; ++left) {
+      for (int right = 0; right < n; ++right) {
+        costs[left][right] = absl::Uniform(random, -max_cost, max_cost);
+        reference.AddArcWithCost(left, right, costs[left][right]);
+      }
+    }
+    ASSERT_EQ(reference.Solve(), SimpleLinearSumAssignment::OPTIMAL);
+    for (const int num_threads : {1, 3}) {
+      AuctionAssignment assignment(n);
+      for (int left = 0; left < n; ++left) {
+        for (int right = 0; right < n; ++right) {
+          assignment.SetArcCost(left, right, costs[left][right]);
+        }
+      }
+      assignment.SetNumThreads(num_threads);
+      assignment.SetCostScalingDivisor(2 + iteration % 8);
+      ASSERT_TRUE(assignment.ComputeAssignment());
+      CheckAssignment(assignment);
+      EXPECT_EQ(assignment.GetCost(), reference.OptimalCost());
+    }
+  }
+}
+
+void FillRandomDenseProblem(int n, AuctionAssignment* assignment,
+                            SimpleLinearSumAssignment* reference) {
+  std::mt19937 random(0);
+  for (int left = 0; left < n; ++left) {
+    for (int right = 0; right < n; ++right) {
+      const CostValue cost = absl::Uniform(random, 0, 1000000);
+      if (assignment != nullptr) assignment->SetArcCost(left, right, cost);
+      if (reference != nullptr) reference->AddArcWithCost(left, right, cost);
+    }
+  }
+}
+
+void BM_DenseAuctionAssignment(benchmark::State& state) {
+  const int n = state.range(0);
+  const int num_threads = state.range(1);
+  for (auto _ : state) {
+    state.PauseTiming();
+    AuctionAssignment assignment(n);
+    FillRandomDenseProblem(n, &assignment, nullptr);
+    assignment.SetNumThreads(num_threads);
+    state.ResumeTiming();
+    CHECK(assignment.ComputeAssignment());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+BENCHMARK(BM_DenseAuctionAssignment)
+    ->ArgPair(500, 1)
+    ->ArgPair(500, 4)
+    ->ArgPair(2000, 1)
+    ->ArgPair(2000, 4)
+    ->ArgPair(2000, 16);
+
+void BM_DenseLinearSumAssignment(benchmark::State& state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    SimpleLinearSumAssignment assignment;
+    FillRandomDenseProblem(n, nullptr, &assignment);
+    state.ResumeTiming();
+    CHECK_EQ(assignment.Solve(), SimpleLinearSumAssignment::OPTIMAL);
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+BENCHMARK(BM_DenseLinearSumAssignment)->Arg(500)->Arg(2000);
+
+}  // namespace
+}  // namespace operations_research
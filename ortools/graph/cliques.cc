@@ -14,12 +14,18 @@
 #include "ortools/graph/cliques.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/logging.h"
+#include "ortools/util/bitset.h"
 
 namespace operations_research {
 namespace {
@@ -260,4 +266,469 @@ void CoverArcsByCliques(std::function<bool(int, int)> graph, int node_count,
          &actual, &stop);
 }
 
+namespace {
+
+// Operations on the bitsets of DenseGraphCliques, which are arrays of
+// num_words 64-bit words.
+int BitsetCount(const uint64_t* set, int num_words) {
+  int count = 0;
+  for (int w = 0; w < num_words; ++w) count += BitCount64(set[w]);
+  return count;
+}
+
+int BitsetIntersectionCount(const uint64_t* set1, const uint64_t* set2,
+                            int num_words) {
+  int count = 0;
+  for (int w = 0; w < num_words; ++w) count += BitCount64(set1[w] & set2[w]);
+  return count;
+}
+
+bool BitsetIsEmpty(const uint64_t* set, int num_words) {
+  for (int w = 0; w < num_words; ++w) {
+    if (set[w] != 0) return false;
+  }
+  return true;
+}
+
+// Calls f(node) for each node of the set, by increasing index. f may clear
+// the bits of the nodes which were already visited.
+template <typename F>
+void ForEachNode(const uint64_t* set, int num_words, const F& f) {
+  for (int w = 0; w < num_words; ++w) {
+    for (uint64_t word = set[w]; word != 0; word &= word - 1) {
+      f(static_cast<int>(BitShift64(w) | LeastSignificantBitPosition64(word)));
+    }
+  }
+}
+
+// Calls worker() on num_threads threads, the calling thread being one of
+// them, and returns once all the calls are done.
+void RunOnThreads(int num_threads, const std::function<void()>& worker) {
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread < num_threads; ++thread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) thread.join();
+}
+
+// State shared by the threads of a search on a relabeled graph.
+class SharedCliqueSearch {
+ public:
+  SharedCliqueSearch(const std::vector<uint64_t>* adjacency, int num_words,
+                     const std::vector<int>* labels,
+                     const DenseGraphCliques::CliqueCallback* callback)
+      : adjacency_(adjacency),
+        num_words_(num_words),
+        labels_(labels),
+        callback_(callback) {}
+
+  const uint64_t* Row(int node) const {
+    return adjacency_->data() + static_cast<int64_t>(node) * num_words_;
+  }
+  int num_words() const { return num_words_; }
+  int num_nodes() const { return labels_->size(); }
+
+  // Returns the next top-level branch to explore, or -1 if there are none
+  // left or if the search was stopped.
+  int NextBranch() {
+    if (stopped()) return -1;
+    const int node = next_branch_.fetch_add(1);
+    return node < num_nodes() ? node : -1;
+  }
+
+  bool stopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // Reports a clique of the relabeled graph to the callback.
+  void Report(const std::vector<int>& clique) {
+    std::vector<int> original_clique = OriginalClique(clique);
+    absl::MutexLock lock(&mutex_);
+    if (stopped()) return;
+    if ((*callback_)(original_clique) == CliqueResponse::STOP) {
+      stopped_ = true;
+    }
+  }
+
+  // For the maximum clique search: the size of the best clique so far, and
+  // the update of this clique.
+  int best_size() const { return best_size_.load(std::memory_order_relaxed); }
+  void UpdateBestClique(const std::vector<int>& clique) {
+    absl::MutexLock lock(&mutex_);
+    if (static_cast<int>(clique.size()) <= best_size()) return;
+    best_clique_ = OriginalClique(clique);
+    best_size_ = clique.size();
+  }
+  std::vector<int> best_clique() {
+    absl::MutexLock lock(&mutex_);
+    return best_clique_;
+  }
+
+ private:
+  std::vector<int> OriginalClique(const std::vector<int>& clique) const {
+    std::vector<int> original_clique;
+    original_clique.reserve(clique.size());
+    for (const int node : clique) original_clique.push_back((*labels_)[node]);
+    std::sort(original_clique.begin(), original_clique.end());
+    return original_clique;
+  }
+
+  const std::vector<uint64_t>* const adjacency_;
+  const int num_words_;
+  const std::vector<int>* const labels_;
+  const DenseGraphCliques::CliqueCallback* const callback_;
+  std::atomic<int> next_branch_ = 0;
+  std::atomic<bool> stopped_ = false;
+  std::atomic<int> best_size_ = 0;
+  absl::Mutex mutex_;
+  std::vector<int> best_clique_ ABSL_GUARDED_BY(mutex_);
+};
+
+// The search of one thread. The bitsets of the recursion level 'depth' are
+// stored in levels_[depth], which are allocated on demand; growing levels_
+// moves the vectors but not their contents, so the pointers held by the
+// lower levels stay valid.
+class CliqueSearchWorker {
+ public:
+  explicit CliqueSearchWorker(SharedCliqueSearch* shared)
+      : shared_(shared), num_words_(shared->num_words()) {}
+
+  // Runs the top-level branches of the Bron-Kerbosch algorithm until there
+  // are none left.
+  void FindMaximalCliques() {
+    for (int node = shared_->NextBranch(); node != -1;
+         node = shared_->NextBranch()) {
+      // The candidates are the neighbors after 'node', and the "not" set the
+      // neighbors before it.
+      uint64_t* const candidates = Bitset(0, 0);
+      uint64_t* const not_set = Bitset(0, 1);
+      SplitRow(node, candidates, not_set);
+      clique_.assign(1, node);
+      ExpandMaximal(0);
+    }
+  }
+
+  // Runs the top-level branches of the maximum clique search, last nodes
+  // first, until there are none left.
+  void FindMaximumClique() {
+    for (int branch = shared_->NextBranch(); branch != -1;
+         branch = shared_->NextBranch()) {
+      const int node = shared_->num_nodes() - 1 - branch;
+      uint64_t* const candidates = Bitset(0, 0);
+      SplitRow(node, candidates, Bitset(0, 1));
+      if (1 + BitsetCount(candidates, num_words_) <= shared_->best_size()) {
+        continue;
+      }
+      clique_.assign(1, node);
+      if (BitsetIsEmpty(candidates, num_words_)) {
+        shared_->UpdateBestClique(clique_);
+      } else {
+        ExpandMaximum(0);
+      }
+    }
+  }
+
+  // Runs the top-level branches of the listing of the cliques of size
+  // clique_size until there are none left.
+  void ListCliquesOfSize(int clique_size) {
+    clique_size_ = clique_size;
+    for (int node = shared_->NextBranch(); node != -1;
+         node = shared_->NextBranch()) {
+      clique_.assign(1, node);
+      if (clique_size == 1) {
+        shared_->Report(clique_);
+        continue;
+      }
+      uint64_t* const candidates = Bitset(0, 0);
+      SplitRow(node, candidates, Bitset(0, 1));
+      ExpandOfSize(0);
+    }
+  }
+
+ private:
+  // The bitsets used at each level of the recursion.
+  static constexpr int kNumBitsetsPerLevel = 3;
+
+  uint64_t* Bitset(int depth, int index) {
+    while (static_cast<int>(levels_.size()) <= depth) {
+      levels_.emplace_back(kNumBitsetsPerLevel * num_words_);
+    }
+    return levels_[depth].data() + index * num_words_;
+  }
+
+  // Splits the neighbors of node into the ones after and before it.
+  void SplitRow(int node, uint64_t* after, uint64_t* before) const {
+    const uint64_t* const row = shared_->Row(node);
+    const int node_word = BitOffset64(node);
+    for (int w = 0; w < num_words_; ++w) {
+      uint64_t after_mask = w < node_word ? 0 : kAllBits64;
+      if (w == node_word) after_mask = IntervalUp64(BitPos64(node));
+      after[w] = row[w] & after_mask;
+      before[w] = row[w] & ~after_mask;
+    }
+  }
+
+  void ExpandMaximal(int depth) {
+    uint64_t* const candidates = Bitset(depth, 0);
+    uint64_t* const not_set = Bitset(depth, 1);
+    if (BitsetIsEmpty(candidates, num_words_)) {
+      if (BitsetIsEmpty(not_set, num_words_)) shared_->Report(clique_);
+      return;
+    }
+    // The pivot is the node of candidates or not_set which has the most
+    // neighbors among the candidates; only the candidates which are not its
+    // neighbors need to be branched on.
+    int pivot = -1;
+    int max_count = -1;
+    const auto consider_pivot = [this, candidates, &pivot,
+                                 &max_count](int node) {
+      const int count =
+          BitsetIntersectionCount(shared_->Row(node), candidates, num_words_);
+      if (count > max_count) {
+        max_count = count;
+        pivot = node;
+      }
+    };
+    ForEachNode(candidates, num_words_, consider_pivot);
+    ForEachNode(not_set, num_words_, consider_pivot);
+    uint64_t* const branches = Bitset(depth, 2);
+    const uint64_t* const pivot_row = shared_->Row(pivot);
+    for (int w = 0; w < num_words_; ++w) {
+      branches[w] = candidates[w] & ~pivot_row[w];
+    }
+    ForEachNode(branches, num_words_, [this, depth, candidates,
+                                       not_set](int node) {
+      if (shared_->stopped()) return;
+      const uint64_t* const row = shared_->Row(node);
+      uint64_t* const next_candidates = Bitset(depth + 1, 0);
+      uint64_t* const next_not_set = Bitset(depth + 1, 1);
+      for (int w = 0; w < num_words_; ++w) {
+        next_candidates[w] = candidates[w] & row[w];
+        next_not_set[w] = not_set[w] & row[w];
+      }
+      clique_.push_back(node);
+      ExpandMaximal(depth + 1);
+      clique_.pop_back();
+      candidates[BitOffset64(node)] &= ~OneBit64(BitPos64(node));
+      not_set[BitOffset64(node)] |= OneBit64(BitPos64(node));
+    });
+  }
+
+  // Colors the candidates greedily: each color class is an independent set,
+  // so a clique contains at most one node of each class. Fills order_ with
+  // the candidates by increasing color, and colors_ with the number of colors
+  // used up to each of them.
+  void ColorCandidates(const uint64_t* candidates, uint64_t* uncolored,
+                       uint64_t* color_class, std::vector<int>* order,
+                       std::vector<int>* colors) const {
+    order->clear();
+    colors->clear();
+    std::copy(candidates, candidates + num_words_, uncolored);
+    int color = 0;
+    while (!BitsetIsEmpty(uncolored, num_words_)) {
+      ++color;
+      std::copy(uncolored, uncolored + num_words_, color_class);
+      for (int w = 0; w < num_words_; ++w) {
+        while (color_class[w] != 0) {
+          const int bit = LeastSignificantBitPosition64(color_class[w]);
+          const int node = BitShift64(w) | bit;
+          color_class[w] &= ~OneBit64(bit);
+          uncolored[w] &= ~OneBit64(bit);
+          // The next nodes of this color must not be neighbors of node.
+          const uint64_t* const row = shared_->Row(node);
+          for (int v = w; v < num_words_; ++v) color_class[v] &= ~row[v];
+          order->push_back(node);
+          colors->push_back(color);
+        }
+      }
+    }
+  }
+
+  void ExpandMaximum(int depth) {
+    uint64_t* const candidates = Bitset(depth, 0);
+    if (static_cast<int>(order_.size()) <= depth) {
+      order_.resize(depth + 1);
+      colors_.resize(depth + 1);
+    }
+    ColorCandidates(candidates, Bitset(depth, 1), Bitset(depth, 2),
+                    &order_[depth], &colors_[depth]);
+    // As for the bitsets, the deeper levels may move order_[depth] and
+    // colors_[depth], but not their contents.
+    const int* const order = order_[depth].data();
+    const int* const colors = colors_[depth].data();
+    for (int i = order_[depth].size() - 1; i >= 0; --i) {
+      const int bound = static_cast<int>(clique_.size()) + colors[i];
+      if (bound <= shared_->best_size()) return;
+      if (shared_->stopped()) return;
+      const int node = order[i];
+      const uint64_t* const row = shared_->Row(node);
+      uint64_t* const next_candidates = Bitset(depth + 1, 0);
+      for (int w = 0; w < num_words_; ++w) {
+        next_candidates[w] = candidates[w] & row[w];
+      }
+      clique_.push_back(node);
+      if (BitsetIsEmpty(next_candidates, num_words_)) {
+        shared_->UpdateBestClique(clique_);
+      } else {
+        ExpandMaximum(depth + 1);
+      }
+      clique_.pop_back();
+      candidates[BitOffset64(node)] &= ~OneBit64(BitPos64(node));
+    }
+  }
+
+  void ExpandOfSize(int depth) {
+    uint64_t* const candidates = Bitset(depth, 0);
+    const int num_missing_nodes =
+        clique_size_ - static_cast<int>(clique_.size());
+    if (BitsetCount(candidates, num_words_) < num_missing_nodes) return;
+    ForEachNode(candidates, num_words_, [this, depth, candidates,
+                                         num_missing_nodes](int node) {
+      if (shared_->stopped()) return;
+      // Only the candidates after node are considered in the branch of node,
+      // so that each clique is listed once.
+      candidates[BitOffset64(node)] &= ~OneBit64(BitPos64(node));
+      if (num_missing_nodes > 1 &&
+          BitsetCount(candidates, num_words_) < num_missing_nodes - 1) {
+        return;
+      }
+      clique_.push_back(node);
+      if (num_missing_nodes == 1) {
+        shared_->Report(clique_);
+      } else {
+        const uint64_t* const row = shared_->Row(node);
+        uint64_t* const next_candidates = Bitset(depth + 1, 0);
+        for (int w = 0; w < num_words_; ++w) {
+          next_candidates[w] = candidates[w] & row[w];
+        }
+        ExpandOfSize(depth + 1);
+      }
+      clique_.pop_back();
+    });
+  }
+
+  SharedCliqueSearch* const shared_;
+  const int num_words_;
+  std::vector<std::vector<uint64_t>> levels_;
+  std::vector<std::vector<int>> order_;
+  std::vector<std::vector<int>> colors_;
+  std::vector<int> clique_;
+  int clique_size_ = 0;
+};
+
+}  // namespace
+
+DenseGraphCliques::DenseGraphCliques(int num_nodes)
+    : num_nodes_(num_nodes),
+      num_words_(BitLength64(num_nodes)),
+      adjacency_(static_cast<int64_t>(num_nodes) * num_words_, 0) {
+  DCHECK_GE(num_nodes, 0);
+}
+
+void DenseGraphCliques::AddArc(int node1, int node2) {
+  DCHECK_GE(node1, 0);
+  DCHECK_LT(node1, num_nodes_);
+  DCHECK_GE(node2, 0);
+  DCHECK_LT(node2, num_nodes_);
+  if (node1 == node2) return;
+  const int64_t row1 = static_cast<int64_t>(node1) * num_words_;
+  const int64_t row2 = static_cast<int64_t>(node2) * num_words_;
+  adjacency_[row1 + BitOffset64(node2)] |= OneBit64(BitPos64(node2));
+  adjacency_[row2 + BitOffset64(node1)] |= OneBit64(BitPos64(node1));
+}
+
+bool DenseGraphCliques::HasArc(int node1, int node2) const {
+  const int64_t row1 = static_cast<int64_t>(node1) * num_words_;
+  return adjacency_[row1 + BitOffset64(node2)] & OneBit64(BitPos64(node2));
+}
+
+std::vector<int> DenseGraphCliques::DegeneracyOrder() const {
+  std::vector<int> degree(num_nodes_);
+  for (int node = 0; node < num_nodes_; ++node) {
+    degree[node] = BitsetCount(
+        adjacency_.data() + static_cast<int64_t>(node) * num_words_,
+        num_words_);
+  }
+  std::vector<uint64_t> remaining(num_words_, 0);
+  for (int node = 0; node < num_nodes_; ++node) {
+    remaining[BitOffset64(node)] |= OneBit64(BitPos64(node));
+  }
+  // The graphs are dense, so a linear scan for the node of minimum degree is
+  // not more expensive than the degree updates.
+  std::vector<int> order;
+  order.reserve(num_nodes_);
+  for (int i = 0; i < num_nodes_; ++i) {
+    int best_node = -1;
+    ForEachNode(remaining.data(), num_words_, [&degree, &best_node](int node) {
+      if (best_node == -1 || degree[node] < degree[best_node]) {
+        best_node = node;
+      }
+    });
+    order.push_back(best_node);
+    remaining[BitOffset64(best_node)] &= ~OneBit64(BitPos64(best_node));
+    const uint64_t* const row =
+        adjacency_.data() + static_cast<int64_t>(best_node) * num_words_;
+    for (int w = 0; w < num_words_; ++w) {
+      for (uint64_t word = row[w] & remaining[w]; word != 0;
+           word &= word - 1) {
+        --degree[BitShift64(w) | LeastSignificantBitPosition64(word)];
+      }
+    }
+  }
+  return order;
+}
+
+std::vector<uint64_t> DenseGraphCliques::RelabeledAdjacency(
+    const std::vector<int>& order) const {
+  std::vector<int> position(num_nodes_);
+  for (int i = 0; i < num_nodes_; ++i) position[order[i]] = i;
+  std::vector<uint64_t> adjacency(adjacency_.size(), 0);
+  for (int i = 0; i < num_nodes_; ++i) {
+    uint64_t* const row =
+        adjacency.data() + static_cast<int64_t>(i) * num_words_;
+    ForEachNode(
+        adjacency_.data() + static_cast<int64_t>(order[i]) * num_words_,
+        num_words_, [row, &position](int node) {
+          const int new_node = position[node];
+          row[BitOffset64(new_node)] |= OneBit64(BitPos64(new_node));
+        });
+  }
+  return adjacency;
+}
+
+BronKerboschAlgorithmStatus DenseGraphCliques::FindMaximalCliques(
+    const CliqueCallback& callback) const {
+  const std::vector<int> order = DegeneracyOrder();
+  const std::vector<uint64_t> adjacency = RelabeledAdjacency(order);
+  SharedCliqueSearch shared(&adjacency, num_words_, &order, &callback);
+  RunOnThreads(num_threads_, [&shared]() {
+    CliqueSearchWorker(&shared).FindMaximalCliques();
+  });
+  return shared.stopped() ? BronKerboschAlgorithmStatus::INTERRUPTED
+                          : BronKerboschAlgorithmStatus::COMPLETED;
+}
+
+std::vector<int> DenseGraphCliques::FindMaximumClique() const {
+  const std::vector<int> order = DegeneracyOrder();
+  const std::vector<uint64_t> adjacency = RelabeledAdjacency(order);
+  const CliqueCallback callback = nullptr;
+  SharedCliqueSearch shared(&adjacency, num_words_, &order, &callback);
+  RunOnThreads(num_threads_, [&shared]() {
+    CliqueSearchWorker(&shared).FindMaximumClique();
+  });
+  return shared.best_clique();
+}
+
+BronKerboschAlgorithmStatus DenseGraphCliques::ListCliquesOfSize(
+    int clique_size, const CliqueCallback& callback) const {
+  CHECK_GE(clique_size, 1);
+  const std::vector<int> order = DegeneracyOrder();
+  const std::vector<uint64_t> adjacency = RelabeledAdjacency(order);
+  SharedCliqueSearch shared(&adjacency, num_words_, &order, &callback);
+  RunOnThreads(num_threads_, [&shared, clique_size]() {
+    CliqueSearchWorker(&shared).ListCliquesOfSize(clique_size);
+  });
+  return shared.stopped() ? BronKerboschAlgorithmStatus::INTERRUPTED
+                          : BronKerboschAlgorithmStatus::COMPLETED;
+}
+
 }  // namespace operations_research
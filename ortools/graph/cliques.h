@@ -357,6 +357,90 @@ class BronKerboschAlgorithm {
   TimeLimit* time_limit_;
 };
 
+// Clique algorithms for dense graphs. The adjacency matrix is stored as rows
+// of 64-bit words, so that the candidate sets of the searches are bitsets:
+// intersecting them with the neighborhood of a node is a word-wise AND, and
+// the pivot selection and pruning bounds use popcounts. This uses n^2 / 8
+// bytes of memory for a graph with n nodes, but is much faster than the
+// callback-based BronKerboschAlgorithm on dense graphs.
+//
+// The searches relabel the nodes in a degeneracy order, and split the search
+// tree at the top level: the branch of node v looks for the cliques whose
+// smallest node in this order is v. These branches are independent, and are
+// distributed among SetNumThreads() threads.
+//
+// Typical usage:
+// DenseGraphCliques graph(num_nodes);
+// for (const auto& [node1, node2] : edges) graph.AddArc(node1, node2);
+// graph.SetNumThreads(8);
+// const std::vector<int> maximum_clique = graph.FindMaximumClique();
+class DenseGraphCliques {
+ public:
+  // A callback called by the algorithms to report a clique, sorted by
+  // increasing node index. With more than one thread, it is called by the
+  // threads of the search, in no particular order, but never concurrently.
+  using CliqueCallback = std::function<CliqueResponse(const std::vector<int>&)>;
+
+  // Creates a graph with num_nodes nodes and no arcs.
+  explicit DenseGraphCliques(int num_nodes);
+
+  // This type is neither copyable nor movable.
+  DenseGraphCliques(const DenseGraphCliques&) = delete;
+  DenseGraphCliques& operator=(const DenseGraphCliques&) = delete;
+
+  // Adds an undirected arc between node1 and node2. Self-loops are ignored.
+  void AddArc(int node1, int node2);
+
+  // Returns true if there is an arc between node1 and node2.
+  bool HasArc(int node1, int node2) const;
+
+  int num_nodes() const { return num_nodes_; }
+
+  // Sets the number of threads used by the searches. The default is one.
+  void SetNumThreads(int num_threads) {
+    DCHECK_GE(num_threads, 1);
+    num_threads_ = num_threads;
+  }
+
+  // Calls 'callback' for each maximal clique of the graph, even of size 1.
+  // This is the Bron-Kerbosch algorithm with the pivot of Tomita et al.,
+  // which has the most neighbors among the candidates. Returns COMPLETED if
+  // all maximal cliques were reported, and INTERRUPTED if the callback
+  // returned CliqueResponse::STOP.
+  BronKerboschAlgorithmStatus FindMaximalCliques(
+      const CliqueCallback& callback) const;
+
+  // Returns a clique of maximum size, sorted by increasing node index, or an
+  // empty vector if the graph has no nodes. This is a branch and bound, which
+  // bounds the size of the cliques in a branch by a greedy coloring of the
+  // candidates (the MCQ algorithm of Tomita and Seki). With more than one
+  // thread, the returned clique may depend on the scheduling of the threads,
+  // but not its size.
+  std::vector<int> FindMaximumClique() const;
+
+  // Calls 'callback' for each clique of exactly 'clique_size' nodes, maximal
+  // or not. Returns COMPLETED if all these cliques were reported, and
+  // INTERRUPTED if the callback returned CliqueResponse::STOP.
+  BronKerboschAlgorithmStatus ListCliquesOfSize(
+      int clique_size, const CliqueCallback& callback) const;
+
+ private:
+  // Returns the nodes in a degeneracy order: each node has the smallest
+  // degree in the subgraph induced by the nodes that are not before it.
+  std::vector<int> DegeneracyOrder() const;
+
+  // Returns the adjacency rows of the graph in which node order[i] is
+  // relabeled as i.
+  std::vector<uint64_t> RelabeledAdjacency(const std::vector<int>& order) const;
+
+  const int num_nodes_;
+  // The number of 64-bit words of an adjacency row.
+  const int num_words_;
+  int num_threads_ = 1;
+  // The adjacency rows of the nodes, each of num_words_ words.
+  std::vector<uint64_t> adjacency_;
+};
+
 template <typename NodeIndex>
 void BronKerboschAlgorithm<NodeIndex>::InitializeState(State* state) {
   DCHECK(state != nullptr);
@@ -19,6 +19,7 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -527,6 +528,166 @@ TEST(BronKerboschAlgorithmTest, DeterministicTimeLimit) {
   EXPECT_TRUE(time_limit->LimitReached());
 }
 
+void AddArcs(const absl::flat_hash_set<std::pair<int, int>>& arcs,
+             DenseGraphCliques* graph) {
+  for (const auto& [node1, node2] : arcs) graph->AddArc(node1, node2);
+}
+
+std::vector<std::vector<int>> SortedCliques(
+    std::vector<std::vector<int>> cliques) {
+  for (std::vector<int>& clique : cliques) {
+    std::sort(clique.begin(), clique.end());
+  }
+  std::sort(cliques.begin(), cliques.end());
+  return cliques;
+}
+
+TEST(DenseGraphCliquesTest, SmallGraph) {
+  // Two triangles sharing the arc (1, 2), and an isolated node.
+  DenseGraphCliques graph(5);
+  graph.AddArc(0, 1);
+  graph.AddArc(0, 2);
+  graph.AddArc(1, 2);
+  graph.AddArc(1, 3);
+  graph.AddArc(2, 3);
+  graph.AddArc(3, 3);
+  EXPECT_TRUE(graph.HasArc(2, 1));
+  EXPECT_FALSE(graph.HasArc(0, 3));
+  EXPECT_FALSE(graph.HasArc(3, 3));
+  CliqueReporter<int> reporter;
+  EXPECT_EQ(graph.FindMaximalCliques(reporter.MakeCliqueCallback()),
+            BronKerboschAlgorithmStatus::COMPLETED);
+  EXPECT_EQ(SortedCliques(reporter.all_cliques()),
+            std::vector<std::vector<int>>({{0, 1, 2}, {1, 2, 3}, {4}}));
+  EXPECT_EQ(graph.FindMaximumClique().size(), 3);
+  CliqueReporter<int> pairs;
+  EXPECT_EQ(graph.ListCliquesOfSize(2, pairs.MakeCliqueCallback()),
+            BronKerboschAlgorithmStatus::COMPLETED);
+  EXPECT_EQ(SortedCliques(pairs.all_cliques()),
+            std::vector<std::vector<int>>(
+                {{0, 1}, {0, 2}, {1, 2}, {1, 3}, {2, 3}}));
+}
+
+TEST(DenseGraphCliquesTest, EmptyGraph) {
+  DenseGraphCliques graph(0);
+  CliqueReporter<int> reporter;
+  EXPECT_EQ(graph.FindMaximalCliques(reporter.MakeCliqueCallback()),
+            BronKerboschAlgorithmStatus::COMPLETED);
+  EXPECT_TRUE(reporter.all_cliques().empty());
+  EXPECT_TRUE(graph.FindMaximumClique().empty());
+}
+
+TEST(DenseGraphCliquesTest, FullKPartiteGraph) {
+  constexpr int kNumPartitions = 5;
+  DenseGraphCliques graph(kNumPartitions * kNumPartitions);
+  for (int node1 = 0; node1 < graph.num_nodes(); ++node1) {
+    for (int node2 = 0; node2 < node1; ++node2) {
+      if (FullKPartiteGraph(kNumPartitions, node1, node2)) {
+        graph.AddArc(node1, node2);
+      }
+    }
+  }
+  for (const int num_threads : {1, 4}) {
+    graph.SetNumThreads(num_threads);
+    CliqueSizeVerifier verifier(kNumPartitions, kNumPartitions);
+    EXPECT_EQ(graph.FindMaximalCliques(verifier.MakeCliqueCallback()),
+              BronKerboschAlgorithmStatus::COMPLETED);
+    EXPECT_EQ(verifier.num_cliques(),
+              ::MathUtil::IPow(kNumPartitions, kNumPartitions));
+    EXPECT_EQ(graph.FindMaximumClique().size(), kNumPartitions);
+  }
+}
+
+// Compares the dense graph algorithms with BronKerboschAlgorithm on random
+// graphs, with sizes around multiples of 64 and various densities.
+TEST(DenseGraphCliquesTest, RandomGraphs) {
+  std::mt19937 random(12345);
+  for (int iteration = 0; iteration < 30; ++iteration) {
+    const int num_nodes = absl::Uniform(random, 1, 140);
+    // Dense large graphs have too many maximal cliques for this test.
+    const float max_arc_probability = num_nodes <= 40 ? 0.7f : 0.25f;
+    const float arc_probability =
+        absl::Uniform(random, 0.0f, max_arc_probability);
+    const absl::flat_hash_set<std::pair<int, int>> arcs =
+        MakeRandomGraphAdjacencyMatrix(num_nodes, arc_probability, iteration);
+    const auto is_arc = [&arcs](int node1, int node2) {
+      return BitmapGraph(arcs, node1, node2);
+    };
+    CliqueReporter<int> expected;
+    BronKerboschAlgorithm<int> bron_kerbosch(is_arc, num_nodes,
+                                             expected.MakeCliqueCallback());
+    ASSERT_EQ(bron_kerbosch.Run(), BronKerboschAlgorithmStatus::COMPLETED);
+    const std::vector<std::vector<int>> expected_cliques =
+        SortedCliques(expected.all_cliques());
+    int max_clique_size = 0;
+    for (const std::vector<int>& clique : expected_cliques) {
+      max_clique_size = std::max<int>(max_clique_size, clique.size());
+    }
+
+    DenseGraphCliques graph(num_nodes);
+    AddArcs(arcs, &graph);
+    for (const int num_threads : {1, 3}) {
+      graph.SetNumThreads(num_threads);
+      CliqueReporter<int> reporter;
+      ASSERT_EQ(graph.FindMaximalCliques(reporter.MakeCliqueCallback()),
+                BronKerboschAlgorithmStatus::COMPLETED);
+      EXPECT_EQ(SortedCliques(reporter.all_cliques()), expected_cliques);
+
+      const std::vector<int> maximum_clique = graph.FindMaximumClique();
+      EXPECT_EQ(maximum_clique.size(), max_clique_size);
+      for (int i = 0; i < maximum_clique.size(); ++i) {
+        for (int j = 0; j < i; ++j) {
+          EXPECT_TRUE(graph.HasArc(maximum_clique[i], maximum_clique[j]));
+        }
+      }
+
+      // The cliques of a given size are the subsets of this size of the
+      // maximal cliques.
+      for (int clique_size = 1; clique_size <= 4; ++clique_size) {
+        std::set<std::vector<int>> expected_subsets;
+        for (const std::vector<int>& clique : expected_cliques) {
+          if (clique.size() < clique_size || clique.size() > 12) continue;
+          std::vector<bool> selected(clique.size(), false);
+          std::fill(selected.begin(), selected.begin() + clique_size, true);
+          do {
+            std::vector<int> subset;
+            for (int i = 0; i < clique.size(); ++i) {
+              if (selected[i]) subset.push_back(clique[i]);
+            }
+            expected_subsets.insert(subset);
+          } while (std::prev_permutation(selected.begin(), selected.end()));
+        }
+        if (max_clique_size > 12) continue;
+        CliqueReporter<int> subsets;
+        ASSERT_EQ(
+            graph.ListCliquesOfSize(clique_size, subsets.MakeCliqueCallback()),
+            BronKerboschAlgorithmStatus::COMPLETED);
+        EXPECT_EQ(SortedCliques(subsets.all_cliques()),
+                  std::vector<std::vector<int>>(expected_subsets.begin(),
+                                                expected_subsets.end()));
+      }
+    }
+  }
+}
+
+TEST(DenseGraphCliquesTest, Stop) {
+  const absl::flat_hash_set<std::pair<int, int>> arcs =
+      MakeRandomGraphAdjacencyMatrix(200, 0.3, 0);
+  DenseGraphCliques graph(200);
+  AddArcs(arcs, &graph);
+  for (const int num_threads : {1, 4}) {
+    graph.SetNumThreads(num_threads);
+    CliqueReporter<int> reporter(10);
+    EXPECT_EQ(graph.FindMaximalCliques(reporter.MakeCliqueCallback()),
+              BronKerboschAlgorithmStatus::INTERRUPTED);
+    EXPECT_EQ(reporter.all_cliques().size(), 10);
+    CliqueReporter<int> triangles(10);
+    EXPECT_EQ(graph.ListCliquesOfSize(3, triangles.MakeCliqueCallback()),
+              BronKerboschAlgorithmStatus::INTERRUPTED);
+    EXPECT_EQ(triangles.all_cliques().size(), 10);
+  }
+}
+
 // A benchmark that finds all maximal cliques in a modulo graph of the given
 // size.
 void BM_FindCliquesInModuloGraph(benchmark::State& state) {
@@ -672,5 +833,48 @@ BENCHMARK(BM_FindCliquesInRandomGraphWithBronKerboschAlgorithm)
     ->ArgPair(1000, 100)
     ->ArgPair(10000, 1);
 
+void BM_FindMaximalCliquesInRandomDenseGraph(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const double arc_probability = state.range(1) / 1000.0;
+  const int num_threads = state.range(2);
+  DenseGraphCliques graph(num_nodes);
+  AddArcs(MakeRandomGraphAdjacencyMatrix(num_nodes, arc_probability,
+                                         absl::GetFlag(FLAGS_test_random_seed)),
+          &graph);
+  graph.SetNumThreads(num_threads);
+  CliqueSizeVerifier verifier(0, num_nodes);
+  for (auto _ : state) {
+    graph.FindMaximalCliques(verifier.MakeCliqueCallback());
+  }
+}
+
+BENCHMARK(BM_FindMaximalCliquesInRandomDenseGraph)
+    ->Args({100, 500, 1})
+    ->Args({200, 100, 1})
+    ->Args({1000, 50, 1})
+    ->Args({1000, 100, 1})
+    ->Args({1000, 100, 4});
+
+void BM_FindMaximumCliqueInRandomDenseGraph(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const double arc_probability = state.range(1) / 1000.0;
+  const int num_threads = state.range(2);
+  DenseGraphCliques graph(num_nodes);
+  AddArcs(MakeRandomGraphAdjacencyMatrix(num_nodes, arc_probability,
+                                         absl::GetFlag(FLAGS_test_random_seed)),
+          &graph);
+  graph.SetNumThreads(num_threads);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph.FindMaximumClique());
+  }
+}
+
+BENCHMARK(BM_FindMaximumCliqueInRandomDenseGraph)
+    ->Args({200, 500, 1})
+    ->Args({200, 700, 1})
+    ->Args({200, 700, 4})
+    ->Args({1000, 300, 1})
+    ->Args({1000, 300, 4});
+
 }  // namespace
 }  // namespace operations_research
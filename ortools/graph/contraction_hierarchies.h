@@ -0,0 +1,586 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Contraction hierarchies, for many shortest path queries on the same graph.
+//
+// Preprocessing contracts the nodes of the graph one by one, in an order
+// estimating their importance: contracting a node removes it from the graph,
+// and adds a "shortcut" arc u -> w for each pair of arcs u -> node -> w unless
+// a path from u to w not longer than the shortcut exists without the node (a
+// "witness" path). The rank of a node is its position in the contraction
+// order. Every shortest path of the original graph then has an equivalent path
+// in the graph augmented with shortcuts which first goes up in rank, then goes
+// down. Queries therefore run a forward search from the source and a backward
+// search from the destination which only explore arcs going up in rank; on road
+// networks, these searches settle a few hundred nodes, whatever the size of the
+// graph.
+//
+// The many-to-many query computes a whole distance matrix with a single
+// backward search per destination and a single forward search per source,
+// using "buckets" of distances to destinations stored on the nodes reached by
+// the backward searches. Its output can be fed directly to
+// RoutingModel::RegisterTransitMatrix().
+//
+// Example:
+//   StaticGraph<> graph;
+//   std::vector<int64_t> arc_lengths;
+//   ... add arcs to graph and their lengths to arc_lengths ...
+//   graph.Build(&permutation);
+//   util::Permute(permutation, &arc_lengths);
+//   ContractionHierarchy<StaticGraph<>, int64_t> hierarchy(graph, arc_lengths);
+//   const std::vector<std::vector<int64_t>> matrix =
+//       hierarchy.ManyToManyDistances(stops, stops);
+//
+// Reference: R. Geisberger, P. Sanders, D. Schultes, D. Delling, "Contraction
+// Hierarchies: Faster and Simpler Hierarchical Routing in Road Networks",
+// WEA 2008.
+
+#ifndef OR_TOOLS_GRAPH_CONTRACTION_HIERARCHIES_H_
+#define OR_TOOLS_GRAPH_CONTRACTION_HIERARCHIES_H_
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+
+namespace operations_research {
+
+// The graph must implement the interface described in graph.h; only outgoing
+// arcs are used. Arc lengths must be non-negative, and the length of any path
+// must fit in DistanceType. Self-arcs and duplicate arcs are supported.
+//
+// The preprocessed hierarchy does not depend on the graph, which can be
+// destroyed after construction. Queries use internal buffers: they are not
+// thread-safe, but the class can be copied to run queries on several threads.
+template <class GraphType, class DistanceType>
+class ContractionHierarchy {
+ public:
+  typedef typename GraphType::NodeIndex NodeIndex;
+
+  // Distance returned for unreachable nodes.
+  static constexpr DistanceType kInfinity =
+      std::numeric_limits<DistanceType>::max();
+
+  // Preprocesses the graph. 'arc_lengths[arc]' is the length of 'arc'.
+  // 'max_witness_settled_nodes' bounds the number of nodes settled by each
+  // witness search; larger values lead to fewer shortcuts, and therefore to
+  // faster queries, at the expense of a slower preprocessing.
+  ContractionHierarchy(const GraphType& graph,
+                       absl::Span<const DistanceType> arc_lengths,
+                       int max_witness_settled_nodes = 500);
+
+  int num_nodes() const { return rank_.size(); }
+  // Number of shortcut arcs added by the preprocessing.
+  int num_shortcuts() const { return num_shortcuts_; }
+  // Position of 'node' in the contraction order.
+  int Rank(NodeIndex node) const { return rank_[node]; }
+
+  // Returns the length of a shortest path from 'source' to 'destination', or
+  // kInfinity if there is none.
+  DistanceType Distance(NodeIndex source, NodeIndex destination);
+
+  // Same as Distance(), and fills 'path' with the nodes of a shortest path,
+  // including 'source' and 'destination'. 'path' is empty if there is no path.
+  DistanceType ShortestPath(NodeIndex source, NodeIndex destination,
+                            std::vector<NodeIndex>* path);
+
+  // Returns the matrix of the shortest path lengths from each source to each
+  // destination: result[i][j] is the distance from sources[i] to
+  // destinations[j], or kInfinity if there is no path.
+  std::vector<std::vector<DistanceType>> ManyToManyDistances(
+      absl::Span<const NodeIndex> sources,
+      absl::Span<const NodeIndex> destinations);
+
+ private:
+  // Arc of the hierarchy. 'middle' is the node contracted when adding a
+  // shortcut arc, -1 for arcs of the original graph.
+  struct Arc {
+    NodeIndex node;
+    DistanceType length;
+    NodeIndex middle;
+  };
+  // Node with a distance, ordered for a min-priority queue.
+  struct NodeDistance {
+    DistanceType distance;
+    NodeIndex node;
+    bool operator<(const NodeDistance& other) const {
+      return distance > other.distance;
+    }
+  };
+  // Arcs stored per node, in compressed sparse row format.
+  struct ArcLists {
+    std::vector<int> starts;
+    std::vector<Arc> arcs;
+    absl::Span<const Arc> ArcsOf(NodeIndex node) const {
+      return absl::MakeConstSpan(arcs.data() + starts[node],
+                                 starts[node + 1] - starts[node]);
+    }
+  };
+  // Buffers of a search on the upward arcs of the hierarchy.
+  struct Search {
+    std::vector<DistanceType> distances;
+    std::vector<NodeIndex> parents;
+    std::vector<NodeIndex> reached;
+    std::priority_queue<NodeDistance> queue;
+  };
+
+  // Preprocessing.
+  void Contract(const GraphType& graph,
+                absl::Span<const DistanceType> arc_lengths);
+  // Returns the number of shortcuts needed to contract 'node', and adds them
+  // to the graph being contracted if 'add_shortcuts' is true.
+  int ContractNode(NodeIndex node, bool add_shortcuts);
+  // Runs a Dijkstra from 'source' on the graph being contracted, without going
+  // through 'excluded', up to 'max_distance'.
+  void WitnessSearch(NodeIndex source, NodeIndex excluded,
+                     DistanceType max_distance);
+  int Priority(NodeIndex node) {
+    return ContractNode(node, /*add_shortcuts=*/false) -
+           static_cast<int>(in_arcs_[node].size() + out_arcs_[node].size()) +
+           num_contracted_neighbors_[node];
+  }
+  static void AddOrImproveArc(std::vector<Arc>* arcs, const Arc& arc);
+  static void RemoveArcsTo(std::vector<Arc>* arcs, NodeIndex node);
+
+  // Queries.
+  void ClearSearch(Search* search);
+  // Settles the closest node in the queue of 'search' on the arcs of
+  // 'up_arcs'; returns it, or -1 if the queue only contains outdated entries.
+  NodeIndex SettleNext(const ArcLists& up_arcs, Search* search);
+  // Runs a full upward search from 'node'.
+  void RunUpwardSearch(NodeIndex node, const ArcLists& up_arcs,
+                       Search* search);
+  // Runs a bidirectional query, returns the distance and the meeting node.
+  std::pair<DistanceType, NodeIndex> RunQuery(NodeIndex source,
+                                              NodeIndex destination);
+  // Appends the nodes of the original path corresponding to the hierarchy arc
+  // 'tail' -> 'head' to 'path', excluding 'tail'.
+  void UnpackArc(NodeIndex tail, NodeIndex head,
+                 std::vector<NodeIndex>* path) const;
+  static const Arc* FindArc(absl::Span<const Arc> arcs, NodeIndex node);
+
+  const int max_witness_settled_nodes_;
+  int num_shortcuts_ = 0;
+  std::vector<int> rank_;
+  // forward_up_arcs_ contains the arcs node -> arc.node of the hierarchy
+  // going up in rank, and backward_up_arcs_ the arcs arc.node -> node going
+  // up in rank.
+  ArcLists forward_up_arcs_;
+  ArcLists backward_up_arcs_;
+
+  // Graph being contracted; only used during preprocessing.
+  std::vector<std::vector<Arc>> out_arcs_;
+  std::vector<std::vector<Arc>> in_arcs_;
+  std::vector<bool> contracted_;
+  std::vector<int> num_contracted_neighbors_;
+  std::vector<DistanceType> witness_distances_;
+  std::vector<NodeIndex> witness_reached_;
+
+  Search forward_search_;
+  Search backward_search_;
+};
+
+// Implementation.
+
+template <class GraphType, class DistanceType>
+ContractionHierarchy<GraphType, DistanceType>::ContractionHierarchy(
+    const GraphType& graph, absl::Span<const DistanceType> arc_lengths,
+    int max_witness_settled_nodes)
+    : max_witness_settled_nodes_(max_witness_settled_nodes) {
+  CHECK_EQ(arc_lengths.size(), graph.num_arcs());
+  CHECK_GT(max_witness_settled_nodes, 0);
+  Contract(graph, arc_lengths);
+  const int num_nodes = rank_.size();
+  for (Search* search : {&forward_search_, &backward_search_}) {
+    search->distances.assign(num_nodes, kInfinity);
+    search->parents.assign(num_nodes, -1);
+  }
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::AddOrImproveArc(
+    std::vector<Arc>* arcs, const Arc& arc) {
+  for (Arc& existing : *arcs) {
+    if (existing.node == arc.node) {
+      if (arc.length < existing.length) existing = arc;
+      return;
+    }
+  }
+  arcs->push_back(arc);
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::RemoveArcsTo(
+    std::vector<Arc>* arcs, NodeIndex node) {
+  arcs->erase(
+      std::remove_if(arcs->begin(), arcs->end(),
+                     [node](const Arc& arc) { return arc.node == node; }),
+      arcs->end());
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::Contract(
+    const GraphType& graph, absl::Span<const DistanceType> arc_lengths) {
+  const int num_nodes = graph.num_nodes();
+  out_arcs_.assign(num_nodes, {});
+  in_arcs_.assign(num_nodes, {});
+  contracted_.assign(num_nodes, false);
+  num_contracted_neighbors_.assign(num_nodes, 0);
+  witness_distances_.assign(num_nodes, kInfinity);
+  for (NodeIndex tail = 0; tail < num_nodes; ++tail) {
+    for (const auto arc : graph.OutgoingArcs(tail)) {
+      const NodeIndex head = graph.Head(arc);
+      DCHECK_GE(arc_lengths[arc], 0);
+      if (head == tail) continue;
+      AddOrImproveArc(&out_arcs_[tail], {head, arc_lengths[arc], -1});
+      AddOrImproveArc(&in_arcs_[head], {tail, arc_lengths[arc], -1});
+    }
+  }
+
+  // Nodes are contracted by increasing priority. Priorities only increase
+  // when neighbors are contracted, and are updated lazily: the node of lowest
+  // priority is contracted if its priority is still lower than the others
+  // once recomputed.
+  typedef std::pair<int, NodeIndex> PriorityNode;
+  std::priority_queue<PriorityNode, std::vector<PriorityNode>,
+                      std::greater<PriorityNode>>
+      queue;
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    queue.push({Priority(node), node});
+  }
+  rank_.assign(num_nodes, -1);
+  std::vector<std::vector<Arc>> forward_up_arcs(num_nodes);
+  std::vector<std::vector<Arc>> backward_up_arcs(num_nodes);
+  int rank = 0;
+  while (!queue.empty()) {
+    const NodeIndex node = queue.top().second;
+    queue.pop();
+    if (contracted_[node]) continue;
+    const int priority = Priority(node);
+    if (!queue.empty() && priority > queue.top().first) {
+      queue.push({priority, node});
+      continue;
+    }
+    rank_[node] = rank++;
+    // The remaining arcs of the node all go to nodes contracted later.
+    forward_up_arcs[node] = out_arcs_[node];
+    backward_up_arcs[node] = in_arcs_[node];
+    num_shortcuts_ += ContractNode(node, /*add_shortcuts=*/true);
+    contracted_[node] = true;
+    for (const Arc& arc : out_arcs_[node]) {
+      RemoveArcsTo(&in_arcs_[arc.node], node);
+      ++num_contracted_neighbors_[arc.node];
+    }
+    for (const Arc& arc : in_arcs_[node]) {
+      RemoveArcsTo(&out_arcs_[arc.node], node);
+      ++num_contracted_neighbors_[arc.node];
+    }
+    std::vector<Arc>().swap(out_arcs_[node]);
+    std::vector<Arc>().swap(in_arcs_[node]);
+  }
+
+  for (auto [up_arcs, arc_lists] :
+       {std::make_pair(&forward_up_arcs, &forward_up_arcs_),
+        std::make_pair(&backward_up_arcs, &backward_up_arcs_)}) {
+    arc_lists->starts.assign(1, 0);
+    arc_lists->arcs.clear();
+    for (const std::vector<Arc>& arcs : *up_arcs) {
+      arc_lists->arcs.insert(arc_lists->arcs.end(), arcs.begin(), arcs.end());
+      arc_lists->starts.push_back(arc_lists->arcs.size());
+    }
+  }
+  out_arcs_.clear();
+  in_arcs_.clear();
+  contracted_.clear();
+  num_contracted_neighbors_.clear();
+  witness_distances_.clear();
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::WitnessSearch(
+    NodeIndex source, NodeIndex excluded, DistanceType max_distance) {
+  for (const NodeIndex node : witness_reached_) {
+    witness_distances_[node] = kInfinity;
+  }
+  witness_reached_.clear();
+  std::priority_queue<NodeDistance> queue;
+  witness_distances_[source] = 0;
+  witness_reached_.push_back(source);
+  queue.push({0, source});
+  int num_settled = 0;
+  while (!queue.empty() && num_settled < max_witness_settled_nodes_) {
+    const NodeDistance top = queue.top();
+    queue.pop();
+    if (top.distance > witness_distances_[top.node]) continue;
+    if (top.distance > max_distance) break;
+    ++num_settled;
+    for (const Arc& arc : out_arcs_[top.node]) {
+      if (arc.node == excluded) continue;
+      const DistanceType distance = top.distance + arc.length;
+      if (distance < witness_distances_[arc.node]) {
+        if (witness_distances_[arc.node] == kInfinity) {
+          witness_reached_.push_back(arc.node);
+        }
+        witness_distances_[arc.node] = distance;
+        queue.push({distance, arc.node});
+      }
+    }
+  }
+}
+
+template <class GraphType, class DistanceType>
+int ContractionHierarchy<GraphType, DistanceType>::ContractNode(
+    NodeIndex node, bool add_shortcuts) {
+  const std::vector<Arc>& in_arcs = in_arcs_[node];
+  const std::vector<Arc>& out_arcs = out_arcs_[node];
+  if (in_arcs.empty() || out_arcs.empty()) return 0;
+  DistanceType max_out_length = 0;
+  for (const Arc& out_arc : out_arcs) {
+    max_out_length = std::max(max_out_length, out_arc.length);
+  }
+  int num_shortcuts = 0;
+  std::vector<Arc> shortcuts;
+  for (const Arc& in_arc : in_arcs) {
+    const NodeIndex tail = in_arc.node;
+    WitnessSearch(tail, node, in_arc.length + max_out_length);
+    for (const Arc& out_arc : out_arcs) {
+      const NodeIndex head = out_arc.node;
+      if (head == tail) continue;
+      const DistanceType length = in_arc.length + out_arc.length;
+      if (witness_distances_[head] <= length) continue;
+      ++num_shortcuts;
+      if (add_shortcuts) shortcuts.push_back({head, length, tail});
+    }
+    // Shortcuts are added once all the witness searches from 'tail' are done,
+    // since they modify the graph being searched. Here 'Arc::middle' is
+    // temporarily used to store the tail of the shortcut.
+    for (const Arc& shortcut : shortcuts) {
+      AddOrImproveArc(&out_arcs_[shortcut.middle],
+                      {shortcut.node, shortcut.length, node});
+      AddOrImproveArc(&in_arcs_[shortcut.node],
+                      {shortcut.middle, shortcut.length, node});
+    }
+    shortcuts.clear();
+  }
+  return num_shortcuts;
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::ClearSearch(
+    Search* search) {
+  for (const NodeIndex node : search->reached) {
+    search->distances[node] = kInfinity;
+    search->parents[node] = -1;
+  }
+  search->reached.clear();
+  search->queue = {};
+}
+
+template <class GraphType, class DistanceType>
+typename ContractionHierarchy<GraphType, DistanceType>::NodeIndex
+ContractionHierarchy<GraphType, DistanceType>::SettleNext(
+    const ArcLists& up_arcs, Search* search) {
+  const NodeDistance top = search->queue.top();
+  search->queue.pop();
+  if (top.distance > search->distances[top.node]) return -1;
+  for (const Arc& arc : up_arcs.ArcsOf(top.node)) {
+    const DistanceType distance = top.distance + arc.length;
+    if (distance < search->distances[arc.node]) {
+      if (search->distances[arc.node] == kInfinity) {
+        search->reached.push_back(arc.node);
+      }
+      search->distances[arc.node] = distance;
+      search->parents[arc.node] = top.node;
+      search->queue.push({distance, arc.node});
+    }
+  }
+  return top.node;
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::RunUpwardSearch(
+    NodeIndex node, const ArcLists& up_arcs, Search* search) {
+  ClearSearch(search);
+  search->distances[node] = 0;
+  search->reached.push_back(node);
+  search->queue.push({0, node});
+  while (!search->queue.empty()) SettleNext(up_arcs, search);
+}
+
+template <class GraphType, class DistanceType>
+std::pair<DistanceType, typename GraphType::NodeIndex>
+ContractionHierarchy<GraphType, DistanceType>::RunQuery(
+    NodeIndex source, NodeIndex destination) {
+  DCHECK_GE(source, 0);
+  DCHECK_LT(source, num_nodes());
+  DCHECK_GE(destination, 0);
+  DCHECK_LT(destination, num_nodes());
+  ClearSearch(&forward_search_);
+  ClearSearch(&backward_search_);
+  forward_search_.distances[source] = 0;
+  forward_search_.reached.push_back(source);
+  forward_search_.queue.push({0, source});
+  backward_search_.distances[destination] = 0;
+  backward_search_.reached.push_back(destination);
+  backward_search_.queue.push({0, destination});
+
+  // The searches alternate, and each one stops once its closest node is
+  // farther than the best path found; upward searches do not meet at the
+  // first common node as plain bidirectional searches do.
+  DistanceType best_distance = kInfinity;
+  NodeIndex meeting_node = -1;
+  bool forward = true;
+  while (true) {
+    const bool forward_done =
+        forward_search_.queue.empty() ||
+        forward_search_.queue.top().distance >= best_distance;
+    const bool backward_done =
+        backward_search_.queue.empty() ||
+        backward_search_.queue.top().distance >= best_distance;
+    if (forward_done && backward_done) break;
+    if (forward_done) forward = false;
+    if (backward_done) forward = true;
+    Search* const search = forward ? &forward_search_ : &backward_search_;
+    const Search& other = forward ? backward_search_ : forward_search_;
+    const NodeIndex node =
+        SettleNext(forward ? forward_up_arcs_ : backward_up_arcs_, search);
+    if (node != -1 && other.distances[node] != kInfinity) {
+      const DistanceType distance =
+          search->distances[node] + other.distances[node];
+      if (distance < best_distance) {
+        best_distance = distance;
+        meeting_node = node;
+      }
+    }
+    forward = !forward;
+  }
+  return {best_distance, meeting_node};
+}
+
+template <class GraphType, class DistanceType>
+DistanceType ContractionHierarchy<GraphType, DistanceType>::Distance(
+    NodeIndex source, NodeIndex destination) {
+  return RunQuery(source, destination).first;
+}
+
+template <class GraphType, class DistanceType>
+const typename ContractionHierarchy<GraphType, DistanceType>::Arc*
+ContractionHierarchy<GraphType, DistanceType>::FindArc(
+    absl::Span<const Arc> arcs, NodeIndex node) {
+  for (const Arc& arc : arcs) {
+    if (arc.node == node) return &arc;
+  }
+  return nullptr;
+}
+
+template <class GraphType, class DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::UnpackArc(
+    NodeIndex tail, NodeIndex head, std::vector<NodeIndex>* path) const {
+  // The arc is stored on its endpoint of lowest rank.
+  const Arc* const arc =
+      rank_[tail] < rank_[head]
+          ? FindArc(forward_up_arcs_.ArcsOf(tail), head)
+          : FindArc(backward_up_arcs_.ArcsOf(head), tail);
+  DCHECK(arc != nullptr);
+  if (arc->middle == -1) {
+    path->push_back(head);
+    return;
+  }
+  UnpackArc(tail, arc->middle, path);
+  UnpackArc(arc->middle, head, path);
+}
+
+template <class GraphType, class DistanceType>
+DistanceType ContractionHierarchy<GraphType, DistanceType>::ShortestPath(
+    NodeIndex source, NodeIndex destination, std::vector<NodeIndex>* path) {
+  path->clear();
+  const auto [distance, meeting_node] = RunQuery(source, destination);
+  if (meeting_node == -1) return distance;
+  // Hierarchy nodes from the source to the meeting node, then to the
+  // destination.
+  std::vector<NodeIndex> nodes;
+  for (NodeIndex node = meeting_node; node != -1;
+       node = forward_search_.parents[node]) {
+    nodes.push_back(node);
+  }
+  std::reverse(nodes.begin(), nodes.end());
+  for (NodeIndex node = backward_search_.parents[meeting_node]; node != -1;
+       node = backward_search_.parents[node]) {
+    nodes.push_back(node);
+  }
+  path->push_back(source);
+  for (int i = 1; i < nodes.size(); ++i) {
+    UnpackArc(nodes[i - 1], nodes[i], path);
+  }
+  return distance;
+}
+
+template <class GraphType, class DistanceType>
+std::vector<std::vector<DistanceType>>
+ContractionHierarchy<GraphType, DistanceType>::ManyToManyDistances(
+    absl::Span<const NodeIndex> sources,
+    absl::Span<const NodeIndex> destinations) {
+  // Buckets: for each node reached by the backward search of a destination,
+  // the index of the destination and the distance from the node to it, stored
+  // in compressed sparse row format.
+  struct BucketEntry {
+    NodeIndex node;
+    int destination;
+    DistanceType distance;
+  };
+  std::vector<BucketEntry> entries;
+  for (int j = 0; j < destinations.size(); ++j) {
+    RunUpwardSearch(destinations[j], backward_up_arcs_, &backward_search_);
+    for (const NodeIndex node : backward_search_.reached) {
+      entries.push_back({node, j, backward_search_.distances[node]});
+    }
+  }
+  std::vector<int> bucket_starts(num_nodes() + 1, 0);
+  for (const BucketEntry& entry : entries) ++bucket_starts[entry.node + 1];
+  for (int node = 0; node < num_nodes(); ++node) {
+    bucket_starts[node + 1] += bucket_starts[node];
+  }
+  std::vector<std::pair<int, DistanceType>> buckets(entries.size());
+  {
+    std::vector<int> positions(bucket_starts.begin(), bucket_starts.end() - 1);
+    for (const BucketEntry& entry : entries) {
+      buckets[positions[entry.node]++] = {entry.destination, entry.distance};
+    }
+  }
+  std::vector<BucketEntry>().swap(entries);
+
+  std::vector<std::vector<DistanceType>> distances(
+      sources.size(),
+      std::vector<DistanceType>(destinations.size(), kInfinity));
+  for (int i = 0; i < sources.size(); ++i) {
+    std::vector<DistanceType>& row = distances[i];
+    RunUpwardSearch(sources[i], forward_up_arcs_, &forward_search_);
+    for (const NodeIndex node : forward_search_.reached) {
+      const DistanceType forward_distance = forward_search_.distances[node];
+      for (int b = bucket_starts[node]; b < bucket_starts[node + 1]; ++b) {
+        const auto [j, backward_distance] = buckets[b];
+        row[j] = std::min(row[j], forward_distance + backward_distance);
+      }
+    }
+  }
+  return distances;
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_CONTRACTION_HIERARCHIES_H_
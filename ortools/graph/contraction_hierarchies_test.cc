@@ -0,0 +1,136 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/contraction_hierarchies.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/graph.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::util::ListGraph;
+
+TEST(ContractionHierarchyTest, SmallGraph) {
+  // 0 -> 1 -> 2 -> 3 is shorter than the direct arc 0 -> 3.
+  ListGraph<> graph;
+  std::vector<int64_t> arc_lengths;
+  graph.AddArc(0, 1);
+  arc_lengths.push_back(1);
+  graph.AddArc(1, 2);
+  arc_lengths.push_back(2);
+  graph.AddArc(2, 3);
+  arc_lengths.push_back(3);
+  graph.AddArc(0, 3);
+  arc_lengths.push_back(10);
+  graph.AddArc(3, 3);
+  arc_lengths.push_back(0);
+  graph.AddNode(4);
+  ContractionHierarchy<ListGraph<>, int64_t> hierarchy(graph, arc_lengths);
+  EXPECT_EQ(hierarchy.num_nodes(), 5);
+  EXPECT_EQ(hierarchy.Distance(0, 3), 6);
+  EXPECT_EQ(hierarchy.Distance(3, 0),
+            (ContractionHierarchy<ListGraph<>, int64_t>::kInfinity));
+  EXPECT_EQ(hierarchy.Distance(2, 2), 0);
+  std::vector<int> path;
+  EXPECT_EQ(hierarchy.ShortestPath(0, 3, &path), 6);
+  EXPECT_THAT(path, ElementsAre(0, 1, 2, 3));
+  EXPECT_EQ(hierarchy.ShortestPath(1, 1, &path), 0);
+  EXPECT_THAT(path, ElementsAre(1));
+  hierarchy.ShortestPath(0, 4, &path);
+  EXPECT_THAT(path, IsEmpty());
+}
+
+TEST(ContractionHierarchyTest, RandomGraphs) {
+  std::mt19937 random(12345);
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    const int num_nodes = absl::Uniform(random, 1, 60);
+    const int num_arcs = absl::Uniform(random, 0, 4 * num_nodes);
+    ListGraph<> graph(num_nodes, num_arcs);
+    std::vector<int64_t> arc_lengths;
+    // Floyd-Warshall distances, used as reference.
+    const int64_t kInfinity =
+        ContractionHierarchy<ListGraph<>, int64_t>::kInfinity;
+    std::vector<std::vector<int64_t>> expected(
+        num_nodes, std::vector<int64_t>(num_nodes, kInfinity));
+    for (int node = 0; node < num_nodes; ++node) expected[node][node] = 0;
+    for (int arc = 0; arc < num_arcs; ++arc) {
+      const int tail = absl::Uniform(random, 0, num_nodes);
+      const int head = absl::Uniform(random, 0, num_nodes);
+      const int64_t length = absl::Uniform(random, 0, 100);
+      graph.AddArc(tail, head);
+      arc_lengths.push_back(length);
+      expected[tail][head] = std::min(expected[tail][head], length);
+    }
+    for (int k = 0; k < num_nodes; ++k) {
+      for (int i = 0; i < num_nodes; ++i) {
+        if (expected[i][k] == kInfinity) continue;
+        for (int j = 0; j < num_nodes; ++j) {
+          if (expected[k][j] == kInfinity) continue;
+          expected[i][j] =
+              std::min(expected[i][j], expected[i][k] + expected[k][j]);
+        }
+      }
+    }
+
+    // A small witness search limit leads to more shortcuts, which must not
+    // change the distances.
+    for (const int max_witness_settled_nodes : {1, 500}) {
+      ContractionHierarchy<ListGraph<>, int64_t> hierarchy(
+          graph, arc_lengths, max_witness_settled_nodes);
+      std::vector<int> nodes(num_nodes);
+      for (int node = 0; node < num_nodes; ++node) nodes[node] = node;
+      EXPECT_EQ(hierarchy.ManyToManyDistances(nodes, nodes), expected);
+      for (int source = 0; source < num_nodes; ++source) {
+        for (int destination = 0; destination < num_nodes; ++destination) {
+          ASSERT_EQ(hierarchy.Distance(source, destination),
+                    expected[source][destination]);
+          std::vector<int> path;
+          hierarchy.ShortestPath(source, destination, &path);
+          if (expected[source][destination] == kInfinity) {
+            EXPECT_THAT(path, IsEmpty());
+            continue;
+          }
+          // The path must be a path of the graph, of the expected length.
+          ASSERT_FALSE(path.empty());
+          EXPECT_EQ(path.front(), source);
+          EXPECT_EQ(path.back(), destination);
+          int64_t length = 0;
+          for (int i = 1; i < path.size(); ++i) {
+            int64_t arc_length = kInfinity;
+            for (const int arc : graph.OutgoingArcs(path[i - 1])) {
+              if (graph.Head(arc) == path[i]) {
+                arc_length = std::min(arc_length, arc_lengths[arc]);
+              }
+            }
+            ASSERT_NE(arc_length, kInfinity);
+            length += arc_length;
+          }
+          EXPECT_EQ(length, expected[source][destination]);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
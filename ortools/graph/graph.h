@@ -155,6 +155,7 @@
 #define UTIL_GRAPH_GRAPH_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -162,7 +163,9 @@
 #include <iterator>
 #include <limits>
 #include <new>
+#include <thread>  // NOLINT
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/base/port.h"
@@ -428,6 +431,14 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
   static StaticGraph FromArcs(NodeIndexType num_nodes,
                               const ArcContainer& arcs);
 
+  // Shortcut to directly create a finalized graph from its arrays, without
+  // sorting anything: the outgoing arcs of node n are the arcs in
+  // [start[n], start[n + 1]) (or [start[n], heads.size()) for the last node),
+  // and heads[arc] is the head of arc. This is how the binary graph files of
+  // io.h are loaded.
+  static StaticGraph FromStartAndHeads(std::vector<ArcIndexType> start,
+                                       std::vector<NodeIndexType> heads);
+
   // Do not use directly. See instead the arc iteration functions below.
   class OutgoingArcIterator;
 
@@ -448,9 +459,18 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
   void AddNode(NodeIndexType node);
   ArcIndexType AddArc(NodeIndexType tail, NodeIndexType head);
 
+  // Same as calling AddArc(tails[i], heads[i]) for all i, in order, but
+  // faster. The new arcs get the indices [num_arcs(), num_arcs() + size).
+  void AddArcs(absl::Span<const NodeIndexType> tails,
+               absl::Span<const NodeIndexType> heads);
+
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
 
+  // Same as Build(permutation), but sorts the arcs by tail with num_threads
+  // threads. The graph and the permutation are the same as with Build().
+  void Build(std::vector<ArcIndexType>* permutation, int num_threads);
+
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
     DCHECK(is_built_);
@@ -624,9 +644,18 @@ class ReverseArcStaticGraph
   void AddNode(NodeIndexType node);
   ArcIndexType AddArc(NodeIndexType tail, NodeIndexType head);
 
+  // Same as calling AddArc(tails[i], heads[i]) for all i, in order.
+  void AddArcs(absl::Span<const NodeIndexType> tails,
+               absl::Span<const NodeIndexType> heads);
+
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
 
+  // Same as Build(permutation), but sorts the arcs by tail and the reverse
+  // arcs by head with num_threads threads. The graph and the permutation are
+  // the same as with Build().
+  void Build(std::vector<ArcIndexType>* permutation, int num_threads);
+
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
     DCHECK(is_built_);
@@ -1274,6 +1303,70 @@ class ListGraph<NodeIndexType, ArcIndexType>::OutgoingHeadIterator {
   ArcIndexType index_;
 };
 
+// Parallel Build() helpers ---------------------------------------------------
+
+namespace internal {
+
+// Calls f(begin, end) on num_threads consecutive chunks of [0, size), each in
+// its own thread, and waits for all of them.
+template <typename IndexType, typename F>
+void ParallelForChunks(int num_threads, IndexType size, const F& f) {
+  const int64_t chunk_size =
+      (static_cast<int64_t>(size) + num_threads - 1) / num_threads;
+  std::vector<std::thread> threads;
+  for (int64_t begin = chunk_size; begin < size; begin += chunk_size) {
+    const int64_t end = std::min<int64_t>(begin + chunk_size, size);
+    threads.emplace_back(f, static_cast<IndexType>(begin),
+                         static_cast<IndexType>(end));
+  }
+  f(IndexType{0}, static_cast<IndexType>(std::min<int64_t>(chunk_size, size)));
+  for (std::thread& thread : threads) thread.join();
+}
+
+// Stable counting sort of the indices [0, keys.size()) by key, using
+// num_threads threads. On return, (*start)[k] is the number of indices with a
+// key smaller than k, and (*positions)[i] is the rank of index i in the sorted
+// order. The memory used is O(num_keys + keys.size()) whatever the number of
+// threads: the indices are distributed with atomic counters, and the indices
+// with the same key are sorted afterwards.
+template <typename KeyType, typename IndexType>
+void ParallelCountingSort(absl::Span<const KeyType> keys, KeyType num_keys,
+                          int num_threads, std::vector<IndexType>* start,
+                          std::vector<IndexType>* positions) {
+  const IndexType size = keys.size();
+  std::vector<std::atomic<IndexType>> next(num_keys);
+  ParallelForChunks(num_threads, size, [&](IndexType begin, IndexType end) {
+    for (IndexType i = begin; i < end; ++i) {
+      next[keys[i]].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  start->resize(num_keys);
+  IndexType sum = 0;
+  for (KeyType k = 0; k < num_keys; ++k) {
+    (*start)[k] = sum;
+    sum += next[k].load(std::memory_order_relaxed);
+    next[k].store((*start)[k], std::memory_order_relaxed);
+  }
+  std::vector<IndexType> order(size);
+  ParallelForChunks(num_threads, size, [&](IndexType begin, IndexType end) {
+    for (IndexType i = begin; i < end; ++i) {
+      order[next[keys[i]].fetch_add(1, std::memory_order_relaxed)] = i;
+    }
+  });
+  ParallelForChunks(num_threads, num_keys, [&](KeyType begin, KeyType end) {
+    for (KeyType k = begin; k < end; ++k) {
+      const IndexType limit = k + 1 < num_keys ? (*start)[k + 1] : size;
+      std::sort(order.begin() + (*start)[k], order.begin() + limit);
+    }
+  });
+  positions->resize(size);
+  ParallelForChunks(num_threads, size, [&](IndexType begin, IndexType end) {
+    for (IndexType i = begin; i < end; ++i) (*positions)[order[i]] = i;
+  });
+}
+
+}  // namespace internal
+
 // StaticGraph implementation --------------------------------------------------
 
 template <typename NodeIndexType, typename ArcIndexType>
@@ -1287,6 +1380,31 @@ StaticGraph<NodeIndexType, ArcIndexType>::FromArcs(NodeIndexType num_nodes,
   return g;
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>::FromStartAndHeads(
+    std::vector<ArcIndexType> start, std::vector<NodeIndexType> heads) {
+  StaticGraph g;
+  g.num_nodes_ = start.size();
+  g.num_arcs_ = heads.size();
+  g.start_ = std::move(start);
+  g.head_ = std::move(heads);
+  g.is_built_ = true;
+  g.node_capacity_ = g.num_nodes_;
+  g.arc_capacity_ = g.num_arcs_;
+  g.FreezeCapacities();
+  DCHECK(g.num_nodes_ > 0 ? g.start_[0] == 0 : g.num_arcs_ == 0);
+  g.tail_.resize(g.num_arcs_);
+  for (const NodeIndexType node : g.AllNodes()) {
+    DCHECK_LE(g.start_[node], g.DirectArcLimit(node));
+    for (const ArcIndexType arc : g.OutgoingArcs(node)) {
+      DCHECK(g.IsNodeValid(g.head_[arc]));
+      g.tail_[arc] = node;
+    }
+  }
+  return g;
+}
+
 DEFINE_RANGE_BASED_ARC_ITERATION(StaticGraph, Outgoing, DirectArcLimit(node));
 
 template <typename NodeIndexType, typename ArcIndexType>
@@ -1347,6 +1465,34 @@ ArcIndexType StaticGraph<NodeIndexType, ArcIndexType>::AddArc(
   return num_arcs_++;
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void StaticGraph<NodeIndexType, ArcIndexType>::AddArcs(
+    absl::Span<const NodeIndexType> tails,
+    absl::Span<const NodeIndexType> heads) {
+  CHECK_EQ(tails.size(), heads.size());
+  DCHECK(!is_built_);
+  if (tails.empty()) return;
+  NodeIndexType max_node = 0;
+  for (size_t i = 0; i < tails.size(); ++i) {
+    DCHECK_GE(tails[i], 0);
+    DCHECK_GE(heads[i], 0);
+    max_node = std::max(max_node, std::max(tails[i], heads[i]));
+  }
+  AddNode(max_node);
+  for (size_t i = 0; arc_in_order_ && i < tails.size(); ++i) {
+    if (tails[i] >= last_tail_seen_) {
+      start_[tails[i]]++;
+      last_tail_seen_ = tails[i];
+    } else {
+      arc_in_order_ = false;
+    }
+  }
+  tail_.insert(tail_.end(), tails.begin(), tails.end());
+  head_.insert(head_.end(), heads.begin(), heads.end());
+  DCHECK(!const_capacities_ || num_arcs_ + tails.size() <= arc_capacity_);
+  num_arcs_ += tails.size();
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 NodeIndexType StaticGraph<NodeIndexType, ArcIndexType>::Tail(
     ArcIndexType arc) const {
@@ -1432,6 +1578,41 @@ void StaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void StaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation, int num_threads) {
+  DCHECK_GE(num_threads, 1);
+  if (num_threads <= 1 || arc_in_order_) {
+    Build(permutation);
+    return;
+  }
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+
+  std::vector<ArcIndexType> perm;
+  internal::ParallelCountingSort<NodeIndexType, ArcIndexType>(
+      tail_, num_nodes_, num_threads, &start_, &perm);
+  std::vector<NodeIndexType> heads(num_arcs_);
+  heads.swap(head_);
+  internal::ParallelForChunks(
+      num_threads, num_arcs_, [&](ArcIndexType begin, ArcIndexType end) {
+        for (ArcIndexType i = begin; i < end; ++i) head_[perm[i]] = heads[i];
+      });
+  internal::ParallelForChunks(
+      num_threads, num_nodes_, [&](NodeIndexType begin, NodeIndexType end) {
+        for (NodeIndexType node = begin; node < end; ++node) {
+          for (const ArcIndexType arc : OutgoingArcs(node)) tail_[arc] = node;
+        }
+      });
+  if (permutation != nullptr) {
+    permutation->swap(perm);
+  }
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class StaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
@@ -1802,6 +1983,26 @@ ArcIndexType ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::AddArc(
   return num_arcs_++;
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::AddArcs(
+    absl::Span<const NodeIndexType> tails,
+    absl::Span<const NodeIndexType> heads) {
+  CHECK_EQ(tails.size(), heads.size());
+  DCHECK(!is_built_);
+  NodeIndexType max_node = 0;
+  for (size_t i = 0; i < tails.size(); ++i) {
+    DCHECK_GE(tails[i], 0);
+    DCHECK_GE(heads[i], 0);
+    max_node = std::max(max_node, std::max(tails[i], heads[i]));
+  }
+  if (!tails.empty()) AddNode(max_node);
+  for (size_t i = 0; i < tails.size(); ++i) {
+    head_.grow(heads[i], tails[i]);
+  }
+  DCHECK(!const_capacities_ || num_arcs_ + tails.size() <= arc_capacity_);
+  num_arcs_ += tails.size();
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
     std::vector<ArcIndexType>* permutation) {
@@ -1847,6 +2048,75 @@ void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation, int num_threads) {
+  DCHECK_GE(num_threads, 1);
+  if (num_threads <= 1) {
+    Build(permutation);
+    return;
+  }
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+
+  // The tails are in the positive range of head_, and the heads in the
+  // negative range, see AddArc().
+  std::vector<NodeIndexType> tails(num_arcs_);
+  std::vector<NodeIndexType> heads(num_arcs_);
+  internal::ParallelForChunks(
+      num_threads, num_arcs_, [&](ArcIndexType begin, ArcIndexType end) {
+        for (ArcIndexType i = begin; i < end; ++i) {
+          tails[i] = head_[i];
+          heads[i] = head_[~i];
+        }
+      });
+  const bool permutation_needed = !std::is_sorted(tails.begin(), tails.end());
+  std::vector<ArcIndexType> perm;
+  internal::ParallelCountingSort<NodeIndexType, ArcIndexType>(
+      tails, num_nodes_, num_threads, &start_, &perm);
+
+  // Sorts the forward arcs by tail, then the reverse arcs by head.
+  std::vector<NodeIndexType> sorted_tails(num_arcs_);
+  std::vector<NodeIndexType> sorted_heads(num_arcs_);
+  internal::ParallelForChunks(
+      num_threads, num_arcs_, [&](ArcIndexType begin, ArcIndexType end) {
+        for (ArcIndexType i = begin; i < end; ++i) {
+          sorted_tails[perm[i]] = tails[i];
+          sorted_heads[perm[i]] = heads[i];
+        }
+      });
+  std::vector<ArcIndexType> reverse_positions;
+  internal::ParallelCountingSort<NodeIndexType, ArcIndexType>(
+      sorted_heads, num_nodes_, num_threads, &reverse_start_,
+      &reverse_positions);
+  opposite_.resize(num_arcs_);
+  internal::ParallelForChunks(
+      num_threads, num_arcs_, [&](ArcIndexType begin, ArcIndexType end) {
+        for (ArcIndexType i = begin; i < end; ++i) {
+          const ArcIndexType reverse_arc = reverse_positions[i] - num_arcs_;
+          head_[i] = sorted_heads[i];
+          head_[reverse_arc] = sorted_tails[i];
+          opposite_[i] = reverse_arc;
+          opposite_[reverse_arc] = i;
+        }
+      });
+  for (ArcIndexType& reverse_start : reverse_start_) {
+    reverse_start -= num_arcs_;
+  }
+
+  if (permutation != nullptr) {
+    if (permutation_needed) {
+      permutation->swap(perm);
+    } else {
+      permutation->clear();
+    }
+  }
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
@@ -0,0 +1,194 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "gtest/gtest.h"
+
+namespace util {
+namespace {
+
+// Returns (node, arc, head, opposite arc) for all the arcs of the graph, in
+// the order in which the iterators return them. The opposite arc is only
+// defined for graphs with reverse arcs, and is 0 otherwise.
+template <typename NodeIndexType, typename ArcIndexType>
+std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> DescribeGraph(
+    const StaticGraph<NodeIndexType, ArcIndexType>& graph) {
+  std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> arcs;
+  for (const NodeIndexType node : graph.AllNodes()) {
+    for (const ArcIndexType arc : graph.OutgoingArcs(node)) {
+      EXPECT_EQ(graph.Tail(arc), node);
+      arcs.push_back({node, arc, graph.Head(arc), 0});
+    }
+  }
+  return arcs;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> DescribeGraph(
+    const ReverseArcStaticGraph<NodeIndexType, ArcIndexType>& graph) {
+  std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> arcs;
+  for (const NodeIndexType node : graph.AllNodes()) {
+    for (const ArcIndexType arc : graph.OutgoingOrOppositeIncomingArcs(node)) {
+      EXPECT_EQ(graph.Tail(arc), node);
+      arcs.push_back({node, arc, graph.Head(arc), graph.OppositeArc(arc)});
+    }
+  }
+  return arcs;
+}
+
+struct Arcs {
+  int num_nodes;
+  std::vector<int> tails;
+  std::vector<int> heads;
+};
+
+// Random arcs on num_nodes nodes. If sorted, the arcs are sorted by tail, which
+// is the case where Build() has nothing to sort.
+Arcs RandomArcs(int num_nodes, int num_arcs, bool sorted, int seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> node(0, num_nodes - 1);
+  Arcs arcs;
+  arcs.num_nodes = num_nodes;
+  for (int i = 0; i < num_arcs; ++i) {
+    arcs.tails.push_back(node(random));
+    arcs.heads.push_back(node(random));
+  }
+  if (sorted) std::sort(arcs.tails.begin(), arcs.tails.end());
+  return arcs;
+}
+
+template <typename Graph>
+class StaticGraphBuildTest : public ::testing::Test {
+ protected:
+  using NodeIndex = typename Graph::NodeIndex;
+  using ArcIndex = typename Graph::ArcIndex;
+
+  // Builds the graph of 'arcs' with AddArc() and Build(permutation), or with
+  // AddArcs() and Build(permutation, num_threads).
+  static Graph BuildGraph(const Arcs& arcs, bool bulk, int num_threads,
+                          std::vector<ArcIndex>* permutation) {
+    Graph graph;
+    graph.AddNode(arcs.num_nodes - 1);
+    if (bulk) {
+      const std::vector<NodeIndex> tails(arcs.tails.begin(), arcs.tails.end());
+      const std::vector<NodeIndex> heads(arcs.heads.begin(), arcs.heads.end());
+      graph.AddArcs(tails, heads);
+      graph.Build(permutation, num_threads);
+    } else {
+      for (int i = 0; i < arcs.tails.size(); ++i) {
+        EXPECT_EQ(graph.AddArc(arcs.tails[i], arcs.heads[i]), i);
+      }
+      graph.Build(permutation);
+    }
+    return graph;
+  }
+
+  static void CheckSameAsSequentialBuild(const Arcs& arcs) {
+    std::vector<ArcIndex> expected_permutation;
+    const Graph expected = BuildGraph(arcs, /*bulk=*/false, /*num_threads=*/1,
+                                      &expected_permutation);
+    for (const int num_threads : {1, 2, 3, 8, 64}) {
+      SCOPED_TRACE(num_threads);
+      // The permutation must be overwritten.
+      std::vector<ArcIndex> permutation = {1, 2, 3};
+      const Graph graph =
+          BuildGraph(arcs, /*bulk=*/true, num_threads, &permutation);
+      EXPECT_EQ(graph.num_nodes(), expected.num_nodes());
+      EXPECT_EQ(graph.num_arcs(), expected.num_arcs());
+      EXPECT_EQ(DescribeGraph(graph), DescribeGraph(expected));
+      EXPECT_EQ(permutation, expected_permutation);
+      // Without permutation.
+      const Graph other = BuildGraph(arcs, /*bulk=*/true, num_threads, nullptr);
+      EXPECT_EQ(DescribeGraph(other), DescribeGraph(expected));
+    }
+  }
+};
+
+using StaticGraphTypes =
+    ::testing::Types<StaticGraph<int32_t, int32_t>,
+                     StaticGraph<int64_t, int64_t>,
+                     ReverseArcStaticGraph<int32_t, int32_t>,
+                     ReverseArcStaticGraph<int64_t, int64_t>>;
+TYPED_TEST_SUITE(StaticGraphBuildTest, StaticGraphTypes);
+
+TYPED_TEST(StaticGraphBuildTest, RandomArcs) {
+  for (int seed = 0; seed < 5; ++seed) {
+    this->CheckSameAsSequentialBuild(
+        RandomArcs(/*num_nodes=*/100, /*num_arcs=*/1000, /*sorted=*/false,
+                   seed));
+  }
+}
+
+TYPED_TEST(StaticGraphBuildTest, ArcsSortedByTail) {
+  this->CheckSameAsSequentialBuild(RandomArcs(
+      /*num_nodes=*/50, /*num_arcs=*/500, /*sorted=*/true, /*seed=*/0));
+}
+
+TYPED_TEST(StaticGraphBuildTest, FewerArcsThanThreads) {
+  this->CheckSameAsSequentialBuild({/*num_nodes=*/10, /*tails=*/{7, 2, 7},
+                                    /*heads=*/{1, 7, 7}});
+}
+
+TYPED_TEST(StaticGraphBuildTest, NoArcs) {
+  this->CheckSameAsSequentialBuild({/*num_nodes=*/5, /*tails=*/{},
+                                    /*heads=*/{}});
+}
+
+TYPED_TEST(StaticGraphBuildTest, DuplicateArcsAndIsolatedNodes) {
+  // Nodes 0, 4 and 9 have no arcs.
+  this->CheckSameAsSequentialBuild(
+      {/*num_nodes=*/10,
+       /*tails=*/{8, 3, 8, 3, 1, 8, 1, 5, 5, 3},
+       /*heads=*/{2, 2, 2, 3, 8, 2, 1, 6, 6, 8}});
+}
+
+TYPED_TEST(StaticGraphBuildTest, AddArcsInSeveralBatches) {
+  using NodeIndex = typename TypeParam::NodeIndex;
+  const Arcs arcs = RandomArcs(/*num_nodes=*/30, /*num_arcs=*/200,
+                               /*sorted=*/false, /*seed=*/1);
+  const TypeParam expected =
+      this->BuildGraph(arcs, /*bulk=*/false, /*num_threads=*/1, nullptr);
+  TypeParam graph;
+  graph.AddNode(arcs.num_nodes - 1);
+  const std::vector<NodeIndex> tails(arcs.tails.begin(), arcs.tails.end());
+  const std::vector<NodeIndex> heads(arcs.heads.begin(), arcs.heads.end());
+  for (int begin = 0; begin < tails.size(); begin += 70) {
+    const int size = std::min<int>(70, tails.size() - begin);
+    graph.AddArcs(absl::MakeConstSpan(tails).subspan(begin, size),
+                  absl::MakeConstSpan(heads).subspan(begin, size));
+    EXPECT_EQ(graph.num_arcs(), begin + size);
+  }
+  graph.Build(nullptr, /*num_threads=*/4);
+  EXPECT_EQ(DescribeGraph(graph), DescribeGraph(expected));
+}
+
+TYPED_TEST(StaticGraphBuildTest, AddArcsAddsNodes) {
+  using NodeIndex = typename TypeParam::NodeIndex;
+  TypeParam graph;
+  const std::vector<NodeIndex> tails = {0, 3};
+  const std::vector<NodeIndex> heads = {6, 1};
+  graph.AddArcs(tails, heads);
+  EXPECT_EQ(graph.num_nodes(), 7);
+  EXPECT_EQ(graph.num_arcs(), 2);
+}
+
+}  // namespace
+}  // namespace util
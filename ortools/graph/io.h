@@ -18,9 +18,15 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>  // NOLINT
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <system_error>  // NOLINT
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -69,6 +75,41 @@ absl::Status WriteGraphToFile(const Graph& graph, const std::string& filename,
                               bool directed,
                               absl::Span<const int> num_nodes_with_color);
 
+// Compact binary format of a built StaticGraph<>. The file holds a
+// StaticGraphBinaryHeader, then the index of the first outgoing arc of each
+// node (as ArcIndexType), then the head of each arc (as NodeIndexType). Each
+// array is padded with zeros to a multiple of 8 bytes. All values are in the
+// native byte order, so that the arrays are aligned and can be used as is when
+// the file is memory-mapped.
+//
+// Reading such a file is much faster than building the graph again: it is a
+// bulk read of the arrays, with no parsing and no sorting of the arcs.
+struct StaticGraphBinaryHeader {
+  static constexpr char kMagic[8] = {'O', 'R', 'S', 'G', 'R', 'A', 'P', 'H'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8];
+  uint32_t version;
+  // kByteOrderMark, in the byte order of the machine which wrote the file.
+  uint32_t byte_order_mark;
+  uint32_t node_index_size;
+  uint32_t arc_index_size;
+  int64_t num_nodes;
+  int64_t num_arcs;
+};
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Status WriteStaticGraphToBinaryFile(
+    const StaticGraph<NodeIndexType, ArcIndexType>& graph,
+    const std::string& filename);
+
+// Reads a graph written by WriteStaticGraphToBinaryFile() with the same index
+// types. The returned graph is already built.
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<StaticGraph<NodeIndexType, ArcIndexType>>
+ReadStaticGraphFromBinaryFile(const std::string& filename);
+
 // Implementations of the templated methods.
 
 template <class Graph>
@@ -161,6 +202,144 @@ absl::Status WriteGraphToFile(const Graph& graph, const std::string& filename,
   return ::absl::OkStatus();
 }
 
+namespace internal {
+
+inline int64_t BinaryArraySizeWithPadding(int64_t size, size_t value_size) {
+  return (size * static_cast<int64_t>(value_size) + 7) / 8 * 8;
+}
+
+// Writes value(0), ..., value(size - 1) by blocks, in this order, followed by
+// the padding. Returns false on error.
+template <typename T, typename ValueFunction>
+bool WriteBinaryArray(FILE* f, int64_t size, const ValueFunction& value) {
+  constexpr int64_t kBlockSize = 1 << 16;
+  std::vector<T> block;
+  block.reserve(std::min(size, kBlockSize));
+  for (int64_t begin = 0; begin < size; begin += kBlockSize) {
+    block.clear();
+    const int64_t end = std::min(begin + kBlockSize, size);
+    for (int64_t i = begin; i < end; ++i) block.push_back(value(i));
+    if (fwrite(block.data(), sizeof(T), block.size(), f) != block.size()) {
+      return false;
+    }
+  }
+  const char padding[8] = {};
+  const size_t padding_size =
+      BinaryArraySizeWithPadding(size, sizeof(T)) - size * sizeof(T);
+  return fwrite(padding, 1, padding_size, f) == padding_size;
+}
+
+// Reads 'size' values and the padding after them. Returns false on error.
+template <typename T>
+bool ReadBinaryArray(FILE* f, int64_t size, std::vector<T>* values) {
+  values->resize(size);
+  if (fread(values->data(), sizeof(T), size, f) != static_cast<size_t>(size)) {
+    return false;
+  }
+  char padding[8];
+  const size_t padding_size =
+      BinaryArraySizeWithPadding(size, sizeof(T)) - size * sizeof(T);
+  return fread(padding, 1, padding_size, f) == padding_size;
+}
+
+}  // namespace internal
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Status WriteStaticGraphToBinaryFile(
+    const StaticGraph<NodeIndexType, ArcIndexType>& graph,
+    const std::string& filename) {
+  FILE* f = fopen(filename.c_str(), "wb");
+  if (f == nullptr) {
+    return absl::Status(absl::StatusCode::kInvalidArgument,
+                        "Could not open file: '" + filename + "'");
+  }
+  StaticGraphBinaryHeader header;
+  std::memcpy(header.magic, StaticGraphBinaryHeader::kMagic,
+              sizeof(header.magic));
+  header.version = StaticGraphBinaryHeader::kVersion;
+  header.byte_order_mark = StaticGraphBinaryHeader::kByteOrderMark;
+  header.node_index_size = sizeof(NodeIndexType);
+  header.arc_index_size = sizeof(ArcIndexType);
+  header.num_nodes = graph.num_nodes();
+  header.num_arcs = graph.num_arcs();
+  ArcIndexType start = 0;
+  bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+  ok = ok && internal::WriteBinaryArray<ArcIndexType>(
+                 f, header.num_nodes, [&graph, &start](int64_t node) {
+                   const ArcIndexType node_start = start;
+                   start += graph.OutDegree(node);
+                   return node_start;
+                 });
+  // The arcs of a built StaticGraph<> are sorted by tail.
+  ok = ok && internal::WriteBinaryArray<NodeIndexType>(
+                 f, header.num_arcs,
+                 [&graph](int64_t arc) { return graph.Head(arc); });
+  if (fclose(f) != 0 || !ok) {
+    return absl::Status(absl::StatusCode::kInternal,
+                        "Could not write file '" + filename + "'");
+  }
+  return ::absl::OkStatus();
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<StaticGraph<NodeIndexType, ArcIndexType>>
+ReadStaticGraphFromBinaryFile(const std::string& filename) {
+  const absl::Status invalid_file_error(
+      absl::StatusCode::kInvalidArgument,
+      "Invalid binary graph file: '" + filename + "'");
+  std::error_code error;
+  const uintmax_t file_size = std::filesystem::file_size(filename, error);
+  if (error) {
+    return absl::Status(absl::StatusCode::kInvalidArgument,
+                        "Could not open file: '" + filename + "'");
+  }
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (f == nullptr) {
+    return absl::Status(absl::StatusCode::kInvalidArgument,
+                        "Could not open file: '" + filename + "'");
+  }
+  StaticGraphBinaryHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1 ||
+      std::memcmp(header.magic, StaticGraphBinaryHeader::kMagic,
+                  sizeof(header.magic)) != 0 ||
+      header.version != StaticGraphBinaryHeader::kVersion ||
+      header.byte_order_mark != StaticGraphBinaryHeader::kByteOrderMark ||
+      header.node_index_size != sizeof(NodeIndexType) ||
+      header.arc_index_size != sizeof(ArcIndexType) || header.num_nodes < 0 ||
+      header.num_arcs < 0 ||
+      header.num_nodes > std::numeric_limits<NodeIndexType>::max() ||
+      header.num_arcs > std::numeric_limits<ArcIndexType>::max() ||
+      file_size != sizeof(header) +
+                       internal::BinaryArraySizeWithPadding(
+                           header.num_nodes, sizeof(ArcIndexType)) +
+                       internal::BinaryArraySizeWithPadding(
+                           header.num_arcs, sizeof(NodeIndexType))) {
+    fclose(f);
+    return invalid_file_error;
+  }
+  std::vector<ArcIndexType> start;
+  std::vector<NodeIndexType> heads;
+  const bool ok = internal::ReadBinaryArray(f, header.num_nodes, &start) &&
+                  internal::ReadBinaryArray(f, header.num_arcs, &heads);
+  fclose(f);
+  if (!ok) return invalid_file_error;
+
+  // Checks the consistency of the arrays, which StaticGraph<> assumes.
+  if (header.num_nodes == 0 ? header.num_arcs != 0 : start[0] != 0) {
+    return invalid_file_error;
+  }
+  for (int64_t node = 0; node < header.num_nodes; ++node) {
+    const ArcIndexType limit =
+        node + 1 < header.num_nodes ? start[node + 1] : header.num_arcs;
+    if (start[node] > limit) return invalid_file_error;
+  }
+  for (const NodeIndexType head : heads) {
+    if (head < 0 || head >= header.num_nodes) return invalid_file_error;
+  }
+  return StaticGraph<NodeIndexType, ArcIndexType>::FromStartAndHeads(
+      std::move(start), std::move(heads));
+}
+
 }  // namespace util
 
 #endif  // UTIL_GRAPH_IO_H_
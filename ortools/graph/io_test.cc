@@ -0,0 +1,213 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/path.h"
+#include "ortools/graph/graph.h"
+
+namespace util {
+namespace {
+
+template <typename Graph>
+Graph MakeGraph(int num_nodes, const std::vector<std::pair<int, int>>& arcs) {
+  Graph graph;
+  if (num_nodes > 0) graph.AddNode(num_nodes - 1);
+  for (const auto& [tail, head] : arcs) graph.AddArc(tail, head);
+  graph.Build();
+  return graph;
+}
+
+template <typename Graph>
+void ExpectSameGraph(const Graph& graph, const Graph& expected) {
+  ASSERT_EQ(graph.num_nodes(), expected.num_nodes());
+  ASSERT_EQ(graph.num_arcs(), expected.num_arcs());
+  for (const auto node : expected.AllNodes()) {
+    EXPECT_EQ(graph.OutDegree(node), expected.OutDegree(node));
+  }
+  for (const auto arc : expected.AllForwardArcs()) {
+    EXPECT_EQ(graph.Tail(arc), expected.Tail(arc));
+    EXPECT_EQ(graph.Head(arc), expected.Head(arc));
+  }
+}
+
+std::string TestFile(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+std::string GetFileContents(const std::string& filename) {
+  std::string contents;
+  CHECK_OK(file::GetContents(filename, &contents, file::Defaults()));
+  return contents;
+}
+
+void SetFileContents(const std::string& filename,
+                     const std::string& contents) {
+  CHECK_OK(file::SetContents(filename, contents, file::Defaults()));
+}
+
+template <typename Graph>
+class StaticGraphBinaryFileTest : public ::testing::Test {};
+
+using StaticGraphTypes =
+    ::testing::Types<StaticGraph<int32_t, int32_t>,
+                     StaticGraph<int32_t, int64_t>,
+                     StaticGraph<int64_t, int64_t>>;
+TYPED_TEST_SUITE(StaticGraphBinaryFileTest, StaticGraphTypes);
+
+TYPED_TEST(StaticGraphBinaryFileTest, RoundTrip) {
+  const std::string filename = TestFile("round_trip.graph");
+  // Odd numbers of nodes and arcs, so that the arrays of 4-byte indices are
+  // padded.
+  const std::vector<std::pair<int, std::vector<std::pair<int, int>>>> graphs =
+      {{0, {}},
+       {1, {}},
+       {3, {{0, 0}}},
+       {7, {{5, 1}, {0, 3}, {5, 6}, {2, 2}, {0, 3}}},
+       {4, {{3, 0}, {2, 1}, {1, 2}, {0, 3}}}};
+  for (const auto& [num_nodes, arcs] : graphs) {
+    SCOPED_TRACE(num_nodes);
+    const TypeParam graph = MakeGraph<TypeParam>(num_nodes, arcs);
+    ASSERT_TRUE(WriteStaticGraphToBinaryFile(graph, filename).ok());
+    const absl::StatusOr<TypeParam> read_graph =
+        ReadStaticGraphFromBinaryFile<typename TypeParam::NodeIndex,
+                                      typename TypeParam::ArcIndex>(filename);
+    ASSERT_TRUE(read_graph.ok()) << read_graph.status();
+    ExpectSameGraph(*read_graph, graph);
+    EXPECT_EQ(GetFileContents(filename).size() % 8, 0);
+  }
+}
+
+using Graph = StaticGraph<int32_t, int32_t>;
+
+// Writes a graph with 3 nodes and 3 arcs: 0->1, 0->2 and 2->0. The file
+// holds the header, the start array {0, 2, 2} and its padding, then the head
+// array {1, 2, 0} and its padding.
+std::string WriteTestGraph(const std::string& filename) {
+  const Graph graph = MakeGraph<Graph>(3, {{0, 1}, {0, 2}, {2, 0}});
+  CHECK_OK(WriteStaticGraphToBinaryFile(graph, filename));
+  return GetFileContents(filename);
+}
+
+constexpr size_t kStartOffset = sizeof(StaticGraphBinaryHeader);
+constexpr size_t kHeadOffset = kStartOffset + 16;
+
+absl::Status ReadTestGraph(const std::string& filename) {
+  return ReadStaticGraphFromBinaryFile<int32_t, int32_t>(filename).status();
+}
+
+void SetInt32(size_t offset, int32_t value, std::string* contents) {
+  std::memcpy(contents->data() + offset, &value, sizeof(value));
+}
+
+TEST(StaticGraphBinaryFileTest, ValidTestGraph) {
+  const std::string filename = TestFile("valid.graph");
+  EXPECT_EQ(WriteTestGraph(filename).size(),
+            sizeof(StaticGraphBinaryHeader) + 16 + 16);
+  const absl::StatusOr<Graph> graph =
+      ReadStaticGraphFromBinaryFile<int32_t, int32_t>(filename);
+  ASSERT_TRUE(graph.ok()) << graph.status();
+  ExpectSameGraph(*graph, MakeGraph<Graph>(3, {{0, 1}, {0, 2}, {2, 0}}));
+}
+
+TEST(StaticGraphBinaryFileTest, MissingFile) {
+  EXPECT_EQ(ReadTestGraph(TestFile("missing.graph")).code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(StaticGraphBinaryFileTest, TruncatedFile) {
+  const std::string filename = TestFile("truncated.graph");
+  const std::string contents = WriteTestGraph(filename);
+  for (const size_t size :
+       {size_t{0}, size_t{5}, sizeof(StaticGraphBinaryHeader), kHeadOffset,
+        contents.size() - 8, contents.size() - 1}) {
+    SCOPED_TRACE(size);
+    SetFileContents(filename, contents.substr(0, size));
+    EXPECT_EQ(ReadTestGraph(filename).code(),
+              absl::StatusCode::kInvalidArgument);
+  }
+  // Trailing bytes are rejected too.
+  SetFileContents(filename, contents + std::string(8, '\0'));
+  EXPECT_EQ(ReadTestGraph(filename).code(), absl::StatusCode::kInvalidArgument);
+}
+
+TEST(StaticGraphBinaryFileTest, CorruptHeader) {
+  const std::string filename = TestFile("corrupt_header.graph");
+  const std::string contents = WriteTestGraph(filename);
+  const auto expect_invalid = [&filename](const std::string& corrupted) {
+    SetFileContents(filename, corrupted);
+    EXPECT_EQ(ReadTestGraph(filename).code(),
+              absl::StatusCode::kInvalidArgument);
+  };
+  std::string corrupted = contents;
+  corrupted[0] = 'X';
+  expect_invalid(corrupted);
+  corrupted = contents;
+  SetInt32(offsetof(StaticGraphBinaryHeader, version),
+           StaticGraphBinaryHeader::kVersion + 1, &corrupted);
+  expect_invalid(corrupted);
+  corrupted = contents;
+  SetInt32(offsetof(StaticGraphBinaryHeader, byte_order_mark), 0x04030201,
+           &corrupted);
+  expect_invalid(corrupted);
+  // A graph read with other index types.
+  SetFileContents(filename, contents);
+  EXPECT_EQ((ReadStaticGraphFromBinaryFile<int32_t, int64_t>(filename)
+                 .status()
+                 .code()),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(StaticGraphBinaryFileTest, CorruptArrays) {
+  const std::string filename = TestFile("corrupt_arrays.graph");
+  const std::string contents = WriteTestGraph(filename);
+  const auto expect_invalid = [&filename](const std::string& corrupted) {
+    SetFileContents(filename, corrupted);
+    EXPECT_EQ(ReadTestGraph(filename).code(),
+              absl::StatusCode::kInvalidArgument);
+  };
+  // The first arc of node 0 must be arc 0.
+  std::string corrupted = contents;
+  SetInt32(kStartOffset, 1, &corrupted);
+  expect_invalid(corrupted);
+  // Non-monotonic starts.
+  corrupted = contents;
+  SetInt32(kStartOffset + 4, 3, &corrupted);
+  expect_invalid(corrupted);
+  // Start beyond the number of arcs.
+  corrupted = contents;
+  SetInt32(kStartOffset + 8, 4, &corrupted);
+  expect_invalid(corrupted);
+  // Heads out of range.
+  corrupted = contents;
+  SetInt32(kHeadOffset + 4, 3, &corrupted);
+  expect_invalid(corrupted);
+  corrupted = contents;
+  SetInt32(kHeadOffset, -1, &corrupted);
+  expect_invalid(corrupted);
+}
+
+}  // namespace
+}  // namespace util
@@ -14,14 +14,19 @@
 #include "ortools/graph/max_flow.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/graph/graph.h"
 #include "ortools/graph/graphs.h"
 
@@ -77,6 +82,7 @@ SimpleMaxFlow::Status SimpleMaxFlow::Solve(NodeIndex source, NodeIndex sink) {
   underlying_graph_->Build(&arc_permutation_);
   underlying_max_flow_ = std::make_unique<GenericMaxFlow<Graph>>(
       underlying_graph_.get(), source, sink);
+  underlying_max_flow_->SetNumThreads(num_threads_);
   for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
     ArcIndex permuted_arc =
         arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
@@ -156,6 +162,7 @@ GenericMaxFlow<Graph>::GenericMaxFlow(const Graph* graph, NodeIndex source,
       process_node_by_height_(true),
       check_input_(true),
       check_result_(true),
+      num_threads_(1),
       stats_("MaxFlow") {
   SCOPED_TIME_STAT(&stats_);
   DCHECK(graph->IsNodeValid(source));
@@ -369,7 +376,11 @@ bool GenericMaxFlow<Graph>::Solve() {
     return true;
   }
   if (use_global_update_) {
-    RefineWithGlobalUpdate();
+    if (num_threads_ > 1 && use_two_phase_algorithm_) {
+      RefineInParallel();
+    } else {
+      RefineWithGlobalUpdate();
+    }
   } else {
     Refine();
   }
@@ -862,6 +873,295 @@ void GenericMaxFlow<Graph>::RefineWithGlobalUpdate() {
   }
 }
 
+// Runs the phases of a parallel algorithm on a fixed set of threads, to avoid
+// creating threads for each phase: Run(phase) calls phase(thread) for each
+// thread in [0, num_threads), the calling thread being thread 0, and returns
+// once all the calls are done.
+template <typename Graph>
+class GenericMaxFlow<Graph>::PhaseRunner {
+ public:
+  explicit PhaseRunner(int num_threads) : num_threads_(num_threads) {
+    for (int thread = 1; thread < num_threads; ++thread) {
+      workers_.emplace_back([this, thread]() { RunWorker(thread); });
+    }
+  }
+
+  ~PhaseRunner() {
+    {
+      absl::MutexLock lock(&mutex_);
+      stopped_ = true;
+      ++generation_;
+      condition_.SignalAll();
+    }
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  int num_threads() const { return num_threads_; }
+
+  void Run(const std::function<void(int thread)>& phase) {
+    {
+      absl::MutexLock lock(&mutex_);
+      phase_ = &phase;
+      num_running_ = num_threads_ - 1;
+      ++generation_;
+      condition_.SignalAll();
+    }
+    phase(0);
+    absl::MutexLock lock(&mutex_);
+    while (num_running_ > 0) condition_.Wait(&mutex_);
+  }
+
+  // Calls f(thread, i) for all i in [0, size), distributing the indices among
+  // the threads by chunks.
+  void ParallelFor(int size, const std::function<void(int thread, int i)>& f) {
+    constexpr int kChunkSize = 256;
+    std::atomic<int> next_chunk_start = 0;
+    Run([size, &f, &next_chunk_start](int thread) {
+      while (true) {
+        const int start = next_chunk_start.fetch_add(kChunkSize);
+        if (start >= size) return;
+        const int end = std::min(size, start + kChunkSize);
+        for (int i = start; i < end; ++i) f(thread, i);
+      }
+    });
+  }
+
+ private:
+  void RunWorker(int thread) {
+    int64_t generation = 0;
+    while (true) {
+      const std::function<void(int)>* phase;
+      {
+        absl::MutexLock lock(&mutex_);
+        while (generation_ == generation) condition_.Wait(&mutex_);
+        generation = generation_;
+        if (stopped_) return;
+        phase = phase_;
+      }
+      (*phase)(thread);
+      absl::MutexLock lock(&mutex_);
+      if (--num_running_ == 0) condition_.SignalAll();
+    }
+  }
+
+  const int num_threads_;
+  std::vector<std::thread> workers_;
+  absl::Mutex mutex_;
+  absl::CondVar condition_;
+  const std::function<void(int)>* phase_ ABSL_GUARDED_BY(mutex_) = nullptr;
+  int num_running_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t generation_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+template <typename Graph>
+void GenericMaxFlow<Graph>::ParallelGlobalUpdate(
+    PhaseRunner* runner, std::vector<NodeIndex>* active_nodes,
+    std::vector<char>* in_active_nodes) {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  const int num_threads = runner->num_threads();
+  std::vector<std::atomic<bool>> visited(num_nodes);
+  runner->ParallelFor(num_nodes, [&visited](int, int node) {
+    visited[node].store(false, std::memory_order_relaxed);
+  });
+  visited[sink_].store(true, std::memory_order_relaxed);
+  visited[source_].store(true, std::memory_order_relaxed);
+
+  // Level-synchronous breadth-first search from the sink in the reverse
+  // residual graph. A node is claimed by the first thread which visits it.
+  std::vector<NodeIndex> frontier = {sink_};
+  std::vector<std::vector<NodeIndex>> next_frontiers(num_threads);
+  for (NodeHeight height = 1; !frontier.empty(); ++height) {
+    runner->ParallelFor(frontier.size(), [this, height, &frontier, &visited,
+                                          &next_frontiers](int thread, int i) {
+      for (OutgoingOrOppositeIncomingArcIterator it(*graph_, frontier[i]);
+           it.Ok(); it.Next()) {
+        const ArcIndex arc = it.Index();
+        const NodeIndex head = Head(arc);
+        if (visited[head].load(std::memory_order_relaxed)) continue;
+        if (residual_arc_capacity_[Opposite(arc)] <= 0) continue;
+        if (visited[head].exchange(true, std::memory_order_relaxed)) continue;
+        node_potential_[head] = height;
+        next_frontiers[thread].push_back(head);
+      }
+    });
+    frontier.clear();
+    for (std::vector<NodeIndex>& next_frontier : next_frontiers) {
+      frontier.insert(frontier.end(), next_frontier.begin(),
+                      next_frontier.end());
+      next_frontier.clear();
+    }
+  }
+
+  // As in GlobalUpdate(), the nodes which cannot reach the sink get an
+  // unreachable height. The other nodes with excess are active.
+  std::vector<std::vector<NodeIndex>> thread_active_nodes(num_threads);
+  runner->ParallelFor(num_nodes, [this, num_nodes, &visited, in_active_nodes,
+                                  &thread_active_nodes](int thread, int node) {
+    if (!visited[node].load(std::memory_order_relaxed)) {
+      node_potential_[node] = 2 * num_nodes - 1;
+    }
+    const bool active = IsActive(node) && node_potential_[node] < num_nodes;
+    (*in_active_nodes)[node] = active;
+    if (active) thread_active_nodes[thread].push_back(node);
+  });
+  active_nodes->clear();
+  for (const std::vector<NodeIndex>& nodes : thread_active_nodes) {
+    active_nodes->insert(active_nodes->end(), nodes.begin(), nodes.end());
+  }
+}
+
+template <typename Graph>
+void GenericMaxFlow<Graph>::RefineInParallel() {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  const ArcIndex num_arcs = graph_->num_arcs();
+  PhaseRunner runner(num_threads_);
+  const int num_threads = runner.num_threads();
+
+  // The working set of active nodes, which can all reach the sink.
+  std::vector<NodeIndex> active_nodes;
+  std::vector<char> in_active_nodes(num_nodes, false);
+  // The nodes which received some flow during the current round, and the
+  // excess they received, which is only added to node_excess_ at the end of
+  // the round.
+  std::vector<std::vector<NodeIndex>> thread_received_nodes(num_threads);
+  std::vector<NodeIndex> received_nodes;
+  std::vector<std::atomic<bool>> received(num_nodes);
+  std::vector<std::atomic<FlowQuantity>> received_excess(num_nodes);
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    received[node].store(false, std::memory_order_relaxed);
+    received_excess[node].store(0, std::memory_order_relaxed);
+  }
+  std::vector<NodeHeight> new_height(num_nodes);
+  std::vector<char> relabeled;
+  std::vector<int64_t> thread_relabel_work(num_threads);
+  std::vector<std::vector<NodeIndex>> thread_active_nodes(num_threads);
+
+  // The global update is run when the work spent in relabels since the last
+  // one exceeds a linear function of the size of the graph.
+  const int64_t global_update_work_threshold =
+      6 * static_cast<int64_t>(num_nodes) + num_arcs / 2;
+
+  while (SaturateOutgoingArcsFromSource()) {
+    ParallelGlobalUpdate(&runner, &active_nodes, &in_active_nodes);
+    int64_t relabel_work = 0;
+    while (!active_nodes.empty()) {
+      // Pushes. A node only pushes flow on arcs whose head is exactly one
+      // level lower, with the heights of the beginning of the round, so the
+      // two arcs of a pair are never pushed on concurrently, and each thread
+      // updates the residual capacities of the arcs of the nodes it processes.
+      relabeled.assign(active_nodes.size(), false);
+      runner.ParallelFor(
+          active_nodes.size(), [this, &active_nodes, &relabeled, &received,
+                                &received_excess, &thread_received_nodes](
+                                   int thread, int i) {
+            const NodeIndex node = active_nodes[i];
+            const NodeHeight height = node_potential_[node];
+            FlowQuantity excess = node_excess_[node];
+            for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node);
+                 it.Ok() && excess > 0; it.Next()) {
+              const ArcIndex arc = it.Index();
+              const NodeIndex head = Head(arc);
+              if (node_potential_[head] + 1 != height) continue;
+              const FlowQuantity capacity = residual_arc_capacity_[arc];
+              if (capacity <= 0) continue;
+              const FlowQuantity flow = std::min(excess, capacity);
+              residual_arc_capacity_[arc] -= flow;
+              residual_arc_capacity_[Opposite(arc)] += flow;
+              excess -= flow;
+              received_excess[head].fetch_add(flow,
+                                              std::memory_order_relaxed);
+              if (!received[head].exchange(true, std::memory_order_relaxed)) {
+                thread_received_nodes[thread].push_back(head);
+              }
+            }
+            node_excess_[node] = excess;
+            // All the admissible arcs of the node are saturated.
+            relabeled[i] = excess > 0;
+          });
+
+      // Relabels, with the heights of the beginning of the round.
+      runner.ParallelFor(
+          active_nodes.size(),
+          [this, num_nodes, &active_nodes, &relabeled, &new_height,
+           &thread_relabel_work](int thread, int i) {
+            if (!relabeled[i]) return;
+            const NodeIndex node = active_nodes[i];
+            NodeHeight min_height = 2 * num_nodes - 2;
+            for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node);
+                 it.Ok(); it.Next()) {
+              const ArcIndex arc = it.Index();
+              ++thread_relabel_work[thread];
+              if (residual_arc_capacity_[arc] > 0) {
+                min_height = std::min(min_height, node_potential_[Head(arc)]);
+              }
+            }
+            new_height[node] = min_height + 1;
+          });
+
+      // Applies the new heights and the received excesses.
+      received_nodes.clear();
+      for (std::vector<NodeIndex>& nodes : thread_received_nodes) {
+        received_nodes.insert(received_nodes.end(), nodes.begin(),
+                              nodes.end());
+        nodes.clear();
+      }
+      const int num_active_nodes = active_nodes.size();
+      runner.ParallelFor(
+          num_active_nodes + received_nodes.size(),
+          [this, num_active_nodes, &active_nodes, &relabeled, &new_height,
+           &received_nodes, &received, &received_excess](int, int i) {
+            if (i < num_active_nodes) {
+              if (relabeled[i]) {
+                const NodeIndex node = active_nodes[i];
+                node_potential_[node] = new_height[node];
+              }
+              return;
+            }
+            const NodeIndex node = received_nodes[i - num_active_nodes];
+            node_excess_[node] +=
+                received_excess[node].exchange(0, std::memory_order_relaxed);
+            received[node].store(false, std::memory_order_relaxed);
+          });
+
+      // Computes the next working set: the active nodes of the current one,
+      // and the nodes which became active by receiving flow.
+      runner.ParallelFor(
+          num_active_nodes + received_nodes.size(),
+          [this, num_nodes, num_active_nodes, &active_nodes, &received_nodes,
+           &in_active_nodes, &thread_active_nodes](int thread, int i) {
+            const NodeIndex node = i < num_active_nodes
+                                       ? active_nodes[i]
+                                       : received_nodes[i - num_active_nodes];
+            if (i >= num_active_nodes && in_active_nodes[node]) return;
+            if (IsActive(node) && node_potential_[node] < num_nodes) {
+              thread_active_nodes[thread].push_back(node);
+            }
+          });
+      for (const NodeIndex node : active_nodes) in_active_nodes[node] = false;
+      active_nodes.clear();
+      for (std::vector<NodeIndex>& nodes : thread_active_nodes) {
+        for (const NodeIndex node : nodes) in_active_nodes[node] = true;
+        active_nodes.insert(active_nodes.end(), nodes.begin(), nodes.end());
+        nodes.clear();
+      }
+
+      for (int64_t& work : thread_relabel_work) {
+        relabel_work += work;
+        work = 0;
+      }
+      if (relabel_work > global_update_work_threshold &&
+          !active_nodes.empty()) {
+        ParallelGlobalUpdate(&runner, &active_nodes, &in_active_nodes);
+        relabel_work = 0;
+      }
+    }
+    PushFlowExcessBackToSource();
+  }
+}
+
 template <typename Graph>
 void GenericMaxFlow<Graph>::Discharge(NodeIndex node) {
   SCOPED_TIME_STAT(&stats_);
@@ -234,6 +234,10 @@ class SimpleMaxFlow {
   // Creates the protocol buffer representation of the current problem.
   FlowModelProto CreateFlowModelProto(NodeIndex source, NodeIndex sink) const;
 
+  // Sets the number of threads used by Solve(), see
+  // GenericMaxFlow::SetNumThreads(). Defaults to 1.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
  private:
   NodeIndex num_nodes_;
   std::vector<NodeIndex> arc_tail_;
@@ -242,6 +246,7 @@ class SimpleMaxFlow {
   std::vector<ArcIndex> arc_permutation_;
   std::vector<FlowQuantity> arc_flow_;
   FlowQuantity optimal_flow_;
+  int num_threads_ = 1;
 
   // Note that we cannot free the graph before we stop using the max-flow
   // instance that uses it.
@@ -439,6 +444,18 @@ class GenericMaxFlow : public MaxFlowStatusClass {
     process_node_by_height_ = value && use_global_update_;
   }
 
+  // Sets the number of threads used by Solve(). Defaults to 1. With more than
+  // one thread, and with the global update and the two-phase algorithm
+  // enabled (the default), Solve() runs a synchronous parallel push-relabel:
+  // in each round, all the active nodes push their excess in parallel, then
+  // the nodes with remaining excess are relabeled in parallel, and the global
+  // update is run as a parallel breadth-first search. The ProcessNodeByHeight()
+  // option is ignored in this case.
+  void SetNumThreads(int num_threads) {
+    DCHECK_GE(num_threads, 1);
+    num_threads_ = num_threads;
+  }
+
   // Returns the protocol buffer representation of the current problem.
   FlowModelProto CreateFlowModel();
 
@@ -503,6 +520,20 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   void Refine();
   void RefineWithGlobalUpdate();
 
+  // Runs closures on a fixed set of threads, see max_flow.cc.
+  class PhaseRunner;
+
+  // Parallel version of RefineWithGlobalUpdate(), with the two-phase
+  // algorithm. Uses num_threads_ threads.
+  void RefineInParallel();
+
+  // Parallel version of GlobalUpdate(), which does not steal the excess of
+  // the nodes it visits. Fills 'active_nodes' with the active nodes which can
+  // reach the sink, and marks them in 'in_active_nodes'.
+  void ParallelGlobalUpdate(PhaseRunner* runner,
+                            std::vector<NodeIndex>* active_nodes,
+                            std::vector<char>* in_active_nodes);
+
   // Discharges an active node node by saturating its admissible adjacent arcs,
   // if any, and by relabelling it when it becomes inactive.
   void Discharge(NodeIndex node);
@@ -654,6 +685,9 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // TODO(user): Make the check more exhaustive by checking the optimality?
   bool check_result_;
 
+  // Number of threads used by Solve().
+  int num_threads_;
+
   // Statistics about this class.
   mutable StatsGroup stats_;
 };
@@ -133,6 +133,35 @@ TEST(SimpleMaxFlowTest, SetArcCapacity) {
   EXPECT_EQ(25, max_flow.OptimalFlow());
 }
 
+TEST(SimpleMaxFlowTest, MultipleThreads) {
+  std::mt19937 randomizer(12345);
+  const int kNumNodes = 1000;
+  const int kNumArcs = 10000;
+  SimpleMaxFlow sequential;
+  SimpleMaxFlow parallel;
+  parallel.SetNumThreads(4);
+  for (int i = 0; i < kNumArcs; ++i) {
+    const NodeIndex tail = absl::Uniform(randomizer, 0, kNumNodes);
+    const NodeIndex head = absl::Uniform(randomizer, 0, kNumNodes);
+    const FlowQuantity capacity = absl::Uniform(randomizer, 0, 100);
+    sequential.AddArcWithCapacity(tail, head, capacity);
+    parallel.AddArcWithCapacity(tail, head, capacity);
+  }
+  for (const NodeIndex sink : {1, 2, kNumNodes - 1}) {
+    ASSERT_EQ(SimpleMaxFlow::OPTIMAL, sequential.Solve(0, sink));
+    ASSERT_EQ(SimpleMaxFlow::OPTIMAL, parallel.Solve(0, sink));
+    EXPECT_EQ(sequential.OptimalFlow(), parallel.OptimalFlow());
+    FlowQuantity flow_out_of_source = 0;
+    for (ArcIndex arc = 0; arc < parallel.NumArcs(); ++arc) {
+      EXPECT_LE(0, parallel.Flow(arc));
+      EXPECT_LE(parallel.Flow(arc), parallel.Capacity(arc));
+      if (parallel.Tail(arc) == 0) flow_out_of_source += parallel.Flow(arc);
+      if (parallel.Head(arc) == 0) flow_out_of_source -= parallel.Flow(arc);
+    }
+    EXPECT_EQ(flow_out_of_source, parallel.OptimalFlow());
+  }
+}
+
 SimpleMaxFlow::Status LoadAndSolveFlowModel(const FlowModelProto& model,
                                             SimpleMaxFlow* solver) {
   for (int a = 0; a < model.arcs_size(); ++a) {
@@ -513,6 +542,12 @@ FlowQuantity SolveMaxFlow(GenericMaxFlow<Graph>* max_flow) {
   return max_flow->GetOptimalFlow();
 }
 
+template <typename Graph>
+FlowQuantity SolveMaxFlowInParallel(GenericMaxFlow<Graph>* max_flow) {
+  max_flow->SetNumThreads(4);
+  return SolveMaxFlow(max_flow);
+}
+
 template <typename Graph>
 FlowQuantity SolveMaxFlowWithLP(GenericMaxFlow<Graph>* max_flow) {
   MPSolver solver("LPSolver", MPSolver::GLOP_LINEAR_PROGRAMMING);
@@ -661,7 +696,8 @@ void FullRandomFlow(typename MaxFlowSolver<Graph>::Solver f,
 #define LP_AND_FLOW_TEST(test_name, size, expected_flow1, expected_flow2) \
   LP_ONLY_TEST(test_name, size, expected_flow1, expected_flow2)           \
   FLOW_ONLY_TEST(test_name, size, expected_flow1, expected_flow2)         \
-  FLOW_ONLY_TEST_SG(test_name, size, expected_flow1, expected_flow2)
+  FLOW_ONLY_TEST_SG(test_name, size, expected_flow1, expected_flow2)      \
+  PARALLEL_FLOW_TEST(test_name, size, expected_flow1, expected_flow2)
 
 #define LP_ONLY_TEST(test_name, size, expected_flow1, expected_flow2) \
   TEST(LPMaxFlowTest, test_name##size) {                              \
@@ -681,6 +717,14 @@ void FullRandomFlow(typename MaxFlowSolver<Graph>::Solver f,
                                               expected_flow1, expected_flow2); \
   }
 
+#define PARALLEL_FLOW_TEST(test_name, size, expected_flow1, expected_flow2)  \
+  TEST(ParallelMaxFlowTest, test_name##size) {                               \
+    test_name<StarGraph>(SolveMaxFlowInParallel, size, size, expected_flow1, \
+                         expected_flow2);                                    \
+    test_name<util::ReverseArcStaticGraph<> >(                               \
+        SolveMaxFlowInParallel, size, size, expected_flow1, expected_flow2); \
+  }
+
 LP_AND_FLOW_TEST(FullRandomAssignment, 300, 300, 300);
 LP_AND_FLOW_TEST(PartialRandomAssignment, 100, 100, 100);
 LP_AND_FLOW_TEST(PartialRandomAssignment, 1000, 1000, 1000);
@@ -728,6 +772,67 @@ static void BM_FullRandomFlow(benchmark::State& state) {
   state.SetItemsProcessed(static_cast<int64_t>(state.max_iterations) * kSize);
 }
 
+// Same as above with the parallel push-relabel; the benchmark argument is the
+// number of threads.
+template <typename Graph>
+static FlowQuantity SolveMaxFlowWithThreads(GenericMaxFlow<Graph>* max_flow,
+                                            int num_threads) {
+  max_flow->SetNumThreads(num_threads);
+  EXPECT_TRUE(max_flow->Solve());
+  return max_flow->GetOptimalFlow();
+}
+
+template <typename Graph>
+static void BM_ParallelPartialRandomAssignment(benchmark::State& state) {
+  const int kSize = 10100;
+  const typename Graph::NodeIndex kDegree = 10;
+  Graph graph;
+  GeneratePartialRandomGraph(kSize, kSize, kDegree, &graph);
+  Graphs<Graph>::Build(&graph);
+  std::vector<int64_t> arc_capacity(graph.num_arcs(), 1);
+  for (auto _ : state) {
+    GenericMaxFlow<Graph> max_flow(&graph, graph.num_nodes() - 2,
+                                   graph.num_nodes() - 1);
+    SetUpNetworkData(arc_capacity, &max_flow);
+    EXPECT_EQ(kSize, SolveMaxFlowWithThreads(&max_flow, state.range(0)));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.max_iterations) * kSize);
+}
+
+template <typename Graph>
+static void BM_ParallelPartialRandomFlow(benchmark::State& state) {
+  const int kSize = 20000;
+  const typename Graph::NodeIndex kDegree = 10;
+  const FlowQuantity kCapacityRange = 10000;
+  Graph graph;
+  GeneratePartialRandomGraph(kSize, kSize, kDegree, &graph);
+  std::vector<int64_t> arc_capacity(graph.num_arcs());
+  GenerateRandomArcValuations(graph, kCapacityRange, &arc_capacity);
+  std::vector<typename Graph::ArcIndex> permutation;
+  Graphs<Graph>::Build(&graph, &permutation);
+  util::Permute(permutation, &arc_capacity);
+  for (auto _ : state) {
+    GenericMaxFlow<Graph> max_flow(&graph, graph.num_nodes() - 2,
+                                   graph.num_nodes() - 1);
+    SetUpNetworkData(arc_capacity, &max_flow);
+    ::benchmark::DoNotOptimize(
+        SolveMaxFlowWithThreads(&max_flow, state.range(0)));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.max_iterations) * kSize);
+}
+
+BENCHMARK_TEMPLATE(BM_ParallelPartialRandomAssignment,
+                   util::ReverseArcStaticGraph<>)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+BENCHMARK_TEMPLATE(BM_ParallelPartialRandomFlow, util::ReverseArcStaticGraph<>)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+
 BENCHMARK_TEMPLATE(BM_FullRandomAssignment, StarGraph);
 BENCHMARK_TEMPLATE(BM_FullRandomAssignment, util::ReverseArcListGraph<>);
 BENCHMARK_TEMPLATE(BM_FullRandomAssignment, util::ReverseArcStaticGraph<>);
@@ -751,6 +856,7 @@ BENCHMARK_TEMPLATE(BM_PartialRandomAssignment, util::ReverseArcMixedGraph<>);
 #undef LP_ONLY_TEST
 #undef FLOW_ONLY_TEST
 #undef FLOW_ONLY_TEST_SG
+#undef PARALLEL_FLOW_TEST
 
 // ----------------------------------------------------------
 // PriorityQueueWithRestrictedPush tests.
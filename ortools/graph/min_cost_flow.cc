@@ -17,13 +17,17 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/base/dump_vars.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/graph/graph.h"
@@ -74,8 +78,11 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetNodeSupply(
     NodeIndex node, FlowQuantity supply) {
   DCHECK(graph_->IsNodeValid(node));
-  node_excess_[node] = supply;
+  // The excess of the node also accounts for the current flow, which is kept
+  // by the next solve.
+  node_excess_[node] += supply - initial_node_excess_[node];
   initial_node_excess_[node] = supply;
+  if (can_warm_start_) modified_nodes_.push_back(node);
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
 }
@@ -84,7 +91,22 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetArcUnitCost(
     ArcIndex arc, ArcScaledCostType unit_cost) {
   DCHECK(IsArcDirect(arc));
-  scaled_arc_unit_cost_.Set(arc, unit_cost);
+  if (can_warm_start_) {
+    // The costs stay scaled between incremental solves. A cost larger than the
+    // ones seen by the last Solve() could make the node potentials overflow.
+    const CostValue threshold =
+        (overflow_threshold_ - std::numeric_limits<CostValue>::min()) /
+        cost_scaling_factor_;
+    if (unit_cost > threshold || unit_cost < -threshold) {
+      ResetWarmStart();
+    } else {
+      modified_arcs_.push_back(arc);
+      modified_nodes_.push_back(Tail(arc));
+      modified_nodes_.push_back(Head(arc));
+    }
+  }
+  if (!can_warm_start_ && cost_scaling_factor_ != 1) UnscaleCosts();
+  scaled_arc_unit_cost_.Set(arc, unit_cost * cost_scaling_factor_);
   scaled_arc_unit_cost_.Set(Opposite(arc), -scaled_arc_unit_cost_[arc]);
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
@@ -102,6 +124,11 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetArcCapacity(
   }
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
+  if (can_warm_start_) {
+    modified_arcs_.push_back(arc);
+    modified_nodes_.push_back(Tail(arc));
+    modified_nodes_.push_back(Head(arc));
+  }
   const FlowQuantity new_availability = free_capacity + capacity_delta;
   if (new_availability >= 0) {
     // The above condition is true when one of two following holds:
@@ -137,6 +164,7 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetArcFlow(
   residual_arc_capacity_.Set(arc, capacity - new_flow);
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
+  ResetWarmStart();
 }
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
@@ -340,6 +368,7 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::MakeFeasible() {
   if (!feasibility_checked_) {
     return false;
   }
+  ResetWarmStart();
   for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
     const FlowQuantity excess = feasible_node_excess_[node];
     node_excess_[node] = excess;
@@ -374,8 +403,7 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 CostValue GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UnitCost(
     ArcIndex arc) const {
   DCHECK(IsArcValid(arc));
-  DCHECK_EQ(uint64_t{1}, cost_scaling_factor_);
-  return scaled_arc_unit_cost_[arc];
+  return scaled_arc_unit_cost_[arc] / cost_scaling_factor_;
 }
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
@@ -452,6 +480,8 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
+  ResetWarmStart();
+  if (cost_scaling_factor_ != 1) UnscaleCosts();
   if (absl::GetFlag(FLAGS_min_cost_flow_check_balance) &&
       !CheckInputConsistency()) {
     return false;
@@ -471,15 +501,191 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
 
   if (absl::GetFlag(FLAGS_min_cost_flow_check_result) && !CheckResult()) {
     status_ = BAD_RESULT;
-    UnscaleCosts();
     return false;
   }
-  UnscaleCosts();
+  // The costs are left scaled, so that SolveIncrementally() can start from the
+  // current flow and node potentials.
+  can_warm_start_ = true;
 
   IF_STATS_ENABLED(VLOG(1) << stats_.StatString());
   return true;
 }
 
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+bool GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::SolveIncrementally() {
+  const CostValue cost_scaling_factor =
+      scale_prices_ ? graph_->num_nodes() + 1 : 1;
+  if (!can_warm_start_ || cost_scaling_factor_ != cost_scaling_factor) {
+    return Solve();
+  }
+  SCOPED_TIME_STAT(&stats_);
+  status_ = NOT_SOLVED;
+  epsilon_ = 1LL;
+  num_relabels_since_last_price_update_ = 0;
+
+  // The last solution is 1-optimal for all the arcs which were not modified.
+  // Restore the 1-optimality of the modified arcs by saturating them when their
+  // reduced cost became too negative. The only nodes with a non-zero excess are
+  // then the ends of the modified arcs and the nodes whose supply changed.
+  for (const ArcIndex arc : modified_arcs_) {
+    for (const ArcIndex residual_arc : {arc, Opposite(arc)}) {
+      if (residual_arc_capacity_[residual_arc] > 0 &&
+          ReducedCost(residual_arc) < -epsilon_) {
+        PushFlow(residual_arc_capacity_[residual_arc], residual_arc);
+      }
+    }
+  }
+  modified_arcs_.clear();
+  std::sort(modified_nodes_.begin(), modified_nodes_.end());
+  modified_nodes_.erase(
+      std::unique(modified_nodes_.begin(), modified_nodes_.end()),
+      modified_nodes_.end());
+  FlowQuantity total_excess = 0;
+  for (const NodeIndex node : modified_nodes_) {
+    total_excess += node_excess_[node];
+  }
+  if (absl::GetFlag(FLAGS_min_cost_flow_check_balance) && total_excess != 0) {
+    // The warm start is still valid, the supplies can be fixed and the problem
+    // solved again.
+    status_ = UNBALANCED;
+    LOG(ERROR) << "Input consistency error: unbalanced problem";
+    return false;
+  }
+
+  std::vector<NodeIndex> sources;
+  for (const NodeIndex node : modified_nodes_) {
+    if (node_excess_[node] > 0) sources.push_back(node);
+  }
+  ResetWarmStart();
+  while (!sources.empty()) {
+    if (!AugmentAlongShortestPath(sources)) return false;
+    sources.erase(std::remove_if(sources.begin(), sources.end(),
+                                 [this](NodeIndex node) {
+                                   return node_excess_[node] == 0;
+                                 }),
+                  sources.end());
+  }
+  DCHECK_EQ(status_, NOT_SOLVED);
+  status_ = OPTIMAL;
+  DCHECK(CheckResult());
+  can_warm_start_ = true;
+  return true;
+}
+
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::
+    AugmentAlongShortestPath(absl::Span<const NodeIndex> sources) {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  const CostValue kMaxCostValue = std::numeric_limits<CostValue>::max();
+  if (node_distance_.size() < num_nodes) {
+    node_distance_.resize(num_nodes, kMaxCostValue);
+    node_parent_arc_.resize(num_nodes, Graph::kNilArc);
+  }
+
+  // Dijkstra from the sources in the residual graph, until a node with a
+  // deficit is settled. The length of a residual arc is its reduced cost plus
+  // epsilon_, which is non-negative since the pseudo-flow is epsilon-optimal.
+  // With costs scaled by (n + 1) and epsilon_ == 1, the lengths of two simple
+  // paths differ by less than n + 1 from their scaled costs, so a shortest
+  // path is also a path of minimum cost.
+  std::vector<NodeIndex> settled_nodes;
+  std::vector<NodeIndex> reached_nodes;
+  std::priority_queue<std::pair<CostValue, NodeIndex>,
+                      std::vector<std::pair<CostValue, NodeIndex>>,
+                      std::greater<std::pair<CostValue, NodeIndex>>>
+      queue;
+  for (const NodeIndex source : sources) {
+    node_distance_[source] = 0;
+    reached_nodes.push_back(source);
+    queue.push({0, source});
+  }
+  NodeIndex sink = Graph::kNilNode;
+  while (!queue.empty()) {
+    const auto [distance, node] = queue.top();
+    queue.pop();
+    if (distance > node_distance_[node]) continue;
+    settled_nodes.push_back(node);
+    if (node_excess_[node] < 0) {
+      sink = node;
+      break;
+    }
+    const CostValue tail_potential = node_potential_[node];
+    for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node); it.Ok();
+         it.Next()) {
+      const ArcIndex arc = it.Index();
+      if (residual_arc_capacity_[arc] == 0) continue;
+      const NodeIndex head = Head(arc);
+      const CostValue head_distance =
+          distance + FastReducedCost(arc, tail_potential) + epsilon_;
+      DCHECK_GE(head_distance, distance);
+      if (head_distance < node_distance_[head]) {
+        if (node_distance_[head] == kMaxCostValue) {
+          reached_nodes.push_back(head);
+        }
+        node_distance_[head] = head_distance;
+        node_parent_arc_[head] = arc;
+        queue.push({head_distance, head});
+      }
+    }
+  }
+
+  const auto reset_nodes = [this, &reached_nodes, kMaxCostValue]() {
+    for (const NodeIndex node : reached_nodes) {
+      node_distance_[node] = kMaxCostValue;
+      node_parent_arc_[node] = Graph::kNilArc;
+    }
+  };
+  if (sink == Graph::kNilNode) {
+    // Only max flow can detect that a min-cost flow problem is infeasible in
+    // general, but here no path leads the excess of the sources to a deficit.
+    reset_nodes();
+    status_ = INFEASIBLE;
+    return false;
+  }
+
+  // Lowers the potential of the settled nodes so that the arcs of the shortest
+  // paths have a reduced cost of -epsilon_, which keeps the epsilon-optimality
+  // of the pseudo-flow. The other nodes are left unchanged.
+  const CostValue sink_distance = node_distance_[sink];
+  for (const NodeIndex node : settled_nodes) {
+    node_potential_[node] += node_distance_[node] - sink_distance;
+    if (node_potential_[node] < overflow_threshold_) {
+      reset_nodes();
+      status_ = BAD_COST_RANGE;
+      return false;
+    }
+  }
+
+  // Pushes as much flow as possible along the path.
+  FlowQuantity flow = -node_excess_[sink];
+  NodeIndex source = sink;
+  while (node_parent_arc_[source] != Graph::kNilArc) {
+    const ArcIndex arc = node_parent_arc_[source];
+    flow = std::min(flow,
+                    static_cast<FlowQuantity>(residual_arc_capacity_[arc]));
+    source = Tail(arc);
+  }
+  flow = std::min(flow, node_excess_[source]);
+  DCHECK_GT(flow, 0);
+  for (NodeIndex node = sink; node != source;) {
+    const ArcIndex arc = node_parent_arc_[node];
+    node = Tail(arc);
+    FastPushFlow(flow, arc, node);
+  }
+  reset_nodes();
+  return true;
+}
+
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+void GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::ResetWarmStart() {
+  can_warm_start_ = false;
+  modified_arcs_.clear();
+  modified_nodes_.clear();
+}
+
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 CostValue
 GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::GetOptimalCost() {
@@ -494,8 +700,8 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::GetOptimalCost() {
   const CostValue kMinCost = std::numeric_limits<CostValue>::min();
   for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
     const CostValue flow_on_arc = residual_arc_capacity_[Opposite(arc)];
-    const CostValue flow_cost =
-        CapProd(scaled_arc_unit_cost_[arc], flow_on_arc);
+    const CostValue flow_cost = CapProd(
+        scaled_arc_unit_cost_[arc] / cost_scaling_factor_, flow_on_arc);
     if (flow_cost == kMaxCost || flow_cost == kMinCost) return kMaxCost;
     total_flow_cost = CapAdd(flow_cost, total_flow_cost);
     if (total_flow_cost == kMaxCost || total_flow_cost == kMinCost) {
@@ -175,6 +175,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/types.h"
 #include "ortools/graph/ebert_graph.h"
@@ -423,6 +424,18 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Solves the problem, returning true if a min-cost flow could be found.
   bool Solve();
 
+  // Same as Solve(), but starts from the flow and the node potentials of the
+  // last successful Solve() or SolveIncrementally(), and only repairs the arcs
+  // and nodes modified since then by SetArcUnitCost(), SetArcCapacity() and
+  // SetNodeSupply(): the flow is pushed along shortest paths from the nodes
+  // with an excess, which only explores the graph around the changes.
+  // Falls back to Solve() when there is no such solution, when the graph
+  // changed, or after calls to SetArcFlow(), MakeFeasible() or
+  // SetArcUnitCost() with a cost much larger than the costs of the last
+  // Solve(). Contrary to Solve(), the infeasibility of the modified problem is
+  // always detected, without a max-flow.
+  bool SolveIncrementally();
+
   // Checks for feasibility, i.e., that all the supplies and demands can be
   // matched without exceeding bottlenecks in the network.
   // If infeasible_supply_node (resp. infeasible_demand_node) are not NULL,
@@ -560,6 +573,16 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Returns false on overflow or infeasibility.
   bool Refine();
 
+  // Pushes flow from the given nodes with a positive excess to the closest
+  // node with a deficit, along a shortest path of the residual graph, and
+  // updates the node potentials of the explored nodes to keep the
+  // epsilon-optimality of the pseudo-flow. Used by SolveIncrementally().
+  // Returns false on overflow or infeasibility.
+  bool AugmentAlongShortestPath(absl::Span<const NodeIndex> sources);
+
+  // Forgets the solution used to warm start SolveIncrementally().
+  void ResetWarmStart();
+
   // Discharges an active node by saturating its admissible adjacent arcs,
   // if any, and by relabelling it when it becomes inactive.
   // Returns false on overflow or infeasibility.
@@ -669,6 +692,21 @@ class GenericMinCostFlow : public MinCostFlowBase {
 
   // Whether to scale prices, see SimpleMinCostFlow::SetPriceScaling().
   bool scale_prices_ = true;
+
+  // Whether the flow and the node potentials are the ones of the last
+  // successful solve, with the costs still scaled by cost_scaling_factor_, and
+  // can be used by SolveIncrementally().
+  bool can_warm_start_ = false;
+
+  // The arcs and nodes modified since the last successful solve, possibly with
+  // duplicates. Only maintained when can_warm_start_ is true.
+  std::vector<ArcIndex> modified_arcs_;
+  std::vector<NodeIndex> modified_nodes_;
+
+  // Distances and shortest path tree of AugmentAlongShortestPath(). Only the
+  // explored nodes are reset after each call.
+  std::vector<CostValue> node_distance_;
+  std::vector<ArcIndex> node_parent_arc_;
 };
 
 #if !SWIG
@@ -284,6 +284,125 @@ TYPED_TEST(GenericMinCostFlowTest, TotalFlowCostOverflow) {
       kExpectedFlowCost, kExpectedFlow, GenericMinCostFlow<TypeParam>::OPTIMAL);
 }
 
+// Solves a sequence of random modifications of a transportation problem
+// incrementally, and compares the result with a solve from scratch.
+TYPED_TEST(GenericMinCostFlowTest, SolveIncrementally) {
+  const int kNumSources = 10;
+  const int kNumSinks = 10;
+  const int kNumNodes = kNumSources + kNumSinks + 10;
+  const int kNumRandomArcs = 100;
+  const FlowQuantity kMaxSupply = 20;
+  std::mt19937 random(12345);
+  std::vector<NodeIndex> tails;
+  std::vector<NodeIndex> heads;
+  std::vector<CostValue> costs;
+  std::vector<FlowQuantity> capacities;
+  // Expensive arcs from each source to each sink keep the problem feasible,
+  // they are never modified.
+  for (NodeIndex source = 0; source < kNumSources; ++source) {
+    for (NodeIndex sink = 0; sink < kNumSinks; ++sink) {
+      tails.push_back(source);
+      heads.push_back(kNumSources + sink);
+      costs.push_back(1000);
+      capacities.push_back(2 * kMaxSupply);
+    }
+  }
+  const ArcIndex num_fixed_arcs = tails.size();
+  for (ArcIndex arc = 0; arc < kNumRandomArcs; ++arc) {
+    tails.push_back(absl::Uniform(random, 0, kNumNodes));
+    heads.push_back(absl::Uniform(random, 0, kNumNodes));
+    costs.push_back(absl::Uniform(random, -10, 100));
+    capacities.push_back(absl::Uniform(random, 0, kMaxSupply));
+  }
+  std::vector<FlowQuantity> supplies(kNumNodes, 0);
+  for (NodeIndex source = 0; source < kNumSources; ++source) {
+    const FlowQuantity supply = absl::Uniform(random, 0, kMaxSupply);
+    supplies[source] += supply;
+    supplies[kNumSources + source % kNumSinks] -= supply;
+  }
+
+  const ArcIndex num_arcs = tails.size();
+  TypeParam graph(kNumNodes, num_arcs);
+  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+    graph.AddArc(tails[arc], heads[arc]);
+  }
+  std::vector<ArcIndex> permutation;
+  Graphs<TypeParam>::Build(&graph, &permutation);
+  const auto permuted = [&permutation](ArcIndex arc) {
+    return arc < permutation.size() ? permutation[arc] : arc;
+  };
+
+  GenericMinCostFlow<TypeParam> incremental(&graph);
+  SetUpNetworkData(permutation, supplies, costs, capacities, &graph,
+                   &incremental);
+  ASSERT_TRUE(incremental.SolveIncrementally());
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    for (int i = 0; i < 3; ++i) {
+      const ArcIndex arc = absl::Uniform(random, num_fixed_arcs, num_arcs);
+      costs[arc] = absl::Uniform(random, -10, 100);
+      capacities[arc] = absl::Uniform(random, 0, kMaxSupply);
+      incremental.SetArcUnitCost(permuted(arc), costs[arc]);
+      incremental.SetArcCapacity(permuted(arc), capacities[arc]);
+    }
+    if (iteration % 5 == 0) {
+      const NodeIndex source = absl::Uniform(random, 0, kNumSources);
+      const NodeIndex sink = kNumSources + absl::Uniform(random, 0, kNumSinks);
+      const FlowQuantity delta = std::min(kMaxSupply - supplies[source],
+                                          kMaxSupply + supplies[sink]);
+      supplies[source] += delta;
+      supplies[sink] -= delta;
+      incremental.SetNodeSupply(source, supplies[source]);
+      incremental.SetNodeSupply(sink, supplies[sink]);
+    }
+    ASSERT_TRUE(incremental.SolveIncrementally());
+    EXPECT_EQ(GenericMinCostFlow<TypeParam>::OPTIMAL, incremental.status());
+
+    GenericMinCostFlow<TypeParam> from_scratch(&graph);
+    SetUpNetworkData(permutation, supplies, costs, capacities, &graph,
+                     &from_scratch);
+    ASSERT_TRUE(from_scratch.Solve());
+    EXPECT_EQ(from_scratch.GetOptimalCost(), incremental.GetOptimalCost());
+
+    std::vector<FlowQuantity> excesses = supplies;
+    for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+      const FlowQuantity flow = incremental.Flow(permuted(arc));
+      EXPECT_LE(0, flow);
+      EXPECT_LE(flow, capacities[arc]);
+      EXPECT_EQ(costs[arc], incremental.UnitCost(permuted(arc)));
+      excesses[tails[arc]] -= flow;
+      excesses[heads[arc]] += flow;
+    }
+    EXPECT_EQ(excesses, std::vector<FlowQuantity>(kNumNodes, 0));
+  }
+}
+
+TEST(GenericMinCostFlowTest, SolveIncrementallyInfeasible) {
+  util::ReverseArcListGraph<> graph;
+  const int arc = graph.AddArc(0, 1);
+
+  GenericMinCostFlow<util::ReverseArcListGraph<>> mcf(&graph);
+  mcf.SetArcCapacity(arc, 10);
+  mcf.SetArcUnitCost(arc, 3);
+  mcf.SetNodeSupply(0, 5);
+  mcf.SetNodeSupply(1, -5);
+  EXPECT_TRUE(mcf.SolveIncrementally());
+  EXPECT_EQ(mcf.GetOptimalCost(), 15);
+
+  mcf.SetArcCapacity(arc, 3);
+  EXPECT_FALSE(mcf.SolveIncrementally());
+  EXPECT_EQ(mcf.status(), MinCostFlowBase::INFEASIBLE);
+
+  mcf.SetArcCapacity(arc, 4);
+  mcf.SetNodeSupply(0, 4);
+  mcf.SetNodeSupply(1, -4);
+  EXPECT_TRUE(mcf.SolveIncrementally());
+  EXPECT_EQ(mcf.GetOptimalCost(), 12);
+  mcf.SetArcUnitCost(arc, -2);
+  EXPECT_TRUE(mcf.SolveIncrementally());
+  EXPECT_EQ(mcf.GetOptimalCost(), -8);
+  EXPECT_EQ(mcf.Flow(arc), 4);
+}
+
 TEST(GenericMinCostFlowTest, OverflowPrevention1) {
   util::ReverseArcListGraph<> graph;
   const int arc = graph.AddArc(0, 1);
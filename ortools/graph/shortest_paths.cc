@@ -14,6 +14,9 @@
 #include "ortools/graph/shortest_paths.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -21,6 +24,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/bind_front.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/adjustable_priority_queue-inl.h"
 #include "ortools/base/adjustable_priority_queue.h"
 #include "ortools/base/logging.h"
@@ -575,4 +579,231 @@ void ComputeManyToManyShortestPathsWithMultipleThreads(
       graph, arc_lengths, sources, destinations, num_threads, path_container);
 }
 
+namespace {
+
+// Synchronizes the threads of a delta-stepping computation between phases.
+class DeltaSteppingBarrier {
+ public:
+  explicit DeltaSteppingBarrier(int num_threads) : num_threads_(num_threads) {}
+
+  // Blocks until all threads have called Wait(). The last thread to arrive
+  // runs 'last_arrival' before releasing the other threads.
+  void Wait(const std::function<void()>& last_arrival) {
+    absl::MutexLock lock(&mutex_);
+    if (++num_arrived_ == num_threads_) {
+      last_arrival();
+      num_arrived_ = 0;
+      ++generation_;
+      condition_.SignalAll();
+      return;
+    }
+    const int64_t generation = generation_;
+    while (generation_ == generation) condition_.Wait(&mutex_);
+  }
+
+ private:
+  const int num_threads_;
+  absl::Mutex mutex_;
+  absl::CondVar condition_;
+  int num_arrived_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t generation_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Delta-stepping computation from a single source. All threads run
+// RunThread(); each phase relaxes the arcs of the nodes in 'frontier_' in
+// parallel, each thread recording the nodes it improved. Between phases, a
+// single thread moves these nodes to their buckets, and selects the next
+// frontier.
+class DeltaStepping {
+ public:
+  typedef StaticGraph<>::NodeIndex NodeIndex;
+
+  DeltaStepping(const StaticGraph<>& graph,
+                const std::vector<PathDistance>& arc_lengths,
+                PathDistance delta, PathDistance max_arc_length,
+                int num_threads)
+      : graph_(graph),
+        arc_lengths_(arc_lengths),
+        delta_(delta),
+        num_threads_(num_threads),
+        distances_(graph.num_nodes()),
+        bucket_of_node_(graph.num_nodes(), -1),
+        relaxed_in_bucket_(graph.num_nodes(), -1),
+        // Pending nodes have distances between those of the current bucket
+        // and those of the current bucket plus the maximum arc length.
+        buckets_(max_arc_length / delta + 2),
+        improved_nodes_(num_threads),
+        barrier_(num_threads) {
+    for (std::atomic<PathDistance>& distance : distances_) {
+      distance.store(kDisconnectedPathDistance, std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<PathDistance> Run(NodeIndex source) {
+    distances_[source].store(0, std::memory_order_relaxed);
+    improved_nodes_[0].push_back(source);
+    // Moves 'source' to its bucket and selects the first frontier.
+    light_phase_ = false;
+    EndPhase();
+    {
+      ThreadPool pool("OR_DeltaStepping", num_threads_);
+      pool.StartWorkers();
+      for (int thread = 0; thread < num_threads_; ++thread) {
+        pool.Schedule([this, thread]() { RunThread(thread); });
+      }
+    }
+    std::vector<PathDistance> distances(distances_.size());
+    for (int node = 0; node < distances.size(); ++node) {
+      distances[node] = distances_[node].load(std::memory_order_relaxed);
+    }
+    return distances;
+  }
+
+ private:
+  int64_t BucketOf(NodeIndex node) const {
+    return distances_[node].load(std::memory_order_relaxed) / delta_;
+  }
+
+  void RunThread(int thread) {
+    const std::function<void()> end_phase = [this]() { EndPhase(); };
+    while (!done_) {
+      // Each thread relaxes a contiguous slice of the frontier.
+      const int begin = frontier_.size() * thread / num_threads_;
+      const int end = frontier_.size() * (thread + 1) / num_threads_;
+      for (int i = begin; i < end; ++i) {
+        Relax(frontier_[i], &improved_nodes_[thread]);
+      }
+      barrier_.Wait(end_phase);
+    }
+  }
+
+  // Relaxes the light (or heavy) arcs of 'node', and appends the nodes whose
+  // distance was improved to 'improved_nodes'.
+  void Relax(NodeIndex node, std::vector<NodeIndex>* improved_nodes) {
+    const uint64_t distance = distances_[node].load(std::memory_order_relaxed);
+    for (const StaticGraph<>::ArcIndex arc : graph_.OutgoingArcs(node)) {
+      const PathDistance arc_length = arc_lengths_[arc];
+      if ((arc_length <= delta_) != light_phase_) continue;
+      const uint64_t new_distance = distance + arc_length;
+      if (new_distance >= kDisconnectedPathDistance) continue;
+      const NodeIndex head = graph_.Head(arc);
+      std::atomic<PathDistance>& head_distance = distances_[head];
+      PathDistance old_distance = head_distance.load(std::memory_order_relaxed);
+      while (new_distance < old_distance) {
+        if (head_distance.compare_exchange_weak(old_distance, new_distance,
+                                                std::memory_order_relaxed)) {
+          improved_nodes->push_back(head);
+          break;
+        }
+      }
+    }
+  }
+
+  // Runs on a single thread between phases.
+  void EndPhase() {
+    const int num_buckets = buckets_.size();
+    for (std::vector<NodeIndex>& improved_nodes : improved_nodes_) {
+      for (const NodeIndex node : improved_nodes) {
+        const int64_t bucket = BucketOf(node);
+        // Skips nodes improved several times during the phase.
+        if (bucket_of_node_[node] == bucket) continue;
+        bucket_of_node_[node] = bucket;
+        buckets_[bucket % num_buckets].push_back(node);
+        ++num_pending_entries_;
+      }
+      improved_nodes.clear();
+    }
+
+    if (light_phase_) {
+      // Light arcs are relaxed until the current bucket stays empty, then the
+      // heavy arcs of all the nodes relaxed in the bucket are relaxed once.
+      TakeBucket();
+      if (frontier_.empty()) {
+        light_phase_ = false;
+        frontier_.swap(relaxed_nodes_);
+        relaxed_nodes_.clear();
+      }
+      return;
+    }
+    // Moves to the next non-empty bucket.
+    frontier_.clear();
+    while (frontier_.empty()) {
+      if (num_pending_entries_ == 0) {
+        done_ = true;
+        return;
+      }
+      ++current_bucket_;
+      TakeBucket();
+    }
+    light_phase_ = true;
+  }
+
+  // Moves the nodes of the current bucket to the frontier. Entries of nodes
+  // whose distance was improved after their insertion are stale, and skipped.
+  void TakeBucket() {
+    std::vector<NodeIndex>& bucket =
+        buckets_[current_bucket_ % buckets_.size()];
+    num_pending_entries_ -= bucket.size();
+    frontier_.clear();
+    for (const NodeIndex node : bucket) {
+      if (bucket_of_node_[node] != current_bucket_) continue;
+      bucket_of_node_[node] = -1;
+      frontier_.push_back(node);
+      if (relaxed_in_bucket_[node] != current_bucket_) {
+        relaxed_in_bucket_[node] = current_bucket_;
+        relaxed_nodes_.push_back(node);
+      }
+    }
+    bucket.clear();
+  }
+
+  const StaticGraph<>& graph_;
+  const std::vector<PathDistance>& arc_lengths_;
+  const PathDistance delta_;
+  const int num_threads_;
+  std::vector<std::atomic<PathDistance>> distances_;
+  // Bucket in which each node is pending, -1 if none.
+  std::vector<int64_t> bucket_of_node_;
+  // Last bucket in which each node was relaxed.
+  std::vector<int64_t> relaxed_in_bucket_;
+  // Circular array of buckets, containing the nodes pending relaxation.
+  std::vector<std::vector<NodeIndex>> buckets_;
+  int64_t num_pending_entries_ = 0;
+  int64_t current_bucket_ = -1;
+  // Nodes relaxed in the current bucket, whose heavy arcs remain to relax.
+  std::vector<NodeIndex> relaxed_nodes_;
+  // The following members are only modified by EndPhase(), and read by all
+  // threads during phases.
+  std::vector<NodeIndex> frontier_;
+  bool light_phase_ = true;
+  bool done_ = false;
+  // Nodes improved by each thread during the current phase.
+  std::vector<std::vector<NodeIndex>> improved_nodes_;
+  DeltaSteppingBarrier barrier_;
+};
+
+}  // namespace
+
+std::vector<PathDistance> ComputeOneToAllShortestPathDistancesWithDeltaStepping(
+    const StaticGraph<>& graph, const std::vector<PathDistance>& arc_lengths,
+    StaticGraph<>::NodeIndex source, PathDistance delta, int num_threads) {
+  CHECK_EQ(graph.num_arcs(), arc_lengths.size())
+      << "Number of arcs in graph must match arc length vector size";
+  CHECK_GE(source, 0);
+  CHECK_LT(source, graph.num_nodes());
+  CHECK_GE(num_threads, 1);
+  PathDistance max_arc_length = 0;
+  for (const PathDistance arc_length : arc_lengths) {
+    max_arc_length = std::max(max_arc_length, arc_length);
+  }
+  if (delta == 0) {
+    const int64_t average_degree =
+        std::max<int64_t>(1, graph.num_arcs() / graph.num_nodes());
+    delta = std::max<PathDistance>(1, max_arc_length / average_degree);
+  }
+  DeltaStepping delta_stepping(graph, arc_lengths, delta, max_arc_length,
+                               num_threads);
+  return delta_stepping.Run(source);
+}
+
 }  // namespace operations_research
@@ -320,6 +320,28 @@ void ComputeAllToAllShortestPathsWithMultipleThreads(
       graph, arc_lengths, all_nodes, all_nodes, num_threads, path_container);
 }
 
+// Computes the distances from 'source' to all the nodes of the graph, using
+// 'num_threads' threads for this single source, and returns them indexed by
+// node (kDisconnectedPathDistance for nodes not reachable from 'source').
+// Unlike in PathContainer, the distance from 'source' to itself is always 0.
+// The ComputeXXXWithMultipleThreads() functions above run one sequential
+// Dijkstra per source, and do not benefit from threads for a single source.
+//
+// Implements the delta-stepping algorithm (U. Meyer, P. Sanders,
+// "Delta-stepping: a parallelizable shortest path algorithm", J. Algorithms
+// 49(1), 2003): nodes are grouped in buckets of distances of width 'delta',
+// and all the nodes of the bucket of smallest distances are relaxed in
+// parallel. Arcs of length at most 'delta' ("light" arcs) may reinsert nodes
+// in the current bucket, and are relaxed until the bucket is empty; the other
+// arcs are then relaxed once from the nodes which were in the bucket. A small
+// 'delta' makes the algorithm close to Dijkstra, with little parallelism; a
+// large one makes it close to Bellman-Ford, with many redundant relaxations.
+// If 'delta' is 0, the maximum arc length divided by the average out-degree is
+// used, which is a good value on graphs with random arc lengths.
+std::vector<PathDistance> ComputeOneToAllShortestPathDistancesWithDeltaStepping(
+    const StaticGraph<>& graph, const std::vector<PathDistance>& arc_lengths,
+    StaticGraph<>::NodeIndex source, PathDistance delta, int num_threads);
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_GRAPH_SHORTEST_PATHS_H_
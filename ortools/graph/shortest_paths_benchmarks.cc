@@ -233,5 +233,52 @@ BENCHMARK(BM_WindowedAllPairsOn2DGrid<SHORTEST_PATHS, 16>)
     ->ArgPair(1000, 10)
     ->ArgPair(500, 50);
 
+// Compares the sequential Dijkstra of ComputeOneToAllShortestPaths() with
+// delta-stepping on a single source, with the default delta.
+template <bool use_delta_stepping>
+static void BM_OneToAllOn2DGrid(benchmark::State& state) {
+  // Benchmark arguments: grid size and number of threads (only used by
+  // delta-stepping).
+  const int grid_size = state.range(0);
+  const int num_threads = state.range(1);
+
+  std::unique_ptr<Graph> graph =
+      util::Create2DGridGraph<Graph>(grid_size, grid_size);
+  std::vector<uint32_t> arc_costs(graph->num_arcs(), 0);
+  std::mt19937 random(12345);
+  for (uint32_t& cost : arc_costs) {
+    cost = absl::Uniform(random, 0, 100000);
+  }
+  // Source at the center of the grid.
+  const int source = (grid_size / 2) * grid_size + grid_size / 2;
+  for (auto _ : state) {
+    if (use_delta_stepping) {
+      ::benchmark::DoNotOptimize(
+          ComputeOneToAllShortestPathDistancesWithDeltaStepping(
+              *graph, arc_costs, source, /*delta=*/0, num_threads));
+    } else {
+      PathContainer path_container;
+      PathContainer::BuildPathDistanceContainer(&path_container);
+      ComputeOneToAllShortestPaths(*graph, arc_costs, source, &path_container);
+      ::benchmark::DoNotOptimize(path_container.GetDistance(source, 0));
+    }
+  }
+  // "byte" = node for which we computed the shortest path distance.
+  state.SetBytesProcessed(state.iterations() * graph->num_nodes());
+}
+
+BENCHMARK(BM_OneToAllOn2DGrid<false>)
+    ->ArgPair(/*grid_size*/ 100, /*num_threads*/ 1)
+    ->ArgPair(/*grid_size*/ 1000, /*num_threads*/ 1)
+    ->ArgPair(/*grid_size*/ 3000, /*num_threads*/ 1);
+BENCHMARK(BM_OneToAllOn2DGrid<true>)
+    ->ArgPair(/*grid_size*/ 100, /*num_threads*/ 1)
+    ->ArgPair(/*grid_size*/ 100, /*num_threads*/ 8)
+    ->ArgPair(/*grid_size*/ 1000, /*num_threads*/ 1)
+    ->ArgPair(/*grid_size*/ 1000, /*num_threads*/ 8)
+    ->ArgPair(/*grid_size*/ 1000, /*num_threads*/ 16)
+    ->ArgPair(/*grid_size*/ 3000, /*num_threads*/ 8)
+    ->ArgPair(/*grid_size*/ 3000, /*num_threads*/ 16);
+
 }  // namespace
 }  // namespace operations_research
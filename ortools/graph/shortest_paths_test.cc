@@ -460,4 +460,42 @@ TYPED_TEST(GraphShortestPathsTest, DISABLED_LargeRandomShortestPaths) {
     }
   }
 }
+
+// Compares delta-stepping with Dijkstra on random graphs, for several values
+// of delta and numbers of threads.
+TEST(DeltaSteppingTest, RandomGraphs) {
+  std::mt19937 randomizer(12345);
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    const int num_nodes = 1 + absl::Uniform(randomizer, 0, 200);
+    const int num_arcs = absl::Uniform(randomizer, 0, 5 * num_nodes);
+    StaticGraph<> graph(num_nodes, num_arcs);
+    std::vector<PathDistance> lengths;
+    for (int i = 0; i < num_arcs; ++i) {
+      graph.AddArc(absl::Uniform(randomizer, 0, num_nodes),
+                   absl::Uniform(randomizer, 0, num_nodes));
+      lengths.push_back(absl::Uniform(randomizer, 0, 1000));
+    }
+    std::vector<StaticGraph<>::ArcIndex> permutation;
+    graph.Build(&permutation);
+    util::Permute(permutation, &lengths);
+    const StaticGraph<>::NodeIndex source =
+        absl::Uniform(randomizer, 0, num_nodes);
+    PathContainer container;
+    PathContainer::BuildPathDistanceContainer(&container);
+    ComputeOneToAllShortestPaths(graph, lengths, source, &container);
+    for (const PathDistance delta : {0, 1, 50, 2000}) {
+      for (const int num_threads : {1, 4}) {
+        const std::vector<PathDistance> distances =
+            ComputeOneToAllShortestPathDistancesWithDeltaStepping(
+                graph, lengths, source, delta, num_threads);
+        ASSERT_EQ(distances.size(), num_nodes);
+        EXPECT_EQ(distances[source], 0);
+        for (int node = 0; node < num_nodes; ++node) {
+          if (node == source) continue;
+          EXPECT_EQ(distances[node], container.GetDistance(source, node));
+        }
+      }
+    }
+  }
+}
 }  // namespace operations_research
@@ -72,6 +72,7 @@ class GLOPInterface : public MPSolverInterface {
 
   std::string SolverVersion() const override;
   void* underlying_solver() override;
+  bool ExtractsTermVectors() const override;
 
   void ExtractNewVariables() override;
   void ExtractNewConstraints() override;
@@ -266,6 +267,8 @@ std::string GLOPInterface::SolverVersion() const {
 
 void* GLOPInterface::underlying_solver() { return &lp_solver_; }
 
+bool GLOPInterface::ExtractsTermVectors() const { return true; }
+
 void GLOPInterface::ExtractNewVariables() {
   DCHECK_EQ(0, last_variable_index_);
   DCHECK_EQ(0, last_constraint_index_);
@@ -284,6 +287,21 @@ void GLOPInterface::ExtractNewConstraints() {
   DCHECK_EQ(0, last_constraint_index_);
 
   const glop::RowIndex num_rows(solver_->constraints_.size());
+
+  // Reserve the columns of the matrix beforehand, so that each of them is
+  // allocated once.
+  glop::StrictITIVector<glop::ColIndex, glop::EntryIndex> column_sizes(
+      linear_program_.num_variables(), glop::EntryIndex(0));
+  for (glop::RowIndex row(0); row < num_rows; ++row) {
+    solver_->constraints_[row.value()]->ForEachTerm(
+        [&column_sizes](const MPVariable* const var, const double) {
+          ++column_sizes[glop::ColIndex(var->index())];
+        });
+  }
+  for (glop::ColIndex col(0); col < column_sizes.size(); ++col) {
+    linear_program_.GetMutableSparseColumn(col)->Reserve(column_sizes[col]);
+  }
+
   for (glop::RowIndex row(0); row < num_rows; ++row) {
     MPConstraint* const ct = solver_->constraints_[row.value()];
     set_constraint_as_extracted(row.value(), true);
@@ -294,13 +312,11 @@ void GLOPInterface::ExtractNewConstraints() {
     DCHECK_EQ(new_row, row);
     linear_program_.SetConstraintBounds(row, lb, ub);
 
-    for (const auto& entry : ct->coefficients_) {
-      const int var_index = entry.first->index();
+    ct->ForEachTerm([&](const MPVariable* const var, const double coeff) {
+      const int var_index = var->index();
       DCHECK(variable_is_extracted(var_index));
-      const glop::ColIndex col(var_index);
-      const double coeff = entry.second;
-      linear_program_.SetCoefficient(row, col, coeff);
-    }
+      linear_program_.SetCoefficient(row, glop::ColIndex(var_index), coeff);
+    });
   }
 }
 
@@ -112,12 +112,23 @@ bool SolverTypeIsMip(MPModelRequest::SolverType solver_type) {
 double MPConstraint::GetCoefficient(const MPVariable* const var) const {
   DLOG_IF(DFATAL, !interface_->solver_->OwnsVariable(var)) << var;
   if (var == nullptr) return 0.0;
+  MergeTermVector();
   return gtl::FindWithDefault(coefficients_, var);
 }
 
 void MPConstraint::SetCoefficient(const MPVariable* const var, double coeff) {
   DLOG_IF(DFATAL, !interface_->solver_->OwnsVariable(var)) << var;
   if (var == nullptr) return;
+  if (use_term_vector_ && coefficients_.empty() &&
+      interface_->sync_status_ == MPSolverInterface::MUST_RELOAD &&
+      !interface_->constraint_is_extracted(index_)) {
+    // The interface reads all the terms of the constraint when it reloads the
+    // model, so there is nothing to notify it of.
+    term_vector_.push_back(std::make_pair(var, coeff));
+    term_vector_is_merged_ = false;
+    return;
+  }
+  MergeTermVector();
   if (coeff == 0.0) {
     auto it = coefficients_.find(var);
     // If setting a coefficient to 0 when this coefficient did not
@@ -142,8 +153,66 @@ void MPConstraint::SetCoefficient(const MPVariable* const var, double coeff) {
 }
 
 void MPConstraint::Clear() {
+  if (interface_->constraint_is_extracted(index_)) MergeTermVector();
   interface_->ClearConstraint(this);
   coefficients_.clear();
+  term_vector_.clear();
+  term_vector_is_merged_ = true;
+}
+
+namespace {
+
+// Sorts the (var, coeff) pairs by variable index and merges the pairs of each
+// variable, keeping the last one, then drops the zero coefficients.
+void SortAndMergeTerms(
+    std::vector<std::pair<const MPVariable*, double>>* const terms) {
+  const auto by_index = [](const std::pair<const MPVariable*, double>& a,
+                           const std::pair<const MPVariable*, double>& b) {
+    return a.first->index() < b.first->index();
+  };
+  // The stable sort keeps the pairs of a variable in the order they were set.
+  if (!std::is_sorted(terms->begin(), terms->end(), by_index)) {
+    std::stable_sort(terms->begin(), terms->end(), by_index);
+  }
+  const int size = terms->size();
+  int num_terms = 0;
+  for (int i = 0; i < size; ++i) {
+    if (i + 1 < size && (*terms)[i + 1].first == (*terms)[i].first) continue;
+    if ((*terms)[i].second == 0.0) continue;
+    (*terms)[num_terms++] = (*terms)[i];
+  }
+  terms->resize(num_terms);
+}
+
+}  // namespace
+
+void MPConstraint::SortAndMergeTermVector() {
+  if (term_vector_is_merged_) return;
+  SortAndMergeTerms(&term_vector_);
+  term_vector_is_merged_ = true;
+}
+
+std::vector<std::pair<const MPVariable*, double>>
+MPConstraint::MergedTermVectorCopy() const {
+  std::vector<std::pair<const MPVariable*, double>> terms = term_vector_;
+  SortAndMergeTerms(&terms);
+  return terms;
+}
+
+void MPConstraint::MergeTermVector() const {
+  if (term_vector_.empty()) return;
+  DCHECK(coefficients_.empty());
+  coefficients_.reserve(term_vector_.size());
+  for (const auto& [var, coeff] : term_vector_) {
+    if (coeff == 0.0) {
+      coefficients_.erase(var);
+    } else {
+      coefficients_[var] = coeff;
+    }
+  }
+  term_vector_.clear();
+  term_vector_.shrink_to_fit();
+  term_vector_is_merged_ = true;
 }
 
 void MPConstraint::SetBounds(double lb, double ub) {
@@ -178,7 +247,7 @@ MPSolver::BasisStatus MPConstraint::basis_status() const {
 
 bool MPConstraint::ContainsNewVariables() {
   const int last_variable_index = interface_->last_variable_index();
-  for (const auto& entry : coefficients_) {
+  for (const auto& entry : terms()) {
     const int variable_index = entry.first->index();
     if (variable_index >= last_variable_index ||
         !interface_->variable_is_extracted(variable_index)) {
@@ -1251,16 +1320,17 @@ void MPSolver::ExportModelToProto(MPModelProto* output_model) const {
     // Vector linear_term will contain pairs (variable index, coeff), that will
     // be sorted by variable index.
     std::vector<std::pair<int, double>> linear_term;
-    for (const auto& entry : constraint->coefficients_) {
-      const MPVariable* const var = entry.first;
+    constraint->ForEachTerm([&](const MPVariable* const var,
+                                const double coeff) {
       const int var_index = gtl::FindWithDefault(var_to_index, var, -1);
       DCHECK_NE(-1, var_index);
-      const double coeff = entry.second;
       linear_term.push_back(std::pair<int, double>(var_index, coeff));
-    }
+    });
     // The cost of sort is expected to be low as constraints usually have very
-    // few terms.
-    std::sort(linear_term.begin(), linear_term.end());
+    // few terms. The terms of a term vector are already sorted.
+    if (!std::is_sorted(linear_term.begin(), linear_term.end())) {
+      std::sort(linear_term.begin(), linear_term.end());
+    }
     // Now use linear term.
     for (const std::pair<int, double>& var_and_coeff : linear_term) {
       constraint_proto->add_var_index(var_and_coeff.first);
@@ -1480,6 +1550,7 @@ MPConstraint* MPSolver::MakeRowConstraint(double lb, double ub,
   const int constraint_index = NumConstraints();
   MPConstraint* const constraint =
       new MPConstraint(constraint_index, lb, ub, name, interface_.get());
+  constraint->use_term_vector_ = use_term_vectors_;
   if (constraint_name_to_index_) {
     gtl::InsertOrDie(&*constraint_name_to_index_, constraint->name(),
                      constraint_index);
@@ -1516,8 +1587,8 @@ int MPSolver::ComputeMaxConstraintSize(int min_constraint_index,
   DCHECK_LE(max_constraint_index, constraints_.size());
   for (int i = min_constraint_index; i < max_constraint_index; ++i) {
     MPConstraint* const ct = constraints_[i];
-    if (static_cast<int>(ct->coefficients_.size()) > max_constraint_size) {
-      max_constraint_size = ct->coefficients_.size();
+    if (static_cast<int>(ct->terms().size()) > max_constraint_size) {
+      max_constraint_size = ct->terms().size();
     }
   }
   return max_constraint_size;
@@ -1666,9 +1737,10 @@ std::vector<double> MPSolver::ComputeConstraintActivities() const {
   for (int i = 0; i < static_cast<int>(constraints_.size()); ++i) {
     const MPConstraint& constraint = *constraints_[i];
     AccurateSum<double> sum;
-    for (const auto& entry : constraint.coefficients_) {
-      sum.Add(entry.first->solution_value() * entry.second);
-    }
+    constraint.ForEachTerm([&sum](const MPVariable* const var,
+                                  const double coeff) {
+      sum.Add(var->solution_value() * coeff);
+    });
     activities[i] = sum.Value();
   }
   return activities;
@@ -1734,9 +1806,10 @@ bool MPSolver::VerifySolution(double tolerance, bool log_errors) const {
     const double activity = activities[i];
     // Re-compute the activity with a inaccurate summing algorithm.
     double inaccurate_activity = 0.0;
-    for (const auto& entry : constraint.coefficients_) {
-      inaccurate_activity += entry.first->solution_value() * entry.second;
-    }
+    constraint.ForEachTerm([&inaccurate_activity](const MPVariable* const var,
+                                                  const double coeff) {
+      inaccurate_activity += var->solution_value() * coeff;
+    });
     // Catch NaNs.
     if (std::isnan(activity) || std::isnan(inaccurate_activity)) {
       ++num_errors;
@@ -1973,6 +2046,15 @@ void MPSolverInterface::Write(const std::string& filename) {
 void MPSolverInterface::ExtractModel() {
   switch (sync_status_) {
     case MUST_RELOAD: {
+      // Merges the term vectors in place, so that the const methods reading
+      // the constraints do not need to merge them again.
+      for (MPConstraint* const ct : solver_->constraints_) {
+        if (ExtractsTermVectors()) {
+          ct->SortAndMergeTermVector();
+        } else {
+          ct->MergeTermVector();
+        }
+      }
       ExtractNewVariables();
       ExtractNewConstraints();
       ExtractObjective();
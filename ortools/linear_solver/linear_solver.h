@@ -698,6 +698,34 @@ class MPSolver {
    */
   void SetHint(std::vector<std::pair<const MPVariable*, double> > hint);
 
+  /**
+   * Advanced usage: controls how the constraints created from now on store
+   * their terms.
+   *
+   * By default, MPConstraint::SetCoefficient() updates a hash map. With term
+   * vectors, the terms set on a constraint that has not been extracted yet are
+   * appended to a vector instead, and duplicates are merged lazily, the last
+   * coefficient set for a variable winning. GLOP, SAT and PDLP extract such
+   * constraints directly from the vector; the other solvers, as well as
+   * MPConstraint::terms() and MPConstraint::GetCoefficient(), first convert it
+   * to the hash map.
+   *
+   * Note that with term vectors, a variable whose coefficient was last set to
+   * 0 does not appear in MPConstraint::terms().
+   *
+   * Thread safety: Solve() merges the term vectors in place, and
+   * ExportModelToProto(), ComputeConstraintActivities() and VerifySolution()
+   * merge a copy of the ones not merged yet, so these can run concurrently.
+   * But the first call to MPConstraint::terms() or
+   * MPConstraint::GetCoefficient() on a constraint that still has a term
+   * vector converts it to the hash map: it must not run concurrently with any
+   * other read of the constraint.
+   */
+  void SetUseTermVectors(bool use_term_vectors) {
+    use_term_vectors_ = use_term_vectors;
+  }
+  bool UseTermVectors() const { return use_term_vectors_; }
+
   // Gives some brief (a few lines, at most) human-readable information about
   // the given request, suitable for debug logging.
   ABSL_DEPRECATED("Prefer MPModelRequestLoggingInfo() from solve_mp_model.h.")
@@ -951,6 +979,9 @@ class MPSolver {
   // Permanent storage for the number of threads.
   int num_threads_ = 1;
 
+  // See SetUseTermVectors().
+  bool use_term_vectors_ = false;
+
   // Permanent storage for SetSolverSpecificParametersAsString().
   std::string solver_specific_parameter_string_;
 
@@ -1289,6 +1320,8 @@ class MPConstraint {
   /**
    * Gets the coefficient of a given variable on the constraint (which is 0 if
    * the variable does not appear in the constraint).
+   *
+   * See MPSolver::SetUseTermVectors() for thread safety.
    */
   double GetCoefficient(const MPVariable* var) const;
 
@@ -1296,8 +1329,10 @@ class MPConstraint {
    * Returns a map from variables to their coefficients in the constraint.
    *
    * If a variable is not present in the map, then its coefficient is zero.
+   * See MPSolver::SetUseTermVectors() for thread safety.
    */
   const absl::flat_hash_map<const MPVariable*, double>& terms() const {
+    MergeTermVector();
     return coefficients_;
   }
 
@@ -1400,8 +1435,39 @@ class MPConstraint {
   // been extracted yet.
   bool ContainsNewVariables();
 
-  // Mapping var -> coefficient.
-  absl::flat_hash_map<const MPVariable*, double> coefficients_;
+  // Calls f(var, coeff) on each term of the constraint. When the terms are
+  // stored in term_vector_, they are visited by increasing variable index
+  // without building coefficients_. Does not modify the constraint.
+  template <typename F>
+  void ForEachTerm(F f) const;
+
+  // Sorts term_vector_ by variable index and merges its duplicates, keeping
+  // the last coefficient set for each variable and dropping the zeros.
+  void SortAndMergeTermVector();
+
+  // Returns a copy of term_vector_, sorted and merged as above.
+  std::vector<std::pair<const MPVariable*, double>> MergedTermVectorCopy()
+      const;
+
+  // Moves the terms of term_vector_ to coefficients_. This is the only const
+  // method that modifies the constraint, see MPSolver::SetUseTermVectors().
+  void MergeTermVector() const;
+
+  // Mapping var -> coefficient. It is empty while term_vector_ is not, see
+  // MPSolver::SetUseTermVectors(). Mutable since terms() and GetCoefficient()
+  // build it lazily.
+  mutable absl::flat_hash_map<const MPVariable*, double> coefficients_;
+
+  // The (var, coeff) pairs in the order they were set, possibly with several
+  // pairs per variable, if use_term_vector_ is true and the constraint has not
+  // been extracted since it was created.
+  mutable std::vector<std::pair<const MPVariable*, double>> term_vector_;
+
+  // Whether term_vector_ is sorted and merged by SortAndMergeTermVector().
+  mutable bool term_vector_is_merged_ = true;
+
+  // Set from MPSolver::UseTermVectors() when the constraint is created.
+  bool use_term_vector_ = false;
 
   const int index_;  // See index().
 
@@ -1428,6 +1494,21 @@ class MPConstraint {
   MPSolverInterface* const interface_;
 };
 
+#ifndef SWIG
+template <typename F>
+void MPConstraint::ForEachTerm(F f) const {
+  if (term_vector_.empty()) {
+    for (const auto& entry : coefficients_) f(entry.first, entry.second);
+  } else if (term_vector_is_merged_) {
+    for (const auto& entry : term_vector_) f(entry.first, entry.second);
+  } else {
+    for (const auto& entry : MergedTermVectorCopy()) {
+      f(entry.first, entry.second);
+    }
+  }
+}
+#endif  // SWIG
+
 /**
  * This class stores parameter settings for LP and MIP solvers. Some parameters
  * are marked as advanced: do not change their values unless you know what you
@@ -1813,6 +1894,11 @@ class MPSolverInterface {
 
   virtual bool SupportsCallbacks() const { return false; }
 
+  // Returns true if the extraction of the model reads the terms of the
+  // constraints with MPConstraint::ForEachTerm(), so that they do not need to
+  // be converted to a hash map first. See MPSolver::SetUseTermVectors().
+  virtual bool ExtractsTermVectors() const { return false; }
+
   friend class MPSolver;
 
   // To access the maximize_ bool and the MPSolver.
@@ -0,0 +1,224 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/linear_solver/linear_solver.h"
+
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::EqualsProto;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(TermVectorsTest, LastCoefficientWins) {
+  MPSolver solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  solver.SetUseTermVectors(true);
+  MPVariable* const x = solver.MakeNumVar(0.0, 1.0, "x");
+  MPVariable* const y = solver.MakeNumVar(0.0, 1.0, "y");
+  MPConstraint* const ct = solver.MakeRowConstraint(0.0, 1.0, "ct");
+  ct->SetCoefficient(y, 1.0);
+  ct->SetCoefficient(x, 2.0);
+  ct->SetCoefficient(y, 3.0);
+  ct->SetCoefficient(x, 4.0);
+  ct->SetCoefficient(y, 5.0);
+  MPModelProto model;
+  solver.ExportModelToProto(&model);
+  ASSERT_EQ(model.constraint_size(), 1);
+  EXPECT_THAT(model.constraint(0).var_index(), ElementsAre(0, 1));
+  EXPECT_THAT(model.constraint(0).coefficient(), ElementsAre(4.0, 5.0));
+  EXPECT_EQ(ct->GetCoefficient(x), 4.0);
+  EXPECT_EQ(ct->GetCoefficient(y), 5.0);
+  EXPECT_THAT(ct->terms(), UnorderedElementsAre(Pair(x, 4.0), Pair(y, 5.0)));
+}
+
+TEST(TermVectorsTest, ZerosAreDropped) {
+  MPSolver solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  solver.SetUseTermVectors(true);
+  MPVariable* const x = solver.MakeNumVar(0.0, 1.0, "x");
+  MPVariable* const y = solver.MakeNumVar(0.0, 1.0, "y");
+  MPVariable* const z = solver.MakeNumVar(0.0, 1.0, "z");
+  MPConstraint* const ct = solver.MakeRowConstraint(0.0, 1.0);
+  ct->SetCoefficient(x, 1.0);
+  ct->SetCoefficient(y, 0.0);
+  ct->SetCoefficient(z, 2.0);
+  ct->SetCoefficient(x, 0.0);
+  MPModelProto model;
+  solver.ExportModelToProto(&model);
+  ASSERT_EQ(model.constraint_size(), 1);
+  EXPECT_THAT(model.constraint(0).var_index(), ElementsAre(2));
+  EXPECT_THAT(model.constraint(0).coefficient(), ElementsAre(2.0));
+  // Unlike the hash map, the term vector does not keep the zero of x.
+  EXPECT_THAT(ct->terms(), UnorderedElementsAre(Pair(z, 2.0)));
+  EXPECT_EQ(ct->GetCoefficient(x), 0.0);
+
+  MPConstraint* const empty = solver.MakeRowConstraint(0.0, 1.0);
+  empty->SetCoefficient(x, 0.0);
+  EXPECT_THAT(empty->terms(), IsEmpty());
+}
+
+TEST(TermVectorsTest, OnlyAppliesToNewConstraints) {
+  MPSolver solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  MPVariable* const x = solver.MakeNumVar(0.0, 1.0, "x");
+  MPConstraint* const before = solver.MakeRowConstraint(0.0, 1.0);
+  solver.SetUseTermVectors(true);
+  EXPECT_TRUE(solver.UseTermVectors());
+  MPConstraint* const after = solver.MakeRowConstraint(0.0, 1.0);
+  before->SetCoefficient(x, 1.0);
+  before->SetCoefficient(x, 0.0);
+  after->SetCoefficient(x, 1.0);
+  after->SetCoefficient(x, 0.0);
+  // The hash map keeps the zero of a coefficient that was set.
+  EXPECT_THAT(before->terms(), UnorderedElementsAre(Pair(x, 0.0)));
+  EXPECT_THAT(after->terms(), IsEmpty());
+}
+
+// Builds the same random model with and without term vectors. Coefficients are
+// set several times, in random variable order, and the zeros are only set on
+// variables without a coefficient, since the hash map keeps the zero of a
+// coefficient that was set.
+void BuildRandomModel(bool use_term_vectors, MPSolver* const solver) {
+  constexpr int kNumVariables = 20;
+  constexpr int kNumConstraints = 30;
+  constexpr double kValues[] = {0.0, 1.0, -2.0, 3.5};
+  solver->SetUseTermVectors(use_term_vectors);
+  std::mt19937 random(12345);
+  std::vector<MPVariable*> variables;
+  solver->MakeNumVarArray(kNumVariables, 0.0, 10.0, "x", &variables);
+  for (int c = 0; c < kNumConstraints; ++c) {
+    MPConstraint* const ct = solver->MakeRowConstraint(-1.0, c);
+    std::vector<bool> has_coefficient(kNumVariables, false);
+    const int num_terms = std::uniform_int_distribution<int>(0, 40)(random);
+    for (int i = 0; i < num_terms; ++i) {
+      const int var = std::uniform_int_distribution<int>(
+          0, kNumVariables - 1)(random);
+      double value = kValues[std::uniform_int_distribution<int>(0, 3)(random)];
+      if (has_coefficient[var] && value == 0.0) value = 4.0;
+      has_coefficient[var] = has_coefficient[var] || value != 0.0;
+      ct->SetCoefficient(variables[var], value);
+    }
+  }
+}
+
+TEST(TermVectorsTest, ExportMatchesHashMap) {
+  MPSolver hash_map_solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  BuildRandomModel(/*use_term_vectors=*/false, &hash_map_solver);
+  MPSolver term_vector_solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  BuildRandomModel(/*use_term_vectors=*/true, &term_vector_solver);
+  MPModelProto expected;
+  hash_map_solver.ExportModelToProto(&expected);
+  MPModelProto model;
+  term_vector_solver.ExportModelToProto(&model);
+  EXPECT_THAT(model, EqualsProto(expected));
+  // Exporting again, after converting the term vectors to hash maps.
+  for (const MPConstraint* const ct : term_vector_solver.constraints()) {
+    ct->terms();
+  }
+  model.Clear();
+  term_vector_solver.ExportModelToProto(&model);
+  EXPECT_THAT(model, EqualsProto(expected));
+}
+
+TEST(TermVectorsTest, ConcurrentExports) {
+  MPSolver hash_map_solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  BuildRandomModel(/*use_term_vectors=*/false, &hash_map_solver);
+  MPModelProto expected;
+  hash_map_solver.ExportModelToProto(&expected);
+  MPSolver solver("test", MPSolver::GLOP_LINEAR_PROGRAMMING);
+  BuildRandomModel(/*use_term_vectors=*/true, &solver);
+  std::vector<MPModelProto> models(4);
+  std::vector<std::thread> threads;
+  for (MPModelProto& model : models) {
+    threads.emplace_back([&solver, &model]() {
+      solver.ExportModelToProto(&model);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (const MPModelProto& model : models) {
+    EXPECT_THAT(model, EqualsProto(expected));
+  }
+}
+
+class TermVectorsSolveTest
+    : public ::testing::TestWithParam<MPSolver::OptimizationProblemType> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    AllSolvers, TermVectorsSolveTest,
+    ::testing::Values(MPSolver::GLOP_LINEAR_PROGRAMMING,
+                      MPSolver::PDLP_LINEAR_PROGRAMMING,
+                      MPSolver::CLP_LINEAR_PROGRAMMING,
+                      MPSolver::SAT_INTEGER_PROGRAMMING,
+                      MPSolver::SCIP_MIXED_INTEGER_PROGRAMMING,
+                      MPSolver::CBC_MIXED_INTEGER_PROGRAMMING));
+
+// The optima of all the models below are integral, so that LP and MIP solvers
+// find the same ones.
+TEST_P(TermVectorsSolveTest, SetCoefficientAfterExtraction) {
+  if (!MPSolver::SupportsProblemType(GetParam())) {
+    GTEST_SKIP() << "Solver not supported";
+  }
+  MPSolver solver("test", GetParam());
+  solver.SetUseTermVectors(true);
+  MPVariable* const x = solver.MakeVar(0.0, 10.0, solver.IsMIP(), "x");
+  MPVariable* const y = solver.MakeVar(0.0, 10.0, solver.IsMIP(), "y");
+  MPObjective* const objective = solver.MutableObjective();
+  objective->SetCoefficient(x, 1.0);
+  objective->SetCoefficient(y, 1.0);
+  objective->SetMaximization();
+  // x + 2y <= 6.
+  MPConstraint* const first = solver.MakeRowConstraint(-10.0, 6.0);
+  first->SetCoefficient(y, 3.0);
+  first->SetCoefficient(x, 1.0);
+  first->SetCoefficient(y, 2.0);
+  ASSERT_EQ(solver.Solve(), MPSolver::OPTIMAL);
+  EXPECT_NEAR(objective->Value(), 6.0, 1e-4);
+  EXPECT_NEAR(solver.ComputeConstraintActivities()[0], 6.0, 1e-4);
+
+  // A constraint added after the solve: x <= 2.
+  MPConstraint* const second = solver.MakeRowConstraint(-10.0, 2.0);
+  second->SetCoefficient(x, 7.0);
+  second->SetCoefficient(y, 0.0);
+  second->SetCoefficient(x, 1.0);
+  ASSERT_EQ(solver.Solve(), MPSolver::OPTIMAL);
+  EXPECT_NEAR(x->solution_value(), 2.0, 1e-4);
+  EXPECT_NEAR(y->solution_value(), 2.0, 1e-4);
+  EXPECT_TRUE(solver.VerifySolution(1e-4, /*log_errors=*/true));
+
+  // x + y <= 6, set on a constraint that has been solved.
+  first->SetCoefficient(y, 1.0);
+  EXPECT_EQ(first->GetCoefficient(y), 1.0);
+  EXPECT_THAT(first->terms(), UnorderedElementsAre(Pair(x, 1.0), Pair(y, 1.0)));
+  ASSERT_EQ(solver.Solve(), MPSolver::OPTIMAL);
+  EXPECT_NEAR(objective->Value(), 6.0, 1e-4);
+  EXPECT_NEAR(x->solution_value(), 2.0, 1e-4);
+  EXPECT_NEAR(y->solution_value(), 4.0, 1e-4);
+  MPModelProto model;
+  solver.ExportModelToProto(&model);
+  ASSERT_EQ(model.constraint_size(), 2);
+  EXPECT_THAT(model.constraint(0).var_index(), ElementsAre(0, 1));
+  EXPECT_THAT(model.constraint(0).coefficient(), ElementsAre(1.0, 1.0));
+  EXPECT_THAT(model.constraint(1).var_index(), ElementsAre(0));
+  EXPECT_THAT(model.constraint(1).coefficient(), ElementsAre(1.0));
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -75,6 +75,7 @@ class PdlpInterface : public MPSolverInterface {
 
   std::string SolverVersion() const override;
   void* underlying_solver() override;
+  bool ExtractsTermVectors() const override;
   bool InterruptSolve() override;
 
   void ExtractNewVariables() override;
@@ -274,6 +275,9 @@ std::string PdlpInterface::SolverVersion() const { return "PDLP Solver"; }
 // for interpreting the PDLP solution.
 void* PdlpInterface::underlying_solver() { return nullptr; }
 
+// The model is extracted with MPSolver::ExportModelToProto().
+bool PdlpInterface::ExtractsTermVectors() const { return true; }
+
 bool PdlpInterface::InterruptSolve() {
   interrupt_solver_ = true;
   return true;
@@ -74,6 +74,7 @@ class SatInterface : public MPSolverInterface {
 
   std::string SolverVersion() const override;
   void* underlying_solver() override;
+  bool ExtractsTermVectors() const override;
 
   void ExtractNewVariables() override;
   void ExtractNewConstraints() override;
@@ -231,6 +232,9 @@ std::string SatInterface::SolverVersion() const {
 
 void* SatInterface::underlying_solver() { return nullptr; }
 
+// The model is extracted with MPSolver::ExportModelToProto().
+bool SatInterface::ExtractsTermVectors() const { return true; }
+
 void SatInterface::ExtractNewVariables() { NonIncrementalChange(); }
 
 void SatInterface::ExtractNewConstraints() { NonIncrementalChange(); }
@@ -51,6 +51,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -69,10 +70,12 @@
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_parser.h"
 #include "ortools/lp_data/mps_reader.h"
+#include "ortools/lp_data/proto_utils.h"
 #include "ortools/lp_data/sol_reader.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_solver.h"
 #include "ortools/util/file_util.h"
+#include "ortools/util/linear_model_file.h"
 #include "ortools/util/sigint.h"
 
 ABSL_FLAG(std::string, input, "", "REQUIRED: Input file name.");
@@ -82,7 +85,8 @@ ABSL_FLAG(std::string, solver, "glop",
           "The solver to use: bop, cbc, clp, glop, glpk_lp, glpk_mip, "
           "gurobi_lp, gurobi_mip, pdlp, scip, knapsack, sat.");
 ABSL_FLAG(int, num_threads, 1,
-          "Number of threads to use by the underlying solver.");
+          "Number of threads to use by the underlying solver, and to parse "
+          ".mps and .lp input files.");
 ABSL_FLAG(std::string, params_file, "",
           "Solver specific parameters file. "
           "If this flag is set, the --params flag is ignored.");
@@ -122,6 +126,7 @@ ABSL_DECLARE_FLAG(
 static const char kUsageStr[] =
     "Run MPSolver on the given input file. Many formats are supported: \n"
     "  - a .mps or .mps.gz file,\n"
+    "  - a .lmf linear model file,\n"
     "  - an MPModelProto (binary or text, possibly gzipped),\n"
     "  - an MPModelRequest (binary or text, possibly gzipped).";
 
@@ -135,16 +140,24 @@ MPModelRequest ReadMipModel(const std::string& input) {
 #if defined(USE_LP_PARSER)
     std::string data;
     CHECK_OK(file::GetContents(input, &data, file::Defaults()));
-    absl::StatusOr<MPModelProto> result = ModelProtoFromLpFormat(data);
+    absl::StatusOr<MPModelProto> result =
+        ModelProtoFromLpFormat(data, absl::GetFlag(FLAGS_num_threads));
     CHECK_OK(result);
     model_proto = std::move(result).value();
 #else   // !defined(USE_LP_PARSER)
     LOG(FATAL) << "Support for parsing LP format is not compiled in.";
 #endif  // !defined(USE_LP_PARSER)
+  } else if (absl::EndsWith(input, ".lmf")) {
+    const absl::StatusOr<std::unique_ptr<LinearModelFile>> file =
+        LinearModelFile::Open(input);
+    QCHECK_OK(file.status());
+    glop::LinearModelViewToMPModelProto((*file)->view(), &model_proto);
   } else if (absl::EndsWith(input, ".mps") ||
              absl::EndsWith(input, ".mps.gz")) {
-    QCHECK_OK(glop::MPSReader().ParseFile(input, &model_proto))
-        << "Error while parsing the mps file '" << input << "'.";
+    absl::StatusOr<MPModelProto> result =
+        glop::MpsFileToMPModelProto(input, absl::GetFlag(FLAGS_num_threads));
+    QCHECK_OK(result) << "Error while parsing the mps file '" << input << "'.";
+    model_proto = std::move(result).value();
   } else {
     ReadFileToProto(input, &model_proto).IgnoreError();
     ReadFileToProto(input, &request_proto).IgnoreError();
@@ -14,6 +14,7 @@
 #include "ortools/lp_data/lp_parser.h"
 
 #include <algorithm>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -28,7 +29,10 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_types.h"
@@ -66,19 +70,57 @@ bool TokenIsBound(TokenType token_type) {
   return false;
 }
 
+// Number of statements parsed by each thread in a batch, see LPParser::Parse().
+constexpr int kNumStatementsPerThread = 4096;
+
+// Parses the statements of `lines` as constraints, in parallel when
+// `thread_pool` is not null. The statements that are not constraints get an
+// error status.
+std::vector<StatusOr<ParsedConstraint>> ParseConstraints(
+    absl::Span<const StringPiece> lines, ThreadPool* thread_pool) {
+  std::vector<StatusOr<ParsedConstraint>> parsed_constraints(lines.size());
+  if (thread_pool == nullptr) {
+    for (int i = 0; i < lines.size(); ++i) {
+      parsed_constraints[i] = ParseConstraint(lines[i]);
+    }
+    return parsed_constraints;
+  }
+  const int num_shards =
+      (lines.size() + kNumStatementsPerThread - 1) / kNumStatementsPerThread;
+  absl::BlockingCounter counter(num_shards);
+  for (int shard = 0; shard < num_shards; ++shard) {
+    thread_pool->Schedule([&, shard]() {
+      const int end =
+          std::min<int>(lines.size(), (shard + 1) * kNumStatementsPerThread);
+      for (int i = shard * kNumStatementsPerThread; i < end; ++i) {
+        parsed_constraints[i] = ParseConstraint(lines[i]);
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  return parsed_constraints;
+}
+
 // Not thread safe.
 class LPParser {
  public:
   // Accepts the string in LP file format (used by LinearProgram::Dump()).
   // On success, populates the linear program *lp and returns true. Otherwise,
   // returns false and leaves *lp in an unspecified state.
-  ABSL_MUST_USE_RESULT bool Parse(absl::string_view model, LinearProgram* lp);
+  //
+  // With more than one thread, the statements are parsed in batches: the
+  // constraints of a batch, which are the bulk of most models, are parsed in
+  // parallel, and then all the statements of the batch are applied in order.
+  ABSL_MUST_USE_RESULT bool Parse(absl::string_view model, LinearProgram* lp,
+                                  int num_threads = 1);
 
  private:
   bool ParseEmptyLine(StringPiece line);
   bool ParseObjective(StringPiece objective);
   bool ParseIntegerVariablesList(StringPiece line);
-  bool ParseConstraint(StringPiece constraint);
+  // Adds a constraint, or variable bounds, parsed by ParseConstraint().
+  bool AddConstraint(const StatusOr<ParsedConstraint>& parsed_constraint);
   TokenType ConsumeToken(StringPiece* sp);
   bool SetVariableBounds(ColIndex col, Fractional lb, Fractional ub);
 
@@ -94,22 +136,37 @@ class LPParser {
   std::set<ColIndex> bounded_variables_;
 };
 
-bool LPParser::Parse(absl::string_view model, LinearProgram* lp) {
+bool LPParser::Parse(absl::string_view model, LinearProgram* lp,
+                     int num_threads) {
   lp_ = lp;
   bounded_variables_.clear();
   lp_->Clear();
 
-  std::vector<StringPiece> lines =
+  const std::vector<StringPiece> lines =
       absl::StrSplit(model, ';', absl::SkipEmpty());
   bool has_objective = false;
 
-  for (StringPiece line : lines) {
-    if (!has_objective && ParseObjective(line)) {
-      has_objective = true;
-    } else if (!ParseConstraint(line) && !ParseIntegerVariablesList(line) &&
-               !ParseEmptyLine(line)) {
-      LOG(INFO) << "Error in line: " << line;
-      return false;
+  std::unique_ptr<ThreadPool> thread_pool;
+  int batch_size = 1;
+  if (num_threads > 1 && lines.size() > kNumStatementsPerThread) {
+    thread_pool = std::make_unique<ThreadPool>("LPParser", num_threads);
+    thread_pool->StartWorkers();
+    batch_size = num_threads * kNumStatementsPerThread;
+  }
+  for (int begin = 0; begin < lines.size(); begin += batch_size) {
+    const absl::Span<const StringPiece> batch =
+        absl::MakeConstSpan(lines).subspan(begin, batch_size);
+    const std::vector<StatusOr<ParsedConstraint>> parsed_constraints =
+        ParseConstraints(batch, thread_pool.get());
+    for (int i = 0; i < batch.size(); ++i) {
+      const StringPiece line = batch[i];
+      if (!has_objective && ParseObjective(line)) {
+        has_objective = true;
+      } else if (!AddConstraint(parsed_constraints[i]) &&
+                 !ParseIntegerVariablesList(line) && !ParseEmptyLine(line)) {
+        LOG(INFO) << "Error in line: " << line;
+        return false;
+      }
     }
   }
 
@@ -188,9 +245,8 @@ bool LPParser::ParseIntegerVariablesList(StringPiece line) {
   return true;
 }
 
-bool LPParser::ParseConstraint(StringPiece constraint) {
-  const StatusOr<ParsedConstraint> parsed_constraint_or_status =
-      ::operations_research::glop::ParseConstraint(constraint);
+bool LPParser::AddConstraint(
+    const StatusOr<ParsedConstraint>& parsed_constraint_or_status) {
   if (!parsed_constraint_or_status.ok()) return false;
   const ParsedConstraint& parsed_constraint =
       parsed_constraint_or_status.value();
@@ -447,16 +503,17 @@ StatusOr<ParsedConstraint> ParseConstraint(absl::string_view constraint) {
   return parsed_constraint;
 }
 
-bool ParseLp(absl::string_view model, LinearProgram* lp) {
+bool ParseLp(absl::string_view model, LinearProgram* lp, int num_threads) {
   LPParser parser;
-  return parser.Parse(model, lp);
+  return parser.Parse(model, lp, num_threads);
 }
 
 }  // namespace glop
 
-absl::StatusOr<MPModelProto> ModelProtoFromLpFormat(absl::string_view model) {
+absl::StatusOr<MPModelProto> ModelProtoFromLpFormat(absl::string_view model,
+                                                    int num_threads) {
   glop::LinearProgram lp;
-  if (!ParseLp(model, &lp)) {
+  if (!ParseLp(model, &lp, num_threads)) {
     return absl::InvalidArgumentError("Parsing error, see LOGs for details.");
   }
   MPModelProto model_proto;
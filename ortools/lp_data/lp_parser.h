@@ -90,12 +90,16 @@
 namespace operations_research {
 
 // This calls ParseLp() under the hood. See below.
-absl::StatusOr<MPModelProto> ModelProtoFromLpFormat(absl::string_view model);
+absl::StatusOr<MPModelProto> ModelProtoFromLpFormat(absl::string_view model,
+                                                    int num_threads = 1);
 
 namespace glop {
 
-// Like ModelProtoFromLpFormat(), but outputs a glop::LinearProgram.
-ABSL_MUST_USE_RESULT bool ParseLp(absl::string_view model, LinearProgram* lp);
+// Like ModelProtoFromLpFormat(), but outputs a glop::LinearProgram. With more
+// than one thread, the constraints are parsed in parallel; the result is the
+// same as with a single thread.
+ABSL_MUST_USE_RESULT bool ParseLp(absl::string_view model, LinearProgram* lp,
+                                  int num_threads = 1);
 
 // Represents a constraint parsed from the LP file format (used by
 // LinearProgram::Dump()).
@@ -0,0 +1,133 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/lp_data/lp_parser.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::EqualsProto;
+
+// Several batches of statements, see glop::ParseLp().
+constexpr int kNumStatements = 50000;
+
+// Returns the statements of a model whose objective is in the middle, and with
+// constraints, variable bounds and integer variable lists in every batch. The
+// variables are created in the order they first appear.
+std::vector<std::string> ModelStatements() {
+  std::vector<std::string> statements;
+  for (int i = 0; i < kNumStatements; ++i) {
+    const std::string x = absl::StrCat("x", i);
+    const std::string y =
+        absl::StrCat("x", (i * 7919 + 1) % kNumStatements);
+    switch (i % 5) {
+      case 0:
+        statements.push_back(absl::StrCat("c", i, ": 1 <= ", x, " + 2.5 ", y,
+                                          " - z", i, " <= 4"));
+        break;
+      case 1:
+        statements.push_back(absl::StrCat("-1.5e2 ", x, " - ", y, " >= -3"));
+        break;
+      case 2:
+        statements.push_back(absl::StrCat("0 <= ", x, " <= ", i % 7));
+        break;
+      case 3:
+        statements.push_back(absl::StrCat("int ", x, ", ", y));
+        break;
+      case 4:
+        statements.push_back(absl::StrCat(x, " = ", i % 3));
+        break;
+    }
+    if (i == kNumStatements / 2) {
+      statements.push_back(absl::StrCat("max: 3 + x1 - 2 ", x));
+    }
+    if (i % 1000 == 0) statements.push_back("");
+  }
+  return statements;
+}
+
+// Parses `statements` with one and several threads, and checks that the
+// models, or the errors, are the same. Returns the result with one thread.
+absl::StatusOr<MPModelProto> ParseWithAllThreadCounts(
+    const std::vector<std::string>& statements) {
+  const std::string model = absl::StrJoin(statements, ";\n");
+  const absl::StatusOr<MPModelProto> expected = ModelProtoFromLpFormat(model);
+  for (const int num_threads : {2, 3, 8}) {
+    SCOPED_TRACE(absl::StrCat("num_threads: ", num_threads));
+    const absl::StatusOr<MPModelProto> actual =
+        ModelProtoFromLpFormat(model, num_threads);
+    EXPECT_EQ(actual.status(), expected.status());
+    if (expected.ok() && actual.ok()) {
+      EXPECT_THAT(*actual, EqualsProto(*expected));
+    }
+  }
+  return expected;
+}
+
+TEST(LpParserParallelTest, SameModel) {
+  const absl::StatusOr<MPModelProto> model =
+      ParseWithAllThreadCounts(ModelStatements());
+  ASSERT_TRUE(model.ok()) << model.status();
+  EXPECT_EQ(model->variable_size(), kNumStatements + kNumStatements / 5);
+  EXPECT_EQ(model->constraint_size(), 2 * kNumStatements / 5);
+  EXPECT_TRUE(model->maximize());
+  EXPECT_EQ(model->objective_offset(), 3);
+}
+
+// A statement which is neither a constraint, an objective nor a list of
+// integer variables makes the parsing fail, in any batch.
+TEST(LpParserParallelTest, InvalidStatement) {
+  for (const int index : {10, kNumStatements / 3, kNumStatements - 10}) {
+    SCOPED_TRACE(index);
+    std::vector<std::string> statements = ModelStatements();
+    statements[index] = "1 <= x0 + x1 <= 2 <= 3";
+    EXPECT_FALSE(ParseWithAllThreadCounts(statements).ok());
+  }
+}
+
+// The statements are applied in order: a second objective is an error, and so
+// are bounds which are inconsistent with previous ones.
+TEST(LpParserParallelTest, StatementsAreAppliedInOrder) {
+  std::vector<std::string> statements = ModelStatements();
+  statements.push_back("min: x1");
+  EXPECT_FALSE(ParseWithAllThreadCounts(statements).ok());
+
+  statements = ModelStatements();
+  statements.push_back("x2 >= 100");
+  EXPECT_FALSE(ParseWithAllThreadCounts(statements).ok());
+
+  // Bounds are intersected, and variables are created in order.
+  statements = ModelStatements();
+  statements.insert(statements.begin(), "x2 <= 5");
+  statements.push_back("x2 >= 1");
+  const absl::StatusOr<MPModelProto> model =
+      ParseWithAllThreadCounts(statements);
+  ASSERT_TRUE(model.ok()) << model.status();
+  EXPECT_EQ(model->variable(0).name(), "x2");
+  EXPECT_EQ(model->variable(0).lower_bound(), 1);
+  EXPECT_EQ(model->variable(0).upper_bound(), 2);
+}
+
+}  // namespace
+}  // namespace operations_research
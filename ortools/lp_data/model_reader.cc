@@ -13,19 +13,47 @@
 
 #include "ortools/lp_data/model_reader.h"
 
+#include <memory>
 #include <string>
 
+#include "absl/status/statusor.h"
 #include "ortools/base/logging.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/proto_utils.h"
 #include "ortools/util/file_util.h"
+#include "ortools/util/linear_model_file.h"
 
 namespace operations_research {
 namespace glop {
 
+namespace {
+
+// Returns the given file if it is a linear model file (see
+// ortools/util/linear_model_file.h), and nullptr otherwise. The returned
+// status is only an error if the file looks like a linear model file but is
+// invalid.
+absl::StatusOr<std::unique_ptr<LinearModelFile>> MaybeOpenLinearModelFile(
+    const std::string& input_file_path) {
+  if (!IsLinearModelFile(input_file_path)) return nullptr;
+  return LinearModelFile::Open(input_file_path);
+}
+
+}  // namespace
+
 bool LoadMPModelProtoFromModelOrRequest(const std::string& input_file_path,
                                         MPModelProto* model) {
+  const absl::StatusOr<std::unique_ptr<LinearModelFile>> linear_model_file =
+      MaybeOpenLinearModelFile(input_file_path);
+  if (!linear_model_file.ok()) {
+    LOG(ERROR) << linear_model_file.status();
+    return false;
+  }
+  if (*linear_model_file != nullptr) {
+    VLOG(1) << "Read input as a linear model file.";
+    LinearModelViewToMPModelProto((*linear_model_file)->view(), model);
+    return true;
+  }
   MPModelProto model_proto;
   MPModelRequest request_proto;
   ReadFileToProto(input_file_path, &model_proto).IgnoreError();
@@ -58,6 +86,19 @@ bool LoadMPModelProtoFromModelOrRequest(const std::string& input_file_path,
 
 bool LoadLinearProgramFromModelOrRequest(const std::string& input_file_path,
                                          LinearProgram* linear_program) {
+  // Linear model files are loaded without building a MPModelProto.
+  const absl::StatusOr<std::unique_ptr<LinearModelFile>> linear_model_file =
+      MaybeOpenLinearModelFile(input_file_path);
+  if (!linear_model_file.ok()) {
+    LOG(ERROR) << linear_model_file.status();
+    return false;
+  }
+  if (*linear_model_file != nullptr) {
+    VLOG(1) << "Read input as a linear model file.";
+    LinearModelViewToLinearProgram((*linear_model_file)->view(),
+                                   linear_program);
+    return true;
+  }
   MPModelProto model_proto;
   if (LoadMPModelProtoFromModelOrRequest(input_file_path, &model_proto)) {
     MPModelProtoToLinearProgram(model_proto, linear_program);
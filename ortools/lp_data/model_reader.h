@@ -23,7 +23,9 @@ namespace operations_research {
 namespace glop {
 
 // Helper function to read data from model files into MPModelProto and
-// LinearProgram.
+// LinearProgram. The files can hold a MPModelProto or a MPModelRequest, in
+// binary or text format, or be a linear model file (see
+// ortools/util/linear_model_file.h).
 bool LoadMPModelProtoFromModelOrRequest(const std::string& input_file_path,
                                         MPModelProto* model);
 bool LoadLinearProgramFromModelOrRequest(const std::string& input_file_path,
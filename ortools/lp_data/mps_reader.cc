@@ -357,23 +357,27 @@ absl::Status MPSReader::ParseProblemFromString(absl::string_view source,
       .status();
 }
 
-absl::StatusOr<MPModelProto> MpsDataToMPModelProto(absl::string_view mps_data) {
+absl::StatusOr<MPModelProto> MpsDataToMPModelProto(absl::string_view mps_data,
+                                                   int num_threads) {
   MPModelProto model;
   DataWrapper<MPModelProto> data_wrapper(&model);
+  MPSReaderTemplate<DataWrapper<MPModelProto>> reader;
+  reader.set_num_threads(num_threads);
   RETURN_IF_ERROR(
-      (MPSReaderTemplate<DataWrapper<MPModelProto>>()
-           .ParseString(mps_data, &data_wrapper, MPSReaderFormat::kAutoDetect)
-           .status()));
+      reader.ParseString(mps_data, &data_wrapper, MPSReaderFormat::kAutoDetect)
+          .status());
   return model;
 }
 
-absl::StatusOr<MPModelProto> MpsFileToMPModelProto(absl::string_view mps_file) {
+absl::StatusOr<MPModelProto> MpsFileToMPModelProto(absl::string_view mps_file,
+                                                   int num_threads) {
   MPModelProto model;
   DataWrapper<MPModelProto> data_wrapper(&model);
+  MPSReaderTemplate<DataWrapper<MPModelProto>> reader;
+  reader.set_num_threads(num_threads);
   RETURN_IF_ERROR(
-      (MPSReaderTemplate<DataWrapper<MPModelProto>>()
-           .ParseFile(mps_file, &data_wrapper, MPSReaderFormat::kAutoDetect)
-           .status()));
+      reader.ParseFile(mps_file, &data_wrapper, MPSReaderFormat::kAutoDetect)
+          .status());
   return model;
 }
 
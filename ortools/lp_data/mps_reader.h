@@ -36,11 +36,15 @@
 namespace operations_research {
 namespace glop {
 
-// Parses an MPS model from a string.
-absl::StatusOr<MPModelProto> MpsDataToMPModelProto(absl::string_view mps_data);
+// Parses an MPS model from a string. The COLUMNS section is parsed with
+// `num_threads` threads, see MPSReaderTemplate::set_num_threads().
+absl::StatusOr<MPModelProto> MpsDataToMPModelProto(absl::string_view mps_data,
+                                                   int num_threads = 1);
 
-// Parses an MPS model from a file.
-absl::StatusOr<MPModelProto> MpsFileToMPModelProto(absl::string_view mps_file);
+// Parses an MPS model from a file. With more than one thread, the file is
+// memory-mapped instead of being read line by line.
+absl::StatusOr<MPModelProto> MpsFileToMPModelProto(absl::string_view mps_file,
+                                                   int num_threads = 1);
 
 // Implementation class. Please use the 2 functions above.
 //
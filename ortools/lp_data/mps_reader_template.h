@@ -274,8 +274,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -291,9 +294,12 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/util/filelineiter.h"
+#include "ortools/util/mapped_file.h"
 
 namespace operations_research {
 
@@ -516,9 +522,59 @@ class MPSReaderTemplate {
       absl::string_view source, DataWrapper* data,
       MPSReaderFormat form = MPSReaderFormat::kAutoDetect);
 
+  // Sets the number of threads used to parse the COLUMNS section, which holds
+  // the constraint matrix and is by far the largest section of most files.
+  // With more than one thread, ParseFile() memory-maps uncompressed files, and
+  // chunks of lines of the COLUMNS section are split into fields and have
+  // their values parsed in parallel, before being stored in order in
+  // `DataWrapper` by the calling thread. `DataWrapper` is thus never called
+  // concurrently, and the result is the same as with a single thread.
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
  private:
   static constexpr double kInfinity = std::numeric_limits<double>::infinity();
 
+  // Approximate size, in bytes, of the chunks of the COLUMNS section parsed
+  // by each thread.
+  static constexpr size_t kColumnsChunkSize = 1 << 20;
+
+  // A data line of the COLUMNS section, split into fields and with its values
+  // parsed, but not stored in `DataWrapper` yet.
+  struct ColumnsLine {
+    // The integrality marker on the line, if any. The other fields are only
+    // set for lines without a marker.
+    enum class Marker { kNone, kIntOrg, kIntEnd, kOther };
+    Marker marker = Marker::kNone;
+
+    absl::string_view column_name;
+
+    // The non-zero coefficients on the line. `rows[i]` is set when the row
+    // named `row_names[i]` was already known when the line was parsed.
+    int num_coefficients = 0;
+    absl::string_view row_names[2];
+    double values[2];
+    std::optional<IndexType> rows[2];
+
+    // The line, and its number within its chunk, used to report errors.
+    absl::string_view line;
+    int64_t line_index = 0;
+  };
+
+  // A chunk of the COLUMNS section, parsed by a single thread.
+  struct ColumnsChunk {
+    // The text of the chunk, made of whole lines.
+    absl::string_view text;
+
+    // The parsed data lines; blank and comment lines are skipped.
+    std::vector<ColumnsLine> lines;
+
+    // The number of characters and of lines of `text` that were parsed. The
+    // parsing stops before the first line that starts a new section or fails
+    // to parse.
+    size_t parsed_size = 0;
+    int64_t num_parsed_lines = 0;
+  };
+
   // Resets the object to its initial value before reading a new file.
   void Reset();
 
@@ -528,6 +584,23 @@ class MPSReaderTemplate {
   // Line processor.
   absl::Status ProcessLine(absl::string_view line, DataWrapper* data);
 
+  // Processes all the lines of `source` like ProcessLine(), except for the
+  // lines of the COLUMNS section which are parsed in parallel.
+  absl::Status ProcessLinesInParallel(absl::string_view source,
+                                      DataWrapper* data);
+
+  // Parses in parallel up to `num_threads_` chunks of lines of the COLUMNS
+  // section, starting at `source[pos]`, and stores them. Returns the position
+  // of the first line that was not processed, which either starts a new
+  // section, is invalid, or is the last line of `source`.
+  absl::StatusOr<size_t> ProcessColumnsChunks(absl::string_view source,
+                                              size_t pos,
+                                              ThreadPool* thread_pool,
+                                              DataWrapper* data);
+
+  // Parses the lines of `chunk->text`, see ColumnsChunk. Thread-safe.
+  void ParseColumnsChunk(ColumnsChunk* chunk) const;
+
   // Process section OBJSENSE in MPS file.
   absl::Status ProcessObjectiveSenseSection(
       const internal::MPSLineInfo& line_info, DataWrapper* data);
@@ -540,6 +613,15 @@ class MPSReaderTemplate {
   absl::Status ProcessColumnsSection(const internal::MPSLineInfo& line_info,
                                      DataWrapper* data);
 
+  // Parses a data line of the COLUMNS section. Thread-safe.
+  absl::StatusOr<ColumnsLine> ParseColumnsLine(
+      const internal::MPSLineInfo& line_info) const;
+
+  // Stores a line parsed by ParseColumnsLine(). The returned errors do not
+  // contain the line.
+  absl::Status StoreColumnsLine(const ColumnsLine& columns_line,
+                                DataWrapper* data);
+
   // Process section RHS in the MPS file.
   absl::Status ProcessRhsSection(const internal::MPSLineInfo& line_info,
                                  DataWrapper* data);
@@ -559,9 +641,9 @@ class MPSReaderTemplate {
   // Safely converts a string to a numerical type. Returns an error if the
   // string passed as parameter is ill-formed.
   absl::StatusOr<double> GetDoubleFromString(
-      absl::string_view str, const internal::MPSLineInfo& line_info);
+      absl::string_view str, const internal::MPSLineInfo& line_info) const;
   absl::StatusOr<bool> GetBoolFromString(
-      absl::string_view str, const internal::MPSLineInfo& line_info);
+      absl::string_view str, const internal::MPSLineInfo& line_info) const;
 
   // Different types of variables, as defined in the MPS file specification.
   // Note these are more precise than the ones in PrimalSimplex.
@@ -593,10 +675,18 @@ class MPSReaderTemplate {
                           absl::string_view column_name,
                           absl::string_view bound_value, DataWrapper* data);
 
-  // Stores a coefficient value for a column number and a row name.
-  absl::Status StoreCoefficient(const internal::MPSLineInfo& line_info,
-                                IndexType col, absl::string_view row_name,
-                                absl::string_view row_value, DataWrapper* data);
+  // Parses the coefficient value for a row name, and adds it to
+  // `columns_line` unless it is zero.
+  absl::Status ParseCoefficient(const internal::MPSLineInfo& line_info,
+                                absl::string_view row_name,
+                                absl::string_view row_value,
+                                ColumnsLine& columns_line) const;
+
+  // Stores a coefficient value for a column number and a row name. `row` is
+  // the index of the row, if known.
+  void StoreCoefficient(IndexType col, absl::string_view row_name,
+                        double value, std::optional<IndexType> row,
+                        DataWrapper* data);
 
   // Stores a right-hand-side value for a row name.
   absl::Status StoreRightHandSide(const internal::MPSLineInfo& line_info,
@@ -647,6 +737,19 @@ class MPSReaderTemplate {
   // the user because other solvers usually ignore them and we don't (they will
   // be removed in the preprocessor).
   IndexType num_unconstrained_rows_;
+
+  // See set_num_threads().
+  int num_threads_ = 1;
+
+  // When parsing in parallel, maps the names of the rows created so far to
+  // their index, so that the COLUMNS section can be parsed without calling
+  // `DataWrapper`.
+  absl::flat_hash_map<std::string, IndexType> row_indices_;
+
+  // The last column of the COLUMNS section, which usually spans several
+  // consecutive lines.
+  std::string last_column_name_;
+  std::optional<IndexType> last_column_;
 };
 
 template <class DataWrapper>
@@ -657,6 +760,13 @@ absl::StatusOr<MPSReaderFormat> MPSReaderTemplate<DataWrapper>::ParseFile(
     return absl::InvalidArgumentError("NULL pointer passed as argument.");
   }
 
+  // Compressed files are read line by line.
+  if (num_threads_ > 1 && !absl::EndsWith(file_name, ".gz")) {
+    ASSIGN_OR_RETURN(const std::unique_ptr<MappedFile> file,
+                     MappedFile::Open(file_name));
+    return ParseString(file->contents(), data, form);
+  }
+
   if (form != MPSReaderFormat::kFree && form != MPSReaderFormat::kFixed) {
     if (ParseFile(file_name, data, MPSReaderFormat::kFixed).ok()) {
       return MPSReaderFormat::kFixed;
@@ -694,8 +804,12 @@ absl::StatusOr<MPSReaderFormat> MPSReaderTemplate<DataWrapper>::ParseString(
   free_form_ = form == MPSReaderFormat::kFree;
   Reset();
   data->SetUp();
-  for (absl::string_view line : absl::StrSplit(source, '\n')) {
-    RETURN_IF_ERROR(ProcessLine(line, data));
+  if (num_threads_ > 1) {
+    RETURN_IF_ERROR(ProcessLinesInParallel(source, data));
+  } else {
+    for (absl::string_view line : absl::StrSplit(source, '\n')) {
+      RETURN_IF_ERROR(ProcessLine(line, data));
+    }
   }
   data->CleanUp();
   DisplaySummary();
@@ -775,6 +889,103 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessLine(absl::string_view line,
   return absl::OkStatus();
 }
 
+template <class DataWrapper>
+absl::Status MPSReaderTemplate<DataWrapper>::ProcessLinesInParallel(
+    const absl::string_view source, DataWrapper* const data) {
+  ThreadPool thread_pool("MPSReader", num_threads_);
+  thread_pool.StartWorkers();
+  // The lines are the same as with absl::StrSplit(source, '\n').
+  size_t pos = 0;
+  while (true) {
+    if (section_ == internal::MPSSectionId::kColumns) {
+      ASSIGN_OR_RETURN(pos,
+                       ProcessColumnsChunks(source, pos, &thread_pool, data));
+    }
+    const size_t end = source.find('\n', pos);
+    RETURN_IF_ERROR(ProcessLine(source.substr(pos, end - pos), data));
+    if (end == absl::string_view::npos) break;
+    pos = end + 1;
+  }
+  return absl::OkStatus();
+}
+
+template <class DataWrapper>
+absl::StatusOr<size_t> MPSReaderTemplate<DataWrapper>::ProcessColumnsChunks(
+    const absl::string_view source, size_t pos, ThreadPool* const thread_pool,
+    DataWrapper* const data) {
+  // Split the text into chunks of whole lines ending with '\n'. The last line
+  // of `source` is left to ProcessLine() when it does not end with '\n'.
+  std::vector<ColumnsChunk> chunks;
+  size_t chunk_start = pos;
+  while (chunks.size() < static_cast<size_t>(num_threads_) &&
+         chunk_start < source.size()) {
+    size_t chunk_end = source.find(
+        '\n', std::min(chunk_start + kColumnsChunkSize, source.size()) - 1);
+    if (chunk_end == absl::string_view::npos) {
+      chunk_end = source.rfind('\n');
+      if (chunk_end == absl::string_view::npos || chunk_end < chunk_start) {
+        break;
+      }
+    }
+    chunks.emplace_back().text =
+        source.substr(chunk_start, chunk_end + 1 - chunk_start);
+    chunk_start = chunk_end + 1;
+  }
+
+  absl::BlockingCounter counter(chunks.size());
+  for (ColumnsChunk& chunk : chunks) {
+    thread_pool->Schedule([this, &chunk, &counter]() {
+      ParseColumnsChunk(&chunk);
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+
+  for (const ColumnsChunk& chunk : chunks) {
+    for (const ColumnsLine& columns_line : chunk.lines) {
+      const absl::Status status = StoreColumnsLine(columns_line, data);
+      if (!status.ok()) {
+        ASSIGN_OR_RETURN(const internal::MPSLineInfo line_info,
+                         internal::MPSLineInfo::Create(
+                             line_num_ + columns_line.line_index, free_form_,
+                             columns_line.line));
+        return line_info.AppendLineToError(status);
+      }
+    }
+    line_num_ += chunk.num_parsed_lines;
+    pos += chunk.parsed_size;
+    // The next line of the chunk has to be processed by ProcessLine().
+    if (chunk.parsed_size < chunk.text.size()) break;
+  }
+  return pos;
+}
+
+template <class DataWrapper>
+void MPSReaderTemplate<DataWrapper>::ParseColumnsChunk(
+    ColumnsChunk* const chunk) const {
+  const absl::string_view text = chunk->text;
+  while (chunk->parsed_size < text.size()) {
+    const size_t end = text.find('\n', chunk->parsed_size);
+    DCHECK_NE(end, absl::string_view::npos);
+    const absl::string_view line =
+        text.substr(chunk->parsed_size, end - chunk->parsed_size);
+    const int64_t line_index = chunk->num_parsed_lines + 1;
+    const absl::StatusOr<internal::MPSLineInfo> line_info =
+        internal::MPSLineInfo::Create(line_index, free_form_, line);
+    if (!line_info.ok()) return;
+    if (!line_info->IsCommentOrBlank()) {
+      if (line_info->IsNewSection()) return;
+      absl::StatusOr<ColumnsLine> columns_line = ParseColumnsLine(*line_info);
+      if (!columns_line.ok()) return;
+      columns_line->line = line;
+      columns_line->line_index = line_index;
+      chunk->lines.push_back(*std::move(columns_line));
+    }
+    chunk->parsed_size = end + 1;
+    ++chunk->num_parsed_lines;
+  }
+}
+
 template <class DataWrapper>
 absl::Status MPSReaderTemplate<DataWrapper>::ProcessObjectiveSenseSection(
     const internal::MPSLineInfo& line_info, DataWrapper* data) {
@@ -810,6 +1021,10 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessRowsSection(
       ++num_unconstrained_rows_;
     }
     const IndexType row = data->FindOrCreateConstraint(row_name);
+    // A row named like the objective is shadowed by it in the COLUMNS section.
+    if (num_threads_ > 1 && row_name != objective_name_) {
+      row_indices_.emplace(row_name, row);
+    }
     if (is_lazy) data->SetIsLazy(row);
 
     // The initial row range is [0, 0]. We encode the type in the range by
@@ -837,34 +1052,81 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessRowsSection(
 template <class DataWrapper>
 absl::Status MPSReaderTemplate<DataWrapper>::ProcessColumnsSection(
     const internal::MPSLineInfo& line_info, DataWrapper* data) {
+  ASSIGN_OR_RETURN(const ColumnsLine columns_line, ParseColumnsLine(line_info));
+  const absl::Status status = StoreColumnsLine(columns_line, data);
+  if (!status.ok()) return line_info.AppendLineToError(status);
+  return absl::OkStatus();
+}
+
+template <class DataWrapper>
+absl::StatusOr<typename MPSReaderTemplate<DataWrapper>::ColumnsLine>
+MPSReaderTemplate<DataWrapper>::ParseColumnsLine(
+    const internal::MPSLineInfo& line_info) const {
+  ColumnsLine columns_line;
   // Take into account the INTORG and INTEND markers.
   if (absl::StrContains(line_info.GetLine(), "'MARKER'")) {
     if (absl::StrContains(line_info.GetLine(), "'INTORG'")) {
       VLOG(2) << "Entering integer marker.\n" << line_info.GetLine();
-      if (in_integer_section_) {
-        return line_info.InvalidArgumentError(
-            "Found INTORG inside the integer section.");
-      }
-      in_integer_section_ = true;
+      columns_line.marker = ColumnsLine::Marker::kIntOrg;
     } else if (absl::StrContains(line_info.GetLine(), "'INTEND'")) {
       VLOG(2) << "Leaving integer marker.\n" << line_info.GetLine();
-      if (!in_integer_section_) {
-        return line_info.InvalidArgumentError(
-            "Found INTEND without corresponding INTORG.");
-      }
-      in_integer_section_ = false;
+      columns_line.marker = ColumnsLine::Marker::kIntEnd;
+    } else {
+      columns_line.marker = ColumnsLine::Marker::kOther;
     }
-    return absl::OkStatus();
+    return columns_line;
   }
   const int start_index = free_form_ ? 0 : 1;
   if (line_info.GetFieldsSize() < start_index + 3) {
     return line_info.InvalidArgumentError(
         "Not enough fields in COLUMNS section.");
   }
-  const absl::string_view column_name = line_info.GetField(start_index + 0);
+  columns_line.column_name = line_info.GetField(start_index + 0);
   const absl::string_view row1_name = line_info.GetField(start_index + 1);
   const absl::string_view row1_value = line_info.GetField(start_index + 2);
-  const IndexType col = data->FindOrCreateVariable(column_name);
+  RETURN_IF_ERROR(
+      ParseCoefficient(line_info, row1_name, row1_value, columns_line));
+  if (line_info.GetFieldsSize() == start_index + 4) {
+    return line_info.InvalidArgumentError("Unexpected number of fields.");
+  }
+  if (line_info.GetFieldsSize() - start_index > 4) {
+    const absl::string_view row2_name = line_info.GetField(start_index + 3);
+    const absl::string_view row2_value = line_info.GetField(start_index + 4);
+    RETURN_IF_ERROR(
+        ParseCoefficient(line_info, row2_name, row2_value, columns_line));
+  }
+  return columns_line;
+}
+
+template <class DataWrapper>
+absl::Status MPSReaderTemplate<DataWrapper>::StoreColumnsLine(
+    const ColumnsLine& columns_line, DataWrapper* data) {
+  switch (columns_line.marker) {
+    case ColumnsLine::Marker::kIntOrg:
+      if (in_integer_section_) {
+        return absl::InvalidArgumentError(
+            "Found INTORG inside the integer section.");
+      }
+      in_integer_section_ = true;
+      return absl::OkStatus();
+    case ColumnsLine::Marker::kIntEnd:
+      if (!in_integer_section_) {
+        return absl::InvalidArgumentError(
+            "Found INTEND without corresponding INTORG.");
+      }
+      in_integer_section_ = false;
+      return absl::OkStatus();
+    case ColumnsLine::Marker::kOther:
+      return absl::OkStatus();
+    case ColumnsLine::Marker::kNone:
+      break;
+  }
+  if (!last_column_.has_value() ||
+      columns_line.column_name != last_column_name_) {
+    last_column_ = data->FindOrCreateVariable(columns_line.column_name);
+    last_column_name_ = std::string(columns_line.column_name);
+  }
+  const IndexType col = *last_column_;
   is_binary_by_default_.resize(col + 1, false);
   if (in_integer_section_) {
     data->SetVariableTypeToInteger(col);
@@ -874,16 +1136,9 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessColumnsSection(
   } else {
     data->SetVariableBounds(col, 0.0, kInfinity);
   }
-  RETURN_IF_ERROR(
-      StoreCoefficient(line_info, col, row1_name, row1_value, data));
-  if (line_info.GetFieldsSize() == start_index + 4) {
-    return line_info.InvalidArgumentError("Unexpected number of fields.");
-  }
-  if (line_info.GetFieldsSize() - start_index > 4) {
-    const absl::string_view row2_name = line_info.GetField(start_index + 3);
-    const absl::string_view row2_value = line_info.GetField(start_index + 4);
-    RETURN_IF_ERROR(
-        StoreCoefficient(line_info, col, row2_name, row2_value, data));
+  for (int i = 0; i < columns_line.num_coefficients; ++i) {
+    StoreCoefficient(col, columns_line.row_names[i], columns_line.values[i],
+                     columns_line.rows[i], data);
   }
   return absl::OkStatus();
 }
@@ -979,10 +1234,9 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessIndicatorsSection(
 }
 
 template <class DataWrapper>
-absl::Status MPSReaderTemplate<DataWrapper>::StoreCoefficient(
-    const internal::MPSLineInfo& line_info, IndexType col,
-    absl::string_view row_name, absl::string_view row_value,
-    DataWrapper* data) {
+absl::Status MPSReaderTemplate<DataWrapper>::ParseCoefficient(
+    const internal::MPSLineInfo& line_info, absl::string_view row_name,
+    absl::string_view row_value, ColumnsLine& columns_line) const {
   if (row_name.empty() || row_name == "$") {
     return absl::OkStatus();
   }
@@ -994,15 +1248,32 @@ absl::Status MPSReaderTemplate<DataWrapper>::StoreCoefficient(
         "Constraint coefficients cannot be infinity.");
   }
   if (value == 0.0) return absl::OkStatus();
-  if (row_name == objective_name_) {
-    data->SetObjectiveCoefficient(col, value);
-  } else {
-    const IndexType row = data->FindOrCreateConstraint(row_name);
-    data->SetConstraintCoefficient(row, col, value);
+  const int i = columns_line.num_coefficients++;
+  columns_line.row_names[i] = row_name;
+  columns_line.values[i] = value;
+  if (!row_indices_.empty()) {
+    if (const auto it = row_indices_.find(row_name); it != row_indices_.end()) {
+      columns_line.rows[i] = it->second;
+    }
   }
   return absl::OkStatus();
 }
 
+template <class DataWrapper>
+void MPSReaderTemplate<DataWrapper>::StoreCoefficient(
+    IndexType col, absl::string_view row_name, double value,
+    std::optional<IndexType> row, DataWrapper* data) {
+  if (!row.has_value()) {
+    if (row_name == objective_name_) {
+      data->SetObjectiveCoefficient(col, value);
+      return;
+    }
+    row = data->FindOrCreateConstraint(row_name);
+    if (num_threads_ > 1) row_indices_.emplace(row_name, *row);
+  }
+  data->SetConstraintCoefficient(*row, col, value);
+}
+
 template <class DataWrapper>
 absl::Status MPSReaderTemplate<DataWrapper>::StoreRightHandSide(
     const internal::MPSLineInfo& line_info, absl::string_view row_name,
@@ -1187,6 +1458,9 @@ void MPSReaderTemplate<DataWrapper>::Reset() {
   in_integer_section_ = false;
   num_unconstrained_rows_ = 0;
   objective_name_.clear();
+  row_indices_.clear();
+  last_column_name_.clear();
+  last_column_.reset();
 }
 
 template <class DataWrapper>
@@ -1200,7 +1474,7 @@ void MPSReaderTemplate<DataWrapper>::DisplaySummary() {
 
 template <class DataWrapper>
 absl::StatusOr<double> MPSReaderTemplate<DataWrapper>::GetDoubleFromString(
-    absl::string_view str, const internal::MPSLineInfo& line_info) {
+    absl::string_view str, const internal::MPSLineInfo& line_info) const {
   double result;
   if (!absl::SimpleAtod(str, &result)) {
     return line_info.InvalidArgumentError(
@@ -1214,7 +1488,7 @@ absl::StatusOr<double> MPSReaderTemplate<DataWrapper>::GetDoubleFromString(
 
 template <class DataWrapper>
 absl::StatusOr<bool> MPSReaderTemplate<DataWrapper>::GetBoolFromString(
-    absl::string_view str, const internal::MPSLineInfo& line_info) {
+    absl::string_view str, const internal::MPSLineInfo& line_info) const {
   int result;
   if (!absl::SimpleAtoi(str, &result) || result < 0 || result > 1) {
     return line_info.InvalidArgumentError(
@@ -0,0 +1,265 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/lp_data/mps_reader.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/path.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+
+namespace operations_research {
+namespace glop {
+namespace {
+
+using ::testing::EqualsProto;
+using ::testing::HasSubstr;
+
+// Large enough for the COLUMNS section to be split into several chunks per
+// thread, see MPSReaderTemplate::set_num_threads().
+constexpr int kNumColumns = 30000;
+constexpr int kNumRows = 50;
+
+// Returns an MPS line made of `fields`, where `fields[0]` is the code field,
+// which is empty on the lines of the COLUMNS section.
+std::string Line(bool free_form, const std::vector<std::string>& fields) {
+  static constexpr int kFieldStartPos[] = {1, 4, 14, 24, 39, 49};
+  std::string line;
+  for (int i = 0; i < fields.size(); ++i) {
+    if (fields[i].empty()) continue;
+    if (free_form) {
+      absl::StrAppend(&line, " ", fields[i]);
+    } else {
+      line.resize(kFieldStartPos[i], ' ');
+      line += fields[i];
+    }
+  }
+  return line;
+}
+
+std::string Row(int row) { return absl::StrCat("R", row % kNumRows); }
+
+std::string Value(int index) { return absl::StrCat(0.25 * (index % 13 - 6)); }
+
+// Returns the lines of a model with `num_columns` columns. The columns span
+// three lines each, have coefficients on known and undeclared rows, and some
+// of them are between integrality markers. In free format, the model has an
+// additional column, whose name is not valid in fixed format.
+std::vector<std::string> ModelLines(bool free_form, int num_columns) {
+  std::vector<std::string> lines = {"NAME          PARALLEL", "ROWS",
+                                    Line(free_form, {"N", "COST"})};
+  for (int row = 0; row < kNumRows; ++row) {
+    lines.push_back(Line(free_form, {row % 3 == 0   ? "L"
+                                     : row % 3 == 1 ? "G"
+                                                    : "E",
+                                     Row(row)}));
+  }
+  lines.push_back("COLUMNS");
+  if (free_form) {
+    // A name which is too long for fixed format.
+    lines.push_back(
+        Line(free_form, {"", "A_VERY_LONG_COLUMN_NAME", Row(0), "1"}));
+  }
+  for (int col = 0; col < num_columns; ++col) {
+    const std::string name = absl::StrCat("X", col);
+    if (col % 100 == 10) {
+      lines.push_back(
+          Line(free_form, {"", "MARKER", "'MARKER'", "", "'INTORG'"}));
+    }
+    lines.push_back(
+        Line(free_form, {"", name, "COST", Value(col), Row(col), "1"}));
+    if (col % 10 == 0) {
+      lines.push_back("* A comment.");
+    }
+    lines.push_back(Line(free_form, {"", name, Row(col + 7), Value(col + 1),
+                                     Row(col + 19), Value(col + 2)}));
+    lines.push_back(Line(
+        free_form,
+        {"", name, col % 1000 == 0 ? absl::StrCat("U", col) : Row(col + 31),
+         Value(col + 3)}));
+    if (col % 100 == 19) {
+      lines.push_back(
+          Line(free_form, {"", "MARKER", "'MARKER'", "", "'INTEND'"}));
+    }
+  }
+  lines.push_back("RHS");
+  for (int row = 0; row < kNumRows; row += 2) {
+    lines.push_back(Line(free_form, {"", "RHS", Row(row), Value(row)}));
+  }
+  lines.push_back("RANGES");
+  lines.push_back(Line(free_form, {"", "RNG", Row(2), "4"}));
+  lines.push_back("BOUNDS");
+  lines.push_back(Line(free_form, {"UP", "BND", "X1", "4"}));
+  lines.push_back(Line(free_form, {"MI", "BND", "X2"}));
+  lines.push_back(Line(free_form, {"UP", "BND", "X11", "7"}));
+  lines.push_back("ENDATA");
+  return lines;
+}
+
+std::string ToMps(const std::vector<std::string>& lines,
+                  absl::string_view end_of_line = "\n",
+                  bool final_end_of_line = true) {
+  std::string mps = absl::StrJoin(lines, end_of_line);
+  if (final_end_of_line) absl::StrAppend(&mps, end_of_line);
+  return mps;
+}
+
+// Parses `mps` with one and several threads, from a string and from a file,
+// and checks that the models, or the errors, are the same. Returns the result
+// with one thread.
+absl::StatusOr<MPModelProto> ParseWithAllThreadCounts(absl::string_view mps) {
+  const absl::StatusOr<MPModelProto> expected = MpsDataToMPModelProto(mps);
+  const auto expect_same = [&expected](
+                               const absl::StatusOr<MPModelProto>& actual) {
+    ASSERT_EQ(actual.ok(), expected.ok()) << actual.status();
+    if (expected.ok()) {
+      EXPECT_THAT(*actual, EqualsProto(*expected));
+    } else {
+      EXPECT_EQ(actual.status(), expected.status());
+    }
+  };
+  for (const int num_threads : {2, 3, 8}) {
+    SCOPED_TRACE(absl::StrCat("num_threads: ", num_threads));
+    expect_same(MpsDataToMPModelProto(mps, num_threads));
+  }
+  const std::string filename =
+      file::JoinPath(::testing::TempDir(), "parallel.mps");
+  CHECK_OK(file::SetContents(filename, mps, file::Defaults()));
+  for (const int num_threads : {1, 4}) {
+    SCOPED_TRACE(absl::StrCat("file, num_threads: ", num_threads));
+    expect_same(MpsFileToMPModelProto(filename, num_threads));
+  }
+  return expected;
+}
+
+TEST(MpsReaderParallelTest, FixedFormat) {
+  const std::string mps = ToMps(ModelLines(/*free_form=*/false, kNumColumns));
+  ASSERT_GT(mps.size(), 3 << 20);
+  const absl::StatusOr<MPModelProto> model = ParseWithAllThreadCounts(mps);
+  ASSERT_TRUE(model.ok()) << model.status();
+  EXPECT_EQ(model->variable_size(), kNumColumns);
+  // Some undeclared rows only have zero coefficients, and are not created.
+  EXPECT_GT(model->constraint_size(), kNumRows);
+}
+
+TEST(MpsReaderParallelTest, FreeFormat) {
+  const absl::StatusOr<MPModelProto> model = ParseWithAllThreadCounts(
+      ToMps(ModelLines(/*free_form=*/true, kNumColumns)));
+  ASSERT_TRUE(model.ok()) << model.status();
+  EXPECT_EQ(model->variable_size(), kNumColumns + 1);
+}
+
+TEST(MpsReaderParallelTest, IntegerMarkers) {
+  const absl::StatusOr<MPModelProto> model =
+      ParseWithAllThreadCounts(ToMps(ModelLines(/*free_form=*/false, 200)));
+  ASSERT_TRUE(model.ok()) << model.status();
+  for (int col = 0; col < 200; ++col) {
+    const bool is_integer = col % 100 >= 10 && col % 100 < 20;
+    EXPECT_EQ(model->variable(col).is_integer(), is_integer) << col;
+  }
+  EXPECT_EQ(model->variable(11).upper_bound(), 7);
+  EXPECT_EQ(model->variable(12).upper_bound(), 1);
+}
+
+TEST(MpsReaderParallelTest, CrLf) {
+  for (const bool free_form : {false, true}) {
+    SCOPED_TRACE(free_form);
+    const std::vector<std::string> lines = ModelLines(free_form, kNumColumns);
+    const absl::StatusOr<MPModelProto> model =
+        ParseWithAllThreadCounts(ToMps(lines, "\r\n"));
+    ASSERT_TRUE(model.ok()) << model.status();
+    EXPECT_THAT(*model, EqualsProto(*MpsDataToMPModelProto(ToMps(lines))));
+  }
+}
+
+TEST(MpsReaderParallelTest, NoFinalNewline) {
+  for (const bool free_form : {false, true}) {
+    SCOPED_TRACE(free_form);
+    std::vector<std::string> lines = ModelLines(free_form, kNumColumns);
+    const absl::StatusOr<MPModelProto> model = ParseWithAllThreadCounts(
+        ToMps(lines, "\n", /*final_end_of_line=*/false));
+    ASSERT_TRUE(model.ok()) << model.status();
+    // The last line of the COLUMNS section is the last line of the file.
+    lines.resize(std::find(lines.begin(), lines.end(), "RHS") - lines.begin());
+    for (const absl::string_view end_of_line : {"\n", "\r\n"}) {
+      EXPECT_TRUE(ParseWithAllThreadCounts(
+                      ToMps(lines, end_of_line, /*final_end_of_line=*/false))
+                      .ok());
+    }
+  }
+}
+
+// Returns the index of the line of `lines` which starts the given column.
+int ColumnLineIndex(const std::vector<std::string>& lines, int col) {
+  const std::string prefix = absl::StrCat(" X", col, " ");
+  for (int i = 0; i < lines.size(); ++i) {
+    if (absl::StrContains(absl::StrCat(" ", lines[i], " "), prefix)) return i;
+  }
+  return -1;
+}
+
+// Errors in the COLUMNS section are reported with the same message and line
+// number, whichever chunk and thread parses the line.
+TEST(MpsReaderParallelTest, ColumnsErrorInLaterChunk) {
+  for (const bool free_form : {false, true}) {
+    SCOPED_TRACE(free_form);
+    const std::vector<std::string> lines = ModelLines(free_form, kNumColumns);
+    for (const int col : {kNumColumns / 2, kNumColumns - 3}) {
+      SCOPED_TRACE(col);
+      const int index = ColumnLineIndex(lines, col);
+      ASSERT_GE(index, 0);
+      const std::string line_number = absl::StrCat("Line ", index + 1, ":");
+
+      // A value which can't be parsed.
+      std::vector<std::string> bad_lines = lines;
+      bad_lines[index] =
+          Line(free_form, {"", absl::StrCat("X", col), "COST", "1.5x"});
+      absl::StatusOr<MPModelProto> model =
+          ParseWithAllThreadCounts(ToMps(bad_lines));
+      ASSERT_FALSE(model.ok());
+      EXPECT_THAT(model.status().message(), HasSubstr("1.5x"));
+      EXPECT_THAT(model.status().message(), HasSubstr(line_number));
+
+      // A line which parses, but can't be stored.
+      bad_lines = lines;
+      bad_lines[index] =
+          Line(free_form, {"", "MARKER", "'MARKER'", "", "'INTEND'"});
+      model = ParseWithAllThreadCounts(ToMps(bad_lines, "\r\n"));
+      ASSERT_FALSE(model.ok());
+      EXPECT_THAT(model.status().message(), HasSubstr("INTEND"));
+      EXPECT_THAT(model.status().message(), HasSubstr(line_number));
+    }
+  }
+}
+
+TEST(MpsReaderParallelTest, ErrorsInOtherSections) {
+  std::vector<std::string> lines = ModelLines(/*free_form=*/false, 100);
+  lines.insert(lines.end() - 1, "UNKNOWN");
+  EXPECT_FALSE(ParseWithAllThreadCounts(ToMps(lines)).ok());
+  EXPECT_FALSE(ParseWithAllThreadCounts("COLUMNS\n    X1").ok());
+}
+
+}  // namespace
+}  // namespace glop
+}  // namespace operations_research
@@ -13,12 +13,19 @@
 
 #include "ortools/lp_data/proto_utils.h"
 
+#include <cstdint>
+#include <string>
+
 #include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
+#include "ortools/util/linear_model_file.h"
 
 namespace operations_research {
 namespace glop {
@@ -88,5 +95,150 @@ void MPModelProtoToLinearProgram(const MPModelProto& input,
   output->CleanUp();
 }
 
+absl::StatusOr<LinearModelArrays> MPModelProtoToLinearModelArrays(
+    const MPModelProto& input) {
+  if (input.general_constraint_size() > 0) {
+    return absl::InvalidArgumentError(
+        "General constraints are not supported by linear model files.");
+  }
+  if (input.has_quadratic_objective()) {
+    return absl::InvalidArgumentError(
+        "Quadratic objectives are not supported by linear model files.");
+  }
+  LinearModelArrays output;
+  output.maximize = input.maximize();
+  output.objective_offset = input.objective_offset();
+  output.name = input.name();
+  const int num_variables = input.variable_size();
+  output.variable_lower_bounds.reserve(num_variables);
+  output.variable_upper_bounds.reserve(num_variables);
+  output.objective_coefficients.reserve(num_variables);
+  output.variable_is_integer.reserve(num_variables);
+  bool has_variable_names = false;
+  for (const MPVariableProto& var : input.variable()) {
+    output.variable_lower_bounds.push_back(var.lower_bound());
+    output.variable_upper_bounds.push_back(var.upper_bound());
+    output.objective_coefficients.push_back(var.objective_coefficient());
+    output.variable_is_integer.push_back(var.is_integer());
+    has_variable_names |= !var.name().empty();
+  }
+  if (has_variable_names) {
+    output.variable_names.reserve(num_variables);
+    for (const MPVariableProto& var : input.variable()) {
+      output.variable_names.push_back(var.name());
+    }
+  }
+
+  const int num_constraints = input.constraint_size();
+  int64_t num_non_zeros = 0;
+  for (const MPConstraintProto& cst : input.constraint()) {
+    num_non_zeros += cst.var_index_size();
+  }
+  output.constraint_lower_bounds.reserve(num_constraints);
+  output.constraint_upper_bounds.reserve(num_constraints);
+  output.row_starts.reserve(num_constraints + 1);
+  output.column_indices.reserve(num_non_zeros);
+  output.coefficients.reserve(num_non_zeros);
+  bool has_constraint_names = false;
+  for (int j = 0; j < num_constraints; ++j) {
+    const MPConstraintProto& cst = input.constraint(j);
+    if (cst.var_index_size() != cst.coefficient_size()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Constraint ", j, " has ", cst.var_index_size(),
+                       " variables but ", cst.coefficient_size(),
+                       " coefficients."));
+    }
+    output.constraint_lower_bounds.push_back(cst.lower_bound());
+    output.constraint_upper_bounds.push_back(cst.upper_bound());
+    output.column_indices.insert(output.column_indices.end(),
+                                 cst.var_index().begin(),
+                                 cst.var_index().end());
+    output.coefficients.insert(output.coefficients.end(),
+                               cst.coefficient().begin(),
+                               cst.coefficient().end());
+    output.row_starts.push_back(output.coefficients.size());
+    has_constraint_names |= !cst.name().empty();
+  }
+  if (has_constraint_names) {
+    output.constraint_names.reserve(num_constraints);
+    for (const MPConstraintProto& cst : input.constraint()) {
+      output.constraint_names.push_back(cst.name());
+    }
+  }
+  return output;
+}
+
+void LinearModelViewToMPModelProto(const LinearModelView& input,
+                                   MPModelProto* output) {
+  output->Clear();
+  output->set_name(input.name());
+  output->set_maximize(input.maximize());
+  output->set_objective_offset(input.objective_offset());
+  output->mutable_variable()->Reserve(input.num_variables());
+  for (int64_t i = 0; i < input.num_variables(); ++i) {
+    MPVariableProto* variable = output->add_variable();
+    variable->set_lower_bound(input.variable_lower_bounds()[i]);
+    variable->set_upper_bound(input.variable_upper_bounds()[i]);
+    variable->set_objective_coefficient(input.objective_coefficients()[i]);
+    variable->set_is_integer(input.variable_is_integer()[i] != 0);
+    if (input.has_names()) variable->set_name(input.variable_name(i));
+  }
+  output->mutable_constraint()->Reserve(input.num_constraints());
+  for (int64_t j = 0; j < input.num_constraints(); ++j) {
+    MPConstraintProto* constraint = output->add_constraint();
+    constraint->set_lower_bound(input.constraint_lower_bounds()[j]);
+    constraint->set_upper_bound(input.constraint_upper_bounds()[j]);
+    if (input.has_names()) constraint->set_name(input.constraint_name(j));
+    const auto column_indices = input.ColumnIndices(j);
+    const auto coefficients = input.Coefficients(j);
+    constraint->mutable_var_index()->Add(column_indices.begin(),
+                                         column_indices.end());
+    constraint->mutable_coefficient()->Add(coefficients.begin(),
+                                           coefficients.end());
+  }
+}
+
+void LinearModelViewToLinearProgram(const LinearModelView& input,
+                                    LinearProgram* output) {
+  output->Clear();
+  output->SetName(input.name());
+  output->SetMaximizationProblem(input.maximize());
+  output->SetObjectiveOffset(input.objective_offset());
+  for (int64_t i = 0; i < input.num_variables(); ++i) {
+    const ColIndex col = output->CreateNewVariable();
+    if (input.has_names()) output->SetVariableName(col, input.variable_name(i));
+    output->SetVariableBounds(col, input.variable_lower_bounds()[i],
+                              input.variable_upper_bounds()[i]);
+    output->SetObjectiveCoefficient(col, input.objective_coefficients()[i]);
+    if (input.variable_is_integer()[i]) {
+      output->SetVariableType(col, LinearProgram::VariableType::INTEGER);
+    }
+  }
+  // The LinearProgram stores the matrix column-wise, so we reserve the columns
+  // before transposing the rows into them.
+  StrictITIVector<ColIndex, EntryIndex> column_sizes(
+      ColIndex(input.num_variables()), EntryIndex(0));
+  for (const int32_t col : input.column_indices()) {
+    ++column_sizes[ColIndex(col)];
+  }
+  for (ColIndex col(0); col < input.num_variables(); ++col) {
+    output->GetMutableSparseColumn(col)->Reserve(column_sizes[col]);
+  }
+  for (int64_t j = 0; j < input.num_constraints(); ++j) {
+    const RowIndex row = output->CreateNewConstraint();
+    if (input.has_names()) {
+      output->SetConstraintName(row, input.constraint_name(j));
+    }
+    output->SetConstraintBounds(row, input.constraint_lower_bounds()[j],
+                                input.constraint_upper_bounds()[j]);
+    const auto column_indices = input.ColumnIndices(j);
+    const auto coefficients = input.Coefficients(j);
+    for (int k = 0; k < column_indices.size(); ++k) {
+      output->SetCoefficient(row, ColIndex(column_indices[k]), coefficients[k]);
+    }
+  }
+  output->CleanUp();
+}
+
 }  // namespace glop
 }  // namespace operations_research
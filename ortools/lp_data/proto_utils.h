@@ -14,8 +14,10 @@
 #ifndef OR_TOOLS_LP_DATA_PROTO_UTILS_H_
 #define OR_TOOLS_LP_DATA_PROTO_UTILS_H_
 
+#include "absl/status/statusor.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
+#include "ortools/util/linear_model_file.h"
 
 namespace operations_research {
 namespace glop {
@@ -28,6 +30,23 @@ void LinearProgramToMPModelProto(const LinearProgram& input,
 void MPModelProtoToLinearProgram(const MPModelProto& input,
                                  LinearProgram* output);
 
+// Converts a MPModelProto to the contents of a linear model file (see
+// ortools/util/linear_model_file.h). Returns an InvalidArgumentError if the
+// model has general constraints or a quadratic objective, which the format does
+// not support. The solution hint, and the other information only used by some
+// solvers, are dropped.
+absl::StatusOr<LinearModelArrays> MPModelProtoToLinearModelArrays(
+    const MPModelProto& input);
+
+// Converts a linear model file to a MPModelProto.
+void LinearModelViewToMPModelProto(const LinearModelView& input,
+                                   MPModelProto* output);
+
+// Converts a linear model file to a LinearProgram, without going through a
+// MPModelProto.
+void LinearModelViewToLinearProgram(const LinearModelView& input,
+                                    LinearProgram* output);
+
 }  // namespace glop
 }  // namespace operations_research
 
@@ -14,6 +14,9 @@
 #include "ortools/math_opt/cpp/model.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -22,11 +25,13 @@
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "ortools/base/status_builder.h"
 #include "ortools/base/status_macros.h"
 #include "ortools/base/strong_int.h"
 #include "ortools/math_opt/constraints/indicator/indicator_constraint.h"
@@ -50,6 +55,68 @@ namespace math_opt {
 
 constexpr double kInf = std::numeric_limits<double>::infinity();
 
+namespace {
+
+// Returns an error if one of the ids is not in [0, next_id) or is not
+// contained, using a single min/max reduction when all the ids in
+// [0, next_id) are contained.
+template <typename IdType, typename ContainsFn>
+absl::Status CheckIds(const absl::Span<const int64_t> ids,
+                      const IdType next_id, const int64_t num_contained,
+                      const ContainsFn& contains,
+                      const absl::string_view what) {
+  if (ids.empty()) {
+    return absl::OkStatus();
+  }
+  if (num_contained == next_id.value()) {
+    const auto [min_id, max_id] = absl::c_minmax_element(ids);
+    if (*min_id >= 0 && *max_id < next_id.value()) {
+      return absl::OkStatus();
+    }
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(ids.size()); ++i) {
+    if (ids[i] < 0 || ids[i] >= next_id.value() || !contains(IdType(ids[i]))) {
+      return util::InvalidArgumentErrorBuilder()
+             << what << " id " << ids[i] << " at index " << i
+             << " is not found in this model";
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Returns an error if a coefficient is NaN or infinite.
+absl::Status CheckFiniteCoefficients(const absl::Span<const double> values) {
+  for (int64_t i = 0; i < static_cast<int64_t>(values.size()); ++i) {
+    if (!std::isfinite(values[i])) {
+      return util::InvalidArgumentErrorBuilder()
+             << "coefficient at index " << i << " is not finite: "
+             << values[i];
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Returns an error if a bound is NaN, a lower bound is +inf or an upper bound
+// is -inf, as ModelProto validation does.
+absl::Status CheckBounds(const absl::Span<const double> lower_bounds,
+                         const absl::Span<const double> upper_bounds) {
+  for (int64_t i = 0; i < static_cast<int64_t>(lower_bounds.size()); ++i) {
+    if (std::isnan(lower_bounds[i]) || lower_bounds[i] == kInf) {
+      return util::InvalidArgumentErrorBuilder()
+             << "invalid lower bound at index " << i << ": "
+             << lower_bounds[i];
+    }
+    if (std::isnan(upper_bounds[i]) || upper_bounds[i] == -kInf) {
+      return util::InvalidArgumentErrorBuilder()
+             << "invalid upper bound at index " << i << ": "
+             << upper_bounds[i];
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
 absl::StatusOr<std::unique_ptr<Model>> Model::FromModelProto(
     const ModelProto& model_proto) {
   ASSIGN_OR_RETURN(std::unique_ptr<ModelStorage> storage,
@@ -57,8 +124,10 @@ absl::StatusOr<std::unique_ptr<Model>> Model::FromModelProto(
   return std::make_unique<Model>(std::move(storage));
 }
 
-Model::Model(const absl::string_view name)
-    : storage_(std::make_shared<ModelStorage>(name)) {}
+Model::Model(const absl::string_view name,
+             const MatrixStorageMode matrix_storage_mode)
+    : storage_(std::make_shared<ModelStorage>(
+          name, /*primary_objective_name=*/"", matrix_storage_mode)) {}
 
 Model::Model(std::unique_ptr<ModelStorage> storage)
     : storage_(std::move(storage)) {}
@@ -82,6 +151,101 @@ LinearConstraint Model::AddLinearConstraint(
   return LinearConstraint(storage(), constraint);
 }
 
+absl::StatusOr<int64_t> Model::AddLinearConstraints(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const absl::Span<const int64_t> row_starts,
+    const absl::Span<const int64_t> variable_ids,
+    const absl::Span<const double> coefficients,
+    const absl::Span<const std::string> names) {
+  const int64_t num_constraints = lower_bounds.size();
+  const int64_t num_terms = variable_ids.size();
+  if (upper_bounds.size() != lower_bounds.size() ||
+      row_starts.size() != lower_bounds.size() + 1 ||
+      (!names.empty() && names.size() != lower_bounds.size())) {
+    return util::InvalidArgumentErrorBuilder()
+           << "inconsistent sizes: " << num_constraints << " lower bounds, "
+           << upper_bounds.size() << " upper bounds, " << row_starts.size()
+           << " row starts, and " << names.size() << " names";
+  }
+  if (coefficients.size() != variable_ids.size()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "inconsistent sizes: " << num_terms << " variable ids and "
+           << coefficients.size() << " coefficients";
+  }
+  if (row_starts.front() != 0 || row_starts.back() != num_terms) {
+    return util::InvalidArgumentErrorBuilder()
+           << "row starts must go from 0 to " << num_terms
+           << ", got " << row_starts.front() << " to " << row_starts.back();
+  }
+  for (int64_t i = 0; i < num_constraints; ++i) {
+    if (row_starts[i + 1] < row_starts[i]) {
+      return util::InvalidArgumentErrorBuilder()
+             << "row starts must be nondecreasing, got " << row_starts[i]
+             << " then " << row_starts[i + 1] << " at index " << i;
+    }
+  }
+  RETURN_IF_ERROR(CheckBounds(lower_bounds, upper_bounds));
+  RETURN_IF_ERROR(CheckFiniteCoefficients(coefficients));
+  RETURN_IF_ERROR(CheckIds(
+      variable_ids, storage()->next_variable_id(), storage()->num_variables(),
+      [this](const VariableId id) { return storage()->has_variable(id); },
+      "variable"));
+  // Rows with increasing variable ids, the common case, are checked for
+  // duplicates without sorting.
+  std::vector<int64_t> sorted_row;
+  for (int64_t i = 0; i < num_constraints; ++i) {
+    const auto row =
+        variable_ids.subspan(row_starts[i], row_starts[i + 1] - row_starts[i]);
+    if (absl::c_adjacent_find(row, std::greater_equal<int64_t>()) ==
+        row.end()) {
+      continue;
+    }
+    sorted_row.assign(row.begin(), row.end());
+    absl::c_sort(sorted_row);
+    const auto duplicate = absl::c_adjacent_find(sorted_row);
+    if (duplicate != sorted_row.end()) {
+      return util::InvalidArgumentErrorBuilder()
+             << "variable id " << *duplicate << " appears twice in row " << i;
+    }
+  }
+  return storage()
+      ->AddLinearConstraints(lower_bounds, upper_bounds, row_starts,
+                             variable_ids, coefficients, names)
+      .value();
+}
+
+absl::Status Model::SetLinearConstraintCoefficients(
+    const absl::Span<const int64_t> linear_constraint_ids,
+    const absl::Span<const int64_t> variable_ids,
+    const absl::Span<const double> coefficients) {
+  if (variable_ids.size() != linear_constraint_ids.size() ||
+      coefficients.size() != linear_constraint_ids.size()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "inconsistent sizes: " << linear_constraint_ids.size()
+           << " linear constraint ids, " << variable_ids.size()
+           << " variable ids, and " << coefficients.size() << " coefficients";
+  }
+  RETURN_IF_ERROR(CheckIds(
+      linear_constraint_ids, storage()->next_linear_constraint_id(),
+      storage()->num_linear_constraints(),
+      [this](const LinearConstraintId id) {
+        return storage()->has_linear_constraint(id);
+      },
+      "linear constraint"));
+  RETURN_IF_ERROR(CheckIds(
+      variable_ids, storage()->next_variable_id(), storage()->num_variables(),
+      [this](const VariableId id) { return storage()->has_variable(id); },
+      "variable"));
+  RETURN_IF_ERROR(CheckFiniteCoefficients(coefficients));
+  for (int64_t i = 0; i < static_cast<int64_t>(coefficients.size()); ++i) {
+    storage()->set_linear_constraint_coefficient(
+        LinearConstraintId(linear_constraint_ids[i]),
+        VariableId(variable_ids[i]), coefficients[i]);
+  }
+  return absl::OkStatus();
+}
+
 std::vector<Variable> Model::Variables() const {
   std::vector<Variable> result;
   result.reserve(storage()->num_variables());
@@ -130,7 +130,13 @@ class Model {
       const ModelProto& model_proto);
 
   // Creates an empty minimization problem.
-  explicit Model(absl::string_view name = "");
+  //
+  // See MatrixStorageMode for the choice of the data structure storing the
+  // linear constraint matrix. MatrixStorageMode::kColumnar is best suited to
+  // large models built with AddLinearConstraints().
+  explicit Model(
+      absl::string_view name = "",
+      MatrixStorageMode matrix_storage_mode = MatrixStorageMode::kHashMap);
 
   // Creates a model from the existing model storage.
   //
@@ -288,6 +294,57 @@ class Model {
   LinearConstraint AddLinearConstraint(
       const BoundedLinearExpression& bounded_expr, absl::string_view name = "");
 
+  // Adds linear constraints in bulk and returns the id of the first one. The
+  // new constraints have consecutive ids, use linear_constraint() to get them.
+  //
+  // The i-th new constraint has bounds [lower_bounds[i], upper_bounds[i]],
+  // name names[i] (or "" if `names` is empty), and the terms of the i-th row
+  // of a matrix in compressed sparse row (CSR) format:
+  //   coefficients[j] * variable(variable_ids[j])
+  //     for j in [row_starts[i], row_starts[i + 1]).
+  //
+  // Usage, to add x + 2 * y <= 3 and 0 <= y - z:
+  //   const std::vector<double> lower_bounds = {-kInf, 0.0};
+  //   const std::vector<double> upper_bounds = {3.0, kInf};
+  //   const std::vector<int64_t> row_starts = {0, 2, 4};
+  //   const std::vector<int64_t> variable_ids = {x.id(), y.id(), y.id(),
+  //                                              z.id()};
+  //   const std::vector<double> coefficients = {1.0, 2.0, 1.0, -1.0};
+  //   ASSIGN_OR_RETURN(const int64_t first_id,
+  //                    model.AddLinearConstraints(lower_bounds, upper_bounds,
+  //                                               row_starts, variable_ids,
+  //                                               coefficients));
+  //
+  // Unlike AddLinearConstraint(), this does not build a LinearExpression per
+  // constraint, and the input is validated in a single pass over the arrays,
+  // which is much faster for large models. With MatrixStorageMode::kColumnar
+  // the coefficients are copied directly to the constraint matrix.
+  //
+  // Returns an error, without modifying the model, if the sizes of the inputs
+  // are inconsistent, row_starts is not nondecreasing from 0 to the size of
+  // variable_ids, a bound is NaN, a lower bound is +inf, an upper bound is
+  // -inf, a coefficient is not finite, a variable is not in the model, or a
+  // variable appears twice in the same row.
+  absl::StatusOr<int64_t> AddLinearConstraints(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      absl::Span<const int64_t> row_starts,
+      absl::Span<const int64_t> variable_ids,
+      absl::Span<const double> coefficients,
+      absl::Span<const std::string> names = {});
+
+  // Sets the coefficients of (linear constraint, variable) pairs given as
+  // triplets: the coefficient of variable(variable_ids[i]) in
+  // linear_constraint(linear_constraint_ids[i]) is set to coefficients[i]. When
+  // a pair appears several times, its last coefficient is used.
+  //
+  // Returns an error, without modifying the model, if the sizes of the inputs
+  // differ, a coefficient is not finite, or an id is not in the model.
+  absl::Status SetLinearConstraintCoefficients(
+      absl::Span<const int64_t> linear_constraint_ids,
+      absl::Span<const int64_t> variable_ids,
+      absl::Span<const double> coefficients);
+
   // Removes a linear constraint from the model.
   //
   // It is an error to use any reference to this linear constraint after this
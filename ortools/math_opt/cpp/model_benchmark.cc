@@ -0,0 +1,126 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark of the construction of large linear models.
+//
+// Each iteration builds a model with num_constraints constraints of
+// kTermsPerConstraint random terms each, either one LinearExpression at a time
+// or with a single call to Model::AddLinearConstraints(), and exports it.
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/random/random.h"
+#include "benchmark/benchmark.h"
+#include "ortools/math_opt/cpp/model.h"
+#include "ortools/math_opt/cpp/variable_and_expressions.h"
+#include "ortools/math_opt/storage/model_storage_types.h"
+
+namespace operations_research::math_opt {
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr int kTermsPerConstraint = 10;
+
+// A random constraint matrix in compressed sparse row format, with distinct
+// columns in each row.
+struct RandomMatrix {
+  std::vector<int64_t> row_starts = {0};
+  std::vector<int64_t> variable_ids;
+  std::vector<double> coefficients;
+};
+
+RandomMatrix MakeRandomMatrix(const int64_t num_constraints,
+                              const int64_t num_variables) {
+  std::mt19937 random(12345);
+  RandomMatrix matrix;
+  for (int64_t c = 0; c < num_constraints; ++c) {
+    // Consecutive columns of a random window are distinct.
+    const int64_t first = absl::Uniform<int64_t>(
+        random, 0, num_variables - kTermsPerConstraint);
+    for (int64_t j = 0; j < kTermsPerConstraint; ++j) {
+      matrix.variable_ids.push_back(first + j);
+      matrix.coefficients.push_back(absl::Uniform(random, -1.0, 1.0));
+    }
+    matrix.row_starts.push_back(matrix.variable_ids.size());
+  }
+  return matrix;
+}
+
+void BM_AddLinearConstraint(benchmark::State& state) {
+  const auto matrix_storage_mode =
+      static_cast<MatrixStorageMode>(state.range(0));
+  const int64_t num_constraints = state.range(1);
+  const int64_t num_variables = num_constraints;
+  const RandomMatrix matrix = MakeRandomMatrix(num_constraints, num_variables);
+  for (auto _ : state) {
+    Model model("", matrix_storage_mode);
+    std::vector<Variable> variables;
+    variables.reserve(num_variables);
+    for (int64_t v = 0; v < num_variables; ++v) {
+      variables.push_back(model.AddContinuousVariable(0.0, 1.0));
+    }
+    for (int64_t c = 0; c < num_constraints; ++c) {
+      LinearExpression expression;
+      for (int64_t j = matrix.row_starts[c]; j < matrix.row_starts[c + 1];
+           ++j) {
+        expression +=
+            matrix.coefficients[j] * variables[matrix.variable_ids[j]];
+      }
+      model.AddLinearConstraint(expression <= 1.0);
+    }
+    benchmark::DoNotOptimize(model.ExportModel());
+  }
+  state.SetItemsProcessed(state.iterations() * num_constraints *
+                          kTermsPerConstraint);
+}
+
+BENCHMARK(BM_AddLinearConstraint)
+    ->ArgNames({"storage", "num_constraints"})
+    ->ArgsProduct({{static_cast<int>(MatrixStorageMode::kHashMap),
+                    static_cast<int>(MatrixStorageMode::kColumnar)},
+                   {10000, 1000000}});
+
+void BM_AddLinearConstraints(benchmark::State& state) {
+  const auto matrix_storage_mode =
+      static_cast<MatrixStorageMode>(state.range(0));
+  const int64_t num_constraints = state.range(1);
+  const int64_t num_variables = num_constraints;
+  const RandomMatrix matrix = MakeRandomMatrix(num_constraints, num_variables);
+  const std::vector<double> lower_bounds(num_constraints, -kInf);
+  const std::vector<double> upper_bounds(num_constraints, 1.0);
+  for (auto _ : state) {
+    Model model("", matrix_storage_mode);
+    for (int64_t v = 0; v < num_variables; ++v) {
+      model.AddContinuousVariable(0.0, 1.0);
+    }
+    CHECK_OK(model.AddLinearConstraints(lower_bounds, upper_bounds,
+                                        matrix.row_starts, matrix.variable_ids,
+                                        matrix.coefficients));
+    benchmark::DoNotOptimize(model.ExportModel());
+  }
+  state.SetItemsProcessed(state.iterations() * num_constraints *
+                          kTermsPerConstraint);
+}
+
+BENCHMARK(BM_AddLinearConstraints)
+    ->ArgNames({"storage", "num_constraints"})
+    ->ArgsProduct({{static_cast<int>(MatrixStorageMode::kHashMap),
+                    static_cast<int>(MatrixStorageMode::kColumnar)},
+                   {10000, 1000000}});
+
+}  // namespace
+}  // namespace operations_research::math_opt
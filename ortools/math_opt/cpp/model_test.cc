@@ -0,0 +1,307 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/cpp/model.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/math_opt/cpp/linear_constraint.h"
+#include "ortools/math_opt/cpp/variable_and_expressions.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research::math_opt {
+namespace {
+
+using ::testing::EqualsProto;
+using ::testing::HasSubstr;
+using ::testing::status::IsOkAndHolds;
+using ::testing::status::StatusIs;
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Adds a variable to the model and deletes it, returning its id.
+int64_t AddAndDeleteVariable(Model* const model) {
+  const Variable variable = model->AddContinuousVariable(0.0, 1.0, "deleted");
+  model->DeleteVariable(variable);
+  return variable.id();
+}
+
+// Runs each test with both storages of the linear constraint matrix, which
+// AddLinearConstraints() fills differently.
+class BulkLinearConstraintsTest
+    : public ::testing::TestWithParam<MatrixStorageMode> {
+ protected:
+  // Adds variables x and y, a deleted variable, and the constraint
+  // c: 1 <= x + y <= 2.
+  BulkLinearConstraintsTest()
+      : model_("model", GetParam()),
+        x_(model_.AddContinuousVariable(0.0, 1.0, "x")),
+        y_(model_.AddContinuousVariable(0.0, 1.0, "y")),
+        deleted_variable_id_(AddAndDeleteVariable(&model_)),
+        c_(model_.AddLinearConstraint(1.0 <= x_ + y_ <= 2.0, "c")) {}
+
+  // Expects `status` to be an InvalidArgument error containing `message`, and
+  // the model to be unchanged.
+  void ExpectInvalidAndUnchanged(const absl::Status& status,
+                                 const std::string& message,
+                                 const ModelProto& expected_model) {
+    EXPECT_THAT(status, StatusIs(absl::StatusCode::kInvalidArgument,
+                                 HasSubstr(message)));
+    EXPECT_THAT(model_.ExportModel(), EqualsProto(expected_model));
+    EXPECT_EQ(model_.num_linear_constraints(), 1);
+    EXPECT_EQ(model_.next_linear_constraint_id(), 1);
+  }
+
+  Model model_;
+  const Variable x_;
+  const Variable y_;
+  const int64_t deleted_variable_id_;
+  const LinearConstraint c_;
+};
+
+INSTANTIATE_TEST_SUITE_P(AllStorages, BulkLinearConstraintsTest,
+                         ::testing::Values(MatrixStorageMode::kHashMap,
+                                           MatrixStorageMode::kColumnar));
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraints) {
+  // 0 <= x + 2y <= 3, an empty constraint, and -inf <= -y <= 4.
+  ASSERT_THAT(model_.AddLinearConstraints(
+                  /*lower_bounds=*/{0.0, -1.0, -kInf},
+                  /*upper_bounds=*/{3.0, kInf, 4.0},
+                  /*row_starts=*/{0, 2, 2, 3},
+                  /*variable_ids=*/{y_.id(), x_.id(), y_.id()},
+                  /*coefficients=*/{2.0, 1.0, -1.0},
+                  /*names=*/{"a", "b", "d"}),
+              IsOkAndHolds(1));
+  EXPECT_EQ(model_.num_linear_constraints(), 4);
+  EXPECT_EQ(model_.next_linear_constraint_id(), 4);
+  const LinearConstraint a = model_.linear_constraint(1);
+  const LinearConstraint b = model_.linear_constraint(2);
+  const LinearConstraint d = model_.linear_constraint(3);
+  EXPECT_EQ(a.name(), "a");
+  EXPECT_EQ(a.lower_bound(), 0.0);
+  EXPECT_EQ(a.upper_bound(), 3.0);
+  EXPECT_EQ(model_.coefficient(a, x_), 1.0);
+  EXPECT_EQ(model_.coefficient(a, y_), 2.0);
+  EXPECT_EQ(b.name(), "b");
+  EXPECT_EQ(b.lower_bound(), -1.0);
+  EXPECT_EQ(b.upper_bound(), kInf);
+  EXPECT_EQ(model_.coefficient(b, x_), 0.0);
+  EXPECT_EQ(model_.coefficient(b, y_), 0.0);
+  EXPECT_EQ(d.lower_bound(), -kInf);
+  EXPECT_EQ(model_.coefficient(d, x_), 0.0);
+  EXPECT_EQ(model_.coefficient(d, y_), -1.0);
+  // The existing constraint is untouched.
+  EXPECT_EQ(model_.coefficient(c_, x_), 1.0);
+  EXPECT_EQ(model_.coefficient(c_, y_), 1.0);
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsWithoutNames) {
+  ASSERT_THAT(model_.AddLinearConstraints({0.0, 1.0}, {1.0, 2.0}, {0, 1, 2},
+                                          {x_.id(), x_.id()}, {1.0, 0.0}),
+              IsOkAndHolds(1));
+  EXPECT_EQ(model_.linear_constraint(1).name(), "");
+  EXPECT_EQ(model_.coefficient(model_.linear_constraint(1), x_), 1.0);
+  // Explicit zeros are not stored.
+  EXPECT_EQ(model_.coefficient(model_.linear_constraint(2), x_), 0.0);
+  EXPECT_FALSE(model_.linear_constraint(2).is_coefficient_nonzero(x_));
+}
+
+TEST_P(BulkLinearConstraintsTest, AddNoLinearConstraints) {
+  EXPECT_THAT(model_.AddLinearConstraints({}, {}, {0}, {}, {}),
+              IsOkAndHolds(1));
+  EXPECT_EQ(model_.num_linear_constraints(), 1);
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsMismatchedSizes) {
+  const ModelProto expected_model = model_.ExportModel();
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0, 0.0}, {1.0}, {0, 1, 2},
+                                  {x_.id(), y_.id()}, {1.0, 1.0})
+          .status(),
+      "inconsistent sizes", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0}, {1.0}, {0, 1, 2}, {x_.id(), y_.id()},
+                                  {1.0, 1.0})
+          .status(),
+      "inconsistent sizes", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0}, {1.0}, {0, 1}, {x_.id()}, {1.0},
+                                  {"a", "b"})
+          .status(),
+      "inconsistent sizes", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0}, {1.0}, {0, 1}, {x_.id()}, {1.0, 2.0})
+          .status(),
+      "inconsistent sizes", expected_model);
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsInvalidRowStarts) {
+  const ModelProto expected_model = model_.ExportModel();
+  // Does not start at 0.
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0}, {1.0}, {1, 2}, {x_.id(), y_.id()},
+                                  {1.0, 1.0})
+          .status(),
+      "row starts", expected_model);
+  // Does not end at the number of terms.
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0}, {1.0}, {0, 1}, {x_.id(), y_.id()},
+                                  {1.0, 1.0})
+          .status(),
+      "row starts", expected_model);
+  // Decreasing.
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0},
+                                  {0, 2, 1, 2}, {x_.id(), y_.id()}, {1.0, 1.0})
+          .status(),
+      "row starts", expected_model);
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsUnknownVariable) {
+  const ModelProto expected_model = model_.ExportModel();
+  for (const int64_t id : {int64_t{-1}, deleted_variable_id_, int64_t{3}}) {
+    SCOPED_TRACE(id);
+    ExpectInvalidAndUnchanged(
+        model_.AddLinearConstraints({0.0, 0.0}, {1.0, 1.0}, {0, 1, 3},
+                                    {x_.id(), y_.id(), id}, {1.0, 1.0, 1.0})
+            .status(),
+        "variable id", expected_model);
+  }
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsDuplicateVariable) {
+  const ModelProto expected_model = model_.ExportModel();
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0, 0.0}, {1.0, 1.0}, {0, 1, 4},
+                                  {x_.id(), y_.id(), x_.id(), y_.id()},
+                                  {1.0, 1.0, 1.0, 2.0})
+          .status(),
+      "appears twice", expected_model);
+  // The same variable in different rows is fine.
+  EXPECT_THAT(model_.AddLinearConstraints({0.0, 0.0}, {1.0, 1.0}, {0, 1, 2},
+                                          {x_.id(), x_.id()}, {1.0, 1.0}),
+              IsOkAndHolds(1));
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsNonFiniteCoefficient) {
+  const ModelProto expected_model = model_.ExportModel();
+  for (const double coefficient : {kNaN, kInf, -kInf}) {
+    SCOPED_TRACE(coefficient);
+    ExpectInvalidAndUnchanged(
+        model_.AddLinearConstraints({0.0, 0.0}, {1.0, 1.0}, {0, 1, 2},
+                                    {x_.id(), y_.id()}, {1.0, coefficient})
+            .status(),
+        "coefficient at index 1", expected_model);
+  }
+}
+
+TEST_P(BulkLinearConstraintsTest, AddLinearConstraintsInvalidBounds) {
+  const ModelProto expected_model = model_.ExportModel();
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0, kNaN}, {1.0, 1.0}, {0, 1, 2},
+                                  {x_.id(), y_.id()}, {1.0, 1.0})
+          .status(),
+      "lower bound at index 1", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({kInf}, {kInf}, {0, 1}, {x_.id()}, {1.0})
+          .status(),
+      "lower bound at index 0", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({0.0, 0.0}, {1.0, kNaN}, {0, 1, 2},
+                                  {x_.id(), y_.id()}, {1.0, 1.0})
+          .status(),
+      "upper bound at index 1", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.AddLinearConstraints({-kInf}, {-kInf}, {0, 1}, {x_.id()}, {1.0})
+          .status(),
+      "upper bound at index 0", expected_model);
+}
+
+TEST_P(BulkLinearConstraintsTest, SetLinearConstraintCoefficients) {
+  ASSERT_THAT(model_.AddLinearConstraints({0.0}, {1.0}, {0, 1}, {x_.id()},
+                                          {1.0}),
+              IsOkAndHolds(1));
+  const LinearConstraint d = model_.linear_constraint(1);
+  // Overwrites c[x], zeroes c[y], sets d[y] twice (the last value wins), and
+  // sets d[x] to its current value.
+  ASSERT_OK(model_.SetLinearConstraintCoefficients(
+      {c_.id(), c_.id(), d.id(), d.id(), d.id()},
+      {x_.id(), y_.id(), y_.id(), y_.id(), x_.id()},
+      {3.0, 0.0, 4.0, 5.0, 1.0}));
+  EXPECT_EQ(model_.coefficient(c_, x_), 3.0);
+  EXPECT_EQ(model_.coefficient(c_, y_), 0.0);
+  EXPECT_FALSE(c_.is_coefficient_nonzero(y_));
+  EXPECT_EQ(model_.coefficient(d, x_), 1.0);
+  EXPECT_EQ(model_.coefficient(d, y_), 5.0);
+  // Nothing to set.
+  EXPECT_OK(model_.SetLinearConstraintCoefficients({}, {}, {}));
+}
+
+TEST_P(BulkLinearConstraintsTest,
+       SetLinearConstraintCoefficientsMismatchedSizes) {
+  const ModelProto expected_model = model_.ExportModel();
+  ExpectInvalidAndUnchanged(
+      model_.SetLinearConstraintCoefficients({c_.id(), c_.id()}, {x_.id()},
+                                             {1.0, 1.0}),
+      "inconsistent sizes", expected_model);
+  ExpectInvalidAndUnchanged(
+      model_.SetLinearConstraintCoefficients({c_.id()}, {x_.id()}, {1.0, 1.0}),
+      "inconsistent sizes", expected_model);
+}
+
+TEST_P(BulkLinearConstraintsTest, SetLinearConstraintCoefficientsUnknownIds) {
+  const ModelProto expected_model = model_.ExportModel();
+  for (const int64_t id : {int64_t{-1}, deleted_variable_id_, int64_t{3}}) {
+    SCOPED_TRACE(id);
+    ExpectInvalidAndUnchanged(
+        model_.SetLinearConstraintCoefficients(
+            {c_.id(), c_.id()}, {x_.id(), id}, {5.0, 5.0}),
+        "variable id", expected_model);
+  }
+  const LinearConstraint deleted =
+      model_.AddLinearConstraint(x_ <= 1.0, "deleted");
+  model_.DeleteLinearConstraint(deleted);
+  for (const int64_t id : {int64_t{-1}, deleted.id(), int64_t{5}}) {
+    SCOPED_TRACE(id);
+    EXPECT_THAT(model_.SetLinearConstraintCoefficients({c_.id(), id},
+                                                       {x_.id(), y_.id()},
+                                                       {5.0, 5.0}),
+                StatusIs(absl::StatusCode::kInvalidArgument,
+                         HasSubstr("linear constraint id")));
+    EXPECT_THAT(model_.ExportModel(), EqualsProto(expected_model));
+  }
+}
+
+TEST_P(BulkLinearConstraintsTest,
+       SetLinearConstraintCoefficientsNonFiniteCoefficient) {
+  const ModelProto expected_model = model_.ExportModel();
+  for (const double coefficient : {kNaN, kInf, -kInf}) {
+    SCOPED_TRACE(coefficient);
+    ExpectInvalidAndUnchanged(
+        model_.SetLinearConstraintCoefficients(
+            {c_.id(), c_.id()}, {x_.id(), y_.id()}, {5.0, coefficient}),
+        "coefficient at index 1", expected_model);
+  }
+}
+
+}  // namespace
+}  // namespace operations_research::math_opt
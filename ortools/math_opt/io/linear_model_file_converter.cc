@@ -0,0 +1,58 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/io/linear_model_file_converter.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/lp_data/proto_utils.h"
+#include "ortools/math_opt/io/proto_converter.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/util/linear_model_file.h"
+
+namespace operations_research::math_opt {
+
+absl::StatusOr<std::string> ModelProtoToLinearModelFile(
+    const ModelProto& model) {
+  ASSIGN_OR_RETURN(const MPModelProto mp_model_proto,
+                   MathOptModelToMPModelProto(model));
+  ASSIGN_OR_RETURN(const LinearModelArrays arrays,
+                   glop::MPModelProtoToLinearModelArrays(mp_model_proto));
+  return SerializeLinearModel(arrays);
+}
+
+absl::Status WriteLinearModelFile(const ModelProto& model,
+                                  const absl::string_view filename) {
+  ASSIGN_OR_RETURN(const MPModelProto mp_model_proto,
+                   MathOptModelToMPModelProto(model));
+  ASSIGN_OR_RETURN(const LinearModelArrays arrays,
+                   glop::MPModelProtoToLinearModelArrays(mp_model_proto));
+  return ::operations_research::WriteLinearModelFile(arrays, filename);
+}
+
+absl::StatusOr<ModelProto> ReadLinearModelFile(
+    const absl::string_view filename) {
+  ASSIGN_OR_RETURN(const std::unique_ptr<LinearModelFile> file,
+                   LinearModelFile::Open(filename));
+  MPModelProto mp_model;
+  glop::LinearModelViewToMPModelProto(file->view(), &mp_model);
+  return MPModelProtoToMathOptModel(mp_model);
+}
+
+}  // namespace operations_research::math_opt
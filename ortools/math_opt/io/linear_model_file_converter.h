@@ -0,0 +1,42 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_MATH_OPT_IO_LINEAR_MODEL_FILE_CONVERTER_H_
+#define OR_TOOLS_MATH_OPT_IO_LINEAR_MODEL_FILE_CONVERTER_H_
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "ortools/math_opt/model.pb.h"
+
+namespace operations_research::math_opt {
+
+// Returns the model in the linear model file format, a compact binary format
+// which is memory-mapped when read (see ortools/util/linear_model_file.h).
+//
+// Only linear and mixed-integer linear models are supported.
+absl::StatusOr<std::string> ModelProtoToLinearModelFile(
+    const ModelProto& model);
+
+// Writes the model in the linear model file format to the given file.
+absl::Status WriteLinearModelFile(const ModelProto& model,
+                                  absl::string_view filename);
+
+// Reads a linear model file and converts it to a ModelProto.
+absl::StatusOr<ModelProto> ReadLinearModelFile(absl::string_view filename);
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_IO_LINEAR_MODEL_FILE_CONVERTER_H_
@@ -0,0 +1,138 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/io/linear_model_file_converter.h"
+
+#include <string>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_text_proto.h"
+#include "ortools/base/path.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/sparse_containers.pb.h"
+
+namespace operations_research::math_opt {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTextOrDie;
+using ::testing::EqualsProto;
+using ::testing::HasSubstr;
+using ::testing::status::StatusIs;
+
+std::string TestFile(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+// A model with every field supported by linear model files.
+ModelProto TestModel() {
+  return ParseTextOrDie<ModelProto>(R"pb(
+    name: "test"
+    variables {
+      ids: [ 0, 1, 2 ]
+      lower_bounds: [ 0, -inf, -1 ]
+      upper_bounds: [ 10, inf, 2.5 ]
+      integers: [ true, false, false ]
+      names: [ "x", "y", "z" ]
+    }
+    objective {
+      maximize: true
+      offset: 1.5
+      linear_coefficients {
+        ids: [ 0, 2 ]
+        values: [ 1, -2 ]
+      }
+    }
+    linear_constraints {
+      ids: [ 0, 1 ]
+      lower_bounds: [ -inf, 2 ]
+      upper_bounds: [ 4, 2 ]
+      names: [ "c0", "c1" ]
+    }
+    linear_constraint_matrix {
+      row_ids: [ 0, 0, 1 ]
+      column_ids: [ 0, 2, 1 ]
+      coefficients: [ 3, 1, 0.5 ]
+    }
+  )pb");
+}
+
+TEST(LinearModelFileConverterTest, RoundTrip) {
+  const ModelProto model = TestModel();
+  const std::string filename = TestFile("round_trip.lmf");
+  ASSERT_TRUE(WriteLinearModelFile(model, filename).ok());
+  const absl::StatusOr<ModelProto> read_model = ReadLinearModelFile(filename);
+  ASSERT_TRUE(read_model.ok()) << read_model.status();
+  EXPECT_THAT(*read_model, EqualsProto(model));
+
+  const absl::StatusOr<std::string> data = ModelProtoToLinearModelFile(model);
+  ASSERT_TRUE(data.ok()) << data.status();
+  std::string file_data;
+  CHECK_OK(file::GetContents(filename, &file_data, file::Defaults()));
+  EXPECT_EQ(*data, file_data);
+}
+
+TEST(LinearModelFileConverterTest, RoundTripWithoutNames) {
+  ModelProto model = TestModel();
+  model.clear_name();
+  model.mutable_variables()->clear_names();
+  model.mutable_linear_constraints()->clear_names();
+  const std::string filename = TestFile("round_trip_without_names.lmf");
+  ASSERT_TRUE(WriteLinearModelFile(model, filename).ok());
+  const absl::StatusOr<ModelProto> read_model = ReadLinearModelFile(filename);
+  ASSERT_TRUE(read_model.ok()) << read_model.status();
+  EXPECT_THAT(*read_model, EqualsProto(model));
+}
+
+// The conversion from MPModelProto always sets the sub-messages.
+TEST(LinearModelFileConverterTest, EmptyModel) {
+  const std::string filename = TestFile("empty.lmf");
+  ASSERT_TRUE(WriteLinearModelFile(ModelProto(), filename).ok());
+  const absl::StatusOr<ModelProto> read_model = ReadLinearModelFile(filename);
+  ASSERT_TRUE(read_model.ok()) << read_model.status();
+  EXPECT_THAT(*read_model, EqualsProto(ParseTextOrDie<ModelProto>(R"pb(
+                variables {}
+                objective {}
+                linear_constraints {}
+                linear_constraint_matrix {}
+              )pb")));
+}
+
+TEST(LinearModelFileConverterTest, QuadraticObjectiveIsRejected) {
+  ModelProto model = TestModel();
+  SparseDoubleMatrixProto& quadratic =
+      *model.mutable_objective()->mutable_quadratic_coefficients();
+  quadratic.add_row_ids(0);
+  quadratic.add_column_ids(0);
+  quadratic.add_coefficients(1.0);
+  EXPECT_THAT(ModelProtoToLinearModelFile(model),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Quadratic objectives")));
+  EXPECT_THAT(WriteLinearModelFile(model, TestFile("quadratic.lmf")),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Quadratic objectives")));
+}
+
+TEST(LinearModelFileConverterTest, ReadInvalidFile) {
+  const std::string filename = TestFile("invalid.lmf");
+  CHECK_OK(file::SetContents(filename, "variables {}", file::Defaults()));
+  EXPECT_FALSE(ReadLinearModelFile(filename).ok());
+  EXPECT_FALSE(ReadLinearModelFile(TestFile("missing.lmf")).ok());
+}
+
+}  // namespace
+}  // namespace operations_research::math_opt
@@ -0,0 +1,194 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/ipc/proto_connection.h"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/message.h"
+#include "ortools/base/status_macros.h"
+
+namespace operations_research {
+namespace math_opt {
+
+namespace {
+
+constexpr int kSizeBytes = sizeof(uint64_t);
+
+// The send() flags, to avoid SIGPIPE when the peer has closed the socket.
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+absl::Status WriteAll(const int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = send(fd, data, size, kSendFlags);
+    if (written < 0 && errno == ENOTSOCK) {
+      written = write(fd, data, size);
+    }
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return absl::ErrnoToStatus(errno, "failed to send message");
+    }
+    data += written;
+    size -= written;
+  }
+  return absl::OkStatus();
+}
+
+// Returns the number of bytes read, which is smaller than `size` only if the
+// end of the input is reached.
+absl::StatusOr<size_t> ReadAll(const int fd, char* const data,
+                               const size_t size) {
+  size_t total = 0;
+  while (total < size) {
+    const ssize_t read_bytes = read(fd, data + total, size - total);
+    if (read_bytes < 0) {
+      if (errno == EINTR) continue;
+      return absl::ErrnoToStatus(errno, "failed to receive message");
+    }
+    if (read_bytes == 0) break;
+    total += read_bytes;
+  }
+  return total;
+}
+
+absl::StatusOr<sockaddr_un> UnixSocketAddress(const absl::string_view path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("invalid Unix socket path: \"", path, "\""));
+  }
+  path.copy(address.sun_path, path.size());
+  return address;
+}
+
+}  // namespace
+
+ProtoConnection::ProtoConnection(const int input_fd, const int output_fd)
+    : input_fd_(input_fd), output_fd_(output_fd) {}
+
+ProtoConnection::ProtoConnection(const int fd) : ProtoConnection(fd, fd) {}
+
+ProtoConnection::~ProtoConnection() {
+  close(input_fd_);
+  if (output_fd_ != input_fd_) {
+    close(output_fd_);
+  }
+}
+
+absl::Status ProtoConnection::Send(const google::protobuf::Message& message) {
+  std::string buffer(kSizeBytes, '\0');
+  if (!message.AppendToString(&buffer)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("failed to serialize ", message.GetTypeName()));
+  }
+  const uint64_t size = buffer.size() - kSizeBytes;
+  for (int i = 0; i < kSizeBytes; ++i) {
+    buffer[i] = static_cast<char>((size >> (8 * i)) & 0xff);
+  }
+  return WriteAll(output_fd_, buffer.data(), buffer.size());
+}
+
+absl::StatusOr<bool> ProtoConnection::Receive(
+    google::protobuf::Message& message) {
+  char header[kSizeBytes];
+  ASSIGN_OR_RETURN(const size_t header_bytes,
+                   ReadAll(input_fd_, header, kSizeBytes));
+  if (header_bytes == 0) {
+    return false;
+  }
+  if (header_bytes < kSizeBytes) {
+    return absl::DataLossError("connection closed in a message size");
+  }
+  uint64_t size = 0;
+  for (int i = 0; i < kSizeBytes; ++i) {
+    size |= static_cast<uint64_t>(static_cast<unsigned char>(header[i]))
+            << (8 * i);
+  }
+  // Serialized protocol buffers are smaller than 2GiB.
+  if (size > std::numeric_limits<int32_t>::max()) {
+    return absl::DataLossError(
+        absl::StrCat("invalid message size: ", size, " bytes"));
+  }
+  std::string buffer(size, '\0');
+  ASSIGN_OR_RETURN(const size_t read_bytes,
+                   ReadAll(input_fd_, buffer.data(), size));
+  if (read_bytes < size) {
+    return absl::DataLossError(absl::StrCat(
+        "connection closed after ", read_bytes, " of the ", size,
+        " bytes of a message"));
+  }
+  if (!message.ParseFromString(buffer)) {
+    return absl::DataLossError(
+        absl::StrCat("failed to parse ", message.GetTypeName()));
+  }
+  return true;
+}
+
+absl::StatusOr<std::unique_ptr<ProtoConnection>> ConnectToUnixSocket(
+    const absl::string_view path) {
+  ASSIGN_OR_RETURN(const sockaddr_un address, UnixSocketAddress(path));
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, "failed to create socket");
+  }
+  if (connect(fd, reinterpret_cast<const sockaddr*>(&address),
+              sizeof(address)) != 0) {
+    const int error = errno;
+    close(fd);
+    return absl::ErrnoToStatus(error, absl::StrCat("failed to connect to \"",
+                                                   path, "\""));
+  }
+  return std::make_unique<ProtoConnection>(fd);
+}
+
+absl::StatusOr<int> ListenOnUnixSocket(const absl::string_view path) {
+  ASSIGN_OR_RETURN(const sockaddr_un address, UnixSocketAddress(path));
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, "failed to create socket");
+  }
+  unlink(address.sun_path);
+  if (bind(fd, reinterpret_cast<const sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      listen(fd, SOMAXCONN) != 0) {
+    const int error = errno;
+    close(fd);
+    return absl::ErrnoToStatus(error,
+                               absl::StrCat("failed to listen on \"", path,
+                                            "\""));
+  }
+  return fd;
+}
+
+}  // namespace math_opt
+}  // namespace operations_research
@@ -0,0 +1,81 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Exchange of protocol buffers with another process, over a Unix domain socket
+// or a pair of pipes.
+//
+// Each message is sent as its size in bytes, as a little-endian 64-bit
+// integer, followed by its serialization.
+
+#ifndef OR_TOOLS_MATH_OPT_IPC_PROTO_CONNECTION_H_
+#define OR_TOOLS_MATH_OPT_IPC_PROTO_CONNECTION_H_
+
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/message.h"
+
+namespace operations_research {
+namespace math_opt {
+
+// A connection to another process, on which messages are read from one file
+// descriptor and written to another one (which can be the same).
+//
+// Thread-safety: Send() and Receive() can be called concurrently, but each of
+// them must not be called concurrently with itself.
+class ProtoConnection {
+ public:
+  // Takes ownership of the file descriptors, for example the read end of a pipe
+  // and the write end of another one.
+  ProtoConnection(int input_fd, int output_fd);
+
+  // Takes ownership of `fd`, a bidirectional file descriptor like a socket.
+  explicit ProtoConnection(int fd);
+
+  ProtoConnection(const ProtoConnection&) = delete;
+  ProtoConnection& operator=(const ProtoConnection&) = delete;
+
+  // Closes the file descriptors.
+  ~ProtoConnection();
+
+  // Writes `message` on the output file descriptor.
+  //
+  // When the peer has closed the connection, returns an error instead of
+  // raising SIGPIPE if the output is a socket.
+  absl::Status Send(const google::protobuf::Message& message);
+
+  // Reads the next message from the input file descriptor into `message`.
+  // Returns false if the peer closed the connection before sending a new
+  // message, and an error if it was closed in the middle of one.
+  absl::StatusOr<bool> Receive(google::protobuf::Message& message);
+
+ private:
+  const int input_fd_;
+  const int output_fd_;
+};
+
+// Returns a connection to the server listening on the Unix domain socket at
+// `path`.
+absl::StatusOr<std::unique_ptr<ProtoConnection>> ConnectToUnixSocket(
+    absl::string_view path);
+
+// Returns a socket listening on `path`, to be used with accept(). Removes any
+// previous file at `path`.
+absl::StatusOr<int> ListenOnUnixSocket(absl::string_view path);
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_IPC_PROTO_CONNECTION_H_
@@ -0,0 +1,132 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/ipc/stream_solve_client.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/math_opt/cpp/enums.h"
+#include "ortools/math_opt/cpp/model.h"
+#include "ortools/math_opt/cpp/parameters.h"
+#include "ortools/math_opt/cpp/solve_arguments.h"
+#include "ortools/math_opt/cpp/solve_result.h"
+#include "ortools/math_opt/cpp/solver_init_arguments.h"
+#include "ortools/math_opt/cpp/update_tracker.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/rpc.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research {
+namespace math_opt {
+
+absl::StatusOr<std::unique_ptr<StreamSolveClient>> StreamSolveClient::New(
+    Model* const model, const SolverType solver_type,
+    std::unique_ptr<ProtoConnection> connection,
+    SolverInitArguments arguments) {
+  if (model == nullptr) {
+    return absl::InvalidArgumentError("input model can't be null");
+  }
+  if (connection == nullptr) {
+    return absl::InvalidArgumentError("input connection can't be null");
+  }
+  if (arguments.non_streamable.get() != nullptr) {
+    return absl::InvalidArgumentError(
+        "non_streamable init arguments are not supported by remote solves");
+  }
+  return absl::WrapUnique<StreamSolveClient>(new StreamSolveClient(
+      solver_type, std::move(arguments), model->storage(),
+      model->NewUpdateTracker(), std::move(connection)));
+}
+
+StreamSolveClient::StreamSolveClient(
+    const SolverType solver_type, SolverInitArguments init_args,
+    const ModelStorage* const expected_storage,
+    std::unique_ptr<UpdateTracker> update_tracker,
+    std::unique_ptr<ProtoConnection> connection)
+    : solver_type_(solver_type),
+      init_args_(std::move(init_args)),
+      expected_storage_(expected_storage),
+      update_tracker_(std::move(update_tracker)),
+      connection_(std::move(connection)) {}
+
+absl::StatusOr<SolveResult> StreamSolveClient::Solve(
+    const SolveArguments& arguments) {
+  if (failed_) {
+    return absl::FailedPreconditionError(
+        "the stream was closed by a previous error");
+  }
+  RETURN_IF_ERROR(arguments.CheckModelStorageAndCallback(expected_storage_));
+  if (arguments.callback != nullptr) {
+    return absl::InvalidArgumentError(
+        "callbacks are not supported by remote solves");
+  }
+  if (arguments.interrupter != nullptr) {
+    return absl::InvalidArgumentError(
+        "interrupters are not supported by remote solves");
+  }
+
+  StreamSolveRequest request;
+  if (first_request_) {
+    request.set_solver_type(EnumToProto(solver_type_));
+    ASSIGN_OR_RETURN(*request.mutable_model(),
+                     update_tracker_->ExportModel(init_args_.remove_names));
+    *request.mutable_initializer() = init_args_.streamable.Proto();
+  } else {
+    ASSIGN_OR_RETURN(
+        std::optional<ModelUpdateProto> model_update,
+        update_tracker_->ExportModelUpdate(init_args_.remove_names));
+    if (model_update.has_value()) {
+      *request.mutable_model_update() = *std::move(model_update);
+    }
+  }
+  *request.mutable_parameters() = arguments.parameters.Proto();
+  *request.mutable_model_parameters() = arguments.model_parameters.Proto();
+  if (arguments.message_callback != nullptr) {
+    request.mutable_parameters()->set_enable_output(true);
+  }
+
+  // From now on the client and the server may disagree on the model, so any
+  // error closes the stream.
+  failed_ = true;
+  RETURN_IF_ERROR(update_tracker_->AdvanceCheckpoint());
+  first_request_ = false;
+  RETURN_IF_ERROR(connection_->Send(request));
+  StreamSolveResponse response;
+  ASSIGN_OR_RETURN(const bool received, connection_->Receive(response));
+  if (!received) {
+    return absl::UnavailableError("the server closed the connection");
+  }
+  if (response.status_code() != static_cast<int>(absl::StatusCode::kOk)) {
+    return absl::Status(static_cast<absl::StatusCode>(response.status_code()),
+                        response.status_message());
+  }
+  failed_ = false;
+
+  if (arguments.message_callback != nullptr) {
+    arguments.message_callback(std::vector<std::string>(
+        response.messages().begin(), response.messages().end()));
+  }
+  return SolveResult::FromProto(expected_storage_, response.result());
+}
+
+}  // namespace math_opt
+}  // namespace operations_research
@@ -0,0 +1,104 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Client side of the streaming solves of rpc.proto, on a local connection.
+
+#ifndef OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_CLIENT_H_
+#define OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_CLIENT_H_
+
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "ortools/math_opt/cpp/model.h"
+#include "ortools/math_opt/cpp/parameters.h"
+#include "ortools/math_opt/cpp/solve_arguments.h"
+#include "ortools/math_opt/cpp/solve_result.h"
+#include "ortools/math_opt/cpp/solver_init_arguments.h"
+#include "ortools/math_opt/cpp/update_tracker.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research {
+namespace math_opt {
+
+// Solves a model in another process, with a server using ServeStreamSolve()
+// (see stream_solve_server.h), for example math_opt/tools:mathopt_solve_server.
+//
+// Like IncrementalSolver, it keeps track of the changes of the model: the first
+// solve sends the whole model to the server, and the following ones only send
+// the changes since the previous solve. The server keeps the solver between
+// solves.
+//
+// Usage:
+//   Model model;
+//   const Variable x = model.AddContinuousVariable(0.0, 1.0, "x");
+//   model.Maximize(x);
+//
+//   ASSIGN_OR_RETURN(std::unique_ptr<ProtoConnection> connection,
+//                    ConnectToUnixSocket("/tmp/mathopt_solve_server"));
+//   ASSIGN_OR_RETURN(
+//       const std::unique_ptr<StreamSolveClient> solver,
+//       StreamSolveClient::New(&model, SolverType::kGlop,
+//                              std::move(connection)));
+//   ASSIGN_OR_RETURN(const SolveResult result1, solver->Solve());
+//
+//   model.set_upper_bound(x, 2.0);
+//   ASSIGN_OR_RETURN(const SolveResult result2, solver->Solve());
+class StreamSolveClient {
+ public:
+  // Returns a client solving `model` with a new solver of the server at the
+  // other end of `connection`. Nothing is sent before the first solve.
+  //
+  // Returns an error if arguments.non_streamable is set, since it can't be sent
+  // to another process.
+  static absl::StatusOr<std::unique_ptr<StreamSolveClient>> New(
+      Model* model, SolverType solver_type,
+      std::unique_ptr<ProtoConnection> connection,
+      SolverInitArguments arguments = {});
+
+  // Sends the latest changes of the model to the server, solves and waits for
+  // the result.
+  //
+  // The `callback` and `interrupter` arguments are not supported. The messages
+  // of the solver are only passed to `message_callback` at the end of the
+  // solve.
+  //
+  // After an error on the server or on the connection, the server closes the
+  // stream and all the following calls return an error.
+  absl::StatusOr<SolveResult> Solve(const SolveArguments& arguments = {});
+
+  SolverType solver_type() const { return solver_type_; }
+
+ private:
+  StreamSolveClient(SolverType solver_type, SolverInitArguments init_args,
+                    const ModelStorage* expected_storage,
+                    std::unique_ptr<UpdateTracker> update_tracker,
+                    std::unique_ptr<ProtoConnection> connection);
+
+  const SolverType solver_type_;
+  const SolverInitArguments init_args_;
+  const ModelStorage* const expected_storage_;
+  const std::unique_ptr<UpdateTracker> update_tracker_;
+  const std::unique_ptr<ProtoConnection> connection_;
+
+  // True before the first request, which contains the whole model.
+  bool first_request_ = true;
+
+  // Set when the stream was closed by an error.
+  bool failed_ = false;
+};
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_CLIENT_H_
@@ -0,0 +1,155 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/ipc/stream_solve_server.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+#include "ortools/math_opt/parameters.pb.h"
+#include "ortools/math_opt/rpc.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research {
+namespace math_opt {
+
+namespace {
+
+// The state of a stream between two requests.
+class StreamSolveSession {
+ public:
+  // Applies the model or the model update of `request` and solves.
+  absl::StatusOr<StreamSolveResponse> Solve(StreamSolveRequest request);
+
+ private:
+  // Creates the solver from the first request of the stream.
+  absl::Status Initialize(const StreamSolveRequest& request);
+
+  // Applies `model_update` to the model and the solver. Returns false if the
+  // solver had to be recreated.
+  absl::StatusOr<bool> Update(const ModelUpdateProto& model_update);
+
+  SolverTypeProto solver_type_ = SOLVER_TYPE_UNSPECIFIED;
+  Solver::InitArgs init_args_;
+
+  // A copy of the model of the solver, used to recreate it when it does not
+  // support an update.
+  std::unique_ptr<ModelStorage> model_;
+
+  // Only nullptr before the first request.
+  std::unique_ptr<Solver> solver_;
+};
+
+absl::Status StreamSolveSession::Initialize(
+    const StreamSolveRequest& request) {
+  if (!request.has_model()) {
+    return absl::InvalidArgumentError(
+        "the first request of a stream must contain a model");
+  }
+  if (request.has_model_update()) {
+    return absl::InvalidArgumentError(
+        "the first request of a stream can't contain a model_update");
+  }
+  solver_type_ = request.solver_type();
+  init_args_.streamable = request.initializer();
+  ASSIGN_OR_RETURN(model_, ModelStorage::FromModelProto(request.model()));
+  ASSIGN_OR_RETURN(solver_,
+                   Solver::New(solver_type_, request.model(), init_args_));
+  return absl::OkStatus();
+}
+
+absl::StatusOr<bool> StreamSolveSession::Update(
+    const ModelUpdateProto& model_update) {
+  RETURN_IF_ERROR(model_->ApplyUpdateProto(model_update))
+      << "invalid model_update";
+  ASSIGN_OR_RETURN(const bool did_update, solver_->Update(model_update));
+  if (did_update) {
+    return true;
+  }
+  ASSIGN_OR_RETURN(solver_, Solver::New(solver_type_, model_->ExportModel(),
+                                        init_args_));
+  return false;
+}
+
+absl::StatusOr<StreamSolveResponse> StreamSolveSession::Solve(
+    StreamSolveRequest request) {
+  StreamSolveResponse response;
+  response.set_did_update(true);
+  if (solver_ == nullptr) {
+    RETURN_IF_ERROR(Initialize(request));
+  } else {
+    if (request.has_model() ||
+        request.solver_type() != SOLVER_TYPE_UNSPECIFIED ||
+        request.has_initializer()) {
+      return absl::InvalidArgumentError(
+          "only the first request of a stream can contain a model, a "
+          "solver_type or an initializer");
+    }
+    if (request.has_model_update()) {
+      ASSIGN_OR_RETURN(const bool did_update, Update(request.model_update()));
+      response.set_did_update(did_update);
+    }
+  }
+
+  absl::Mutex mutex;
+  Solver::SolveArgs solve_args = {
+      .parameters = std::move(*request.mutable_parameters()),
+      .model_parameters = std::move(*request.mutable_model_parameters()),
+  };
+  if (solve_args.parameters.enable_output()) {
+    solve_args.message_callback =
+        [&](const std::vector<std::string>& messages) {
+          const absl::MutexLock lock(&mutex);
+          for (const std::string& message : messages) {
+            response.add_messages(message);
+          }
+        };
+  }
+  ASSIGN_OR_RETURN(*response.mutable_result(), solver_->Solve(solve_args));
+  return response;
+}
+
+}  // namespace
+
+absl::Status ServeStreamSolve(ProtoConnection& connection) {
+  StreamSolveSession session;
+  while (true) {
+    StreamSolveRequest request;
+    ASSIGN_OR_RETURN(const bool received, connection.Receive(request));
+    if (!received) {
+      return absl::OkStatus();
+    }
+    absl::StatusOr<StreamSolveResponse> response =
+        session.Solve(std::move(request));
+    if (!response.ok()) {
+      StreamSolveResponse error_response;
+      error_response.set_status_code(
+          static_cast<int>(response.status().code()));
+      error_response.set_status_message(response.status().message());
+      RETURN_IF_ERROR(connection.Send(error_response));
+      return response.status();
+    }
+    RETURN_IF_ERROR(connection.Send(*response));
+  }
+}
+
+}  // namespace math_opt
+}  // namespace operations_research
@@ -0,0 +1,50 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Server side of the streaming solves of rpc.proto, on a local connection.
+//
+// The server keeps one solver per stream, so that the client only sends the
+// changes of its model between two solves and the solver can reuse its state
+// (for example a basis) when it supports incremental updates. Running solvers
+// in a separate process also isolates their crashes and memory from the
+// client.
+//
+// See stream_solve_client.h for the client side and
+// math_opt/tools/mathopt_solve_server_main.cc for the server executable.
+
+#ifndef OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_SERVER_H_
+#define OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_SERVER_H_
+
+#include "absl/status/status.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+
+namespace operations_research {
+namespace math_opt {
+
+// Serves one stream: receives StreamSolveRequest messages on `connection` and
+// sends a StreamSolveResponse for each of them, until the client closes the
+// connection.
+//
+// The first request creates the solver, which is then updated by the
+// following ones. When the solver does not support an update, it is recreated
+// from a copy of the updated model kept by the server.
+//
+// When a request fails, its response contains the error and this function
+// returns it without reading more requests. It also returns an error if the
+// connection fails.
+absl::Status ServeStreamSolve(ProtoConnection& connection);
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_IPC_STREAM_SOLVE_SERVER_H_
@@ -0,0 +1,203 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/socket.h>
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/math_opt/cpp/matchers.h"
+#include "ortools/math_opt/cpp/math_opt.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+#include "ortools/math_opt/ipc/stream_solve_client.h"
+#include "ortools/math_opt/ipc/stream_solve_server.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/rpc.pb.h"
+
+namespace operations_research {
+namespace math_opt {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::testing::status::IsOkAndHolds;
+using ::testing::status::StatusIs;
+
+// Runs ServeStreamSolve() in a thread, on one end of a socket pair. The server
+// closes its end when ServeStreamSolve() returns.
+class StreamSolveTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    client_connection_ = std::make_unique<ProtoConnection>(fds[0]);
+    server_connection_ = std::make_unique<ProtoConnection>(fds[1]);
+    server_thread_ = std::thread([&]() {
+      server_status_ = ServeStreamSolve(*server_connection_);
+      server_connection_.reset();
+    });
+  }
+
+  // Closes the client end of the socket pair, which stops the server.
+  void StopServer() {
+    client_connection_.reset();
+    if (server_thread_.joinable()) {
+      server_thread_.join();
+    }
+  }
+
+  void TearDown() override { StopServer(); }
+
+  std::unique_ptr<ProtoConnection> client_connection_;
+  std::unique_ptr<ProtoConnection> server_connection_;
+  std::thread server_thread_;
+  absl::Status server_status_;
+};
+
+TEST_F(StreamSolveTest, SolvesUpdatedModel) {
+  Model model;
+  const Variable x = model.AddContinuousVariable(0.0, 1.0, "x");
+  const Variable y = model.AddContinuousVariable(0.0, 2.0, "y");
+  model.AddLinearConstraint(x + y <= 2.5);
+  model.Maximize(x + 2 * y);
+  ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<StreamSolveClient> solver,
+      StreamSolveClient::New(&model, SolverType::kGlop,
+                             std::move(client_connection_)));
+  EXPECT_THAT(solver->Solve(),
+              IsOkAndHolds(IsOptimalWithSolution(4.5, {{x, 0.5}, {y, 2.0}})));
+
+  model.set_upper_bound(y, 1.0);
+  EXPECT_THAT(solver->Solve(),
+              IsOkAndHolds(IsOptimalWithSolution(3.0, {{x, 1.0}, {y, 1.0}})));
+
+  const Variable z = model.AddContinuousVariable(0.0, 1.0, "z");
+  model.set_objective_coefficient(z, 3.0);
+  model.DeleteVariable(x);
+  EXPECT_THAT(solver->Solve(),
+              IsOkAndHolds(IsOptimalWithSolution(5.0, {{y, 1.0}, {z, 1.0}})));
+
+  // A solve without changes sends an empty update.
+  EXPECT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(5.0)));
+  solver.reset();
+  StopServer();
+  EXPECT_OK(server_status_);
+}
+
+TEST_F(StreamSolveTest, ForwardsMessages) {
+  Model model;
+  const Variable x = model.AddContinuousVariable(0.0, 1.0, "x");
+  model.Maximize(x);
+  ASSERT_OK_AND_ASSIGN(
+      const std::unique_ptr<StreamSolveClient> solver,
+      StreamSolveClient::New(&model, SolverType::kGlop,
+                             std::move(client_connection_)));
+  std::vector<std::string> messages;
+  EXPECT_THAT(solver->Solve({.message_callback =
+                                 [&](const std::vector<std::string>& lines) {
+                                   messages.insert(messages.end(),
+                                                   lines.begin(), lines.end());
+                                 }}),
+              IsOkAndHolds(IsOptimal(1.0)));
+  EXPECT_THAT(messages, Not(IsEmpty()));
+}
+
+TEST_F(StreamSolveTest, RejectsCallbacks) {
+  Model model;
+  model.AddContinuousVariable(0.0, 1.0, "x");
+  ASSERT_OK_AND_ASSIGN(
+      const std::unique_ptr<StreamSolveClient> solver,
+      StreamSolveClient::New(&model, SolverType::kGlop,
+                             std::move(client_connection_)));
+  EXPECT_THAT(
+      solver->Solve({.callback = [](const CallbackData&) {
+        return CallbackResult();
+      }}),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("callbacks")));
+  // The stream is still usable since nothing was sent.
+  EXPECT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(0.0)));
+}
+
+TEST_F(StreamSolveTest, RecreatesSolverOnUnsupportedUpdate) {
+  Model model;
+  const Variable x = model.AddContinuousVariable(0.0, 1.0, "x");
+  model.Maximize(x);
+  StreamSolveRequest request;
+  request.set_solver_type(SOLVER_TYPE_PDLP);
+  *request.mutable_model() = model.ExportModel();
+  ASSERT_OK(client_connection_->Send(request));
+  StreamSolveResponse response;
+  ASSERT_THAT(client_connection_->Receive(response), IsOkAndHolds(true));
+  EXPECT_EQ(response.status_code(), 0) << response.status_message();
+  EXPECT_TRUE(response.did_update());
+
+  // PDLP supports bound changes, but not new variables.
+  request.Clear();
+  request.mutable_model_update()
+      ->mutable_variable_updates()
+      ->mutable_upper_bounds()
+      ->add_ids(x.id());
+  request.mutable_model_update()
+      ->mutable_variable_updates()
+      ->mutable_upper_bounds()
+      ->add_values(2.0);
+  ASSERT_OK(client_connection_->Send(request));
+  ASSERT_THAT(client_connection_->Receive(response), IsOkAndHolds(true));
+  EXPECT_EQ(response.status_code(), 0) << response.status_message();
+  EXPECT_TRUE(response.did_update());
+
+  request.Clear();
+  VariablesProto& new_variables =
+      *request.mutable_model_update()->mutable_new_variables();
+  new_variables.add_ids(x.id() + 1);
+  new_variables.add_lower_bounds(0.0);
+  new_variables.add_upper_bounds(1.0);
+  new_variables.add_integers(false);
+  new_variables.add_names("y");
+  ASSERT_OK(client_connection_->Send(request));
+  ASSERT_THAT(client_connection_->Receive(response), IsOkAndHolds(true));
+  EXPECT_EQ(response.status_code(), 0) << response.status_message();
+  EXPECT_FALSE(response.did_update());
+  EXPECT_EQ(response.result().termination().reason(),
+            TERMINATION_REASON_OPTIMAL);
+  EXPECT_NEAR(
+      response.result().termination().objective_bounds().primal_bound(), 2.0,
+      1e-4);
+}
+
+TEST_F(StreamSolveTest, FirstRequestWithoutModel) {
+  StreamSolveRequest request;
+  request.set_solver_type(SOLVER_TYPE_GLOP);
+  ASSERT_OK(client_connection_->Send(request));
+  StreamSolveResponse response;
+  ASSERT_THAT(client_connection_->Receive(response), IsOkAndHolds(true));
+  EXPECT_EQ(response.status_code(),
+            static_cast<int>(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(response.status_message(), HasSubstr("must contain a model"));
+
+  // The server closes the stream after an error.
+  EXPECT_THAT(client_connection_->Receive(response), IsOkAndHolds(false));
+  StopServer();
+  EXPECT_THAT(server_status_, StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace math_opt
+}  // namespace operations_research
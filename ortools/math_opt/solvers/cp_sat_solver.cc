@@ -14,14 +14,18 @@
 #include "ortools/math_opt/solvers/cp_sat_solver.h"
 
 #include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/memory/memory.h"
@@ -35,6 +39,7 @@
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "google/protobuf/repeated_ptr_field.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/protoutil.h"
 #include "ortools/base/status_macros.h"
@@ -102,6 +107,50 @@ bool ApplyCutoff(const double cutoff, MPModelProto* model) {
   return true;
 }
 
+// Removes from `ids` and `elements` the entries whose id is in the sorted
+// `deleted_ids`, preserving the order of the others. Returns the new index of
+// each of the original entries, -1 for the deleted ones.
+template <typename T>
+std::vector<int> DeleteEntries(
+    const absl::Span<const int64_t> deleted_ids, std::vector<int64_t>& ids,
+    google::protobuf::RepeatedPtrField<T>& elements) {
+  DCHECK_EQ(ids.size(), elements.size());
+  std::vector<int> new_indices(ids.size(), -1);
+  auto deleted_it = deleted_ids.begin();
+  int num_kept = 0;
+  for (int i = 0; i < ids.size(); ++i) {
+    if (deleted_it != deleted_ids.end() && *deleted_it == ids[i]) {
+      ++deleted_it;
+      continue;
+    }
+    new_indices[i] = num_kept;
+    if (num_kept != i) {
+      ids[num_kept] = ids[i];
+      elements.SwapElements(num_kept, i);
+    }
+    ++num_kept;
+  }
+  DCHECK(deleted_it == deleted_ids.end());
+  ids.resize(num_kept);
+  elements.DeleteSubrange(num_kept, elements.size() - num_kept);
+  return new_indices;
+}
+
+// Removes the terms of `constraint` whose coefficient is zero.
+void RemoveZeroTerms(MPConstraintProto& constraint) {
+  int num_kept = 0;
+  for (int k = 0; k < constraint.var_index_size(); ++k) {
+    if (constraint.coefficient(k) == 0.0) {
+      continue;
+    }
+    constraint.set_var_index(num_kept, constraint.var_index(k));
+    constraint.set_coefficient(num_kept, constraint.coefficient(k));
+    ++num_kept;
+  }
+  constraint.mutable_var_index()->Truncate(num_kept);
+  constraint.mutable_coefficient()->Truncate(num_kept);
+}
+
 // Returns a list of warnings from parameter settings that were
 // invalid/unsupported (specific to CP-SAT), one element per bad parameter.
 std::vector<std::string> SetSolveParameters(
@@ -387,6 +436,16 @@ absl::StatusOr<SolveResultProto> CpSatSolver::Solve(
       req.mutable_model()->mutable_solution_hint()->add_var_index(i);
       req.mutable_model()->mutable_solution_hint()->add_var_value(val);
     }
+  } else if (!parameters.cp_sat().fix_variables_to_their_hinted_value()) {
+    // Warm start from the last solution found, typically before an Update().
+    // CP-SAT repairs or ignores the values that are no longer feasible.
+    for (int i = 0; i < previous_solution_.size(); ++i) {
+      if (!std::isnan(previous_solution_[i])) {
+        req.mutable_model()->mutable_solution_hint()->add_var_index(i);
+        req.mutable_model()->mutable_solution_hint()->add_var_value(
+            previous_solution_[i]);
+      }
+    }
   }
 
   // We need to chain the user interrupter through a local interrupter, because
@@ -463,6 +522,8 @@ absl::StatusOr<SolveResultProto> CpSatSolver::Solve(
       };
   if (response.status() == MPSOLVER_OPTIMAL ||
       response.status() == MPSOLVER_FEASIBLE) {
+    previous_solution_.assign(response.variable_value().begin(),
+                              response.variable_value().end());
     add_solution(response.variable_value(), response.objective_value());
     for (const MPSolution& extra_solution : response.additional_solutions()) {
       add_solution(extra_solution.variable_value(),
@@ -476,8 +537,221 @@ absl::StatusOr<SolveResultProto> CpSatSolver::Solve(
   return result;
 }
 
-absl::StatusOr<bool> CpSatSolver::Update(const ModelUpdateProto&) {
-  return false;
+absl::StatusOr<bool> CpSatSolver::Update(const ModelUpdateProto& model_update) {
+  if (!UpdateIsSupported(model_update, kCpSatSupportedStructures)) {
+    return false;
+  }
+
+  DeleteVariables(model_update.deleted_variable_ids());
+  DeleteLinearConstraints(model_update.deleted_linear_constraint_ids());
+
+  const VariableUpdatesProto& variable_updates =
+      model_update.variable_updates();
+  for (const auto [id, lower_bound] :
+       MakeView(variable_updates.lower_bounds())) {
+    cp_sat_model_.mutable_variable(VariableIndex(id))
+        ->set_lower_bound(lower_bound);
+  }
+  for (const auto [id, upper_bound] :
+       MakeView(variable_updates.upper_bounds())) {
+    cp_sat_model_.mutable_variable(VariableIndex(id))
+        ->set_upper_bound(upper_bound);
+  }
+  for (const auto [id, is_integer] : MakeView(variable_updates.integers())) {
+    cp_sat_model_.mutable_variable(VariableIndex(id))
+        ->set_is_integer(is_integer);
+  }
+
+  const LinearConstraintUpdatesProto& linear_constraint_updates =
+      model_update.linear_constraint_updates();
+  for (const auto [id, lower_bound] :
+       MakeView(linear_constraint_updates.lower_bounds())) {
+    cp_sat_model_.mutable_constraint(LinearConstraintIndex(id))
+        ->set_lower_bound(lower_bound);
+  }
+  for (const auto [id, upper_bound] :
+       MakeView(linear_constraint_updates.upper_bounds())) {
+    cp_sat_model_.mutable_constraint(LinearConstraintIndex(id))
+        ->set_upper_bound(upper_bound);
+  }
+
+  AddVariables(model_update.new_variables());
+  AddLinearConstraints(model_update.new_linear_constraints());
+
+  // The objective priority is irrelevant with a single objective.
+  const ObjectiveUpdatesProto& objective_updates =
+      model_update.objective_updates();
+  if (objective_updates.has_direction_update()) {
+    cp_sat_model_.set_maximize(objective_updates.direction_update());
+  }
+  if (objective_updates.has_offset_update()) {
+    cp_sat_model_.set_objective_offset(objective_updates.offset_update());
+  }
+  for (const auto [id, coefficient] :
+       MakeView(objective_updates.linear_coefficients())) {
+    cp_sat_model_.mutable_variable(VariableIndex(id))
+        ->set_objective_coefficient(coefficient);
+  }
+
+  UpdateLinearConstraintMatrix(model_update.linear_constraint_matrix_updates());
+  return true;
+}
+
+int CpSatSolver::VariableIndex(const int64_t variable_id) const {
+  const auto it = absl::c_lower_bound(variable_ids_, variable_id);
+  CHECK(it != variable_ids_.end() && *it == variable_id)
+      << "unknown variable id: " << variable_id;
+  return static_cast<int>(it - variable_ids_.begin());
+}
+
+int CpSatSolver::LinearConstraintIndex(
+    const int64_t linear_constraint_id) const {
+  const auto it =
+      absl::c_lower_bound(linear_constraint_ids_, linear_constraint_id);
+  CHECK(it != linear_constraint_ids_.end() && *it == linear_constraint_id)
+      << "unknown linear constraint id: " << linear_constraint_id;
+  return static_cast<int>(it - linear_constraint_ids_.begin());
+}
+
+void CpSatSolver::DeleteVariables(
+    const absl::Span<const int64_t> deleted_variable_ids) {
+  if (deleted_variable_ids.empty()) {
+    return;
+  }
+  const std::vector<int> new_indices = DeleteEntries(
+      deleted_variable_ids, variable_ids_, *cp_sat_model_.mutable_variable());
+  if (!previous_solution_.empty()) {
+    for (int i = 0; i < new_indices.size(); ++i) {
+      if (new_indices[i] >= 0) {
+        previous_solution_[new_indices[i]] = previous_solution_[i];
+      }
+    }
+    previous_solution_.resize(variable_ids_.size());
+  }
+  for (MPConstraintProto& constraint : *cp_sat_model_.mutable_constraint()) {
+    int num_kept = 0;
+    for (int k = 0; k < constraint.var_index_size(); ++k) {
+      const int new_index = new_indices[constraint.var_index(k)];
+      if (new_index < 0) {
+        continue;
+      }
+      constraint.set_var_index(num_kept, new_index);
+      constraint.set_coefficient(num_kept, constraint.coefficient(k));
+      ++num_kept;
+    }
+    constraint.mutable_var_index()->Truncate(num_kept);
+    constraint.mutable_coefficient()->Truncate(num_kept);
+  }
+}
+
+void CpSatSolver::DeleteLinearConstraints(
+    const absl::Span<const int64_t> deleted_linear_constraint_ids) {
+  if (deleted_linear_constraint_ids.empty()) {
+    return;
+  }
+  DeleteEntries(deleted_linear_constraint_ids, linear_constraint_ids_,
+                *cp_sat_model_.mutable_constraint());
+}
+
+void CpSatSolver::AddVariables(const VariablesProto& variables) {
+  const int num_new_variables = variables.ids_size();
+  if (num_new_variables == 0) {
+    return;
+  }
+  DCHECK(variable_ids_.empty() || variables.ids(0) > variable_ids_.back());
+  const bool has_names = variables.names_size() > 0;
+  cp_sat_model_.mutable_variable()->Reserve(cp_sat_model_.variable_size() +
+                                            num_new_variables);
+  for (int j = 0; j < num_new_variables; ++j) {
+    MPVariableProto* const variable = cp_sat_model_.add_variable();
+    variable->set_lower_bound(variables.lower_bounds(j));
+    variable->set_upper_bound(variables.upper_bounds(j));
+    variable->set_is_integer(variables.integers(j));
+    if (has_names) {
+      variable->set_name(variables.names(j));
+    }
+    variable_ids_.push_back(variables.ids(j));
+  }
+  if (!previous_solution_.empty()) {
+    previous_solution_.resize(variable_ids_.size(),
+                              std::numeric_limits<double>::quiet_NaN());
+  }
+}
+
+void CpSatSolver::AddLinearConstraints(
+    const LinearConstraintsProto& linear_constraints) {
+  const int num_new_constraints = linear_constraints.ids_size();
+  if (num_new_constraints == 0) {
+    return;
+  }
+  DCHECK(linear_constraint_ids_.empty() ||
+         linear_constraints.ids(0) > linear_constraint_ids_.back());
+  const bool has_names = linear_constraints.names_size() > 0;
+  cp_sat_model_.mutable_constraint()->Reserve(cp_sat_model_.constraint_size() +
+                                              num_new_constraints);
+  for (int i = 0; i < num_new_constraints; ++i) {
+    MPConstraintProto* const constraint = cp_sat_model_.add_constraint();
+    constraint->set_lower_bound(linear_constraints.lower_bounds(i));
+    constraint->set_upper_bound(linear_constraints.upper_bounds(i));
+    if (has_names) {
+      constraint->set_name(linear_constraints.names(i));
+    }
+    linear_constraint_ids_.push_back(linear_constraints.ids(i));
+  }
+}
+
+void CpSatSolver::UpdateLinearConstraintMatrix(
+    const SparseDoubleMatrixProto& updates) {
+  // The updates are sorted by row, we process them one row at a time.
+  const int num_updates = updates.row_ids_size();
+  for (int row_begin = 0, row_end = 0; row_begin < num_updates;
+       row_begin = row_end) {
+    const int64_t row_id = updates.row_ids(row_begin);
+    while (row_end < num_updates && updates.row_ids(row_end) == row_id) {
+      ++row_end;
+    }
+    MPConstraintProto& constraint =
+        *cp_sat_model_.mutable_constraint(LinearConstraintIndex(row_id));
+
+    // A single update is applied with a linear scan of the row, more are
+    // applied with a map from variable index to term position.
+    absl::flat_hash_map<int, int> term_positions;
+    if (row_end - row_begin > 1) {
+      term_positions.reserve(constraint.var_index_size());
+      for (int k = 0; k < constraint.var_index_size(); ++k) {
+        term_positions[constraint.var_index(k)] = k;
+      }
+    }
+    bool has_zero_terms = false;
+    for (int u = row_begin; u < row_end; ++u) {
+      const int variable_index = VariableIndex(updates.column_ids(u));
+      const double coefficient = updates.coefficients(u);
+      int position = -1;
+      if (row_end - row_begin > 1) {
+        const auto it = term_positions.find(variable_index);
+        if (it != term_positions.end()) {
+          position = it->second;
+        }
+      } else {
+        const auto it = absl::c_find(constraint.var_index(), variable_index);
+        if (it != constraint.var_index().end()) {
+          position = static_cast<int>(it - constraint.var_index().begin());
+        }
+      }
+      if (position >= 0) {
+        constraint.set_coefficient(position, coefficient);
+        has_zero_terms |= coefficient == 0.0;
+      } else if (coefficient != 0.0) {
+        // The updates of a row have distinct columns, so this term is not
+        // updated again and needs no entry in `term_positions`.
+        constraint.add_var_index(variable_index);
+        constraint.add_coefficient(coefficient);
+      }
+    }
+    if (has_zero_terms) {
+      RemoveZeroTerms(constraint);
+    }
+  }
 }
 
 CpSatSolver::CpSatSolver(MPModelProto cp_sat_model,
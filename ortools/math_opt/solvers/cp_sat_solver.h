@@ -65,16 +65,46 @@ class CpSatSolver : public SolverInterface {
   // Returns the ids of variables and linear constraints with inverted bounds.
   InvertedBounds ListInvertedBounds() const;
 
-  const MPModelProto cp_sat_model_;
+  // Returns the index in `cp_sat_model_` of the variable (respectively, linear
+  // constraint) with the given id, which must exist.
+  int VariableIndex(int64_t variable_id) const;
+  int LinearConstraintIndex(int64_t linear_constraint_id) const;
+
+  // Removes the given variables from `cp_sat_model_`, from the terms of its
+  // constraints and from `previous_solution_`. The ids must be sorted.
+  void DeleteVariables(absl::Span<const int64_t> deleted_variable_ids);
+
+  // Removes the given linear constraints from `cp_sat_model_`. The ids must be
+  // sorted.
+  void DeleteLinearConstraints(
+      absl::Span<const int64_t> deleted_linear_constraint_ids);
+
+  // Appends the new variables (respectively, linear constraints) to
+  // `cp_sat_model_`; their ids must be greater than all the existing ones.
+  void AddVariables(const VariablesProto& variables);
+  void AddLinearConstraints(const LinearConstraintsProto& linear_constraints);
+
+  // Sets the given coefficients of the linear constraints, removing the terms
+  // whose coefficient becomes zero.
+  void UpdateLinearConstraintMatrix(const SparseDoubleMatrixProto& updates);
+
+  // The model, kept in sync with the input `Model` by Update().
+  MPModelProto cp_sat_model_;
 
   // For the i-th variable in `cp_sat_model_`, `variable_ids_[i]` contains the
-  // corresponding id in the input `Model`.
-  const std::vector<int64_t> variable_ids_;
+  // corresponding id in the input `Model`. The ids are sorted.
+  std::vector<int64_t> variable_ids_;
 
   // For the i-th linear constraint in `cp_sat_model_`,
   // `linear_constraint_ids_[i]` contains the corresponding id in the input
-  // `Model`.
-  const std::vector<int64_t> linear_constraint_ids_;
+  // `Model`. The ids are sorted.
+  std::vector<int64_t> linear_constraint_ids_;
+
+  // Values of the variables in the last solution found by Solve(), used as a
+  // hint by the next solves without a user provided hint. Either empty or
+  // with one value per variable of `cp_sat_model_`, NaN for the variables
+  // added since that solution.
+  std::vector<double> previous_solution_;
 };
 
 }  // namespace math_opt
@@ -43,6 +43,7 @@ namespace {
 using ::testing::HasSubstr;
 using ::testing::Values;
 using ::testing::ValuesIn;
+using ::testing::status::IsOkAndHolds;
 using ::testing::status::StatusIs;
 
 StatusTestParameters StatusDefault() {
@@ -60,7 +61,8 @@ INSTANTIATE_TEST_SUITE_P(
     CpSatSimpleMipTest, SimpleMipTest,
     Values(SimpleMipTestParameters(SolverType::kCpSat,
                                    /*report_unboundness_correctly=*/true)));
-GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(IncrementalMipTest);
+INSTANTIATE_TEST_SUITE_P(CpSatIncrementalMipTest, IncrementalMipTest,
+                         Values(SolverType::kCpSat));
 
 MultiObjectiveTestParameters GetCpSatMultiObjectiveTestParameters() {
   return MultiObjectiveTestParameters(
@@ -336,6 +338,34 @@ INSTANTIATE_TEST_SUITE_P(CpSatCallbackTest, CallbackTest,
                              /*all_solutions=*/AllSolutions(),
                              /*reaches_cut_callback=*/std::nullopt)));
 
+TEST(CpSatSolverTest, IncrementalUpdateReindexesModel) {
+  Model model;
+  const Variable x = model.AddIntegerVariable(0.0, 3.0, "x");
+  const Variable y = model.AddIntegerVariable(0.0, 3.0, "y");
+  const Variable z = model.AddIntegerVariable(0.0, 3.0, "z");
+  const LinearConstraint c = model.AddLinearConstraint(x + y + z <= 4.0, "c");
+  const LinearConstraint d = model.AddLinearConstraint(y - z <= 0.0, "d");
+  model.Maximize(x + 2.0 * y + 3.0 * z);
+
+  ASSERT_OK_AND_ASSIGN(const auto solver,
+                       IncrementalSolver::New(&model, SolverType::kCpSat));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimalWithSolution(
+                                   2.0 + 9.0, {{x, 0.0}, {y, 1.0}, {z, 3.0}})));
+
+  // Deleting x and d shifts the indices of y, z and c in the CP-SAT model.
+  model.DeleteVariable(x);
+  model.DeleteLinearConstraint(d);
+  const Variable w = model.AddIntegerVariable(0.0, 1.0, "w");
+  model.set_coefficient(c, w, 1.0);
+  model.set_coefficient(c, z, 0.0);
+  model.set_objective_coefficient(w, 10.0);
+  model.set_upper_bound(c, 2.0);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(),
+              IsOkAndHolds(IsOptimalWithSolution(
+                  10.0 + 2.0 + 9.0, {{y, 1.0}, {z, 3.0}, {w, 1.0}})));
+}
+
 TEST(CpSatInvalidCallbackTest, RequestLazyConstraints) {
   Model model("model");
   const Variable x = model.AddBinaryVariable("x");
@@ -13,6 +13,7 @@
 
 #include "ortools/math_opt/solvers/pdlp_bridge.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -21,6 +22,7 @@
 #include "Eigen/Core"
 #include "Eigen/SparseCore"
 #include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -30,6 +32,7 @@
 #include "ortools/math_opt/core/math_opt_proto_utils.h"
 #include "ortools/math_opt/core/sparse_vector_view.h"
 #include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/model_update.pb.h"
 #include "ortools/math_opt/solution.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
 #include "ortools/pdlp/quadratic_program.h"
@@ -76,6 +79,23 @@ Eigen::VectorXd EncodeSolution(
   return pdlp_vector;
 }
 
+// Returns a pointer to the coefficient of the entry (row, column) of the
+// compressed `matrix`, or nullptr if this entry is not stored.
+double* FindCoefficient(Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>&
+                            matrix,
+                        const int64_t row, const int64_t column) {
+  DCHECK(matrix.isCompressed());
+  const int64_t* const column_begin =
+      matrix.innerIndexPtr() + matrix.outerIndexPtr()[column];
+  const int64_t* const column_end =
+      matrix.innerIndexPtr() + matrix.outerIndexPtr()[column + 1];
+  const int64_t* const it = std::lower_bound(column_begin, column_end, row);
+  if (it == column_end || *it != row) {
+    return nullptr;
+  }
+  return matrix.valuePtr() + (it - matrix.innerIndexPtr());
+}
+
 }  // namespace
 
 absl::StatusOr<PdlpBridge> PdlpBridge::FromProto(
@@ -167,6 +187,123 @@ absl::StatusOr<PdlpBridge> PdlpBridge::FromProto(
   return result;
 }
 
+bool PdlpBridge::Update(const ModelUpdateProto& model_update) {
+  if (!UpdateIsSupported(model_update, kPdlpSupportedStructures) ||
+      !model_update.deleted_variable_ids().empty() ||
+      !model_update.deleted_linear_constraint_ids().empty() ||
+      !model_update.new_variables().ids().empty() ||
+      !model_update.new_linear_constraints().ids().empty()) {
+    return false;
+  }
+  const ObjectiveUpdatesProto& objective_updates =
+      model_update.objective_updates();
+  const SparseDoubleMatrixProto& quadratic_updates =
+      objective_updates.quadratic_coefficients();
+  for (int i = 0; i < quadratic_updates.row_ids_size(); ++i) {
+    // FromProto() returns an error for these, as PDLP only supports diagonal
+    // objective matrices.
+    if (quadratic_updates.row_ids(i) != quadratic_updates.column_ids(i)) {
+      return false;
+    }
+  }
+
+  for (const auto [var_id, lower_bound] :
+       MakeView(model_update.variable_updates().lower_bounds())) {
+    pdlp_lp_.variable_lower_bounds[var_id_to_pdlp_index_.at(var_id)] =
+        lower_bound;
+  }
+  for (const auto [var_id, upper_bound] :
+       MakeView(model_update.variable_updates().upper_bounds())) {
+    pdlp_lp_.variable_upper_bounds[var_id_to_pdlp_index_.at(var_id)] =
+        upper_bound;
+  }
+  for (const auto [lin_con_id, lower_bound] :
+       MakeView(model_update.linear_constraint_updates().lower_bounds())) {
+    pdlp_lp_.constraint_lower_bounds[lin_con_id_to_pdlp_index_.at(
+        lin_con_id)] = lower_bound;
+  }
+  for (const auto [lin_con_id, upper_bound] :
+       MakeView(model_update.linear_constraint_updates().upper_bounds())) {
+    pdlp_lp_.constraint_upper_bounds[lin_con_id_to_pdlp_index_.at(
+        lin_con_id)] = upper_bound;
+  }
+
+  // The PDLP objective is the MathOpt one times the scaling factor, so a
+  // direction change negates it.
+  if (objective_updates.has_direction_update()) {
+    const double obj_scale = objective_updates.direction_update() ? -1.0 : 1.0;
+    if (obj_scale != pdlp_lp_.objective_scaling_factor) {
+      pdlp_lp_.objective_vector = -pdlp_lp_.objective_vector;
+      pdlp_lp_.objective_offset = -pdlp_lp_.objective_offset;
+      if (pdlp_lp_.objective_matrix.has_value()) {
+        pdlp_lp_.objective_matrix->diagonal() =
+            -pdlp_lp_.objective_matrix->diagonal();
+      }
+      pdlp_lp_.objective_scaling_factor = obj_scale;
+    }
+  }
+  const double obj_scale = pdlp_lp_.objective_scaling_factor;
+  if (objective_updates.has_offset_update()) {
+    pdlp_lp_.objective_offset = obj_scale * objective_updates.offset_update();
+  }
+  for (const auto [var_id, coef] :
+       MakeView(objective_updates.linear_coefficients())) {
+    pdlp_lp_.objective_vector[var_id_to_pdlp_index_.at(var_id)] =
+        obj_scale * coef;
+  }
+  if (!quadratic_updates.row_ids().empty()) {
+    if (!pdlp_lp_.objective_matrix.has_value()) {
+      pdlp_lp_.objective_matrix.emplace();
+      pdlp_lp_.objective_matrix->setZero(pdlp_index_to_var_id_.size());
+    }
+    for (int i = 0; i < quadratic_updates.row_ids_size(); ++i) {
+      // See FromProto() for the factor 2.
+      pdlp_lp_.objective_matrix->diagonal()[var_id_to_pdlp_index_.at(
+          quadratic_updates.row_ids(i))] =
+          2 * obj_scale * quadratic_updates.coefficients(i);
+    }
+    // As in FromProto(), a model without quadratic terms is a linear program.
+    if (pdlp_lp_.objective_matrix->diagonal().isZero(0.0)) {
+      pdlp_lp_.objective_matrix.reset();
+    }
+  }
+
+  // Coefficients of existing entries are modified in place, new entries are
+  // added with a single sparse sum and entries set to zero are removed.
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& constraint_matrix =
+      pdlp_lp_.constraint_matrix;
+  const SparseDoubleMatrixProto& matrix_updates =
+      model_update.linear_constraint_matrix_updates();
+  std::vector<Eigen::Triplet<double, int64_t>> new_entries;
+  bool has_zeros = false;
+  for (int i = 0; i < matrix_updates.row_ids_size(); ++i) {
+    const int64_t row_index =
+        lin_con_id_to_pdlp_index_.at(matrix_updates.row_ids(i));
+    const int64_t column_index =
+        var_id_to_pdlp_index_.at(matrix_updates.column_ids(i));
+    const double value = matrix_updates.coefficients(i);
+    if (double* const coefficient =
+            FindCoefficient(constraint_matrix, row_index, column_index);
+        coefficient != nullptr) {
+      *coefficient = value;
+      has_zeros |= value == 0.0;
+    } else if (value != 0.0) {
+      new_entries.emplace_back(row_index, column_index, value);
+    }
+  }
+  if (!new_entries.empty()) {
+    Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> additions(
+        constraint_matrix.rows(), constraint_matrix.cols());
+    additions.setFromTriplets(new_entries.begin(), new_entries.end());
+    constraint_matrix += additions;
+  }
+  if (has_zeros) {
+    constraint_matrix.prune(
+        [](int64_t, int64_t, const double value) { return value != 0.0; });
+  }
+  return true;
+}
+
 InvertedBounds PdlpBridge::ListInvertedBounds() const {
   InvertedBounds inverted_bounds;
   for (int64_t var_index = 0; var_index < pdlp_index_to_var_id_.size();
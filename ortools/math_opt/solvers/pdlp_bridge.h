@@ -24,6 +24,7 @@
 #include "ortools/math_opt/core/inverted_bounds.h"
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_parameters.pb.h"
+#include "ortools/math_opt/model_update.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
 #include "ortools/pdlp/primal_dual_hybrid_gradient.h"
 #include "ortools/pdlp/quadratic_program.h"
@@ -52,6 +53,12 @@ class PdlpBridge {
 
   const pdlp::QuadraticProgram& pdlp_lp() const { return pdlp_lp_; }
 
+  // Applies `model_update` to the PDLP model and returns true when it only
+  // modifies the bounds, the objective and the linear constraint coefficients
+  // of existing variables and constraints. Otherwise returns false without
+  // modifying the model.
+  bool Update(const ModelUpdateProto& model_update);
+
   // Returns the ids of variables and linear constraints with inverted bounds.
   InvertedBounds ListInvertedBounds() const;
 
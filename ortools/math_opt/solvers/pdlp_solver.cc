@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "Eigen/Core"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -210,6 +211,33 @@ absl::StatusOr<TerminationProto> ConvertReason(
       "PDLP status: ", ProtoEnumToString(pdlp_reason), " not implemented."));
 }
 
+// Returns true if the iterates of `pdlp_result` are a solution (or a partial
+// one) that PDLP accepts as the initial solution of a later solve. Rays of
+// infeasible problems and diverged iterates are rejected.
+bool IsValidWarmStart(const SolverResult& pdlp_result) {
+  switch (pdlp_result.solve_log.termination_reason()) {
+    case pdlp::TERMINATION_REASON_OPTIMAL:
+    case pdlp::TERMINATION_REASON_TIME_LIMIT:
+    case pdlp::TERMINATION_REASON_ITERATION_LIMIT:
+    case pdlp::TERMINATION_REASON_KKT_MATRIX_PASS_LIMIT:
+    case pdlp::TERMINATION_REASON_INTERRUPTED_BY_USER:
+      break;
+    default:
+      return false;
+  }
+  // See CheckInitialSolution() in primal_dual_hybrid_gradient.cc.
+  constexpr double kExcessiveInputValue = 1e50;
+  for (const Eigen::VectorXd* const values :
+       {&pdlp_result.primal_solution, &pdlp_result.dual_solution}) {
+    if (!values->allFinite() ||
+        (values->size() > 0 &&
+         values->lpNorm<Eigen::Infinity>() > kExcessiveInputValue)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 absl::StatusOr<SolveResultProto> PdlpSolver::MakeSolveResult(
@@ -354,6 +382,10 @@ absl::StatusOr<SolveResultProto> PdlpSolver::Solve(
   if (!model_parameters.solution_hints().empty()) {
     initial_solution = pdlp_bridge_.SolutionHintToWarmStart(
         model_parameters.solution_hints(0));
+  } else {
+    // After an Update(), the previous iterates are usually close to the new
+    // optimum and PDLP converges much faster from them than from zero.
+    initial_solution = last_iterates_;
   }
 
   std::function<void(const std::string&)> pdlp_callback = nullptr;
@@ -363,14 +395,22 @@ absl::StatusOr<SolveResultProto> PdlpSolver::Solve(
     };
   }
 
-  const SolverResult pdlp_result =
+  SolverResult pdlp_result =
       PrimalDualHybridGradient(pdlp_bridge_.pdlp_lp(), pdlp_params,
-                               initial_solution, &interrupt, pdlp_callback);
-  return MakeSolveResult(pdlp_result, model_parameters);
+                               std::move(initial_solution), &interrupt,
+                               pdlp_callback);
+  ASSIGN_OR_RETURN(SolveResultProto result,
+                   MakeSolveResult(pdlp_result, model_parameters));
+  if (IsValidWarmStart(pdlp_result)) {
+    last_iterates_ = PrimalAndDualSolution{
+        .primal_solution = std::move(pdlp_result.primal_solution),
+        .dual_solution = std::move(pdlp_result.dual_solution)};
+  }
+  return result;
 }
 
-absl::StatusOr<bool> PdlpSolver::Update(const ModelUpdateProto&) {
-  return false;
+absl::StatusOr<bool> PdlpSolver::Update(const ModelUpdateProto& model_update) {
+  return pdlp_bridge_.Update(model_update);
 }
 
 absl::StatusOr<ComputeInfeasibleSubsystemResultProto>
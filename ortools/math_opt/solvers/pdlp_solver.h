@@ -15,6 +15,7 @@
 #define OR_TOOLS_MATH_OPT_SOLVERS_PDLP_SOLVER_H_
 
 #include <memory>
+#include <optional>
 
 #include "absl/status/statusor.h"
 #include "ortools/math_opt/callback.pb.h"
@@ -62,6 +63,10 @@ class PdlpSolver : public SolverInterface {
       const ModelSolveParametersProto& model_params);
 
   PdlpBridge pdlp_bridge_;
+
+  // The primal and dual iterates of the last solve that returned a solution.
+  // Solves without a solution hint start from them.
+  std::optional<pdlp::PrimalAndDualSolution> last_iterates_;
 };
 
 }  // namespace math_opt
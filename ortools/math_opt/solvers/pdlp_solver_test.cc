@@ -22,6 +22,7 @@
 #include "gtest/gtest.h"
 #include "ortools/base/gmock.h"
 #include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/cpp/matchers.h"
 #include "ortools/math_opt/cpp/math_opt.h"
 #include "ortools/math_opt/model_parameters.pb.h"
 #include "ortools/math_opt/solver_tests/callback_tests.h"
@@ -45,7 +46,10 @@ namespace operations_research {
 namespace math_opt {
 namespace {
 
+using ::testing::Field;
 using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::status::IsOkAndHolds;
 using ::testing::status::StatusIs;
 
 StatusTestParameters StatusDefault() {
@@ -89,8 +93,8 @@ INSTANTIATE_TEST_SUITE_P(
 QpTestParameters GetPdlpQpTestParameters() {
   return QpTestParameters(SolverType::kPdlp, SolveParameters(),
                           /*qp_support=*/QpSupportType::kDiagonalQpOnly,
-                          /*supports_incrementalism_not_modifying_qp=*/false,
-                          /*supports_qp_incrementalism=*/false,
+                          /*supports_incrementalism_not_modifying_qp=*/true,
+                          /*supports_qp_incrementalism=*/true,
                           /*use_integer_variables=*/false);
 }
 INSTANTIATE_TEST_SUITE_P(PdlpSimpleQpTest, SimpleQpTest,
@@ -300,6 +304,106 @@ TEST(PdlpWarmSart, InvalidWarmStart) {
                        HasSubstr("PDLP solution hint invalid")));
 }
 
+SolveParameters TightPdlpParameters() {
+  SolveParameters parameters;
+  auto* const optimality = parameters.pdlp.mutable_termination_criteria()
+                               ->mutable_simple_optimality_criteria();
+  optimality->set_eps_optimal_absolute(1.0e-9);
+  optimality->set_eps_optimal_relative(1.0e-9);
+  return parameters;
+}
+
+TEST(PdlpIncrementalTest, UpdateBoundsObjectiveAndMatrix) {
+  Model model;
+  const Variable x = model.AddContinuousVariable(0.0, 3.0, "x");
+  const Variable y = model.AddContinuousVariable(0.0, 10.0, "y");
+  const LinearConstraint c = model.AddLinearConstraint(x + 2 * y <= 4.0, "c");
+  const LinearConstraint d = model.AddLinearConstraint(y <= 3.0, "d");
+  model.Maximize(x + y);
+  ASSERT_OK_AND_ASSIGN(const std::unique_ptr<IncrementalSolver> solver,
+                       IncrementalSolver::New(&model, SolverType::kPdlp));
+  EXPECT_THAT(solver->Solve({.parameters = TightPdlpParameters()}),
+              IsOkAndHolds(IsOptimalWithSolution(3.5, {{x, 3.0}, {y, 0.5}})));
+
+  // The new model is: max 2x + y s.t. 2y <= 4, x + y <= 3, 0 <= x <= 10 and
+  // 0 <= y <= 10. This removes the entry (c, x) and adds the entry (d, x).
+  model.set_upper_bound(x, 10.0);
+  model.set_objective_coefficient(x, 2.0);
+  model.set_coefficient(c, x, 0.0);
+  model.set_coefficient(d, x, 1.0);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(
+      solver->SolveWithoutUpdate({.parameters = TightPdlpParameters()}),
+      IsOkAndHolds(IsOptimalWithSolution(6.0, {{x, 3.0}, {y, 0.0}})));
+
+  // Changing the direction negates the objective of the PDLP model.
+  model.set_minimize();
+  model.set_objective_offset(1.0);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(
+      solver->SolveWithoutUpdate({.parameters = TightPdlpParameters()}),
+      IsOkAndHolds(IsOptimalWithSolution(1.0, {{x, 0.0}, {y, 0.0}})));
+}
+
+TEST(PdlpIncrementalTest, WarmStartFromPreviousSolve) {
+  // PDLP checks for termination every 64 iterations by default, so the model
+  // needs several hundred iterations from zero for the difference to show.
+  constexpr int kNumVars = 50;
+  Model model;
+  std::vector<Variable> x;
+  for (int k = 0; k < kNumVars; ++k) {
+    x.push_back(model.AddContinuousVariable(0.0, 10.0));
+  }
+  std::vector<LinearConstraint> c;
+  for (int k = 0; k + 1 < kNumVars; ++k) {
+    c.push_back(
+        model.AddLinearConstraint(x[k] + 2 * x[k + 1] <= 1.0 + 0.1 * (k % 5)));
+  }
+  LinearExpression objective;
+  for (int k = 0; k < kNumVars; ++k) {
+    objective += (1.0 + 0.3 * (k % 7)) * x[k];
+  }
+  model.Maximize(objective);
+  ASSERT_OK_AND_ASSIGN(const std::unique_ptr<IncrementalSolver> solver,
+                       IncrementalSolver::New(&model, SolverType::kPdlp));
+  ASSERT_OK_AND_ASSIGN(const SolveResult first_result,
+                       solver->Solve({.parameters = TightPdlpParameters()}));
+  ASSERT_THAT(first_result, IsOptimal());
+
+  // A small change of the right hand side moves the optimum slightly, so the
+  // second solve should start close to it.
+  const LinearConstraint changed = c[kNumVars / 2];
+  model.set_upper_bound(changed, model.upper_bound(changed) + 0.01);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  ASSERT_OK_AND_ASSIGN(
+      const SolveResult second_result,
+      solver->SolveWithoutUpdate({.parameters = TightPdlpParameters()}));
+  EXPECT_THAT(second_result, IsOptimal());
+  EXPECT_LT(second_result.solve_stats.first_order_iterations,
+            first_result.solve_stats.first_order_iterations);
+
+  // Without any change, the previous iterates are already optimal.
+  EXPECT_THAT(
+      solver->SolveWithoutUpdate({.parameters = TightPdlpParameters()}),
+      IsOkAndHolds(Field(&SolveResult::solve_stats,
+                         Field(&SolveStats::first_order_iterations, 0))));
+}
+
+TEST(PdlpIncrementalTest, NewVariableRecreatesSolver) {
+  Model model;
+  const Variable x = model.AddContinuousVariable(0.0, 1.0, "x");
+  model.Maximize(x);
+  ASSERT_OK_AND_ASSIGN(const std::unique_ptr<IncrementalSolver> solver,
+                       IncrementalSolver::New(&model, SolverType::kPdlp));
+  EXPECT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(1.0)));
+
+  const Variable y = model.AddContinuousVariable(0.0, 2.0, "y");
+  model.set_objective_coefficient(y, 1.0);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(Not(DidUpdate())));
+  EXPECT_THAT(solver->SolveWithoutUpdate(),
+              IsOkAndHolds(IsOptimalWithSolution(3.0, {{x, 1.0}, {y, 2.0}})));
+}
+
 TEST(PdlpOutput, FiniteCorrectedDual) {
   Model model;
   Variable x = model.AddContinuousVariable(0.0, 1.0);
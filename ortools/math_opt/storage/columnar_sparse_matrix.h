@@ -0,0 +1,711 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A sparse matrix optimized for building large matrices in bulk.
+#ifndef OR_TOOLS_MATH_OPT_STORAGE_COLUMNAR_SPARSE_MATRIX_H_
+#define OR_TOOLS_MATH_OPT_STORAGE_COLUMNAR_SPARSE_MATRIX_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/math_opt/sparse_containers.pb.h"
+#include "ortools/math_opt/storage/sparse_matrix.h"
+
+namespace operations_research::math_opt {
+
+// A sparse double valued matrix over int-like rows and columns, with the same
+// API as SparseMatrix, but without any hash map.
+//
+// Implementation: The nonzeros are stored in compressed sparse row (CSR)
+// format: the entries of row r are at positions [row_starts_[r],
+// row_starts_[r + 1]) of `columns_` and `values_`, sorted by column. Rows are
+// indexed by the value of their id, so the ids should be dense, as the ids of
+// ModelStorage are. A compressed sparse column (CSC) index of the same
+// positions is built by the first column query, and kept until the positions
+// change.
+//
+// New entries are appended to coordinate (COO) buffers, without any lookup.
+// The buffers are merged into the CSR arrays by the next read, in
+// O(nonzeros + rows + b * log(b)) for b buffered entries. Changing the value of
+// an existing entry is done in place in O(log(row size)). As in SparseMatrix,
+// setting an entry to zero or deleting a row or a column zeroes the entries in
+// place, and the zeros are removed when they exceed `internal::kZerosCleanup`
+// of all entries.
+//
+// Const methods merge the buffers and build the CSC index lazily. This is
+// protected by a mutex, so that const methods can be called concurrently.
+//
+// This is much faster than SparseMatrix to build a matrix entry by entry, and
+// to export it as a proto since the CSR entries are already sorted. It is
+// slower when new entries are added to rows that are read in between, since
+// each read after an insertion merges all the buffered entries.
+//
+// Memory use:
+//   * 2*8 bytes per nonzero for the CSR arrays and 2*8 more for the CSC index
+//     once it is built.
+//   * 3*8 bytes per buffered entry, until the next merge.
+//   * 8 bytes per row and 8 bytes per column of the CSC index.
+template <typename RowId, typename ColumnId>
+class ColumnarSparseMatrix {
+ public:
+  ColumnarSparseMatrix() = default;
+
+  // This type is neither copyable nor movable.
+  ColumnarSparseMatrix(const ColumnarSparseMatrix&) = delete;
+  ColumnarSparseMatrix& operator=(const ColumnarSparseMatrix&) = delete;
+
+  // Setting `value` to zero removes the value from the matrix.
+  // Returns true if `value` is different from the existing value in the matrix.
+  //
+  // Finding the existing value merges the buffered entries if `row` has any,
+  // use Append() when the return value is not needed.
+  bool set(RowId row, ColumnId column, double value);
+
+  // Same as set(), without returning whether the value changed. The entry is
+  // appended to the buffers unless it is already in the CSR arrays.
+  void Append(RowId row, ColumnId column, double value);
+
+  // Appends the rows [first_row, first_row + row_starts.size() - 1), given in
+  // CSR format: the entries of row first_row + i are (columns[j], values[j])
+  // for j in [row_starts[i], row_starts[i + 1]). The new rows are written
+  // directly to the CSR arrays, and zero values are skipped.
+  //
+  // The columns of each row must be unique, and no row after first_row can
+  // have entries, not even buffered ones.
+  void AppendRows(RowId first_row, absl::Span<const int64_t> row_starts,
+                  absl::Span<const int64_t> columns,
+                  absl::Span<const double> values);
+
+  // Zero is returned if the value is not present.
+  double get(RowId row, ColumnId column) const;
+
+  // Returns true if the value is present (nonzero).
+  bool contains(RowId row, ColumnId column) const;
+
+  // Zeros out all coefficients for this variable.
+  void DeleteRow(RowId row);
+
+  // Zeros out all coefficients for this variable.
+  void DeleteColumn(ColumnId column);
+
+  // Returns the columns with a nonzero entry in `row_id`, sorted.
+  std::vector<ColumnId> row(RowId row_id) const;
+
+  // Returns the rows with a nonzero entry in `column_id`, sorted.
+  std::vector<RowId> column(ColumnId column_id) const;
+
+  // Returns the (column, value) pairs of the nonzero entries of `row_id`,
+  // sorted by column.
+  std::vector<std::pair<ColumnId, double>> RowTerms(RowId row_id) const;
+
+  // Returns the (row, value) pairs of the nonzero entries of `col_id`, sorted
+  // by row.
+  std::vector<std::pair<RowId, double>> ColumnTerms(ColumnId col_id) const;
+
+  // Returns the (row, column, value) tuples of the nonzero entries, sorted.
+  std::vector<std::tuple<RowId, ColumnId, double>> Terms() const;
+
+  // Removes all terms from the matrix.
+  void Clear();
+
+  // The number of (row, column) keys with nonzero value.
+  int64_t nonzeros() const;
+
+  // For testing/debugging only, do not depend on this value, behavior may
+  // change based on implementation.
+  int64_t impl_detail_matrix_storage_size() const {
+    MergeBuffersIfNeeded();
+    return columns_.size();
+  }
+
+  SparseDoubleMatrixProto Proto() const;
+
+  SparseDoubleMatrixProto Update(
+      const absl::flat_hash_set<RowId>& deleted_rows,
+      absl::Span<const RowId> new_rows,
+      const absl::flat_hash_set<ColumnId>& deleted_columns,
+      absl::Span<const ColumnId> new_columns,
+      const absl::flat_hash_set<std::pair<RowId, ColumnId>>& dirty) const;
+
+ private:
+  int64_t num_csr_rows() const { return row_starts_.size() - 1; }
+
+  bool RowHasBufferedEntries(const RowId row) const {
+    return row.value() <
+               static_cast<int64_t>(rows_with_buffered_entries_.size()) &&
+           rows_with_buffered_entries_[row.value()];
+  }
+
+  bool ColumnHasBufferedEntries(const ColumnId column) const {
+    return column.value() <
+               static_cast<int64_t>(columns_with_buffered_entries_.size()) &&
+           columns_with_buffered_entries_[column.value()];
+  }
+
+  // Returns the position of (row, column) in the CSR arrays, or -1.
+  int64_t Find(RowId row, ColumnId column) const;
+
+  // Sets values_[position], and maintains num_zeros_. Does not compact.
+  void SetValueAt(int64_t position, double value);
+
+  void AppendToBuffers(RowId row, ColumnId column, double value);
+
+  // Merges the buffers into the CSR arrays, if they are not empty.
+  void MergeBuffersIfNeeded() const;
+  void MergeBuffers() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Builds the CSC index, if it was not built since the last change of the
+  // CSR positions. The buffers must have been merged.
+  void BuildColumnIndexIfNeeded() const;
+  void ClearColumnIndex();
+
+  void CompactIfNeeded();
+
+  // Protects the lazy merge of the buffers and the lazy construction of the
+  // CSC index by const methods.
+  mutable absl::Mutex mutex_;
+  mutable std::atomic<bool> has_buffered_entries_ = false;
+  mutable std::atomic<bool> has_column_index_ = false;
+
+  // The CSR arrays. The values can include zero.
+  mutable std::vector<int64_t> row_starts_ = {0};
+  mutable std::vector<ColumnId> columns_;
+  mutable std::vector<double> values_;
+  // The number of zeros in values_.
+  mutable int64_t num_zeros_ = 0;
+
+  // The CSC index: the entries of column c are the ones at positions
+  // column_positions_[i] of the CSR arrays, for i in [column_starts_[c],
+  // column_starts_[c + 1]), and are in rows column_rows_[i], sorted.
+  mutable std::vector<int64_t> column_starts_;
+  mutable std::vector<RowId> column_rows_;
+  mutable std::vector<int64_t> column_positions_;
+
+  // The COO buffers. When an entry appears several times, the last one wins.
+  mutable std::vector<RowId> buffered_rows_;
+  mutable std::vector<ColumnId> buffered_columns_;
+  mutable std::vector<double> buffered_values_;
+  mutable std::vector<bool> rows_with_buffered_entries_;
+  mutable std::vector<bool> columns_with_buffered_entries_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Inlined functions
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename RowId, typename ColumnId>
+bool ColumnarSparseMatrix<RowId, ColumnId>::set(const RowId row,
+                                                const ColumnId column,
+                                                const double value) {
+  if (RowHasBufferedEntries(row)) {
+    MergeBuffersIfNeeded();
+  }
+  const int64_t position = Find(row, column);
+  if (position == -1) {
+    if (value == 0.0) {
+      return false;
+    }
+    AppendToBuffers(row, column, value);
+    return true;
+  }
+  if (values_[position] == value) {
+    return false;
+  }
+  SetValueAt(position, value);
+  if (value == 0.0) {
+    CompactIfNeeded();
+  }
+  return true;
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::Append(const RowId row,
+                                                   const ColumnId column,
+                                                   const double value) {
+  if (!RowHasBufferedEntries(row)) {
+    const int64_t position = Find(row, column);
+    if (position != -1) {
+      SetValueAt(position, value);
+      if (value == 0.0) {
+        CompactIfNeeded();
+      }
+      return;
+    }
+  }
+  AppendToBuffers(row, column, value);
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::AppendRows(
+    const RowId first_row, const absl::Span<const int64_t> row_starts,
+    const absl::Span<const int64_t> columns,
+    const absl::Span<const double> values) {
+  DCHECK_GE(first_row.value(), num_csr_rows());
+  DCHECK_GE(first_row.value(),
+            static_cast<int64_t>(rows_with_buffered_entries_.size()));
+  DCHECK_EQ(columns.size(), values.size());
+  if (row_starts.size() <= 1) {
+    return;
+  }
+  // Rows before first_row without entries.
+  row_starts_.resize(first_row.value() + 1, columns_.size());
+  const int64_t num_new_entries = row_starts.back() - row_starts.front();
+  columns_.reserve(columns_.size() + num_new_entries);
+  values_.reserve(values_.size() + num_new_entries);
+  std::vector<std::pair<ColumnId, double>> unsorted_row;
+  for (int64_t i = 0; i + 1 < static_cast<int64_t>(row_starts.size()); ++i) {
+    const int64_t row_start = columns_.size();
+    bool is_sorted = true;
+    for (int64_t j = row_starts[i]; j < row_starts[i + 1]; ++j) {
+      if (values[j] == 0.0) continue;
+      const ColumnId column(columns[j]);
+      if (static_cast<int64_t>(columns_.size()) > row_start &&
+          columns_.back() >= column) {
+        is_sorted = false;
+      }
+      columns_.push_back(column);
+      values_.push_back(values[j]);
+    }
+    const int64_t row_end = columns_.size();
+    if (!is_sorted) {
+      unsorted_row.clear();
+      for (int64_t p = row_start; p < row_end; ++p) {
+        unsorted_row.push_back({columns_[p], values_[p]});
+      }
+      absl::c_sort(unsorted_row);
+      for (int64_t p = row_start; p < row_end; ++p) {
+        std::tie(columns_[p], values_[p]) = unsorted_row[p - row_start];
+        DCHECK(p == row_start || columns_[p - 1] < columns_[p]);
+      }
+    }
+    row_starts_.push_back(row_end);
+  }
+  ClearColumnIndex();
+}
+
+template <typename RowId, typename ColumnId>
+double ColumnarSparseMatrix<RowId, ColumnId>::get(const RowId row,
+                                                  const ColumnId column) const {
+  MergeBuffersIfNeeded();
+  const int64_t position = Find(row, column);
+  return position == -1 ? 0.0 : values_[position];
+}
+
+template <typename RowId, typename ColumnId>
+bool ColumnarSparseMatrix<RowId, ColumnId>::contains(
+    const RowId row, const ColumnId column) const {
+  return get(row, column) != 0.0;
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::DeleteRow(const RowId row) {
+  if (RowHasBufferedEntries(row)) {
+    MergeBuffersIfNeeded();
+  }
+  if (row.value() >= num_csr_rows()) {
+    return;
+  }
+  for (int64_t p = row_starts_[row.value()]; p < row_starts_[row.value() + 1];
+       ++p) {
+    SetValueAt(p, 0.0);
+  }
+  CompactIfNeeded();
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::DeleteColumn(
+    const ColumnId column) {
+  if (ColumnHasBufferedEntries(column)) {
+    MergeBuffersIfNeeded();
+  }
+  BuildColumnIndexIfNeeded();
+  if (column.value() >= static_cast<int64_t>(column_starts_.size()) - 1) {
+    return;
+  }
+  for (int64_t i = column_starts_[column.value()];
+       i < column_starts_[column.value() + 1]; ++i) {
+    SetValueAt(column_positions_[i], 0.0);
+  }
+  CompactIfNeeded();
+}
+
+template <typename RowId, typename ColumnId>
+std::vector<ColumnId> ColumnarSparseMatrix<RowId, ColumnId>::row(
+    const RowId row_id) const {
+  std::vector<ColumnId> result;
+  for (const auto [column, value] : RowTerms(row_id)) {
+    result.push_back(column);
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+std::vector<RowId> ColumnarSparseMatrix<RowId, ColumnId>::column(
+    const ColumnId column_id) const {
+  std::vector<RowId> result;
+  for (const auto [row, value] : ColumnTerms(column_id)) {
+    result.push_back(row);
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+std::vector<std::pair<ColumnId, double>>
+ColumnarSparseMatrix<RowId, ColumnId>::RowTerms(const RowId row_id) const {
+  MergeBuffersIfNeeded();
+  std::vector<std::pair<ColumnId, double>> result;
+  if (row_id.value() < num_csr_rows()) {
+    for (int64_t p = row_starts_[row_id.value()];
+         p < row_starts_[row_id.value() + 1]; ++p) {
+      if (values_[p] != 0.0) {
+        result.push_back({columns_[p], values_[p]});
+      }
+    }
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+std::vector<std::pair<RowId, double>>
+ColumnarSparseMatrix<RowId, ColumnId>::ColumnTerms(
+    const ColumnId col_id) const {
+  MergeBuffersIfNeeded();
+  BuildColumnIndexIfNeeded();
+  std::vector<std::pair<RowId, double>> result;
+  if (col_id.value() < static_cast<int64_t>(column_starts_.size()) - 1) {
+    for (int64_t i = column_starts_[col_id.value()];
+         i < column_starts_[col_id.value() + 1]; ++i) {
+      const double value = values_[column_positions_[i]];
+      if (value != 0.0) {
+        result.push_back({column_rows_[i], value});
+      }
+    }
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+std::vector<std::tuple<RowId, ColumnId, double>>
+ColumnarSparseMatrix<RowId, ColumnId>::Terms() const {
+  MergeBuffersIfNeeded();
+  std::vector<std::tuple<RowId, ColumnId, double>> result;
+  result.reserve(columns_.size() - num_zeros_);
+  for (int64_t r = 0; r < num_csr_rows(); ++r) {
+    for (int64_t p = row_starts_[r]; p < row_starts_[r + 1]; ++p) {
+      if (values_[p] != 0.0) {
+        result.push_back({RowId(r), columns_[p], values_[p]});
+      }
+    }
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::Clear() {
+  row_starts_ = {0};
+  columns_.clear();
+  values_.clear();
+  num_zeros_ = 0;
+  ClearColumnIndex();
+  buffered_rows_.clear();
+  buffered_columns_.clear();
+  buffered_values_.clear();
+  rows_with_buffered_entries_.clear();
+  columns_with_buffered_entries_.clear();
+  has_buffered_entries_.store(false, std::memory_order_relaxed);
+}
+
+template <typename RowId, typename ColumnId>
+int64_t ColumnarSparseMatrix<RowId, ColumnId>::nonzeros() const {
+  MergeBuffersIfNeeded();
+  return columns_.size() - num_zeros_;
+}
+
+template <typename RowId, typename ColumnId>
+SparseDoubleMatrixProto ColumnarSparseMatrix<RowId, ColumnId>::Proto() const {
+  MergeBuffersIfNeeded();
+  // The CSR entries are already sorted by (row, column).
+  const int num_entries = static_cast<int>(columns_.size() - num_zeros_);
+  SparseDoubleMatrixProto result;
+  result.mutable_row_ids()->Reserve(num_entries);
+  result.mutable_column_ids()->Reserve(num_entries);
+  result.mutable_coefficients()->Reserve(num_entries);
+  for (int64_t r = 0; r < num_csr_rows(); ++r) {
+    for (int64_t p = row_starts_[r]; p < row_starts_[r + 1]; ++p) {
+      if (values_[p] != 0.0) {
+        result.add_row_ids(r);
+        result.add_column_ids(columns_[p].value());
+        result.add_coefficients(values_[p]);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename RowId, typename ColumnId>
+SparseDoubleMatrixProto ColumnarSparseMatrix<RowId, ColumnId>::Update(
+    const absl::flat_hash_set<RowId>& deleted_rows,
+    const absl::Span<const RowId> new_rows,
+    const absl::flat_hash_set<ColumnId>& deleted_columns,
+    const absl::Span<const ColumnId> new_columns,
+    const absl::flat_hash_set<std::pair<RowId, ColumnId>>& dirty) const {
+  // See SparseMatrix::Update(), this returns the same entries.
+  std::vector<std::tuple<RowId, ColumnId, double>> matrix_updates;
+  for (const auto [row, column] : dirty) {
+    if (deleted_rows.contains(row) || deleted_columns.contains(column)) {
+      continue;
+    }
+    matrix_updates.push_back({row, column, get(row, column)});
+  }
+  for (const ColumnId new_col : new_columns) {
+    for (const auto [row, coef] : ColumnTerms(new_col)) {
+      matrix_updates.push_back({row, new_col, coef});
+    }
+  }
+  for (const RowId new_row : new_rows) {
+    for (const auto [col, coef] : RowTerms(new_row)) {
+      if (new_columns.empty() || col < new_columns[0]) {
+        matrix_updates.push_back({new_row, col, coef});
+      }
+    }
+  }
+  return internal::EntriesToMatrixProto(std::move(matrix_updates));
+}
+
+template <typename RowId, typename ColumnId>
+int64_t ColumnarSparseMatrix<RowId, ColumnId>::Find(
+    const RowId row, const ColumnId column) const {
+  if (row.value() >= num_csr_rows()) {
+    return -1;
+  }
+  const auto begin = columns_.begin() + row_starts_[row.value()];
+  const auto end = columns_.begin() + row_starts_[row.value() + 1];
+  const auto it = std::lower_bound(begin, end, column);
+  if (it == end || *it != column) {
+    return -1;
+  }
+  return it - columns_.begin();
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::SetValueAt(const int64_t position,
+                                                       const double value) {
+  const double old_value = values_[position];
+  if (old_value == value) {
+    return;
+  }
+  values_[position] = value;
+  if (value == 0.0) {
+    ++num_zeros_;
+  } else if (old_value == 0.0) {
+    --num_zeros_;
+  }
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::AppendToBuffers(
+    const RowId row, const ColumnId column, const double value) {
+  buffered_rows_.push_back(row);
+  buffered_columns_.push_back(column);
+  buffered_values_.push_back(value);
+  if (row.value() >= static_cast<int64_t>(rows_with_buffered_entries_.size())) {
+    rows_with_buffered_entries_.resize(row.value() + 1);
+  }
+  rows_with_buffered_entries_[row.value()] = true;
+  if (column.value() >=
+      static_cast<int64_t>(columns_with_buffered_entries_.size())) {
+    columns_with_buffered_entries_.resize(column.value() + 1);
+  }
+  columns_with_buffered_entries_[column.value()] = true;
+  has_buffered_entries_.store(true, std::memory_order_relaxed);
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::MergeBuffersIfNeeded() const {
+  if (!has_buffered_entries_.load(std::memory_order_acquire)) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  if (has_buffered_entries_.load(std::memory_order_relaxed)) {
+    MergeBuffers();
+    has_buffered_entries_.store(false, std::memory_order_release);
+  }
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::MergeBuffers() const {
+  const int64_t num_old_rows = num_csr_rows();
+  int64_t num_rows = num_old_rows;
+  for (const RowId row : buffered_rows_) {
+    num_rows = std::max(num_rows, row.value() + 1);
+  }
+
+  // Sorts the buffered entries by row with a stable counting sort, so that
+  // the entries of each row stay in insertion order.
+  std::vector<int64_t> buffer_starts(num_rows + 1, 0);
+  for (const RowId row : buffered_rows_) {
+    ++buffer_starts[row.value() + 1];
+  }
+  std::partial_sum(buffer_starts.begin(), buffer_starts.end(),
+                   buffer_starts.begin());
+  std::vector<std::pair<ColumnId, double>> sorted(buffered_rows_.size());
+  {
+    std::vector<int64_t> next(buffer_starts.begin(), buffer_starts.end() - 1);
+    for (int64_t i = 0; i < static_cast<int64_t>(buffered_rows_.size());
+         ++i) {
+      sorted[next[buffered_rows_[i].value()]++] = {buffered_columns_[i],
+                                                   buffered_values_[i]};
+    }
+  }
+  // Releases the memory of the buffers before allocating the new arrays.
+  std::vector<RowId>().swap(buffered_rows_);
+  std::vector<ColumnId>().swap(buffered_columns_);
+  std::vector<double>().swap(buffered_values_);
+  rows_with_buffered_entries_.clear();
+  columns_with_buffered_entries_.clear();
+
+  // Merges each row of the CSR arrays with the buffered entries of the row. A
+  // buffered entry overrides the CSR entry of the same column, and the last
+  // buffered entry of a column overrides the previous ones. Zeros are dropped.
+  std::vector<int64_t> new_row_starts(num_rows + 1);
+  std::vector<ColumnId> new_columns;
+  std::vector<double> new_values;
+  new_columns.reserve(columns_.size() - num_zeros_ + sorted.size());
+  new_values.reserve(columns_.size() - num_zeros_ + sorted.size());
+  const auto by_column = [](const std::pair<ColumnId, double>& a,
+                            const std::pair<ColumnId, double>& b) {
+    return a.first < b.first;
+  };
+  for (int64_t r = 0; r < num_rows; ++r) {
+    new_row_starts[r] = new_columns.size();
+    auto first = sorted.begin() + buffer_starts[r];
+    const auto last = sorted.begin() + buffer_starts[r + 1];
+    std::stable_sort(first, last, by_column);
+    int64_t p = r < num_old_rows ? row_starts_[r] : 0;
+    const int64_t p_end = r < num_old_rows ? row_starts_[r + 1] : 0;
+    while (p < p_end || first != last) {
+      if (first == last || (p < p_end && columns_[p] < first->first)) {
+        if (values_[p] != 0.0) {
+          new_columns.push_back(columns_[p]);
+          new_values.push_back(values_[p]);
+        }
+        ++p;
+        continue;
+      }
+      const ColumnId column = first->first;
+      while (first + 1 != last && (first + 1)->first == column) {
+        ++first;
+      }
+      if (p < p_end && columns_[p] == column) {
+        ++p;
+      }
+      if (first->second != 0.0) {
+        new_columns.push_back(column);
+        new_values.push_back(first->second);
+      }
+      ++first;
+    }
+  }
+  new_row_starts[num_rows] = new_columns.size();
+
+  row_starts_ = std::move(new_row_starts);
+  columns_ = std::move(new_columns);
+  values_ = std::move(new_values);
+  num_zeros_ = 0;
+  column_starts_.clear();
+  column_rows_.clear();
+  column_positions_.clear();
+  has_column_index_.store(false, std::memory_order_relaxed);
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::BuildColumnIndexIfNeeded() const {
+  if (has_column_index_.load(std::memory_order_acquire)) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  if (has_column_index_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  int64_t num_columns = 0;
+  for (const ColumnId column : columns_) {
+    num_columns = std::max(num_columns, column.value() + 1);
+  }
+  column_starts_.assign(num_columns + 1, 0);
+  for (const ColumnId column : columns_) {
+    ++column_starts_[column.value() + 1];
+  }
+  std::partial_sum(column_starts_.begin(), column_starts_.end(),
+                   column_starts_.begin());
+  column_rows_.resize(columns_.size());
+  column_positions_.resize(columns_.size());
+  std::vector<int64_t> next(column_starts_.begin(), column_starts_.end() - 1);
+  for (int64_t r = 0; r < num_csr_rows(); ++r) {
+    for (int64_t p = row_starts_[r]; p < row_starts_[r + 1]; ++p) {
+      const int64_t i = next[columns_[p].value()]++;
+      column_rows_[i] = RowId(r);
+      column_positions_[i] = p;
+    }
+  }
+  has_column_index_.store(true, std::memory_order_release);
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::ClearColumnIndex() {
+  std::vector<int64_t>().swap(column_starts_);
+  std::vector<RowId>().swap(column_rows_);
+  std::vector<int64_t>().swap(column_positions_);
+  has_column_index_.store(false, std::memory_order_relaxed);
+}
+
+template <typename RowId, typename ColumnId>
+void ColumnarSparseMatrix<RowId, ColumnId>::CompactIfNeeded() {
+  if (columns_.empty() || static_cast<double>(num_zeros_) / columns_.size() <=
+                              internal::kZerosCleanup) {
+    return;
+  }
+  // Removes the zeros in place, row by row.
+  int64_t write = 0;
+  int64_t row_start = 0;
+  for (int64_t r = 0; r < num_csr_rows(); ++r) {
+    const int64_t row_end = row_starts_[r + 1];
+    for (int64_t p = row_start; p < row_end; ++p) {
+      if (values_[p] != 0.0) {
+        columns_[write] = columns_[p];
+        values_[write] = values_[p];
+        ++write;
+      }
+    }
+    row_starts_[r + 1] = write;
+    row_start = row_end;
+  }
+  columns_.resize(write);
+  values_.resize(write);
+  num_zeros_ = 0;
+  ClearColumnIndex();
+}
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_STORAGE_COLUMNAR_SPARSE_MATRIX_H_
@@ -0,0 +1,222 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/storage/columnar_sparse_matrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/math_opt/storage/model_storage_types.h"
+#include "ortools/math_opt/storage/sparse_matrix.h"
+
+namespace operations_research::math_opt {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::EqualsProto;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+using Matrix = ColumnarSparseMatrix<LinearConstraintId, VariableId>;
+using ReferenceMatrix = SparseMatrix<LinearConstraintId, VariableId>;
+
+constexpr int kNumRows = 12;
+constexpr int kNumColumns = 15;
+
+template <typename T>
+std::vector<T> Sorted(std::vector<T> v) {
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+// Checks that `matrix` has the same entries as `reference`, and that all the
+// entries of `matrix` are returned sorted, which SparseMatrix does not
+// guarantee.
+void ExpectSameMatrix(const Matrix& matrix, const ReferenceMatrix& reference) {
+  ASSERT_EQ(matrix.nonzeros(), reference.nonzeros());
+  EXPECT_EQ(matrix.Terms(), Sorted(reference.Terms()));
+  EXPECT_THAT(matrix.Proto(), EqualsProto(reference.Proto()));
+  // Rows and columns past the ones in use are empty.
+  for (int r = 0; r <= kNumRows; ++r) {
+    const LinearConstraintId row(r);
+    EXPECT_EQ(matrix.RowTerms(row), Sorted(reference.RowTerms(row)));
+    EXPECT_EQ(matrix.row(row), Sorted(reference.row(row)));
+  }
+  for (int c = 0; c <= kNumColumns; ++c) {
+    const VariableId column(c);
+    EXPECT_EQ(matrix.ColumnTerms(column),
+              Sorted(reference.ColumnTerms(column)));
+    EXPECT_EQ(matrix.column(column), Sorted(reference.column(column)));
+  }
+  for (int r = 0; r < kNumRows; ++r) {
+    for (int c = 0; c < kNumColumns; ++c) {
+      const LinearConstraintId row(r);
+      const VariableId column(c);
+      EXPECT_EQ(matrix.get(row, column), reference.get(row, column));
+      EXPECT_EQ(matrix.contains(row, column), reference.contains(row, column));
+    }
+  }
+}
+
+// Applies the same random sequence of operations to a ColumnarSparseMatrix and
+// to a SparseMatrix, and compares them every few operations. Values are drawn
+// from a small set including zero, so that entries are often overwritten,
+// zeroed and re-added.
+TEST(ColumnarSparseMatrixTest, RandomOperationsMatchSparseMatrix) {
+  constexpr double kValues[] = {0.0, 0.0, 1.0, -2.5, 3.0, 1.0e10};
+  for (int seed = 0; seed < 20; ++seed) {
+    SCOPED_TRACE(seed);
+    std::mt19937 random(seed);
+    const auto uniform = [&random](int size) {
+      return std::uniform_int_distribution<int>(0, size - 1)(random);
+    };
+    Matrix matrix;
+    ReferenceMatrix reference;
+    for (int step = 0; step < 300; ++step) {
+      const LinearConstraintId row(uniform(kNumRows));
+      const VariableId column(uniform(kNumColumns));
+      const double value = kValues[uniform(std::size(kValues))];
+      const int operation = uniform(100);
+      if (operation < 40) {
+        EXPECT_EQ(matrix.set(row, column, value),
+                  reference.set(row, column, value));
+      } else if (operation < 80) {
+        matrix.Append(row, column, value);
+        reference.set(row, column, value);
+      } else if (operation < 88) {
+        matrix.DeleteRow(row);
+        reference.DeleteRow(row);
+      } else if (operation < 96) {
+        matrix.DeleteColumn(column);
+        reference.DeleteColumn(column);
+      } else if (operation < 98) {
+        EXPECT_EQ(matrix.get(row, column), reference.get(row, column));
+      } else {
+        matrix.Clear();
+        reference.Clear();
+      }
+      // Comparing after each operation reads the matrix, which merges the
+      // buffers. Only comparing every few steps also covers operations on a
+      // matrix with buffered entries.
+      if (step % 7 == 0) {
+        ASSERT_NO_FATAL_FAILURE(ExpectSameMatrix(matrix, reference));
+      }
+    }
+    ASSERT_NO_FATAL_FAILURE(ExpectSameMatrix(matrix, reference));
+  }
+}
+
+TEST(ColumnarSparseMatrixTest, AppendRowsMatchesSparseMatrix) {
+  for (int seed = 0; seed < 10; ++seed) {
+    SCOPED_TRACE(seed);
+    std::mt19937 random(seed);
+    const auto uniform = [&random](int size) {
+      return std::uniform_int_distribution<int>(0, size - 1)(random);
+    };
+    Matrix matrix;
+    ReferenceMatrix reference;
+    // Rows [0, 4) entry by entry, then rows [5, kNumRows) in bulk, with
+    // duplicate-free unsorted columns and some zeros.
+    for (int i = 0; i < 20; ++i) {
+      const LinearConstraintId row(uniform(4));
+      const VariableId column(uniform(kNumColumns));
+      matrix.Append(row, column, 1.0 + i);
+      reference.set(row, column, 1.0 + i);
+    }
+    std::vector<int64_t> row_starts = {0};
+    std::vector<int64_t> columns;
+    std::vector<double> values;
+    for (int r = 5; r < kNumRows; ++r) {
+      std::vector<int64_t> row_columns(kNumColumns);
+      for (int c = 0; c < kNumColumns; ++c) row_columns[c] = c;
+      std::shuffle(row_columns.begin(), row_columns.end(), random);
+      row_columns.resize(uniform(kNumColumns));
+      for (const int64_t c : row_columns) {
+        const double value = uniform(4) == 0 ? 0.0 : uniform(10) + 1.0;
+        columns.push_back(c);
+        values.push_back(value);
+        reference.set(LinearConstraintId(r), VariableId(c), value);
+      }
+      row_starts.push_back(columns.size());
+    }
+    matrix.AppendRows(LinearConstraintId(5), row_starts, columns, values);
+    ASSERT_NO_FATAL_FAILURE(ExpectSameMatrix(matrix, reference));
+    // The rows are still updatable after AppendRows().
+    matrix.DeleteColumn(VariableId(3));
+    reference.DeleteColumn(VariableId(3));
+    matrix.set(LinearConstraintId(7), VariableId(3), 4.0);
+    reference.set(LinearConstraintId(7), VariableId(3), 4.0);
+    ASSERT_NO_FATAL_FAILURE(ExpectSameMatrix(matrix, reference));
+  }
+}
+
+TEST(ColumnarSparseMatrixTest, IterationIsSorted) {
+  Matrix matrix;
+  matrix.Append(LinearConstraintId(2), VariableId(5), 1.0);
+  matrix.Append(LinearConstraintId(0), VariableId(7), 2.0);
+  matrix.Append(LinearConstraintId(2), VariableId(1), 3.0);
+  matrix.Append(LinearConstraintId(1), VariableId(5), 4.0);
+  // The last write wins, even while buffered.
+  matrix.Append(LinearConstraintId(2), VariableId(5), 5.0);
+  EXPECT_THAT(matrix.RowTerms(LinearConstraintId(2)),
+              ElementsAre(Pair(VariableId(1), 3.0), Pair(VariableId(5), 5.0)));
+  EXPECT_THAT(matrix.ColumnTerms(VariableId(5)),
+              ElementsAre(Pair(LinearConstraintId(1), 4.0),
+                          Pair(LinearConstraintId(2), 5.0)));
+  EXPECT_THAT(
+      matrix.Terms(),
+      ElementsAre(std::make_tuple(LinearConstraintId(0), VariableId(7), 2.0),
+                  std::make_tuple(LinearConstraintId(1), VariableId(5), 4.0),
+                  std::make_tuple(LinearConstraintId(2), VariableId(1), 3.0),
+                  std::make_tuple(LinearConstraintId(2), VariableId(5), 5.0)));
+  matrix.Clear();
+  EXPECT_THAT(matrix.Terms(), IsEmpty());
+  EXPECT_EQ(matrix.nonzeros(), 0);
+}
+
+TEST(ColumnarSparseMatrixTest, UpdateMatchesSparseMatrix) {
+  Matrix matrix;
+  ReferenceMatrix reference;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      if ((r + c) % 3 == 0) continue;
+      matrix.set(LinearConstraintId(r), VariableId(c), r + c);
+      reference.set(LinearConstraintId(r), VariableId(c), r + c);
+    }
+  }
+  const absl::flat_hash_set<LinearConstraintId> deleted_rows = {
+      LinearConstraintId(1)};
+  const std::vector<LinearConstraintId> new_rows = {LinearConstraintId(3)};
+  const absl::flat_hash_set<VariableId> deleted_columns = {VariableId(0)};
+  const std::vector<VariableId> new_columns = {VariableId(2), VariableId(3)};
+  const absl::flat_hash_set<std::pair<LinearConstraintId, VariableId>> dirty = {
+      {LinearConstraintId(0), VariableId(1)},
+      {LinearConstraintId(1), VariableId(2)},
+      {LinearConstraintId(2), VariableId(0)},
+      {LinearConstraintId(2), VariableId(1)}};
+  EXPECT_THAT(matrix.Update(deleted_rows, new_rows, deleted_columns,
+                            new_columns, dirty),
+              EqualsProto(reference.Update(deleted_rows, new_rows,
+                                           deleted_columns, new_columns,
+                                           dirty)));
+}
+
+}  // namespace
+}  // namespace operations_research::math_opt
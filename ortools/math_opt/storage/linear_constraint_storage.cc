@@ -14,6 +14,7 @@
 #include "ortools/math_opt/storage/linear_constraint_storage.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -44,6 +45,39 @@ LinearConstraintId LinearConstraintStorage::Add(const double lower_bound,
   return id;
 }
 
+LinearConstraintId LinearConstraintStorage::Add(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const absl::Span<const std::string> names,
+    const absl::Span<const int64_t> row_starts,
+    const absl::Span<const int64_t> variable_ids,
+    const absl::Span<const double> coefficients) {
+  const LinearConstraintId first = next_id_;
+  const int64_t num_constraints = lower_bounds.size();
+  linear_constraints_.reserve(linear_constraints_.size() + num_constraints);
+  for (int64_t i = 0; i < num_constraints; ++i) {
+    Data& lin_con_data = linear_constraints_[next_id_++];
+    lin_con_data.lower_bound = lower_bounds[i];
+    lin_con_data.upper_bound = upper_bounds[i];
+    if (!names.empty()) {
+      lin_con_data.name = names[i];
+    }
+  }
+  // The new constraints are after the checkpoint of all the update trackers,
+  // so their terms are not tracked.
+  if (matrix_storage_mode_ == MatrixStorageMode::kColumnar) {
+    columnar_matrix_.AppendRows(first, row_starts, variable_ids, coefficients);
+  } else {
+    for (int64_t i = 0; i < num_constraints; ++i) {
+      for (int64_t j = row_starts[i]; j < row_starts[i + 1]; ++j) {
+        matrix_.set(first + LinearConstraintId(i), VariableId(variable_ids[j]),
+                    coefficients[j]);
+      }
+    }
+  }
+  return first;
+}
+
 std::vector<LinearConstraintId> LinearConstraintStorage::LinearConstraints()
     const {
   std::vector<LinearConstraintId> result;
@@ -80,7 +114,8 @@ LinearConstraintStorage::Proto() const {
   for (const LinearConstraintId id : sorted_constraints) {
     AppendConstraint(id, &constraints);
   }
-  return {constraints, matrix_.Proto()};
+  return {constraints,
+          VisitMatrix([](const auto& matrix) { return matrix.Proto(); })};
 }
 
 void LinearConstraintStorage::AppendConstraint(
@@ -142,9 +177,12 @@ LinearConstraintStorage::UpdateResult LinearConstraintStorage::Update(
 
   result.creates = Proto(diff.checkpoint, next_id_);
 
-  result.matrix_updates =
-      matrix_.Update(diff.deleted, ConstraintsFrom(diff.checkpoint),
-                     deleted_variables, new_variables, diff.matrix_keys);
+  const std::vector<LinearConstraintId> new_constraints =
+      ConstraintsFrom(diff.checkpoint);
+  result.matrix_updates = VisitMatrix([&](const auto& matrix) {
+    return matrix.Update(diff.deleted, new_constraints, deleted_variables,
+                         new_variables, diff.matrix_keys);
+  });
   return result;
 }
 
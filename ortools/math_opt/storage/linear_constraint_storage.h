@@ -31,6 +31,7 @@
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
+#include "ortools/math_opt/storage/columnar_sparse_matrix.h"
 #include "ortools/math_opt/storage/model_storage_types.h"
 #include "ortools/math_opt/storage/range.h"
 #include "ortools/math_opt/storage/sparse_matrix.h"
@@ -72,6 +73,14 @@ class LinearConstraintStorage {
     SparseDoubleMatrixProto matrix_updates;
   };
 
+  explicit LinearConstraintStorage(
+      MatrixStorageMode matrix_storage_mode = MatrixStorageMode::kHashMap)
+      : matrix_storage_mode_(matrix_storage_mode) {}
+
+  MatrixStorageMode matrix_storage_mode() const {
+    return matrix_storage_mode_;
+  }
+
   // Adds a linear constraint to the model and returns its id.
   //
   // The returned ids begin at zero and strictly increase (in particular, if
@@ -80,6 +89,16 @@ class LinearConstraintStorage {
   LinearConstraintId Add(double lower_bound, double upper_bound,
                          absl::string_view name);
 
+  // Adds linear constraints with consecutive ids, and their terms, and returns
+  // the id of the first one. See ModelStorage::AddLinearConstraints() for the
+  // format of the input, which must be valid. `names` can be empty.
+  LinearConstraintId Add(absl::Span<const double> lower_bounds,
+                         absl::Span<const double> upper_bounds,
+                         absl::Span<const std::string> names,
+                         absl::Span<const int64_t> row_starts,
+                         absl::Span<const int64_t> variable_ids,
+                         absl::Span<const double> coefficients);
+
   inline double lower_bound(LinearConstraintId id) const;
   inline double upper_bound(LinearConstraintId id) const;
   inline const std::string& name(LinearConstraintId id) const;
@@ -135,10 +154,13 @@ class LinearConstraintStorage {
   void set_term(LinearConstraintId constraint, VariableId variable,
                 double value, const iterator_range<DiffIter>& diffs);
 
-  // The matrix of coefficients for the linear terms in the constraints.
-  const SparseMatrix<LinearConstraintId, VariableId>& matrix() const {
-    return matrix_;
-  }
+  // Calls `f` with the matrix of coefficients for the linear terms in the
+  // constraints, and returns its result. The matrix is either a
+  // SparseMatrix<LinearConstraintId, VariableId> or a
+  // ColumnarSparseMatrix<LinearConstraintId, VariableId>, depending on
+  // matrix_storage_mode(), which have the same API.
+  template <typename F>
+  decltype(auto) VisitMatrix(F&& f) const;
 
   // Returns an equivalent proto of `this`.
   std::pair<LinearConstraintsProto, SparseDoubleMatrixProto> Proto() const;
@@ -184,9 +206,12 @@ class LinearConstraintStorage {
   LinearConstraintsProto Proto(LinearConstraintId start,
                                LinearConstraintId end) const;
 
+  MatrixStorageMode matrix_storage_mode_;
   LinearConstraintId next_id_{0};
   absl::flat_hash_map<LinearConstraintId, Data> linear_constraints_;
+  // Only the matrix of matrix_storage_mode_ is used.
   SparseMatrix<LinearConstraintId, VariableId> matrix_;
+  ColumnarSparseMatrix<LinearConstraintId, VariableId> columnar_matrix_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -249,13 +274,18 @@ void LinearConstraintStorage::Delete(const LinearConstraintId id,
     diff.lower_bounds.erase(id);
     diff.upper_bounds.erase(id);
     diff.deleted.insert(id);
-    for (const VariableId row_var : matrix_.row(id)) {
+    for (const VariableId row_var :
+         VisitMatrix([id](const auto& matrix) { return matrix.row(id); })) {
       if (row_var < diff.variable_checkpoint) {
         diff.matrix_keys.erase({id, row_var});
       }
     }
   }
-  matrix_.DeleteRow(id);
+  if (matrix_storage_mode_ == MatrixStorageMode::kColumnar) {
+    columnar_matrix_.DeleteRow(id);
+  } else {
+    matrix_.DeleteRow(id);
+  }
   linear_constraints_.erase(id);
 }
 
@@ -266,13 +296,20 @@ void LinearConstraintStorage::DeleteVariable(
     if (variable >= diff.variable_checkpoint) {
       continue;
     }
-    for (const LinearConstraintId constraint : matrix_.column(variable)) {
+    for (const LinearConstraintId constraint :
+         VisitMatrix([variable](const auto& matrix) {
+           return matrix.column(variable);
+         })) {
       if (constraint < diff.checkpoint) {
         diff.matrix_keys.erase({constraint, variable});
       }
     }
   }
-  matrix_.DeleteColumn(variable);
+  if (matrix_storage_mode_ == MatrixStorageMode::kColumnar) {
+    columnar_matrix_.DeleteColumn(variable);
+  } else {
+    matrix_.DeleteColumn(variable);
+  }
 }
 
 int64_t LinearConstraintStorage::size() const {
@@ -296,7 +333,25 @@ void LinearConstraintStorage::set_term(const LinearConstraintId constraint,
                                        const double value,
                                        const iterator_range<DiffIter>& diffs) {
   DCHECK(linear_constraints_.contains(constraint));
-  if (!matrix_.set(constraint, variable, value)) {
+  if (matrix_storage_mode_ == MatrixStorageMode::kColumnar) {
+    // Only the trackers need to know whether the value changed, and only for
+    // pairs before their checkpoints. Otherwise the columnar matrix can
+    // append the term without looking up its previous value.
+    bool is_tracked = false;
+    for (const Diff& diff : diffs) {
+      if (constraint < diff.checkpoint && variable < diff.variable_checkpoint) {
+        is_tracked = true;
+        break;
+      }
+    }
+    if (!is_tracked) {
+      columnar_matrix_.Append(constraint, variable, value);
+      return;
+    }
+    if (!columnar_matrix_.set(constraint, variable, value)) {
+      return;
+    }
+  } else if (!matrix_.set(constraint, variable, value)) {
     return;
   }
   for (Diff& diff : diffs) {
@@ -306,6 +361,14 @@ void LinearConstraintStorage::set_term(const LinearConstraintId constraint,
   }
 }
 
+template <typename F>
+decltype(auto) LinearConstraintStorage::VisitMatrix(F&& f) const {
+  if (matrix_storage_mode_ == MatrixStorageMode::kColumnar) {
+    return f(columnar_matrix_);
+  }
+  return f(matrix_);
+}
+
 bool LinearConstraintStorage::diff_is_empty(const Diff& diff) const {
   return next_id_ <= diff.checkpoint && diff.deleted.empty() &&
          diff.lower_bounds.empty() && diff.upper_bounds.empty() &&
@@ -48,15 +48,16 @@ namespace operations_research {
 namespace math_opt {
 
 absl::StatusOr<std::unique_ptr<ModelStorage>> ModelStorage::FromModelProto(
-    const ModelProto& model_proto) {
+    const ModelProto& model_proto,
+    const MatrixStorageMode matrix_storage_mode) {
   // We don't check names since ModelStorage does not do so before exporting
   // models. Thus a model built by ModelStorage can contain duplicated
   // names. And since we use FromModelProto() to implement Clone(), we must make
   // sure duplicated names don't fail.
   RETURN_IF_ERROR(ValidateModel(model_proto, /*check_names=*/false).status());
 
-  auto storage = std::make_unique<ModelStorage>(model_proto.name(),
-                                                model_proto.objective().name());
+  auto storage = std::make_unique<ModelStorage>(
+      model_proto.name(), model_proto.objective().name(), matrix_storage_mode);
 
   // Add variables.
   storage->AddVariables(model_proto.variables());
@@ -150,7 +151,7 @@ std::unique_ptr<ModelStorage> ModelStorage::Clone(
     model_proto.set_name(std::string(*new_name));
   }
   absl::StatusOr<std::unique_ptr<ModelStorage>> clone =
-      ModelStorage::FromModelProto(model_proto);
+      ModelStorage::FromModelProto(model_proto, matrix_storage_mode());
   // Unless there is a very serious bug, a model exported by ExportModel()
   // should always be valid.
   CHECK_OK(clone.status());
@@ -233,6 +234,20 @@ LinearConstraintId ModelStorage::AddLinearConstraint(
   return linear_constraints_.Add(lower_bound, upper_bound, name);
 }
 
+LinearConstraintId ModelStorage::AddLinearConstraints(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const absl::Span<const int64_t> row_starts,
+    const absl::Span<const int64_t> variable_ids,
+    const absl::Span<const double> coefficients,
+    const absl::Span<const std::string> names) {
+  DCHECK_EQ(lower_bounds.size(), upper_bounds.size());
+  DCHECK_EQ(row_starts.size(), lower_bounds.size() + 1);
+  DCHECK(names.empty() || names.size() == lower_bounds.size());
+  return linear_constraints_.Add(lower_bounds, upper_bounds, names, row_starts,
+                                 variable_ids, coefficients);
+}
+
 void ModelStorage::AddLinearConstraints(
     const LinearConstraintsProto& linear_constraints) {
   const bool has_names = !linear_constraints.names().empty();
@@ -39,6 +39,17 @@ DEFINE_STRONG_INT_TYPE(Sos2ConstraintId, int64_t);
 DEFINE_STRONG_INT_TYPE(IndicatorConstraintId, int64_t);
 DEFINE_STRONG_INT_TYPE(UpdateTrackerId, int64_t);
 
+// The data structure used to store the linear constraint matrix.
+enum class MatrixStorageMode {
+  // Hash maps, with O(1) access to any coefficient. Best suited to models
+  // modified coefficient by coefficient between incremental solves.
+  kHashMap,
+  // Coordinate buffers merged lazily into CSR arrays, see
+  // ColumnarSparseMatrix. Several times faster and smaller for large models
+  // built in bulk.
+  kColumnar,
+};
+
 }  // namespace operations_research::math_opt
 
 #endif  // OR_TOOLS_MATH_OPT_STORAGE_MODEL_STORAGE_TYPES_H_
@@ -498,6 +498,7 @@ void SparseMatrix<RowId, ColumnId>::Clear() {
   rows_.clear();
   columns_.clear();
   values_.clear();
+  nonzeros_ = 0;
 }
 
 template <typename RowId, typename ColumnId>
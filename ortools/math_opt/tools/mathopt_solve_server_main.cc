@@ -0,0 +1,104 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Server running MathOpt solvers on behalf of clients in other processes, see
+// math_opt/ipc/stream_solve_client.h. Each client stream has its own solver,
+// which is kept between the solves of the stream.
+//
+// Examples:
+//  * Serve a single stream on the standard input and output, for a client that
+//    started the server with pipes:
+//      mathopt_solve_server
+//  * Serve the clients connecting to a Unix domain socket, each stream on its
+//    own thread:
+//      mathopt_solve_server --socket /tmp/mathopt_solve_server
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/flags/flag.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/math_opt/ipc/proto_connection.h"
+#include "ortools/math_opt/ipc/stream_solve_server.h"
+
+ABSL_FLAG(std::string, socket, "",
+          "the path of the Unix domain socket to listen on; if empty, serves a "
+          "single stream on the standard input and output");
+
+namespace operations_research::math_opt {
+namespace {
+
+void ServeConnection(const std::unique_ptr<ProtoConnection> connection) {
+  if (const absl::Status status = ServeStreamSolve(*connection);
+      !status.ok()) {
+    LOG(WARNING) << "stream failed: " << status;
+  }
+}
+
+absl::Status ServeStandardStreams() {
+  // The solvers or the logging could write on the standard output, so it is
+  // redirected to the standard error and the stream uses a copy of it.
+  const int output_fd = dup(STDOUT_FILENO);
+  if (output_fd < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+    return absl::ErrnoToStatus(errno, "failed to redirect standard output");
+  }
+  ProtoConnection connection(STDIN_FILENO, output_fd);
+  return ServeStreamSolve(connection);
+}
+
+absl::Status ServeUnixSocket(const absl::string_view path) {
+  ASSIGN_OR_RETURN(const int listen_fd, ListenOnUnixSocket(path));
+  LOG(INFO) << "listening on " << path;
+  while (true) {
+    const int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      return absl::ErrnoToStatus(errno, "failed to accept connection");
+    }
+    std::thread(ServeConnection, std::make_unique<ProtoConnection>(fd))
+        .detach();
+  }
+}
+
+absl::Status RunServer() {
+  // Errors when writing to a closed pipe are reported by ProtoConnection.
+  signal(SIGPIPE, SIG_IGN);
+  const std::string socket_path = absl::GetFlag(FLAGS_socket);
+  if (socket_path.empty()) {
+    return ServeStandardStreams();
+  }
+  return ServeUnixSocket(socket_path);
+}
+
+}  // namespace
+}  // namespace operations_research::math_opt
+
+int main(int argc, char* argv[]) {
+  InitGoogle(argv[0], &argc, &argv, /*remove_flags=*/true);
+
+  const absl::Status status = operations_research::math_opt::RunServer();
+  if (!status.ok()) {
+    LOG(QFATAL) << status;
+  }
+
+  return 0;
+}
@@ -0,0 +1,551 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark of the routing solver on instances read with the parsers of this
+// folder.
+//
+// Each instance is loaded through its parser, modeled with a RoutingModel and
+// solved with a fixed random seed and deterministic search limits (a solution
+// limit by default, the time limit only being a safety net). For each instance,
+// a CSV line is printed with:
+// - the time to the first solution (including the closing of the model),
+// - the number of local search neighbors explored per second,
+// - the number of local search filter calls per second,
+// - the gap to the best known solution, if it is known.
+//
+// Instances are given as a comma-separated list of <format>:<path>, where
+// <format> is one of tsplib, solomon, lilim, carp or pdtsp. Instances stored in
+// a zip archive are given as <format>:<file>@<archive>. By default, the
+// benchmark runs on the instances of ortools/routing/testdata.
+//
+// Example:
+//   routing_benchmark --instances=tsplib:/path/to/F-n45-k4.vrp \
+//     --best_known_solutions=F-n45-k4=724 --output=/tmp/results.csv
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/flags/flag.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "google/protobuf/text_format.h"
+#include "ortools/base/file.h"
+#include "ortools/base/helpers.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/base/timer.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/search_stats.pb.h"
+#include "ortools/routing/carp_parser.h"
+#include "ortools/routing/lilim_parser.h"
+#include "ortools/routing/pdtsp_parser.h"
+#include "ortools/routing/simple_graph.h"
+#include "ortools/routing/solomon_parser.h"
+#include "ortools/routing/tsplib_parser.h"
+
+ABSL_FLAG(std::string, instances,
+          "tsplib:ortools/routing/testdata/tsplib_F-n45-k4.vrp,"
+          "solomon:google1.txt@ortools/routing/testdata/solomon.zip,"
+          "lilim:ortools/routing/testdata/pdptw_LRC2_10_6.txt,"
+          "carp:ortools/routing/testdata/carp_gdb19.dat,"
+          "pdtsp:ortools/routing/testdata/pdtsp_prob10b.txt",
+          "Comma-separated list of <format>:<path> or "
+          "<format>:<file>@<archive> instances to benchmark; <format> is one "
+          "of tsplib, solomon, lilim, carp, pdtsp.");
+ABSL_FLAG(std::string, best_known_solutions, "",
+          "Comma-separated list of <instance name>=<cost> overriding the "
+          "built-in table of best known solutions used to compute gaps.");
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, the CSV results are written to this file instead of "
+          "stdout.");
+ABSL_FLAG(int, seed, 0, "Seed of the random number generator of the solver.");
+ABSL_FLAG(int64_t, solution_limit, 200,
+          "Number of solutions after which the search stops; this is the "
+          "deterministic limit of the benchmark.");
+ABSL_FLAG(absl::Duration, time_limit, absl::Seconds(60),
+          "Safety time limit per instance; should not be reached for results "
+          "to be deterministic.");
+ABSL_FLAG(std::string, routing_search_parameters, "",
+          "Text proto RoutingSearchParameters (possibly partial) that will "
+          "override the parameters of the benchmark.");
+
+namespace operations_research {
+namespace {
+
+// Scaling factor applied to Euclidean distances of formats with real-valued
+// distances (Solomon, Li & Lim) to keep some precision.
+constexpr int64_t kEuclideanScalingFactor = 100;
+
+// Best known solutions of the bundled instances, by instance name.
+const absl::flat_hash_map<std::string, double>& BuiltinBestKnownSolutions() {
+  static const auto* const kBestKnownSolutions =
+      new absl::flat_hash_map<std::string, double>({
+          {"F-n45-k4", 724},
+          {"gdb19", 55},
+      });
+  return *kBestKnownSolutions;
+}
+
+struct BenchmarkResult {
+  std::string format;
+  std::string name;
+  int num_nodes = 0;
+  int num_vehicles = 0;
+  bool solved = false;
+  double objective = 0;
+  std::optional<double> best_known_solution;
+  double time_to_first_solution_seconds = 0;
+  double total_time_seconds = 0;
+  int64_t num_solutions = 0;
+  int64_t num_neighbors = 0;
+  int64_t num_filtered_neighbors = 0;
+  int64_t num_filter_calls = 0;
+
+  static std::string CsvHeader() {
+    return "format,instance,nodes,vehicles,solved,objective,best_known,gap,"
+           "time_to_first_solution_s,total_time_s,solutions,neighbors,"
+           "filtered_neighbors,filter_calls,neighbors_per_s,"
+           "filter_calls_per_s";
+  }
+
+  std::string ToCsv() const {
+    const auto per_second = [this](int64_t count) {
+      return total_time_seconds > 0 ? count / total_time_seconds : 0.0;
+    };
+    std::string gap;
+    std::string best_known;
+    if (best_known_solution.has_value()) {
+      best_known = absl::StrCat(*best_known_solution);
+      if (solved && *best_known_solution != 0) {
+        gap = absl::StrFormat(
+            "%.6f", (objective - *best_known_solution) / *best_known_solution);
+      }
+    }
+    return absl::StrFormat(
+        "%s,%s,%d,%d,%d,%.6f,%s,%s,%.6f,%.6f,%d,%d,%d,%d,%.1f,%.1f", format,
+        name, num_nodes, num_vehicles, solved, objective, best_known, gap,
+        time_to_first_solution_seconds, total_time_seconds, num_solutions,
+        num_neighbors, num_filtered_neighbors, num_filter_calls,
+        per_second(num_neighbors), per_second(num_filter_calls));
+  }
+};
+
+RoutingModelParameters BenchmarkModelParameters() {
+  RoutingModelParameters parameters = DefaultRoutingModelParameters();
+  // Needed to collect neighbor and filter statistics.
+  parameters.mutable_solver_parameters()->set_profile_local_search(true);
+  return parameters;
+}
+
+RoutingSearchParameters BenchmarkSearchParameters() {
+  RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+  parameters.set_first_solution_strategy(
+      FirstSolutionStrategy::PARALLEL_CHEAPEST_INSERTION);
+  parameters.set_local_search_metaheuristic(
+      LocalSearchMetaheuristic::GUIDED_LOCAL_SEARCH);
+  parameters.set_solution_limit(absl::GetFlag(FLAGS_solution_limit));
+  CHECK_OK(util_time::EncodeGoogleApiProto(absl::GetFlag(FLAGS_time_limit),
+                                           parameters.mutable_time_limit()));
+  CHECK(google::protobuf::TextFormat::MergeFromString(
+      absl::GetFlag(FLAGS_routing_search_parameters), &parameters));
+  return parameters;
+}
+
+// Solves the model and fills the statistics of 'result'. The objective is
+// divided by 'cost_scaling_factor' to be comparable with best known solutions.
+void SolveAndMeasure(RoutingModel* model, double cost_scaling_factor,
+                     BenchmarkResult* result) {
+  model->solver()->ReSeed(absl::GetFlag(FLAGS_seed));
+  WallTimer timer;
+  std::optional<double> time_to_first_solution;
+  int64_t num_solutions = 0;
+  model->AddAtSolutionCallback([&timer, &time_to_first_solution,
+                                &num_solutions]() {
+    if (!time_to_first_solution.has_value()) {
+      time_to_first_solution = timer.Get();
+    }
+    ++num_solutions;
+  });
+  timer.Start();
+  const Assignment* solution =
+      model->SolveWithParameters(BenchmarkSearchParameters());
+  timer.Stop();
+
+  result->num_vehicles = model->vehicles();
+  result->solved = solution != nullptr;
+  if (solution != nullptr) {
+    result->objective = solution->ObjectiveValue() / cost_scaling_factor;
+  }
+  result->total_time_seconds = timer.Get();
+  result->time_to_first_solution_seconds =
+      time_to_first_solution.value_or(timer.Get());
+  result->num_solutions = num_solutions;
+  const LocalSearchStatistics stats =
+      model->solver()->GetLocalSearchStatistics();
+  result->num_neighbors = stats.total_num_neighbors();
+  result->num_filtered_neighbors = stats.total_num_filtered_neighbors();
+  for (const auto& filter_stats : stats.local_search_filter_statistics()) {
+    result->num_filter_calls += filter_stats.num_calls();
+  }
+}
+
+// Returns the Euclidean distance between two points, scaled and rounded.
+int64_t ScaledDistance(const Coordinates2<int64_t>& a,
+                       const Coordinates2<int64_t>& b) {
+  const double dx = a.x - b.x;
+  const double dy = a.y - b.y;
+  return std::llround(kEuclideanScalingFactor * std::sqrt(dx * dx + dy * dy));
+}
+
+// Adds the capacity and time dimensions shared by Solomon and Li & Lim
+// instances.
+template <typename Parser>
+void AddCapacityAndTimeDimensions(const Parser& parser,
+                                  const RoutingIndexManager& manager,
+                                  RoutingModel* model) {
+  const int cost_index = model->RegisterTransitCallback(
+      [&parser, &manager](int64_t from, int64_t to) {
+        return ScaledDistance(
+            parser.coordinates()[manager.IndexToNode(from).value()],
+            parser.coordinates()[manager.IndexToNode(to).value()]);
+      },
+      RoutingModel::kTransitEvaluatorSignPositiveOrZero);
+  model->SetArcCostEvaluatorOfAllVehicles(cost_index);
+
+  const int demand_index = model->RegisterUnaryTransitCallback(
+      [&parser, &manager](int64_t index) {
+        return parser.demands()[manager.IndexToNode(index).value()];
+      });
+  model->AddDimension(demand_index, 0, parser.capacity(),
+                      /*fix_start_cumul_to_zero=*/true, "demand");
+
+  const int time_index = model->RegisterTransitCallback(
+      [&parser, &manager](int64_t from, int64_t to) {
+        const int from_node = manager.IndexToNode(from).value();
+        const int to_node = manager.IndexToNode(to).value();
+        return kEuclideanScalingFactor * parser.service_times()[from_node] +
+               ScaledDistance(parser.coordinates()[from_node],
+                              parser.coordinates()[to_node]);
+      },
+      RoutingModel::kTransitEvaluatorSignPositiveOrZero);
+  int64_t horizon = 0;
+  for (const SimpleTimeWindow<int64_t>& window : parser.time_windows()) {
+    horizon = std::max(horizon, window.end);
+  }
+  horizon *= kEuclideanScalingFactor;
+  model->AddDimension(time_index, horizon, horizon,
+                      /*fix_start_cumul_to_zero=*/false, "time");
+  const RoutingDimension& time = model->GetDimensionOrDie("time");
+  for (int node = 0; node < parser.NumberOfNodes(); ++node) {
+    const SimpleTimeWindow<int64_t>& window = parser.time_windows()[node];
+    const int64_t start = kEuclideanScalingFactor * window.start;
+    const int64_t end = kEuclideanScalingFactor * window.end;
+    if (node == parser.Depot()) {
+      for (int vehicle = 0; vehicle < model->vehicles(); ++vehicle) {
+        time.CumulVar(model->Start(vehicle))->SetRange(start, end);
+        time.CumulVar(model->End(vehicle))->SetRange(start, end);
+      }
+    } else {
+      time.CumulVar(manager.NodeToIndex(RoutingIndexManager::NodeIndex(node)))
+          ->SetRange(start, end);
+    }
+  }
+}
+
+absl::Status RunTspLib(const std::string& path, BenchmarkResult* result) {
+  TspLibParser parser;
+  if (!parser.LoadFile(path)) {
+    return absl::InvalidArgumentError(absl::StrCat("Cannot load ", path));
+  }
+  result->name = parser.name();
+  result->num_nodes = parser.size();
+  int num_vehicles = 1;
+  if (parser.type() == TspLibParser::CVRP) {
+    // TSPLIB does not give the number of vehicles; use twice the trivial
+    // lower bound to keep the model feasible.
+    int64_t total_demand = 0;
+    for (const int64_t demand : parser.demands()) total_demand += demand;
+    const int64_t min_vehicles =
+        (total_demand + parser.capacity() - 1) / parser.capacity();
+    num_vehicles = std::max<int64_t>(1, 2 * min_vehicles);
+  }
+  RoutingIndexManager manager(parser.size(), num_vehicles,
+                              RoutingIndexManager::NodeIndex(parser.depot()));
+  RoutingModel model(manager, BenchmarkModelParameters());
+  const EdgeWeights distances = parser.GetEdgeWeights();
+  const int cost_index = model.RegisterTransitCallback(
+      [&distances, &manager](int64_t from, int64_t to) {
+        return distances(manager.IndexToNode(from).value(),
+                         manager.IndexToNode(to).value());
+      });
+  model.SetArcCostEvaluatorOfAllVehicles(cost_index);
+  if (parser.type() == TspLibParser::CVRP) {
+    const int demand_index = model.RegisterUnaryTransitCallback(
+        [&parser, &manager](int64_t index) {
+          return parser.demands()[manager.IndexToNode(index).value()];
+        },
+        RoutingModel::kTransitEvaluatorSignPositiveOrZero);
+    model.AddDimension(demand_index, 0, parser.capacity(),
+                       /*fix_start_cumul_to_zero=*/true, "demand");
+    if (parser.max_distance() != std::numeric_limits<int64_t>::max()) {
+      model.AddDimension(cost_index, 0, parser.max_distance(),
+                         /*fix_start_cumul_to_zero=*/true, "distance");
+    }
+  }
+  SolveAndMeasure(&model, 1.0, result);
+  return absl::OkStatus();
+}
+
+absl::Status RunSolomon(const std::string& path, const std::string& archive,
+                        BenchmarkResult* result) {
+  SolomonParser parser;
+  const bool loaded =
+      archive.empty() ? parser.LoadFile(path) : parser.LoadFile(path, archive);
+  if (!loaded) {
+    return absl::InvalidArgumentError(absl::StrCat("Cannot load ", path));
+  }
+  result->name = parser.name();
+  result->num_nodes = parser.NumberOfNodes();
+  RoutingIndexManager manager(parser.NumberOfNodes(),
+                              parser.NumberOfVehicles(),
+                              RoutingIndexManager::NodeIndex(parser.Depot()));
+  RoutingModel model(manager, BenchmarkModelParameters());
+  AddCapacityAndTimeDimensions(parser, manager, &model);
+  SolveAndMeasure(&model, kEuclideanScalingFactor, result);
+  return absl::OkStatus();
+}
+
+absl::Status RunLiLim(const std::string& path, const std::string& archive,
+                      BenchmarkResult* result) {
+  LiLimParser parser;
+  const bool loaded =
+      archive.empty() ? parser.LoadFile(path) : parser.LoadFile(path, archive);
+  if (!loaded) {
+    return absl::InvalidArgumentError(absl::StrCat("Cannot load ", path));
+  }
+  result->name = std::string(file::Stem(path));
+  result->num_nodes = parser.NumberOfNodes();
+  RoutingIndexManager manager(parser.NumberOfNodes(),
+                              parser.NumberOfVehicles(),
+                              RoutingIndexManager::NodeIndex(parser.Depot()));
+  RoutingModel model(manager, BenchmarkModelParameters());
+  AddCapacityAndTimeDimensions(parser, manager, &model);
+  Solver* const solver = model.solver();
+  const RoutingDimension& time = model.GetDimensionOrDie("time");
+  for (int node = 0; node < parser.NumberOfNodes(); ++node) {
+    const std::optional<int> delivery = parser.GetDelivery(node);
+    if (node == parser.Depot() || !delivery.has_value()) continue;
+    const int64_t pickup_index =
+        manager.NodeToIndex(RoutingIndexManager::NodeIndex(node));
+    const int64_t delivery_index =
+        manager.NodeToIndex(RoutingIndexManager::NodeIndex(*delivery));
+    model.AddPickupAndDelivery(pickup_index, delivery_index);
+    solver->AddConstraint(solver->MakeEquality(
+        model.VehicleVar(pickup_index), model.VehicleVar(delivery_index)));
+    solver->AddConstraint(
+        solver->MakeLessOrEqual(time.CumulVar(pickup_index),
+                                time.CumulVar(delivery_index)));
+  }
+  SolveAndMeasure(&model, kEuclideanScalingFactor, result);
+  return absl::OkStatus();
+}
+
+// CARP instances are modeled as node routing problems: each edge requiring
+// servicing is represented by two nodes, one per traversal direction, grouped
+// in a disjunction forcing exactly one of them to be performed. Moving between
+// two such nodes costs the servicing traversal of the first one plus the
+// shortest path between them.
+absl::Status RunCarp(const std::string& path, BenchmarkResult* result) {
+  CarpParser parser;
+  if (!parser.LoadFile(path)) {
+    return absl::InvalidArgumentError(absl::StrCat("Cannot load ", path));
+  }
+  result->name = parser.name();
+  const int num_graph_nodes = parser.NumberOfNodes();
+  constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max() / 4;
+  std::vector<std::vector<int64_t>> shortest_paths(
+      num_graph_nodes, std::vector<int64_t>(num_graph_nodes, kInfinity));
+  for (int node = 0; node < num_graph_nodes; ++node) {
+    shortest_paths[node][node] = 0;
+  }
+  for (const auto& [edge, cost] : parser.traversing_costs()) {
+    int64_t& forward = shortest_paths[edge.tail()][edge.head()];
+    int64_t& backward = shortest_paths[edge.head()][edge.tail()];
+    forward = std::min(forward, cost);
+    backward = std::min(backward, cost);
+  }
+  for (int k = 0; k < num_graph_nodes; ++k) {
+    for (int i = 0; i < num_graph_nodes; ++i) {
+      for (int j = 0; j < num_graph_nodes; ++j) {
+        shortest_paths[i][j] =
+            std::min(shortest_paths[i][j],
+                     shortest_paths[i][k] + shortest_paths[k][j]);
+      }
+    }
+  }
+
+  // Node 0 is the depot, followed by both directions of each serviced edge.
+  std::vector<Arc> arcs = {Arc(parser.depot(), parser.depot())};
+  std::vector<int64_t> demands = {0};
+  std::vector<int64_t> traversing_costs = {0};
+  for (const auto& [edge, demand] : parser.servicing_demands()) {
+    const int64_t cost = parser.GetTraversingCost(edge);
+    for (const Arc arc : {Arc(edge.tail(), edge.head()),
+                          Arc(edge.head(), edge.tail())}) {
+      arcs.push_back(arc);
+      demands.push_back(demand);
+      traversing_costs.push_back(cost);
+    }
+  }
+  result->num_nodes = arcs.size();
+  RoutingIndexManager manager(arcs.size(), parser.NumberOfVehicles(),
+                              RoutingIndexManager::NodeIndex(0));
+  RoutingModel model(manager, BenchmarkModelParameters());
+  const int cost_index = model.RegisterTransitCallback(
+      [&](int64_t from, int64_t to) {
+        const int from_node = manager.IndexToNode(from).value();
+        const int to_node = manager.IndexToNode(to).value();
+        return traversing_costs[from_node] +
+               shortest_paths[arcs[from_node].head()][arcs[to_node].tail()];
+      },
+      RoutingModel::kTransitEvaluatorSignPositiveOrZero);
+  model.SetArcCostEvaluatorOfAllVehicles(cost_index);
+  const int demand_index = model.RegisterUnaryTransitVector(demands);
+  model.AddDimension(demand_index, 0, parser.capacity(),
+                     /*fix_start_cumul_to_zero=*/true, "demand");
+  for (int node = 1; node < arcs.size(); node += 2) {
+    model.AddDisjunction(
+        {manager.NodeToIndex(RoutingIndexManager::NodeIndex(node)),
+         manager.NodeToIndex(RoutingIndexManager::NodeIndex(node + 1))});
+  }
+  SolveAndMeasure(&model, 1.0, result);
+  return absl::OkStatus();
+}
+
+absl::Status RunPdTsp(const std::string& path, BenchmarkResult* result) {
+  PdTspParser parser;
+  if (!parser.LoadFile(path)) {
+    return absl::InvalidArgumentError(absl::StrCat("Cannot load ", path));
+  }
+  result->name = std::string(file::Stem(path));
+  result->num_nodes = parser.Size();
+  RoutingIndexManager manager(parser.Size(), 1,
+                              RoutingIndexManager::NodeIndex(parser.depot()));
+  RoutingModel model(manager, BenchmarkModelParameters());
+  const std::function<int64_t(int, int)> distances = parser.Distances();
+  const int cost_index = model.RegisterTransitCallback(
+      [&distances, &manager](int64_t from, int64_t to) {
+        return distances(manager.IndexToNode(from).value(),
+                         manager.IndexToNode(to).value());
+      },
+      RoutingModel::kTransitEvaluatorSignPositiveOrZero);
+  model.SetArcCostEvaluatorOfAllVehicles(cost_index);
+  // Precedences between pickups and deliveries are enforced by the model.
+  for (int node = 0; node < parser.Size(); ++node) {
+    if (node == parser.depot() || !parser.IsPickup(node)) continue;
+    model.AddPickupAndDelivery(
+        manager.NodeToIndex(RoutingIndexManager::NodeIndex(node)),
+        manager.NodeToIndex(
+            RoutingIndexManager::NodeIndex(parser.DeliveryFromPickup(node))));
+  }
+  SolveAndMeasure(&model, 1.0, result);
+  return absl::OkStatus();
+}
+
+absl::Status RunInstance(absl::string_view instance, BenchmarkResult* result) {
+  const std::pair<std::string, std::string> format_and_path =
+      absl::StrSplit(instance, absl::MaxSplits(':', 1));
+  const auto& [format, location] = format_and_path;
+  const std::pair<std::string, std::string> path_and_archive =
+      absl::StrSplit(location, absl::MaxSplits('@', 1));
+  const auto& [path, archive] = path_and_archive;
+  result->format = format;
+  if (format == "tsplib") return RunTspLib(path, result);
+  if (format == "solomon") return RunSolomon(path, archive, result);
+  if (format == "lilim") return RunLiLim(path, archive, result);
+  if (format == "carp") return RunCarp(path, result);
+  if (format == "pdtsp") return RunPdTsp(path, result);
+  return absl::InvalidArgumentError(
+      absl::StrCat("Unknown instance format: ", format));
+}
+
+absl::flat_hash_map<std::string, double> BestKnownSolutions() {
+  absl::flat_hash_map<std::string, double> best_known_solutions =
+      BuiltinBestKnownSolutions();
+  for (const absl::string_view entry :
+       absl::StrSplit(absl::GetFlag(FLAGS_best_known_solutions), ',',
+                      absl::SkipEmpty())) {
+    const std::pair<absl::string_view, absl::string_view> name_and_cost =
+        absl::StrSplit(entry, absl::MaxSplits('=', 1));
+    double cost = 0;
+    CHECK(absl::SimpleAtod(name_and_cost.second, &cost))
+        << "Malformed best known solution: " << entry;
+    best_known_solutions[name_and_cost.first] = cost;
+  }
+  return best_known_solutions;
+}
+
+void RunBenchmark() {
+  const absl::flat_hash_map<std::string, double> best_known_solutions =
+      BestKnownSolutions();
+  std::string output = absl::StrCat(BenchmarkResult::CsvHeader(), "\n");
+  for (const absl::string_view instance : absl::StrSplit(
+           absl::GetFlag(FLAGS_instances), ',', absl::SkipEmpty())) {
+    BenchmarkResult result;
+    const absl::Status status = RunInstance(instance, &result);
+    if (!status.ok()) {
+      LOG(ERROR) << "Skipping instance " << instance << ": " << status;
+      continue;
+    }
+    const auto it = best_known_solutions.find(result.name);
+    if (it != best_known_solutions.end()) {
+      result.best_known_solution = it->second;
+    }
+    LOG(INFO) << instance << ": " << result.ToCsv();
+    absl::StrAppend(&output, result.ToCsv(), "\n");
+  }
+  const std::string output_file = absl::GetFlag(FLAGS_output);
+  if (output_file.empty()) {
+    absl::PrintF("%s", output);
+  } else {
+    CHECK_OK(file::SetContents(output_file, output, file::Defaults()));
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  operations_research::RunBenchmark();
+  return EXIT_SUCCESS;
+}
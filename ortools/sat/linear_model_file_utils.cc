@@ -0,0 +1,252 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/linear_model_file_utils.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "google/protobuf/repeated_field.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/base/types.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_utils.h"
+#include "ortools/util/linear_model_file.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The integers of larger magnitude may not be exactly represented by a double.
+constexpr int64_t kMaxExactInteger = int64_t{1} << 53;
+
+absl::StatusOr<double> IntegerToDouble(int64_t value) {
+  if (value == kint64min) return -kInfinity;
+  if (value == kint64max) return kInfinity;
+  if (value < -kMaxExactInteger || value > kMaxExactInteger) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "The value ", value, " does not fit exactly in a double."));
+  }
+  return static_cast<double>(value);
+}
+
+// Returns the lower bound of a linear constraint, rounded up.
+absl::StatusOr<int64_t> LowerBoundToInteger(double value) {
+  if (value < -kMaxExactInteger) return kint64min;
+  if (value > kMaxExactInteger) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("The lower bound ", value, " is too large."));
+  }
+  return static_cast<int64_t>(std::ceil(value));
+}
+
+// Returns the upper bound of a linear constraint, rounded down.
+absl::StatusOr<int64_t> UpperBoundToInteger(double value) {
+  if (value > kMaxExactInteger) return kint64max;
+  if (value < -kMaxExactInteger) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("The upper bound ", value, " is too small."));
+  }
+  return static_cast<int64_t>(std::floor(value));
+}
+
+absl::StatusOr<int64_t> CoefficientToInteger(double value) {
+  if (std::round(value) != value || std::abs(value) > kMaxExactInteger) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("The coefficient ", value, " is not an integer."));
+  }
+  return static_cast<int64_t>(value);
+}
+
+absl::Status CheckIsInterval(
+    const google::protobuf::RepeatedField<int64_t>& domain) {
+  if (domain.size() != 2) {
+    return absl::InvalidArgumentError(
+        "Only single interval domains are supported by linear model files.");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<LinearModelArrays> CpModelProtoToLinearModelArrays(
+    const CpModelProto& model) {
+  if (model.has_floating_point_objective()) {
+    return absl::InvalidArgumentError(
+        "Floating point objectives are not supported by linear model files.");
+  }
+  LinearModelArrays output;
+  output.name = model.name();
+  const int num_variables = model.variables_size();
+  output.variable_lower_bounds.reserve(num_variables);
+  output.variable_upper_bounds.reserve(num_variables);
+  output.variable_is_integer.assign(num_variables, 1);
+  output.objective_coefficients.assign(num_variables, 0.0);
+  bool has_variable_names = false;
+  for (const IntegerVariableProto& var : model.variables()) {
+    RETURN_IF_ERROR(CheckIsInterval(var.domain()));
+    ASSIGN_OR_RETURN(const double lb, IntegerToDouble(var.domain(0)));
+    ASSIGN_OR_RETURN(const double ub, IntegerToDouble(var.domain(1)));
+    output.variable_lower_bounds.push_back(lb);
+    output.variable_upper_bounds.push_back(ub);
+    has_variable_names |= !var.name().empty();
+  }
+  if (has_variable_names) {
+    output.variable_names.reserve(num_variables);
+    for (const IntegerVariableProto& var : model.variables()) {
+      output.variable_names.push_back(var.name());
+    }
+  }
+
+  bool has_constraint_names = false;
+  for (int c = 0; c < model.constraints_size(); ++c) {
+    const ConstraintProto& ct = model.constraints(c);
+    if (ct.constraint_case() != ConstraintProto::kLinear ||
+        !ct.enforcement_literal().empty()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Constraint ", c,
+          " is not supported by linear model files: only linear constraints "
+          "without enforcement literals are."));
+    }
+    RETURN_IF_ERROR(CheckIsInterval(ct.linear().domain()));
+    ASSIGN_OR_RETURN(const double lb, IntegerToDouble(ct.linear().domain(0)));
+    ASSIGN_OR_RETURN(const double ub, IntegerToDouble(ct.linear().domain(1)));
+    output.constraint_lower_bounds.push_back(lb);
+    output.constraint_upper_bounds.push_back(ub);
+    for (int i = 0; i < ct.linear().vars_size(); ++i) {
+      const int ref = ct.linear().vars(i);
+      const int64_t coeff = ct.linear().coeffs(i);
+      ASSIGN_OR_RETURN(const double value,
+                       IntegerToDouble(RefIsPositive(ref) ? coeff : -coeff));
+      output.column_indices.push_back(PositiveRef(ref));
+      output.coefficients.push_back(value);
+    }
+    output.row_starts.push_back(output.coefficients.size());
+    has_constraint_names |= !ct.name().empty();
+  }
+  if (has_constraint_names) {
+    output.constraint_names.reserve(model.constraints_size());
+    for (const ConstraintProto& ct : model.constraints()) {
+      output.constraint_names.push_back(ct.name());
+    }
+  }
+
+  if (model.has_objective()) {
+    const CpObjectiveProto& objective = model.objective();
+    if (!objective.domain().empty()) {
+      return absl::InvalidArgumentError(
+          "Objective domains are not supported by linear model files.");
+    }
+    // The objective value is scaling_factor * (sum + offset).
+    const double scaling_factor =
+        objective.scaling_factor() == 0.0 ? 1.0 : objective.scaling_factor();
+    if (scaling_factor != 1.0 && scaling_factor != -1.0) {
+      return absl::InvalidArgumentError(
+          "Scaled objectives are not supported by linear model files.");
+    }
+    output.maximize = scaling_factor == -1.0;
+    output.objective_offset = scaling_factor * objective.offset();
+    for (int i = 0; i < objective.vars_size(); ++i) {
+      const int ref = objective.vars(i);
+      const int64_t coeff = objective.coeffs(i);
+      ASSIGN_OR_RETURN(const double value,
+                       IntegerToDouble(RefIsPositive(ref) ? coeff : -coeff));
+      output.objective_coefficients[PositiveRef(ref)] +=
+          scaling_factor * value;
+    }
+  }
+  return output;
+}
+
+absl::StatusOr<CpModelProto> LinearModelViewToCpModelProto(
+    const LinearModelView& model) {
+  CpModelProto output;
+  output.set_name(model.name());
+  output.mutable_variables()->Reserve(model.num_variables());
+  for (int64_t i = 0; i < model.num_variables(); ++i) {
+    const double lb = model.variable_lower_bounds()[i];
+    const double ub = model.variable_upper_bounds()[i];
+    if (!model.variable_is_integer()[i]) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Variable ", i, " is not integer."));
+    }
+    if (lb < -kMaxExactInteger || ub > kMaxExactInteger) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Variable ", i, " has too large bounds."));
+    }
+    if (std::ceil(lb) > std::floor(ub)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Variable ", i, " has an empty domain."));
+    }
+    IntegerVariableProto* var = output.add_variables();
+    var->add_domain(static_cast<int64_t>(std::ceil(lb)));
+    var->add_domain(static_cast<int64_t>(std::floor(ub)));
+    if (model.has_names()) var->set_name(model.variable_name(i));
+  }
+
+  output.mutable_constraints()->Reserve(model.num_constraints());
+  for (int64_t c = 0; c < model.num_constraints(); ++c) {
+    ConstraintProto* ct = output.add_constraints();
+    if (model.has_names()) ct->set_name(model.constraint_name(c));
+    LinearConstraintProto* linear = ct->mutable_linear();
+    const auto column_indices = model.ColumnIndices(c);
+    const auto coefficients = model.Coefficients(c);
+    linear->mutable_vars()->Add(column_indices.begin(), column_indices.end());
+    linear->mutable_coeffs()->Reserve(coefficients.size());
+    for (const double coefficient : coefficients) {
+      ASSIGN_OR_RETURN(const int64_t coeff, CoefficientToInteger(coefficient));
+      linear->add_coeffs(coeff);
+    }
+    ASSIGN_OR_RETURN(const int64_t lb,
+                     LowerBoundToInteger(model.constraint_lower_bounds()[c]));
+    ASSIGN_OR_RETURN(const int64_t ub,
+                     UpperBoundToInteger(model.constraint_upper_bounds()[c]));
+    if (lb > ub) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Constraint ", c, " has an empty domain."));
+    }
+    linear->add_domain(lb);
+    linear->add_domain(ub);
+  }
+
+  bool has_objective = model.objective_offset() != 0.0;
+  for (const double coefficient : model.objective_coefficients()) {
+    has_objective |= coefficient != 0.0;
+  }
+  if (has_objective) {
+    // A maximization is stored as the minimization of the opposite objective.
+    const double sign = model.maximize() ? -1.0 : 1.0;
+    CpObjectiveProto* objective = output.mutable_objective();
+    for (int64_t i = 0; i < model.num_variables(); ++i) {
+      const double coefficient = model.objective_coefficients()[i];
+      if (coefficient == 0.0) continue;
+      ASSIGN_OR_RETURN(const int64_t coeff,
+                       CoefficientToInteger(sign * coefficient));
+      objective->add_vars(i);
+      objective->add_coeffs(coeff);
+    }
+    objective->set_offset(sign * model.objective_offset());
+    if (model.maximize()) objective->set_scaling_factor(-1.0);
+  }
+  return output;
+}
+
+}  // namespace sat
+}  // namespace operations_research
@@ -0,0 +1,51 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Conversions between CP-SAT models and linear model files, a compact binary
+// format which is memory-mapped when read (see
+// ortools/util/linear_model_file.h). Loading a CpModelProto from such a file
+// only copies flat arrays, instead of parsing a serialized proto.
+
+#ifndef OR_TOOLS_SAT_LINEAR_MODEL_FILE_UTILS_H_
+#define OR_TOOLS_SAT_LINEAR_MODEL_FILE_UTILS_H_
+
+#include "absl/status/statusor.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/util/linear_model_file.h"
+
+namespace operations_research {
+namespace sat {
+
+// Converts a CP-SAT model to the contents of a linear model file. Returns an
+// InvalidArgumentError unless all the constraints are linear constraints
+// without enforcement literals, the domains of the variables and of the
+// constraints are single intervals, and the objective is a linear objective
+// minimized or maximized without scaling. The values must fit exactly in a
+// double; the bounds equal to the int64_t limits are stored as infinite. The
+// search strategy, solution hint and assumptions are dropped.
+absl::StatusOr<LinearModelArrays> CpModelProtoToLinearModelArrays(
+    const CpModelProto& model);
+
+// Converts a linear model file to a CP-SAT model. Returns an
+// InvalidArgumentError unless all the variables are integer with finite
+// bounds, and all the coefficients of the constraints and of the objective are
+// integers. The bounds of the variables and constraints are rounded to the
+// nearest integer in their domain. Use ConvertMPModelProtoToCpModelProto() in
+// ortools/sat/lp_utils.h for models with continuous variables.
+absl::StatusOr<CpModelProto> LinearModelViewToCpModelProto(
+    const LinearModelView& model);
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_LINEAR_MODEL_FILE_UTILS_H_
@@ -0,0 +1,311 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/linear_model_file_utils.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/parse_text_proto.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_utils.h"
+#include "ortools/util/linear_model_file.h"
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+using ::google::protobuf::contrib::parse_proto::ParseTextOrDie;
+using ::testing::ElementsAre;
+using ::testing::EqualsProto;
+using ::testing::HasSubstr;
+using ::testing::status::StatusIs;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+constexpr int64_t kInt64Min = std::numeric_limits<int64_t>::min();
+constexpr int64_t kInt64Max = std::numeric_limits<int64_t>::max();
+
+// Converts `model` to a linear model file and back.
+absl::StatusOr<CpModelProto> RoundTrip(const CpModelProto& model) {
+  ASSIGN_OR_RETURN(const LinearModelArrays arrays,
+                   CpModelProtoToLinearModelArrays(model));
+  ASSIGN_OR_RETURN(const std::string data, SerializeLinearModel(arrays));
+  ASSIGN_OR_RETURN(const LinearModelView view, LinearModelView::Create(data));
+  return LinearModelViewToCpModelProto(view);
+}
+
+// Returns the CP-SAT model read from the linear model file holding `arrays`.
+absl::StatusOr<CpModelProto> FromArrays(const LinearModelArrays& arrays) {
+  ASSIGN_OR_RETURN(const std::string data, SerializeLinearModel(arrays));
+  ASSIGN_OR_RETURN(const LinearModelView view, LinearModelView::Create(data));
+  return LinearModelViewToCpModelProto(view);
+}
+
+// A model with two integer variables and one constraint, which is unchanged by
+// a round trip.
+LinearModelArrays TestArrays() {
+  LinearModelArrays arrays;
+  arrays.variable_lower_bounds = {0.0, -2.0};
+  arrays.variable_upper_bounds = {10.0, 3.0};
+  arrays.objective_coefficients = {1.0, -1.0};
+  arrays.variable_is_integer = {1, 1};
+  arrays.constraint_lower_bounds = {-kInfinity};
+  arrays.constraint_upper_bounds = {4.0};
+  arrays.row_starts = {0, 2};
+  arrays.column_indices = {0, 1};
+  arrays.coefficients = {2.0, 3.0};
+  return arrays;
+}
+
+TEST(LinearModelFileUtilsTest, RoundTrip) {
+  const CpModelProto model = ParseTextOrDie<CpModelProto>(R"pb(
+    name: "test"
+    variables { name: "x" domain: [ 0, 10 ] }
+    variables { name: "y" domain: [ -5, 5 ] }
+    variables { name: "" domain: [ -9007199254740992, 9007199254740992 ] }
+    constraints {
+      name: "c0"
+      linear { vars: [ 0, 1 ] coeffs: [ 2, -3 ] domain: [ -4, 7 ] }
+    }
+    constraints {
+      linear { vars: [ 1, 2 ] coeffs: [ 1, 1 ] domain: [ 3, 3 ] }
+    }
+    objective { vars: [ 0, 2 ] coeffs: [ 1, -4 ] offset: 2.5 }
+  )pb");
+  const absl::StatusOr<CpModelProto> round_trip = RoundTrip(model);
+  ASSERT_TRUE(round_trip.ok()) << round_trip.status();
+  EXPECT_THAT(*round_trip, EqualsProto(model));
+}
+
+// Infinite bounds of the constraints are stored as the int64_t limits.
+TEST(LinearModelFileUtilsTest, InfiniteConstraintDomains) {
+  CpModelProto model = ParseTextOrDie<CpModelProto>(R"pb(
+    variables { domain: [ 0, 10 ] }
+    constraints { linear { vars: 0 coeffs: 1 } }
+    constraints { linear { vars: 0 coeffs: 1 } }
+    constraints { linear { vars: 0 coeffs: 1 } }
+  )pb");
+  model.mutable_constraints(0)->mutable_linear()->add_domain(kInt64Min);
+  model.mutable_constraints(0)->mutable_linear()->add_domain(4);
+  model.mutable_constraints(1)->mutable_linear()->add_domain(-4);
+  model.mutable_constraints(1)->mutable_linear()->add_domain(kInt64Max);
+  model.mutable_constraints(2)->mutable_linear()->add_domain(kInt64Min);
+  model.mutable_constraints(2)->mutable_linear()->add_domain(kInt64Max);
+
+  const absl::StatusOr<LinearModelArrays> arrays =
+      CpModelProtoToLinearModelArrays(model);
+  ASSERT_TRUE(arrays.ok()) << arrays.status();
+  EXPECT_THAT(arrays->constraint_lower_bounds,
+              ElementsAre(-kInfinity, -4.0, -kInfinity));
+  EXPECT_THAT(arrays->constraint_upper_bounds,
+              ElementsAre(4.0, kInfinity, kInfinity));
+  const absl::StatusOr<CpModelProto> round_trip = RoundTrip(model);
+  ASSERT_TRUE(round_trip.ok()) << round_trip.status();
+  EXPECT_THAT(*round_trip, EqualsProto(model));
+}
+
+// A negated reference stands for the opposite of the variable, and is stored
+// as a negated coefficient.
+TEST(LinearModelFileUtilsTest, NegatedReferences) {
+  CpModelProto model = ParseTextOrDie<CpModelProto>(R"pb(
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ -5, 5 ] }
+    constraints { linear { coeffs: [ 2, 3 ] domain: [ -4, 7 ] } }
+    objective { coeffs: [ 5, 1 ] }
+  )pb");
+  model.mutable_constraints(0)->mutable_linear()->add_vars(NegatedRef(0));
+  model.mutable_constraints(0)->mutable_linear()->add_vars(1);
+  model.mutable_objective()->add_vars(0);
+  model.mutable_objective()->add_vars(NegatedRef(1));
+
+  const absl::StatusOr<LinearModelArrays> arrays =
+      CpModelProtoToLinearModelArrays(model);
+  ASSERT_TRUE(arrays.ok()) << arrays.status();
+  EXPECT_THAT(arrays->column_indices, ElementsAre(0, 1));
+  EXPECT_THAT(arrays->coefficients, ElementsAre(-2.0, 3.0));
+  EXPECT_THAT(arrays->objective_coefficients, ElementsAre(5.0, -1.0));
+
+  const absl::StatusOr<CpModelProto> round_trip = RoundTrip(model);
+  ASSERT_TRUE(round_trip.ok()) << round_trip.status();
+  EXPECT_THAT(*round_trip, EqualsProto(ParseTextOrDie<CpModelProto>(R"pb(
+                variables { domain: [ 0, 10 ] }
+                variables { domain: [ -5, 5 ] }
+                constraints {
+                  linear {
+                    vars: [ 0, 1 ]
+                    coeffs: [ -2, 3 ]
+                    domain: [ -4, 7 ]
+                  }
+                }
+                objective { vars: [ 0, 1 ] coeffs: [ 5, -1 ] }
+              )pb")));
+}
+
+// A maximization is a minimization of the opposite objective, with a scaling
+// factor of -1.
+TEST(LinearModelFileUtilsTest, Maximization) {
+  const CpModelProto model = ParseTextOrDie<CpModelProto>(R"pb(
+    variables { domain: [ 0, 10 ] }
+    variables { domain: [ -5, 5 ] }
+    objective {
+      vars: [ 0, 1 ]
+      coeffs: [ -3, 1 ]
+      offset: -4
+      scaling_factor: -1
+    }
+  )pb");
+  const absl::StatusOr<LinearModelArrays> arrays =
+      CpModelProtoToLinearModelArrays(model);
+  ASSERT_TRUE(arrays.ok()) << arrays.status();
+  EXPECT_TRUE(arrays->maximize);
+  EXPECT_EQ(arrays->objective_offset, 4.0);
+  EXPECT_THAT(arrays->objective_coefficients, ElementsAre(3.0, -1.0));
+
+  const absl::StatusOr<CpModelProto> round_trip = RoundTrip(model);
+  ASSERT_TRUE(round_trip.ok()) << round_trip.status();
+  EXPECT_THAT(*round_trip, EqualsProto(model));
+}
+
+TEST(LinearModelFileUtilsTest, ObjectiveOffsetOnly) {
+  const CpModelProto model = ParseTextOrDie<CpModelProto>(R"pb(
+    variables { domain: [ 0, 1 ] }
+    objective { offset: 3 }
+  )pb");
+  const absl::StatusOr<CpModelProto> round_trip = RoundTrip(model);
+  ASSERT_TRUE(round_trip.ok()) << round_trip.status();
+  EXPECT_THAT(*round_trip, EqualsProto(model));
+}
+
+TEST(LinearModelFileUtilsTest, UnsupportedCpModels) {
+  const auto expect_invalid = [](const std::string& text,
+                                 const std::string& error) {
+    SCOPED_TRACE(text);
+    EXPECT_THAT(
+        CpModelProtoToLinearModelArrays(ParseTextOrDie<CpModelProto>(text)),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr(error)));
+  };
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 1 ] }
+                   variables { domain: [ 0, 10 ] }
+                   constraints {
+                     enforcement_literal: 0
+                     linear { vars: 1 coeffs: 1 domain: [ 0, 5 ] }
+                   }
+                 )pb",
+                 "enforcement literals");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 1 ] }
+                   constraints { bool_or { literals: 0 } }
+                 )pb",
+                 "only linear constraints");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 1, 3, 5 ] }
+                 )pb",
+                 "single interval");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 10 ] }
+                   constraints {
+                     linear { vars: 0 coeffs: 1 domain: [ 0, 1, 3, 5 ] }
+                   }
+                 )pb",
+                 "single interval");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 10 ] }
+                   constraints {
+                     linear {
+                       vars: 0
+                       coeffs: 9007199254740993
+                       domain: [ 0, 1 ]
+                     }
+                   }
+                 )pb",
+                 "does not fit exactly");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 10 ] }
+                   objective { vars: 0 coeffs: 1 scaling_factor: 2 }
+                 )pb",
+                 "Scaled objectives");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 10 ] }
+                   objective { vars: 0 coeffs: 1 domain: [ 0, 5 ] }
+                 )pb",
+                 "Objective domains");
+  expect_invalid(R"pb(
+                   variables { domain: [ 0, 10 ] }
+                   floating_point_objective { vars: 0 coeffs: 1.5 }
+                 )pb",
+                 "Floating point objectives");
+}
+
+TEST(LinearModelFileUtilsTest, BoundsAreRounded) {
+  LinearModelArrays arrays = TestArrays();
+  arrays.variable_lower_bounds = {-0.5, -2.0};
+  arrays.variable_upper_bounds = {9.5, 3.0};
+  arrays.constraint_lower_bounds = {-1.5};
+  arrays.constraint_upper_bounds = {4.5};
+  const absl::StatusOr<CpModelProto> model = FromArrays(arrays);
+  ASSERT_TRUE(model.ok()) << model.status();
+  EXPECT_THAT(model->variables(0).domain(), ElementsAre(0, 9));
+  EXPECT_THAT(model->constraints(0).linear().domain(), ElementsAre(-1, 4));
+}
+
+TEST(LinearModelFileUtilsTest, UnsupportedLinearModels) {
+  ASSERT_TRUE(FromArrays(TestArrays()).ok());
+  LinearModelArrays arrays = TestArrays();
+  arrays.coefficients[1] = 1.5;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("coefficient 1.5 is not an integer")));
+
+  arrays = TestArrays();
+  arrays.objective_coefficients[0] = 0.5;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("coefficient 0.5 is not an integer")));
+
+  arrays = TestArrays();
+  arrays.variable_is_integer[1] = 0;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Variable 1 is not integer")));
+
+  arrays = TestArrays();
+  arrays.variable_upper_bounds[0] = kInfinity;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Variable 0 has too large bounds")));
+
+  arrays = TestArrays();
+  arrays.variable_lower_bounds[0] = 0.2;
+  arrays.variable_upper_bounds[0] = 0.8;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Variable 0 has an empty domain")));
+
+  arrays = TestArrays();
+  arrays.constraint_lower_bounds[0] = 1.2;
+  arrays.constraint_upper_bounds[0] = 1.8;
+  EXPECT_THAT(FromArrays(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Constraint 0 has an empty domain")));
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
@@ -12,7 +12,9 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -20,6 +22,7 @@
 #include "absl/log/check.h"
 #include "absl/log/flags.h"
 #include "absl/log/initialize.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -34,17 +37,20 @@
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_solver.h"
 #include "ortools/sat/cp_model_utils.h"
+#include "ortools/sat/linear_model_file_utils.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/opb_reader.h"
 #include "ortools/sat/sat_cnf_reader.h"
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/util/file_util.h"
+#include "ortools/util/linear_model_file.h"
 
 ABSL_FLAG(
     std::string, input, "",
     "Required: input file of the problem to solve. Many format are supported:"
-    ".cnf (sat, max-sat, weighted max-sat), .opb (pseudo-boolean sat/optim) "
-    "and by default the CpModelProto proto (binary or text).");
+    ".cnf (sat, max-sat, weighted max-sat), .opb (pseudo-boolean sat/optim), "
+    ".lmf (linear model file) and by default the CpModelProto proto (binary "
+    "or text).");
 
 ABSL_FLAG(
     std::string, hint_file, "",
@@ -84,6 +90,7 @@ std::string ExtractName(absl::string_view full_filename) {
   TryToRemoveSuffix("prototxt", &filename);
   TryToRemoveSuffix("textproto", &filename);
   TryToRemoveSuffix("bin", &filename);
+  TryToRemoveSuffix("lmf", &filename);
   return filename;
 }
 
@@ -107,6 +114,15 @@ bool LoadProblem(const std::string& filename, absl::string_view hint_file,
     if (!reader.Load(filename, cp_model)) {
       LOG(FATAL) << "Cannot load file '" << filename << "'.";
     }
+  } else if (absl::EndsWith(filename, ".lmf")) {
+    LOG(INFO) << "Reading a linear model file.";
+    const absl::StatusOr<std::unique_ptr<LinearModelFile>> file =
+        LinearModelFile::Open(filename);
+    CHECK_OK(file.status());
+    absl::StatusOr<CpModelProto> model =
+        LinearModelViewToCpModelProto((*file)->view());
+    CHECK_OK(model.status());
+    *cp_model = *std::move(model);
   } else {
     LOG(INFO) << "Reading a CpModelProto.";
     CHECK_OK(ReadFileToProto(filename, cp_model));
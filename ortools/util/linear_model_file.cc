@@ -0,0 +1,362 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/util/linear_model_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/base/file.h"
+#include "ortools/base/status_builder.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/util/mapped_file.h"
+
+namespace operations_research {
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'L', 'I', 'N', 'M', 'O', 'D'};
+constexpr uint32_t kVersion = 1;
+
+enum Flags : uint32_t {
+  kMaximize = 1 << 0,
+  kHasNames = 1 << 1,
+};
+
+// The header at the beginning of a linear model file.
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  int64_t num_variables;
+  int64_t num_constraints;
+  int64_t num_non_zeros;
+  // The number of characters of all the names.
+  int64_t names_size;
+  double objective_offset;
+};
+static_assert(sizeof(Header) % 8 == 0);
+
+// The positions of the arrays in a linear model file, in bytes.
+struct Layout {
+  size_t variable_lower_bounds;
+  size_t variable_upper_bounds;
+  size_t objective_coefficients;
+  size_t variable_is_integer;
+  size_t constraint_lower_bounds;
+  size_t constraint_upper_bounds;
+  size_t row_starts;
+  size_t column_indices;
+  size_t coefficients;
+  size_t name_offsets;
+  size_t names;
+  // The size of the whole file.
+  size_t size;
+};
+
+// The header must be valid, see CheckHeader().
+Layout ComputeLayout(const Header& header) {
+  const size_t num_variables = header.num_variables;
+  const size_t num_constraints = header.num_constraints;
+  const size_t num_non_zeros = header.num_non_zeros;
+  const size_t num_names =
+      (header.flags & kHasNames) ? 1 + num_variables + num_constraints : 0;
+  size_t offset = sizeof(Header);
+  // Returns the position of an array of the given size, and skips it.
+  const auto add_array = [&offset](const size_t size) {
+    const size_t start = offset;
+    offset += (size + 7) / 8 * 8;
+    return start;
+  };
+  Layout layout;
+  layout.variable_lower_bounds = add_array(num_variables * sizeof(double));
+  layout.variable_upper_bounds = add_array(num_variables * sizeof(double));
+  layout.objective_coefficients = add_array(num_variables * sizeof(double));
+  layout.variable_is_integer = add_array(num_variables * sizeof(uint8_t));
+  layout.constraint_lower_bounds = add_array(num_constraints * sizeof(double));
+  layout.constraint_upper_bounds = add_array(num_constraints * sizeof(double));
+  layout.row_starts = add_array((num_constraints + 1) * sizeof(int64_t));
+  layout.column_indices = add_array(num_non_zeros * sizeof(int32_t));
+  layout.coefficients = add_array(num_non_zeros * sizeof(double));
+  layout.name_offsets =
+      add_array(num_names == 0 ? 0 : (num_names + 1) * sizeof(int64_t));
+  layout.names = add_array(header.names_size);
+  layout.size = offset;
+  return layout;
+}
+
+// Checks that the dimensions in the header are compatible with a file of
+// `file_size` bytes, so that ComputeLayout() does not overflow.
+absl::Status CheckHeader(const Header& header, const size_t file_size) {
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return absl::InvalidArgumentError("Not a linear model file.");
+  }
+  if (header.version != kVersion) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Unsupported linear model file version: ", header.version));
+  }
+  if ((header.flags & ~(kMaximize | kHasNames)) != 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Unknown linear model file flags: ", header.flags));
+  }
+  const int64_t max_size = file_size;
+  if (header.num_variables < 0 || header.num_variables > max_size ||
+      header.num_variables > std::numeric_limits<int32_t>::max() ||
+      header.num_constraints < 0 || header.num_constraints > max_size ||
+      header.num_non_zeros < 0 || header.num_non_zeros > max_size ||
+      header.names_size < 0 || header.names_size > max_size) {
+    return absl::InvalidArgumentError(
+        "Invalid dimensions in linear model file.");
+  }
+  return absl::OkStatus();
+}
+
+template <typename T>
+absl::Span<const T> GetArray(absl::string_view data, size_t position,
+                             int64_t size) {
+  return absl::MakeConstSpan(reinterpret_cast<const T*>(data.data() + position),
+                             size);
+}
+
+template <typename T>
+void SetArray(absl::Span<const T> values, size_t position, std::string& data) {
+  if (values.empty()) return;
+  std::memcpy(data.data() + position, values.data(), values.size() * sizeof(T));
+}
+
+// Checks that `starts` are valid offsets into an array of `size` elements.
+bool AreValidStarts(absl::Span<const int64_t> starts, int64_t size) {
+  if (starts.front() != 0 || starts.back() != size) return false;
+  for (int i = 1; i < starts.size(); ++i) {
+    if (starts[i] < starts[i - 1]) return false;
+  }
+  return true;
+}
+
+absl::Status CheckLittleEndian() {
+#if defined(ABSL_IS_LITTLE_ENDIAN)
+  return absl::OkStatus();
+#else
+  return absl::UnimplementedError(
+      "Linear model files are only supported on little-endian platforms.");
+#endif
+}
+
+}  // namespace
+
+absl::StatusOr<std::string> SerializeLinearModel(
+    const LinearModelArrays& model) {
+  RETURN_IF_ERROR(CheckLittleEndian());
+  const size_t num_variables = model.variable_lower_bounds.size();
+  const size_t num_constraints = model.constraint_lower_bounds.size();
+  const size_t num_non_zeros = model.coefficients.size();
+  if (model.variable_upper_bounds.size() != num_variables ||
+      model.objective_coefficients.size() != num_variables ||
+      model.variable_is_integer.size() != num_variables ||
+      model.constraint_upper_bounds.size() != num_constraints ||
+      model.row_starts.size() != num_constraints + 1 ||
+      model.column_indices.size() != num_non_zeros) {
+    return absl::InvalidArgumentError(
+        "Inconsistent array sizes in linear model.");
+  }
+  if ((!model.variable_names.empty() &&
+       model.variable_names.size() != num_variables) ||
+      (!model.constraint_names.empty() &&
+       model.constraint_names.size() != num_constraints)) {
+    return absl::InvalidArgumentError(
+        "Inconsistent number of names in linear model.");
+  }
+  const bool has_names = !model.name.empty() ||
+                         !model.variable_names.empty() ||
+                         !model.constraint_names.empty();
+  if (num_variables > std::numeric_limits<int32_t>::max()) {
+    return absl::InvalidArgumentError(
+        "Too many variables for a linear model file.");
+  }
+
+  std::vector<int64_t> name_offsets;
+  std::string names;
+  if (has_names) {
+    name_offsets.reserve(2 + num_variables + num_constraints);
+    name_offsets.push_back(0);
+    const auto add_name = [&](absl::string_view name) {
+      absl::StrAppend(&names, name);
+      name_offsets.push_back(names.size());
+    };
+    add_name(model.name);
+    for (size_t i = 0; i < num_variables; ++i) {
+      add_name(model.variable_names.empty() ? "" : model.variable_names[i]);
+    }
+    for (size_t i = 0; i < num_constraints; ++i) {
+      add_name(model.constraint_names.empty() ? ""
+                                              : model.constraint_names[i]);
+    }
+  }
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.flags = (model.maximize ? kMaximize : 0) | (has_names ? kHasNames : 0);
+  header.num_variables = num_variables;
+  header.num_constraints = num_constraints;
+  header.num_non_zeros = num_non_zeros;
+  header.names_size = names.size();
+  header.objective_offset = model.objective_offset;
+  const Layout layout = ComputeLayout(header);
+
+  std::string data(layout.size, '\0');
+  std::memcpy(data.data(), &header, sizeof(header));
+  SetArray<double>(model.variable_lower_bounds, layout.variable_lower_bounds,
+                   data);
+  SetArray<double>(model.variable_upper_bounds, layout.variable_upper_bounds,
+                   data);
+  SetArray<double>(model.objective_coefficients, layout.objective_coefficients,
+                   data);
+  SetArray<uint8_t>(model.variable_is_integer, layout.variable_is_integer,
+                    data);
+  SetArray<double>(model.constraint_lower_bounds,
+                   layout.constraint_lower_bounds, data);
+  SetArray<double>(model.constraint_upper_bounds,
+                   layout.constraint_upper_bounds, data);
+  SetArray<int64_t>(model.row_starts, layout.row_starts, data);
+  SetArray<int32_t>(model.column_indices, layout.column_indices, data);
+  SetArray<double>(model.coefficients, layout.coefficients, data);
+  SetArray<int64_t>(name_offsets, layout.name_offsets, data);
+  SetArray<char>(names, layout.names, data);
+
+  // Check the contents of the arrays.
+  RETURN_IF_ERROR(LinearModelView::Create(data).status());
+  return data;
+}
+
+absl::Status WriteLinearModelFile(const LinearModelArrays& model,
+                                  const absl::string_view file_name) {
+  ASSIGN_OR_RETURN(const std::string data, SerializeLinearModel(model));
+  return file::SetContents(file_name, data, file::Defaults());
+}
+
+bool HasLinearModelFileHeader(const absl::string_view data) {
+  return absl::StartsWith(data, absl::string_view(kMagic, sizeof(kMagic)));
+}
+
+bool IsLinearModelFile(const absl::string_view file_name) {
+  File* file;
+  if (!file::Open(file_name, "rb", &file, file::Defaults()).ok()) return false;
+  char magic[sizeof(kMagic)];
+  const size_t size = file->Read(magic, sizeof(magic));
+  file->Close(file::Defaults()).IgnoreError();
+  delete file;
+  return HasLinearModelFileHeader(absl::string_view(magic, size));
+}
+
+absl::StatusOr<LinearModelView> LinearModelView::Create(
+    const absl::string_view data) {
+  RETURN_IF_ERROR(CheckLittleEndian());
+  if (data.size() < sizeof(Header)) {
+    return absl::InvalidArgumentError("Not a linear model file.");
+  }
+  if (reinterpret_cast<uintptr_t>(data.data()) % 8 != 0) {
+    return absl::InvalidArgumentError(
+        "The linear model data must be 8-byte aligned.");
+  }
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  RETURN_IF_ERROR(CheckHeader(header, data.size()));
+  const Layout layout = ComputeLayout(header);
+  if (layout.size != data.size()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid linear model file size: ", data.size(),
+                     ", expected: ", layout.size));
+  }
+
+  const int64_t num_variables = header.num_variables;
+  const int64_t num_constraints = header.num_constraints;
+  LinearModelView view;
+  view.maximize_ = (header.flags & kMaximize) != 0;
+  view.objective_offset_ = header.objective_offset;
+  view.variable_lower_bounds_ =
+      GetArray<double>(data, layout.variable_lower_bounds, num_variables);
+  view.variable_upper_bounds_ =
+      GetArray<double>(data, layout.variable_upper_bounds, num_variables);
+  view.objective_coefficients_ =
+      GetArray<double>(data, layout.objective_coefficients, num_variables);
+  view.variable_is_integer_ =
+      GetArray<uint8_t>(data, layout.variable_is_integer, num_variables);
+  view.constraint_lower_bounds_ =
+      GetArray<double>(data, layout.constraint_lower_bounds, num_constraints);
+  view.constraint_upper_bounds_ =
+      GetArray<double>(data, layout.constraint_upper_bounds, num_constraints);
+  view.row_starts_ =
+      GetArray<int64_t>(data, layout.row_starts, num_constraints + 1);
+  view.column_indices_ =
+      GetArray<int32_t>(data, layout.column_indices, header.num_non_zeros);
+  view.coefficients_ =
+      GetArray<double>(data, layout.coefficients, header.num_non_zeros);
+  if (header.flags & kHasNames) {
+    view.name_offsets_ = GetArray<int64_t>(data, layout.name_offsets,
+                                           2 + num_variables + num_constraints);
+    view.names_ = data.substr(layout.names, header.names_size);
+  }
+
+  if (!AreValidStarts(view.row_starts_, header.num_non_zeros)) {
+    return absl::InvalidArgumentError(
+        "Invalid row starts in linear model file.");
+  }
+  for (const uint8_t is_integer : view.variable_is_integer_) {
+    if (is_integer > 1) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid integrality in linear model file: ",
+                       static_cast<int>(is_integer)));
+    }
+  }
+  for (const int32_t column : view.column_indices_) {
+    if (column < 0 || column >= num_variables) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid column index in linear model file: ", column));
+    }
+  }
+  if (view.has_names() &&
+      !AreValidStarts(view.name_offsets_, header.names_size)) {
+    return absl::InvalidArgumentError(
+        "Invalid name offsets in linear model file.");
+  }
+  return view;
+}
+
+absl::StatusOr<std::unique_ptr<LinearModelFile>> LinearModelFile::Open(
+    const absl::string_view file_name) {
+  ASSIGN_OR_RETURN(std::unique_ptr<MappedFile> file,
+                   MappedFile::Open(file_name));
+  absl::StatusOr<LinearModelView> view =
+      LinearModelView::Create(file->contents());
+  if (!view.ok()) {
+    return util::StatusBuilder(view.status()).SetAppend()
+           << " File: '" << file_name << "'.";
+  }
+  return absl::WrapUnique(new LinearModelFile(std::move(file), *view));
+}
+
+}  // namespace operations_research
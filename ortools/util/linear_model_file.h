@@ -0,0 +1,211 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A compact binary format for linear and mixed-integer linear models, in which
+// all the data is stored in flat arrays that can be used in place. Unlike a
+// serialized proto, a file in this format is memory-mapped and read without
+// any parsing, and does not need to be copied to be used.
+//
+// The file starts with a header holding the dimensions of the model, followed
+// by these arrays, each starting at a multiple of 8 bytes:
+//   - the lower bounds, upper bounds and objective coefficients of the
+//     variables (double), and their integrality (uint8_t, 0 or 1),
+//   - the lower bounds and upper bounds of the constraints (double),
+//   - the constraint matrix in compressed sparse row format: the row starts
+//     (int64_t), the column indices (int32_t) and the coefficients (double),
+//   - optionally, the names of the model, of the variables and of the
+//     constraints, as the offsets of each name (int64_t) followed by their
+//     characters.
+// Numbers are stored in little-endian order. Infinite bounds are stored as
+// infinite doubles. The files use the .lmf extension by convention.
+//
+// The converters from and to MPModelProto and glop::LinearProgram are in
+// ortools/lp_data/proto_utils.h, the ones for CP-SAT in
+// ortools/sat/linear_model_file_utils.h, and the ones for MathOpt in
+// ortools/math_opt/io/linear_model_file_converter.h.
+
+#ifndef OR_TOOLS_UTIL_LINEAR_MODEL_FILE_H_
+#define OR_TOOLS_UTIL_LINEAR_MODEL_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/util/mapped_file.h"
+
+namespace operations_research {
+
+// The contents of a linear model, used to write a linear model file. The
+// vectors of the variables, of the constraints, and of the non-zeros of the
+// constraint matrix must have the same sizes. The names are optional: an empty
+// vector of names means that all the names are empty.
+struct LinearModelArrays {
+  bool maximize = false;
+  double objective_offset = 0.0;
+
+  std::vector<double> variable_lower_bounds;
+  std::vector<double> variable_upper_bounds;
+  std::vector<double> objective_coefficients;
+  std::vector<uint8_t> variable_is_integer;
+
+  std::vector<double> constraint_lower_bounds;
+  std::vector<double> constraint_upper_bounds;
+
+  // The terms of constraint i are at positions [row_starts[i],
+  // row_starts[i + 1]) of column_indices and coefficients, and row_starts has
+  // one more element than there are constraints.
+  std::vector<int64_t> row_starts = {0};
+  std::vector<int32_t> column_indices;
+  std::vector<double> coefficients;
+
+  std::string name;
+  std::vector<std::string> variable_names;
+  std::vector<std::string> constraint_names;
+};
+
+// Returns the linear model file holding `model`, or an InvalidArgumentError if
+// its arrays are inconsistent.
+absl::StatusOr<std::string> SerializeLinearModel(
+    const LinearModelArrays& model);
+
+// Writes `model` to the given file in the linear model file format.
+absl::Status WriteLinearModelFile(const LinearModelArrays& model,
+                                  absl::string_view file_name);
+
+// Returns true if `data` starts like a linear model file. This is a cheap test
+// used to detect the format of a file; LinearModelView::Create() does the full
+// validation.
+bool HasLinearModelFileHeader(absl::string_view data);
+
+// Returns true if the given file starts like a linear model file, and false if
+// it does not or can't be read. Only reads the first bytes of the file.
+bool IsLinearModelFile(absl::string_view file_name);
+
+// A read-only view of a linear model file, whose accessors directly point into
+// the underlying data.
+class LinearModelView {
+ public:
+  // Returns a view of `data`, which must stay alive and unchanged as long as
+  // the view is used. The data must be 8-byte aligned, which is the case of
+  // the contents of a MappedFile or of a std::string. Returns an
+  // InvalidArgumentError if `data` is not a valid linear model file, the
+  // checks being linear in its size.
+  static absl::StatusOr<LinearModelView> Create(absl::string_view data);
+
+  bool maximize() const { return maximize_; }
+  double objective_offset() const { return objective_offset_; }
+
+  int64_t num_variables() const { return variable_lower_bounds_.size(); }
+  int64_t num_constraints() const { return constraint_lower_bounds_.size(); }
+  int64_t num_non_zeros() const { return coefficients_.size(); }
+
+  absl::Span<const double> variable_lower_bounds() const {
+    return variable_lower_bounds_;
+  }
+  absl::Span<const double> variable_upper_bounds() const {
+    return variable_upper_bounds_;
+  }
+  absl::Span<const double> objective_coefficients() const {
+    return objective_coefficients_;
+  }
+  absl::Span<const uint8_t> variable_is_integer() const {
+    return variable_is_integer_;
+  }
+  absl::Span<const double> constraint_lower_bounds() const {
+    return constraint_lower_bounds_;
+  }
+  absl::Span<const double> constraint_upper_bounds() const {
+    return constraint_upper_bounds_;
+  }
+
+  // The constraint matrix, see LinearModelArrays.
+  absl::Span<const int64_t> row_starts() const { return row_starts_; }
+  absl::Span<const int32_t> column_indices() const { return column_indices_; }
+  absl::Span<const double> coefficients() const { return coefficients_; }
+
+  // The column indices and coefficients of the given constraint.
+  absl::Span<const int32_t> ColumnIndices(int64_t constraint) const {
+    return column_indices_.subspan(
+        row_starts_[constraint],
+        row_starts_[constraint + 1] - row_starts_[constraint]);
+  }
+  absl::Span<const double> Coefficients(int64_t constraint) const {
+    return coefficients_.subspan(
+        row_starts_[constraint],
+        row_starts_[constraint + 1] - row_starts_[constraint]);
+  }
+
+  // The names are empty when the file has none.
+  bool has_names() const { return !name_offsets_.empty(); }
+  absl::string_view name() const { return Name(0); }
+  absl::string_view variable_name(int64_t variable) const {
+    return Name(1 + variable);
+  }
+  absl::string_view constraint_name(int64_t constraint) const {
+    return Name(1 + num_variables() + constraint);
+  }
+
+ private:
+  LinearModelView() = default;
+
+  absl::string_view Name(int64_t index) const {
+    if (name_offsets_.empty()) return {};
+    return names_.substr(name_offsets_[index],
+                         name_offsets_[index + 1] - name_offsets_[index]);
+  }
+
+  bool maximize_ = false;
+  double objective_offset_ = 0.0;
+  absl::Span<const double> variable_lower_bounds_;
+  absl::Span<const double> variable_upper_bounds_;
+  absl::Span<const double> objective_coefficients_;
+  absl::Span<const uint8_t> variable_is_integer_;
+  absl::Span<const double> constraint_lower_bounds_;
+  absl::Span<const double> constraint_upper_bounds_;
+  absl::Span<const int64_t> row_starts_;
+  absl::Span<const int32_t> column_indices_;
+  absl::Span<const double> coefficients_;
+
+  // The name of the model, of the variables and of the constraints, in this
+  // order, are delimited by consecutive offsets into names_.
+  absl::Span<const int64_t> name_offsets_;
+  absl::string_view names_;
+};
+
+// A memory-mapped linear model file.
+class LinearModelFile {
+ public:
+  // Maps and validates the given file.
+  static absl::StatusOr<std::unique_ptr<LinearModelFile>> Open(
+      absl::string_view file_name);
+
+  // The model, valid as long as this object is alive.
+  const LinearModelView& view() const { return view_; }
+
+ private:
+  LinearModelFile(std::unique_ptr<MappedFile> file, LinearModelView view)
+      : file_(std::move(file)), view_(view) {}
+
+  std::unique_ptr<MappedFile> file_;
+  LinearModelView view_;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_UTIL_LINEAR_MODEL_FILE_H_
@@ -0,0 +1,326 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/util/linear_model_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/path.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/lp_data/proto_utils.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::EqualsProto;
+using ::testing::HasSubstr;
+using ::testing::status::StatusIs;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+std::string TestFile(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+// A model with 3 variables, 2 constraints and 4 non-zeros. Every field read
+// back from a linear model file is set, so that the model is unchanged by a
+// round trip.
+MPModelProto TestModel(bool with_names) {
+  MPModelProto model;
+  model.set_maximize(true);
+  model.set_objective_offset(1.5);
+  const auto add_variable = [&model](double lower_bound, double upper_bound,
+                                     double objective_coefficient,
+                                     bool is_integer) {
+    MPVariableProto* const variable = model.add_variable();
+    variable->set_lower_bound(lower_bound);
+    variable->set_upper_bound(upper_bound);
+    variable->set_objective_coefficient(objective_coefficient);
+    variable->set_is_integer(is_integer);
+  };
+  add_variable(0.0, 10.0, 1.0, /*is_integer=*/true);
+  add_variable(-kInfinity, kInfinity, -2.0, /*is_integer=*/false);
+  add_variable(-1.0, kInfinity, 0.0, /*is_integer=*/false);
+  MPConstraintProto* constraint = model.add_constraint();
+  constraint->set_lower_bound(-kInfinity);
+  constraint->set_upper_bound(4.0);
+  constraint->add_var_index(2);
+  constraint->add_coefficient(3.0);
+  constraint->add_var_index(0);
+  constraint->add_coefficient(1.0);
+  constraint->add_var_index(1);
+  constraint->add_coefficient(-1.0);
+  constraint = model.add_constraint();
+  constraint->set_lower_bound(2.0);
+  constraint->set_upper_bound(2.0);
+  constraint->add_var_index(1);
+  constraint->add_coefficient(0.5);
+  if (with_names) {
+    model.set_name("model");
+    model.mutable_variable(0)->set_name("x");
+    // An empty name among other names.
+    model.mutable_variable(1)->set_name("");
+    model.mutable_variable(2)->set_name("z");
+    model.mutable_constraint(0)->set_name("first");
+    model.mutable_constraint(1)->set_name("second");
+  } else {
+    model.set_name("");
+  }
+  return model;
+}
+
+LinearModelArrays TestArrays(bool with_names) {
+  absl::StatusOr<LinearModelArrays> arrays =
+      glop::MPModelProtoToLinearModelArrays(TestModel(with_names));
+  CHECK_OK(arrays.status());
+  return *std::move(arrays);
+}
+
+std::string SerializeTestModel(bool with_names) {
+  absl::StatusOr<std::string> data =
+      SerializeLinearModel(TestArrays(with_names));
+  CHECK_OK(data.status());
+  return *std::move(data);
+}
+
+TEST(LinearModelFileTest, RoundTripThroughMPModelProto) {
+  for (const bool with_names : {false, true}) {
+    SCOPED_TRACE(with_names);
+    const std::string filename = TestFile("round_trip.lmf");
+    const MPModelProto model = TestModel(with_names);
+    const absl::StatusOr<LinearModelArrays> arrays =
+        glop::MPModelProtoToLinearModelArrays(model);
+    ASSERT_TRUE(arrays.ok()) << arrays.status();
+    ASSERT_TRUE(WriteLinearModelFile(*arrays, filename).ok());
+    EXPECT_TRUE(IsLinearModelFile(filename));
+
+    const absl::StatusOr<std::unique_ptr<LinearModelFile>> file =
+        LinearModelFile::Open(filename);
+    ASSERT_TRUE(file.ok()) << file.status();
+    const LinearModelView& view = (*file)->view();
+    EXPECT_EQ(view.num_variables(), 3);
+    EXPECT_EQ(view.num_constraints(), 2);
+    EXPECT_EQ(view.num_non_zeros(), 4);
+    EXPECT_EQ(view.has_names(), with_names);
+    EXPECT_EQ(view.variable_name(0), with_names ? "x" : "");
+    EXPECT_EQ(view.constraint_name(1), with_names ? "second" : "");
+    MPModelProto read_model;
+    glop::LinearModelViewToMPModelProto(view, &read_model);
+    EXPECT_THAT(read_model, EqualsProto(model));
+  }
+}
+
+TEST(LinearModelFileTest, EmptyModel) {
+  const absl::StatusOr<std::string> data =
+      SerializeLinearModel(LinearModelArrays());
+  ASSERT_TRUE(data.ok()) << data.status();
+  const absl::StatusOr<LinearModelView> view = LinearModelView::Create(*data);
+  ASSERT_TRUE(view.ok()) << view.status();
+  EXPECT_EQ(view->num_variables(), 0);
+  EXPECT_EQ(view->num_constraints(), 0);
+  EXPECT_FALSE(view->has_names());
+}
+
+TEST(LinearModelFileTest, InconsistentArrays) {
+  LinearModelArrays arrays = TestArrays(/*with_names=*/false);
+  arrays.objective_coefficients.pop_back();
+  EXPECT_THAT(SerializeLinearModel(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  arrays = TestArrays(/*with_names=*/false);
+  arrays.column_indices[0] = 3;
+  EXPECT_THAT(SerializeLinearModel(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(LinearModelFileTest, IsLinearModelFile) {
+  const std::string filename = TestFile("detection.lmf");
+  CHECK_OK(file::SetContents(filename, SerializeTestModel(/*with_names=*/false),
+                             file::Defaults()));
+  EXPECT_TRUE(IsLinearModelFile(filename));
+  // The header is enough.
+  CHECK_OK(file::SetContents(filename, "ORLINMOD", file::Defaults()));
+  EXPECT_TRUE(IsLinearModelFile(filename));
+  CHECK_OK(file::SetContents(filename, "ORLINMO", file::Defaults()));
+  EXPECT_FALSE(IsLinearModelFile(filename));
+  CHECK_OK(file::SetContents(filename, "variable { }", file::Defaults()));
+  EXPECT_FALSE(IsLinearModelFile(filename));
+  EXPECT_FALSE(IsLinearModelFile(TestFile("missing.lmf")));
+}
+
+// The layout of the test model without names: the header, then the arrays.
+constexpr size_t kHeaderSize = 56;
+constexpr size_t kVersionOffset = 8;
+constexpr size_t kFlagsOffset = 12;
+constexpr size_t kNumVariablesOffset = 16;
+constexpr size_t kIsIntegerOffset = kHeaderSize + 3 * 3 * sizeof(double);
+constexpr size_t kRowStartsOffset =
+    kIsIntegerOffset + 8 + 2 * 2 * sizeof(double);
+constexpr size_t kColumnIndicesOffset = kRowStartsOffset + 3 * sizeof(int64_t);
+constexpr size_t kSize = kColumnIndicesOffset + 4 * sizeof(int32_t) +
+                         4 * sizeof(double);
+
+template <typename T>
+void SetValue(size_t offset, T value, std::string* data) {
+  std::memcpy(data->data() + offset, &value, sizeof(value));
+}
+
+absl::Status CreateView(const std::string& data) {
+  return LinearModelView::Create(data).status();
+}
+
+TEST(LinearModelFileTest, TestModelLayout) {
+  const std::string data = SerializeTestModel(/*with_names=*/false);
+  ASSERT_EQ(data.size(), kSize);
+  EXPECT_EQ(data[kIsIntegerOffset], 1);
+  EXPECT_EQ(data[kIsIntegerOffset + 1], 0);
+  int64_t row_start;
+  std::memcpy(&row_start, data.data() + kRowStartsOffset + 8, 8);
+  EXPECT_EQ(row_start, 3);
+  int32_t column;
+  std::memcpy(&column, data.data() + kColumnIndicesOffset, 4);
+  EXPECT_EQ(column, 2);
+}
+
+TEST(LinearModelFileTest, TruncatedData) {
+  const std::string data = SerializeTestModel(/*with_names=*/false);
+  for (const size_t size : {size_t{0}, size_t{7}, kHeaderSize - 1, kHeaderSize,
+                            kRowStartsOffset, data.size() - 8,
+                            data.size() - 1}) {
+    SCOPED_TRACE(size);
+    EXPECT_THAT(CreateView(data.substr(0, size)),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+  EXPECT_THAT(CreateView(data + std::string(8, '\0')),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(LinearModelFileTest, TruncatedFile) {
+  const std::string filename = TestFile("truncated.lmf");
+  const std::string data = SerializeTestModel(/*with_names=*/true);
+  CHECK_OK(file::SetContents(filename, data.substr(0, data.size() - 8),
+                             file::Defaults()));
+  // The file is detected as a linear model file, but does not open.
+  EXPECT_TRUE(IsLinearModelFile(filename));
+  EXPECT_THAT(LinearModelFile::Open(filename).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("truncated.lmf")));
+}
+
+TEST(LinearModelFileTest, BadMagic) {
+  std::string data = SerializeTestModel(/*with_names=*/false);
+  data[3] = 'X';
+  EXPECT_FALSE(HasLinearModelFileHeader(data));
+  EXPECT_THAT(CreateView(data), StatusIs(absl::StatusCode::kInvalidArgument,
+                                         HasSubstr("Not a linear model")));
+}
+
+TEST(LinearModelFileTest, BadVersion) {
+  std::string data = SerializeTestModel(/*with_names=*/false);
+  SetValue<uint32_t>(kVersionOffset, 2, &data);
+  EXPECT_TRUE(HasLinearModelFileHeader(data));
+  EXPECT_THAT(CreateView(data), StatusIs(absl::StatusCode::kInvalidArgument,
+                                         HasSubstr("version")));
+}
+
+TEST(LinearModelFileTest, BadHeader) {
+  const std::string data = SerializeTestModel(/*with_names=*/false);
+  std::string corrupted = data;
+  SetValue<uint32_t>(kFlagsOffset, 1 << 5, &corrupted);
+  EXPECT_THAT(CreateView(corrupted),
+              StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("flags")));
+  for (const int64_t num_variables :
+       {int64_t{-1}, int64_t{4}, std::numeric_limits<int64_t>::max()}) {
+    SCOPED_TRACE(num_variables);
+    corrupted = data;
+    SetValue<int64_t>(kNumVariablesOffset, num_variables, &corrupted);
+    EXPECT_THAT(CreateView(corrupted),
+                StatusIs(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+TEST(LinearModelFileTest, NonMonotonicRowStarts) {
+  const std::string data = SerializeTestModel(/*with_names=*/false);
+  // The row starts are {0, 3, 4}.
+  const std::vector<std::pair<int, int64_t>> corruptions = {
+      {0, 1}, {1, 5}, {1, -1}, {2, 3}};
+  for (const auto& [index, value] : corruptions) {
+    SCOPED_TRACE(index);
+    std::string corrupted = data;
+    SetValue<int64_t>(kRowStartsOffset + index * sizeof(int64_t), value,
+                      &corrupted);
+    EXPECT_THAT(CreateView(corrupted),
+                StatusIs(absl::StatusCode::kInvalidArgument,
+                         HasSubstr("row starts")));
+  }
+}
+
+TEST(LinearModelFileTest, OutOfRangeColumnIndices) {
+  const std::string data = SerializeTestModel(/*with_names=*/false);
+  for (const int32_t column : {-1, 3, std::numeric_limits<int32_t>::max()}) {
+    SCOPED_TRACE(column);
+    std::string corrupted = data;
+    SetValue<int32_t>(kColumnIndicesOffset + sizeof(int32_t), column,
+                      &corrupted);
+    EXPECT_THAT(CreateView(corrupted),
+                StatusIs(absl::StatusCode::kInvalidArgument,
+                         HasSubstr("column index")));
+  }
+}
+
+TEST(LinearModelFileTest, InvalidIntegrality) {
+  std::string data = SerializeTestModel(/*with_names=*/false);
+  data[kIsIntegerOffset + 2] = 2;
+  EXPECT_THAT(CreateView(data), StatusIs(absl::StatusCode::kInvalidArgument,
+                                         HasSubstr("integrality")));
+  LinearModelArrays arrays = TestArrays(/*with_names=*/false);
+  arrays.variable_is_integer[1] = 255;
+  EXPECT_THAT(SerializeLinearModel(arrays),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(LinearModelFileTest, InvalidNameOffsets) {
+  const std::string data = SerializeTestModel(/*with_names=*/true);
+  // The name offsets are the second to last array, followed by the names.
+  const std::string names = "modelxzfirstsecond";
+  const size_t names_offset = data.size() - (names.size() + 7) / 8 * 8;
+  ASSERT_EQ(data.substr(names_offset, names.size()), names);
+  // The name offsets are {0, 5, 6, 6, 7, 12, 18}.
+  const size_t name_offsets_offset = names_offset - 7 * sizeof(int64_t);
+  const std::vector<std::pair<int, int64_t>> corruptions = {
+      {0, 1}, {2, 4}, {3, 19}, {6, 17}};
+  for (const auto& [index, value] : corruptions) {
+    SCOPED_TRACE(index);
+    std::string corrupted = data;
+    SetValue<int64_t>(name_offsets_offset + index * sizeof(int64_t), value,
+                      &corrupted);
+    EXPECT_THAT(CreateView(corrupted),
+                StatusIs(absl::StatusCode::kInvalidArgument,
+                         HasSubstr("name offsets")));
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -0,0 +1,97 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/util/mapped_file.h"
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !defined(_MSC_VER)
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "ortools/base/file.h"
+#include "ortools/base/status_macros.h"
+
+namespace operations_research {
+
+absl::StatusOr<std::unique_ptr<MappedFile>> MappedFile::Open(
+    const absl::string_view file_name) {
+  std::unique_ptr<MappedFile> file(new MappedFile());
+#if !defined(_MSC_VER)
+  const std::string null_terminated_name(file_name);
+  const int fd = open(null_terminated_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(
+        errno, absl::StrCat("Could not open '", file_name, "'"));
+  }
+  struct stat file_stat;
+  // mmap() fails on empty files, and files such as those of /proc have a size
+  // of zero but are not empty: both are read instead.
+  if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+      file_stat.st_size > 0) {
+    void* const data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+                            fd, /*offset=*/0);
+    if (data != MAP_FAILED) {
+      close(fd);
+      file->data_ = static_cast<const char*>(data);
+      file->size_ = file_stat.st_size;
+      file->is_mapped_ = true;
+      return file;
+    }
+  }
+  // Not a regular file, or a file system that does not support mmap(): fall
+  // back to reading the file until its end, as its size may be unknown.
+  constexpr size_t kBufferSize = 1 << 20;
+  const std::unique_ptr<char[]> buffer(new char[kBufferSize]);
+  while (true) {
+    const ssize_t num_read = read(fd, buffer.get(), kBufferSize);
+    if (num_read < 0 && errno == EINTR) continue;
+    if (num_read < 0) {
+      const int read_errno = errno;
+      close(fd);
+      return absl::ErrnoToStatus(
+          read_errno, absl::StrCat("Could not read '", file_name, "'"));
+    }
+    if (num_read == 0) break;
+    file->buffer_.append(buffer.get(), num_read);
+  }
+  close(fd);
+#else   // !defined(_MSC_VER)
+  RETURN_IF_ERROR(
+      file::GetContents(file_name, &file->buffer_, file::Defaults()));
+#endif  // !defined(_MSC_VER)
+  file->data_ = file->buffer_.data();
+  file->size_ = file->buffer_.size();
+  return file;
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_MSC_VER)
+  if (is_mapped_) {
+    CHECK_EQ(munmap(const_cast<char*>(data_), size_), 0);
+  }
+#endif  // !defined(_MSC_VER)
+}
+
+}  // namespace operations_research
@@ -0,0 +1,60 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_UTIL_MAPPED_FILE_H_
+#define OR_TOOLS_UTIL_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace operations_research {
+
+// A read-only view of the whole contents of a file.
+//
+// On POSIX systems the file is memory-mapped, so that its pages are only read
+// from disk when they are first accessed, and can be accessed from several
+// threads without copying. On other systems, and for files which can't be
+// mapped such as empty files or pipes, the file is read into memory.
+class MappedFile {
+ public:
+  // Maps the given file. Returns an error if the file can't be opened.
+  static absl::StatusOr<std::unique_ptr<MappedFile>> Open(
+      absl::string_view file_name);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  // The contents of the file, valid as long as this object is alive.
+  absl::string_view contents() const { return {data_, size_}; }
+
+ private:
+  MappedFile() = default;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+  // True if data_ is a memory mapping to release in the destructor.
+  bool is_mapped_ = false;
+
+  // Storage of the contents when the file is not memory-mapped.
+  std::string buffer_;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_UTIL_MAPPED_FILE_H_
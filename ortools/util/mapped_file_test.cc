@@ -0,0 +1,89 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/util/mapped_file.h"
+
+#if !defined(_MSC_VER)
+#include <sys/stat.h>
+#endif  // !defined(_MSC_VER)
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "gtest/gtest.h"
+#include "ortools/base/file.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/path.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::status::StatusIs;
+
+std::string TestFile(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+TEST(MappedFileTest, RegularFile) {
+  const std::string filename = TestFile("mapped_file_regular");
+  std::string data;
+  for (int i = 0; i < 100000; ++i) data += static_cast<char>('a' + i % 26);
+  data[1234] = '\0';
+  CHECK_OK(file::SetContents(filename, data, file::Defaults()));
+  const absl::StatusOr<std::unique_ptr<MappedFile>> file =
+      MappedFile::Open(filename);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_EQ((*file)->contents(), data);
+}
+
+TEST(MappedFileTest, EmptyFile) {
+  const std::string filename = TestFile("mapped_file_empty");
+  CHECK_OK(file::SetContents(filename, "", file::Defaults()));
+  const absl::StatusOr<std::unique_ptr<MappedFile>> file =
+      MappedFile::Open(filename);
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_TRUE((*file)->contents().empty());
+}
+
+TEST(MappedFileTest, MissingFile) {
+  EXPECT_THAT(MappedFile::Open(TestFile("mapped_file_missing")),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+#if !defined(_MSC_VER)
+// A pipe can't be mapped, and has no size: it is read until its end.
+TEST(MappedFileTest, ReadFallback) {
+  const std::string filename = TestFile("mapped_file_fifo");
+  remove(filename.c_str());
+  ASSERT_EQ(mkfifo(filename.c_str(), 0600), 0);
+  std::string data;
+  for (int i = 0; i < 3000000; ++i) data += static_cast<char>('0' + i % 10);
+  std::thread writer([&filename, &data]() {
+    CHECK_OK(file::SetContents(filename, data, file::Defaults()));
+  });
+  const absl::StatusOr<std::unique_ptr<MappedFile>> file =
+      MappedFile::Open(filename);
+  writer.join();
+  ASSERT_TRUE(file.ok()) << file.status();
+  EXPECT_EQ((*file)->contents(), data);
+  remove(filename.c_str());
+}
+#endif  // !defined(_MSC_VER)
+
+}  // namespace
+}  // namespace operations_research